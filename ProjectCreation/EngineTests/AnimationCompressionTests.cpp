@@ -0,0 +1,174 @@
+#include "TestFramework.h"
+
+#include <math.h>
+#include <random>
+#include <vector>
+
+#include <AnimationCompression.h>
+
+using namespace DirectX;
+
+namespace
+{
+        constexpr double kFrameDuration = 1.0 / 24.0;
+
+        // Same chord form as the compressor, acos of the dot product can't resolve the tolerances in floats
+        float QuaternionAngle(FXMVECTOR a, FXMVECTOR b)
+        {
+                float chord = std::min(XMVectorGetX(XMVector4Length(XMVectorSubtract(a, b))),
+                                       XMVectorGetX(XMVector4Length(XMVectorAdd(a, b))));
+                return 4.0f * asinf(std::min(chord * 0.5f, 1.0f));
+        }
+
+        float Distance(FXMVECTOR a, FXMVECTOR b)
+        {
+                return XMVectorGetX(XMVector3Length(XMVectorSubtract(a, b)));
+        }
+
+        // Joints turn at a constant rate about a fixed axis, every other joint holds still for the first half,
+        // translations move linearly in two legs and scales never change. Slerp and lerp rebuild all of it exactly
+        // except at the corners, so compression has constant tracks and removable keys to find.
+        Animation::FAnimClip MakeTestClip(uint32_t jointCount, int frameCount)
+        {
+                Animation::FAnimClip clip;
+                clip.jointCount = jointCount;
+                clip.duration   = (frameCount - 1) * kFrameDuration;
+
+                for (int frame = 0; frame < frameCount; ++frame)
+                {
+                        float time = float(frame * kFrameDuration);
+                        float half = float(clip.duration * 0.5);
+                        clip.times.push_back(frame * kFrameDuration);
+
+                        for (uint32_t j = 0; j < jointCount; ++j)
+                        {
+                                bool     holding = (j % 2) == 1 && frame < frameCount / 2;
+                                float    angle   = holding ? 0.0f : (time - half) * (0.5f + 0.1f * j);
+                                XMVECTOR axis    = XMVector3Normalize(XMVectorSet(1.0f, float(j % 3), 0.5f, 0.0f));
+
+                                float    leg         = std::min(time, half);
+                                XMVECTOR translation = XMVectorSet(float(j), leg * 2.0f, time - leg, 1.0f);
+
+                                clip.rotations.push_back(XMQuaternionRotationAxis(axis, angle));
+                                clip.translations.push_back(translation);
+                                clip.scales.push_back(XMVectorSet(1.0f, 1.0f, 1.0f, 1.0f));
+                        }
+                }
+
+                return clip;
+        }
+
+        // Samples like AnimationSystem, returns the pose at time
+        void SampleAt(const Animation::FCompressedAnimClip& clip, double time, int& cursor, FTransform* pose)
+        {
+                int    prevFrame = clip.FindKeyFrame(time, cursor);
+                double prevTime  = clip.times[prevFrame];
+                double nextTime  = clip.times[prevFrame + 1];
+                float  ratio     = std::min(std::max(float((time - prevTime) / (nextTime - prevTime)), 0.0f), 1.0f);
+
+                Animation::SampleCompressedAnimClip(clip, prevFrame, ratio, pose);
+        }
+} // namespace
+
+ENGINE_TEST(AnimationCompression_QuantizedQuaternionRoundTrip)
+{
+        std::mt19937                          random(27);
+        std::uniform_real_distribution<float> component(-1.0f, 1.0f);
+
+        float maxError = 0.0f;
+        for (int i = 0; i < 100000; ++i)
+        {
+                XMVECTOR quaternion = XMQuaternionNormalize(
+                    XMVectorSet(component(random), component(random), component(random), component(random)));
+
+                XMVECTOR decoded = Animation::DequantizeQuaternion(Animation::QuantizeQuaternion(quaternion));
+                maxError         = std::max(maxError, QuaternionAngle(quaternion, decoded));
+        }
+
+        // 15 bits over [-1/sqrt(2), 1/sqrt(2)] per component
+        CHECK(maxError < 0.0005f);
+}
+
+ENGINE_TEST(AnimationCompression_SampledPoseMatchesSource)
+{
+        const uint32_t       jointCount = 24;
+        const int            frameCount = 97;
+        Animation::FAnimClip source     = MakeTestClip(jointCount, frameCount);
+
+        Animation::FAnimCompressionSettings settings;
+        Animation::FCompressedAnimClip      compressed;
+        Animation::CompressAnimClip(source, compressed, settings);
+
+        CHECK(compressed.jointCount == jointCount);
+        CHECK(compressed.times.front() == source.times.front());
+        CHECK(compressed.times.back() == source.times.back());
+        CHECK(compressed.GetFrameCount() < frameCount);
+        CHECK(compressed.animatedScaleJoints.empty());
+        CHECK(compressed.animatedRotationJoints.size() == jointCount);
+        CHECK(compressed.animatedTranslationJoints.size() == jointCount);
+
+        // Key reduction tolerance plus the quantization error
+        const float rotationTolerance    = settings.rotationTolerance + 0.0005f;
+        const float translationTolerance = settings.translationTolerance * 1.01f;
+
+        std::vector<FTransform> pose(jointCount);
+        int                     cursor = 0;
+
+        float maxRotationError    = 0.0f;
+        float maxTranslationError = 0.0f;
+        float maxScaleError       = 0.0f;
+        for (int frame = 0; frame < frameCount; ++frame)
+        {
+                SampleAt(compressed, source.times[frame], cursor, pose.data());
+
+                for (uint32_t j = 0; j < jointCount; ++j)
+                {
+                        size_t index = (size_t)frame * jointCount + j;
+                        maxRotationError =
+                            std::max(maxRotationError, QuaternionAngle(pose[j].rotation.data, source.rotations[index]));
+                        maxTranslationError =
+                            std::max(maxTranslationError, Distance(pose[j].translation, source.translations[index]));
+                        maxScaleError = std::max(maxScaleError, Distance(pose[j].scale, source.scales[index]));
+                }
+        }
+
+        CHECK(maxRotationError <= rotationTolerance);
+        CHECK(maxTranslationError <= translationTolerance);
+        CHECK(maxScaleError <= settings.scaleTolerance);
+}
+
+ENGINE_BENCHMARK(AnimationCompression_MemoryAndDecodeThroughput)
+{
+        const uint32_t       jointCount = 64;
+        const int            frameCount = 24 * 10;
+        Animation::FAnimClip source     = MakeTestClip(jointCount, frameCount);
+
+        double                         compressStart = EngineTests::GetSeconds();
+        Animation::FCompressedAnimClip compressed;
+        Animation::CompressAnimClip(source, compressed);
+        double compressSeconds = EngineTests::GetSeconds() - compressStart;
+
+        // Raw import format, three XMVECTORs per joint per frame plus the frame times
+        size_t rawKeys  = source.translations.size() + source.rotations.size() + source.scales.size();
+        size_t rawBytes = source.times.size() * sizeof(double) + rawKeys * sizeof(XMVECTOR);
+
+        EngineTests::ReportBenchmark("raw clip", rawBytes / 1024.0, "KB");
+        EngineTests::ReportBenchmark("compressed clip", compressed.GetMemoryUsage() / 1024.0, "KB");
+        EngineTests::ReportBenchmark("kept keyframes", 100.0 * compressed.GetFrameCount() / frameCount, "%");
+        EngineTests::ReportBenchmark("compress time", compressSeconds * 1000.0, "ms");
+
+        std::vector<FTransform> pose(jointCount);
+        int                     cursor      = 0;
+        const int               sampleCount = 100000;
+
+        double start = EngineTests::GetSeconds();
+        for (int i = 0; i < sampleCount; ++i)
+        {
+                double time = fmod(i * (1.0 / 60.0), compressed.duration);
+                SampleAt(compressed, time, cursor, pose.data());
+        }
+        double seconds = EngineTests::GetSeconds() - start;
+
+        EngineTests::ReportBenchmark("decoded poses", sampleCount / seconds, "poses/s");
+        EngineTests::ReportBenchmark("decoded joints", sampleCount * double(jointCount) / seconds, "joints/s");
+}
@@ -0,0 +1,131 @@
+#include "TestFramework.h"
+
+#include <stdio.h>
+#include <string>
+#include <unordered_map>
+
+#include <AssetArchive.h>
+#include <MemoryTracking.h>
+#include <ResourceManager.h>
+
+namespace
+{
+        // Ids fold names the same way archive paths are folded
+        static_assert(FAssetId("IBLTestBrdf") == FAssetId("ibltestbrdf"), "Error. Ids must be case insensitive");
+        static_assert(FAssetId("Models/Tree01") == FAssetId("Models\\Tree01"), "Error. Ids must ignore slash style");
+        static_assert(FAssetId("IBLTestBrdf") != FAssetId("IBLTestBrdf2"), "Error. Distinct names must differ");
+        static_assert(FAssetId().IsValid() == false, "Error. Only default constructed ids are invalid");
+
+        // The names RenderSystem looks up every frame
+        constexpr unsigned int kCommonTextureCount                      = 5;
+        constexpr const char*  kCommonTextureNames[kCommonTextureCount] = {"IBLTestDiffuseHDR",
+                                                                           "IBLTestSpecularHDR",
+                                                                           "IBLTestBrdf",
+                                                                           "Clouds_Fibers_BlurredNoise",
+                                                                           "Veins_Caustics_Tiles"};
+        constexpr FAssetId kCommonTextureIds[kCommonTextureCount] = {FAssetId(kCommonTextureNames[0]),
+                                                                     FAssetId(kCommonTextureNames[1]),
+                                                                     FAssetId(kCommonTextureNames[2]),
+                                                                     FAssetId(kCommonTextureNames[3]),
+                                                                     FAssetId(kCommonTextureNames[4])};
+
+        class FTestTexture : public Resource<FTestTexture>
+        {
+            public:
+                virtual void Release() override
+                {}
+        };
+
+        uint64_t GetAllocationCount()
+        {
+                uint64_t count = 0;
+                for (int tag = 0; tag < NMemory::E_MEMORY_TAG::COUNT; ++tag)
+                        count += NMemory::MemoryTracking::GetTagStats(tag).allocationCount;
+                return count;
+        }
+
+        void CreateCommonTextures(ResourceContainer<FTestTexture>& container, ResourceHandle* handles)
+        {
+                for (unsigned int i = 0; i < kCommonTextureCount; ++i)
+                        handles[i] = container.CreateResource(kCommonTextureNames[i]);
+                // Filler so the name table has more than a handful of buckets
+                for (unsigned int i = 0; i < 500; ++i)
+                        container.CreateResource("Texture" + std::to_string(i));
+        }
+} // namespace
+
+ENGINE_TEST(AssetId_MatchesArchivePathHash)
+{
+        const char* paths[] = {"Models/Tree01.mesh", "Textures\\IBLTestBrdf.dds", "MATERIALS/Planet02.mat", "a"};
+        for (const char* path : paths)
+                CHECK(FAssetId(path).m_Hash == FileIO::AssetArchive::HashPath(path));
+}
+
+ENGINE_TEST(AssetId_SteadyStateLookupsDontAllocate)
+{
+        ResourceContainer<FTestTexture> container;
+        ResourceHandle                  handles[kCommonTextureCount];
+        CreateCommonTextures(container, handles);
+
+        // Resolve by precomputed id and read through the handle, the way a frame does once everything is loaded
+        unsigned int wrongCount        = 0;
+        uint64_t     allocationsBefore = GetAllocationCount();
+        for (int frame = 0; frame < 1000; ++frame)
+        {
+                for (unsigned int i = 0; i < kCommonTextureCount; ++i)
+                {
+                        ResourceHandle handle = container.FindResource(kCommonTextureIds[i]);
+                        wrongCount += (handle == handles[i]) == false;
+                        wrongCount += container.IsValid(handle) == false;
+                        wrongCount += container.GetResource(handle)->IsReady() == false;
+                }
+        }
+        uint64_t allocationsAfter = GetAllocationCount();
+
+        CHECK(wrongCount == 0);
+        CHECK(allocationsAfter == allocationsBefore);
+}
+
+ENGINE_BENCHMARK(AssetId_LookupThroughput)
+{
+        ResourceContainer<FTestTexture> container;
+        ResourceHandle                  handles[kCommonTextureCount];
+        CreateCommonTextures(container, handles);
+
+        // The string keyed table the name lookups used before, a std::string built from the name on every call
+        std::unordered_map<std::string, ResourceHandle> stringTable;
+        for (unsigned int i = 0; i < kCommonTextureCount; ++i)
+                stringTable[kCommonTextureNames[i]] = handles[i];
+        for (unsigned int i = 0; i < 500; ++i)
+                stringTable["Texture" + std::to_string(i)] = ResourceHandle(kCommonTextureCount + i);
+
+        const int frameCount = 200000;
+        uint64_t  checksum   = 0;
+
+        uint64_t allocationsBefore = GetAllocationCount();
+        double   start             = EngineTests::GetSeconds();
+        for (int frame = 0; frame < frameCount; ++frame)
+        {
+                for (unsigned int i = 0; i < kCommonTextureCount; ++i)
+                        checksum += container.FindResource(kCommonTextureIds[i]).m_Id;
+        }
+        double   idSeconds     = EngineTests::GetSeconds() - start;
+        uint64_t idAllocations = GetAllocationCount() - allocationsBefore;
+
+        allocationsBefore = GetAllocationCount();
+        start             = EngineTests::GetSeconds();
+        for (int frame = 0; frame < frameCount; ++frame)
+        {
+                for (unsigned int i = 0; i < kCommonTextureCount; ++i)
+                        checksum += stringTable.find(std::string(kCommonTextureNames[i]))->second.m_Id;
+        }
+        double   stringSeconds     = EngineTests::GetSeconds() - start;
+        uint64_t stringAllocations = GetAllocationCount() - allocationsBefore;
+        CHECK(checksum == 2ULL * frameCount * (0 + 1 + 2 + 3 + 4));
+
+        const double lookupCount = double(frameCount) * kCommonTextureCount;
+        EngineTests::ReportBenchmark("FAssetId lookups", lookupCount / idSeconds, "lookups/s");
+        EngineTests::ReportBenchmark("FAssetId allocations", idAllocations / lookupCount, "per lookup");
+        EngineTests::ReportBenchmark("std::string lookups", lookupCount / stringSeconds, "lookups/s");
+        EngineTests::ReportBenchmark("std::string allocations", stringAllocations / lookupCount, "per lookup");
+}
@@ -0,0 +1,288 @@
+#include "TestFramework.h"
+
+#include <stdio.h>
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <ContainerUtility.h>
+
+// The stress tests are the ones to run under ThreadSanitizer (or any race detector the build has) after changing the
+// queues. Small capacities keep the queues full or empty most of the time, so both slow paths get exercised.
+
+namespace
+{
+        // Producer in the high bits, the producer's sequence number in the low bits
+        constexpr unsigned int kSequenceBits = 24;
+
+        inline uint32_t MakeItem(unsigned int producer, unsigned int sequence)
+        {
+                return (producer << kSequenceBits) | sequence;
+        }
+
+        // Same interface as the queues over a mutex and a std::deque, for the benchmark
+        template <typename T, unsigned MaxElements>
+        struct FMutexDequeQueue
+        {
+                bool TryPush(const T& element)
+                {
+                        std::lock_guard<std::mutex> lock(m_Mutex);
+                        if (m_Deque.size() >= MaxElements)
+                                return false;
+                        m_Deque.push_back(element);
+                        return true;
+                }
+                unsigned TryPushBatch(const T* elements, unsigned count)
+                {
+                        std::lock_guard<std::mutex> lock(m_Mutex);
+                        unsigned                    pushed = 0;
+                        while (pushed < count && m_Deque.size() < MaxElements)
+                                m_Deque.push_back(elements[pushed++]);
+                        return pushed;
+                }
+                bool TryPop(T& element)
+                {
+                        return TryPopBatch(&element, 1) == 1;
+                }
+                unsigned TryPopBatch(T* elements, unsigned maxCount)
+                {
+                        std::lock_guard<std::mutex> lock(m_Mutex);
+                        unsigned                    popped = 0;
+                        while (popped < maxCount && m_Deque.empty() == false)
+                        {
+                                elements[popped++] = m_Deque.front();
+                                m_Deque.pop_front();
+                        }
+                        return popped;
+                }
+
+                std::mutex    m_Mutex;
+                std::deque<T> m_Deque;
+        };
+
+        struct FQueueRun
+        {
+                unsigned int producerCount;
+                unsigned int consumerCount;
+                unsigned int itemsPerProducer;
+                unsigned int batchSize; // 1 uses TryPush and TryPop
+
+                // Filled by RunQueue
+                double       seconds       = 0.0;
+                unsigned int missingCount  = 0;
+                unsigned int repeatCount   = 0;
+                unsigned int outOfOrder    = 0;
+                unsigned int receivedCount = 0;
+        };
+
+        // Every producer pushes its sequence 0..itemsPerProducer-1, every consumer checks that each producer's items
+        // reach it in order. Afterwards every item must have arrived exactly once.
+        template <typename Queue>
+        void RunQueue(Queue& queue, FQueueRun& run)
+        {
+                const unsigned int totalCount = run.producerCount * run.itemsPerProducer;
+
+                std::unique_ptr<std::atomic<uint8_t>[]> received(new std::atomic<uint8_t>[totalCount]);
+                for (unsigned int i = 0; i < totalCount; ++i)
+                        received[i].store(0, std::memory_order_relaxed);
+
+                std::atomic<unsigned int> receivedCount{0};
+                std::atomic<unsigned int> outOfOrder{0};
+                std::atomic<bool>         start{false};
+
+                std::vector<std::thread> threads;
+                for (unsigned int producer = 0; producer < run.producerCount; ++producer)
+                {
+                        threads.emplace_back([&, producer]() {
+                                while (start.load(std::memory_order_acquire) == false)
+                                        std::this_thread::yield();
+
+                                std::vector<uint32_t> batch(run.batchSize);
+                                unsigned int          sequence = 0;
+                                while (sequence < run.itemsPerProducer)
+                                {
+                                        unsigned int pushed;
+                                        if (run.batchSize == 1)
+                                        {
+                                                pushed = queue.TryPush(MakeItem(producer, sequence)) ? 1 : 0;
+                                        }
+                                        else
+                                        {
+                                                unsigned int count =
+                                                    std::min(run.batchSize, run.itemsPerProducer - sequence);
+                                                for (unsigned int i = 0; i < count; ++i)
+                                                        batch[i] = MakeItem(producer, sequence + i);
+                                                pushed = queue.TryPushBatch(batch.data(), count);
+                                        }
+
+                                        sequence += pushed;
+                                        if (pushed == 0)
+                                                std::this_thread::yield();
+                                }
+                        });
+                }
+
+                for (unsigned int consumer = 0; consumer < run.consumerCount; ++consumer)
+                {
+                        threads.emplace_back([&]() {
+                                while (start.load(std::memory_order_acquire) == false)
+                                        std::this_thread::yield();
+
+                                std::vector<uint32_t> batch(run.batchSize);
+                                std::vector<int64_t>  lastSequence(run.producerCount, -1);
+                                while (receivedCount.load(std::memory_order_relaxed) < totalCount)
+                                {
+                                        unsigned int popped = run.batchSize == 1
+                                                                  ? (queue.TryPop(batch[0]) ? 1 : 0)
+                                                                  : queue.TryPopBatch(batch.data(), run.batchSize);
+                                        for (unsigned int i = 0; i < popped; ++i)
+                                        {
+                                                unsigned int producer = batch[i] >> kSequenceBits;
+                                                unsigned int sequence = batch[i] & ((1 << kSequenceBits) - 1);
+                                                if (producer >= run.producerCount || sequence >= run.itemsPerProducer)
+                                                {
+                                                        outOfOrder++;
+                                                        continue;
+                                                }
+                                                if ((int64_t)sequence <= lastSequence[producer])
+                                                        outOfOrder++;
+                                                lastSequence[producer] = sequence;
+                                                received[producer * run.itemsPerProducer + sequence]++;
+                                        }
+
+                                        receivedCount += popped;
+                                        if (popped == 0)
+                                                std::this_thread::yield();
+                                }
+                        });
+                }
+
+                double startTime = EngineTests::GetSeconds();
+                start.store(true, std::memory_order_release);
+                for (std::thread& thread : threads)
+                        thread.join();
+                run.seconds = EngineTests::GetSeconds() - startTime;
+
+                for (unsigned int i = 0; i < totalCount; ++i)
+                {
+                        run.missingCount += received[i] == 0;
+                        run.repeatCount += received[i] > 1;
+                }
+                run.outOfOrder    = outOfOrder;
+                run.receivedCount = receivedCount;
+        }
+
+        template <typename Queue>
+        void StressQueue(unsigned int producerCount, unsigned int consumerCount)
+        {
+                const unsigned int batchSizes[] = {1, 7};
+                for (unsigned int batchSize : batchSizes)
+                {
+                        std::unique_ptr<Queue> queue = std::make_unique<Queue>();
+                        FQueueRun              run   = {producerCount, consumerCount, 50000, batchSize};
+                        RunQueue(*queue, run);
+
+                        CHECK(run.missingCount == 0);
+                        CHECK(run.repeatCount == 0);
+                        CHECK(run.outOfOrder == 0);
+                        CHECK(run.receivedCount == producerCount * run.itemsPerProducer);
+                        CHECK(queue->SizeApprox() == 0);
+                }
+        }
+
+        template <typename Queue>
+        void BenchmarkQueue(const char*  name,
+                            unsigned int producerCount,
+                            unsigned int consumerCount,
+                            unsigned int batchSize)
+        {
+                std::unique_ptr<Queue> queue = std::make_unique<Queue>();
+                FQueueRun              run   = {producerCount, consumerCount, 1000000 / producerCount, batchSize};
+                RunQueue(*queue, run);
+                CHECK(run.missingCount == 0);
+
+                char label[64];
+                snprintf(label, sizeof(label), "%s %up%uc batch %u", name, producerCount, consumerCount, batchSize);
+                EngineTests::ReportBenchmark(label, run.receivedCount / run.seconds, "items/s");
+        }
+
+        template <template <typename, unsigned> class Queue>
+        void BenchmarkAgainstDeque(const char* name, unsigned int producerCount, unsigned int consumerCount)
+        {
+                const unsigned int batchSizes[] = {1, 16};
+                for (unsigned int batch : batchSizes)
+                {
+                        BenchmarkQueue<Queue<uint32_t, 1024>>(name, producerCount, consumerCount, batch);
+                        BenchmarkQueue<FMutexDequeQueue<uint32_t, 1024>>(
+                            "mutex deque", producerCount, consumerCount, batch);
+                }
+        }
+} // namespace
+
+ENGINE_TEST(ContainerUtility_QueueSingleThreaded)
+{
+        // Capacity rounds up to a power of two
+        static_assert(SPSCQueue<int, 100>::Capacity == 128, "");
+        static_assert(MPMCQueue<int, 64>::Capacity == 64, "");
+
+        std::unique_ptr<MPMCQueue<int, 8>> queue = std::make_unique<MPMCQueue<int, 8>>();
+        int                                value = -1;
+        CHECK(queue->TryPop(value) == false);
+
+        // Fill, overflow, drain, several times around the ring
+        for (int lap = 0; lap < 5; ++lap)
+        {
+                for (int i = 0; i < 8; ++i)
+                        CHECK(queue->TryPush(lap * 100 + i));
+                CHECK(queue->TryPush(-1) == false);
+                CHECK(queue->SizeApprox() == 8);
+
+                for (int i = 0; i < 8; ++i)
+                        CHECK(queue->TryPop(value) && value == lap * 100 + i);
+                CHECK(queue->TryPop(value) == false);
+        }
+
+        // Batches stop at the capacity and at the queued count
+        int input[12]  = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+        int output[12] = {};
+        CHECK(queue->TryPushBatch(input, 5) == 5);
+        CHECK(queue->TryPushBatch(input + 5, 7) == 3);
+        CHECK(queue->TryPopBatch(output, 12) == 8);
+        for (int i = 0; i < 8; ++i)
+                CHECK(output[i] == i);
+
+        std::unique_ptr<SPSCQueue<int, 4>> spsc = std::make_unique<SPSCQueue<int, 4>>();
+        CHECK(spsc->TryPushBatch(input, 6) == 4);
+        CHECK(spsc->TryPush(99) == false);
+        CHECK(spsc->TryPopBatch(output, 3) == 3);
+        CHECK(spsc->TryPush(99));
+        CHECK(spsc->TryPopBatch(output, 12) == 2);
+        CHECK(output[0] == 3 && output[1] == 99);
+}
+
+ENGINE_TEST(ContainerUtility_SPSCQueueStress)
+{
+        StressQueue<SPSCQueue<uint32_t, 64>>(1, 1);
+}
+
+ENGINE_TEST(ContainerUtility_MPSCQueueStress)
+{
+        StressQueue<MPSCQueue<uint32_t, 64>>(4, 1);
+}
+
+ENGINE_TEST(ContainerUtility_MPMCQueueStress)
+{
+        StressQueue<MPMCQueue<uint32_t, 64>>(4, 4);
+        StressQueue<MPMCQueue<uint32_t, 2>>(3, 3);
+}
+
+ENGINE_BENCHMARK(ContainerUtility_QueueThroughput)
+{
+        BenchmarkAgainstDeque<SPSCQueue>("SPSC", 1, 1);
+        BenchmarkAgainstDeque<MPSCQueue>("MPSC", 4, 1);
+        BenchmarkAgainstDeque<MPMCQueue>("MPMC", 4, 4);
+}
@@ -0,0 +1,145 @@
+#include "TestFramework.h"
+
+#include <stdio.h>
+#include <vector>
+
+#include <JobScheduler.h>
+#include <debug_renderer.h>
+
+using namespace DirectX;
+
+namespace
+{
+        // Line i runs from (i, 0, 0) to (i, 1, 0), floats hold the index exactly below 2^24
+        void AddIndexedLine(unsigned int i)
+        {
+                debug_renderer::add_line(XMVectorSet(float(i), 0.0f, 0.0f, 1.0f),
+                                         XMVectorSet(float(i), 1.0f, 0.0f, 1.0f),
+                                         XMFLOAT4(0.0f, 1.0f, 0.0f, 1.0f),
+                                         XMFLOAT4(1.0f, 0.0f, 0.0f, 1.0f));
+        }
+
+        // Submits the lines from every job worker, the same way jobs drawing bone hierarchies or collision shapes do
+        void AddIndexedLinesParallel(unsigned int lineCount)
+        {
+                auto lineJob = ParallelFor([](unsigned int i) { AddIndexedLine(i); });
+                lineJob.SetName("Debug line stress");
+                lineJob.SetRange(0, lineCount, 64);
+                lineJob();
+                lineJob.Wait();
+        }
+
+        // Returns the number of problems in the merged verts: split or mixed up pairs, unknown or repeated lines
+        unsigned int CheckMergedLines(unsigned int lineCount, std::vector<unsigned int>& seenCounts)
+        {
+                const FDebugVertex* verts     = debug_renderer::get_line_verts();
+                size_t              vertCount = debug_renderer::get_line_vert_count();
+
+                seenCounts.assign(lineCount, 0);
+                unsigned int problems = 0;
+                for (size_t v = 0; v + 1 < vertCount; v += 2)
+                {
+                        const FDebugVertex& a     = verts[v];
+                        const FDebugVertex& b     = verts[v + 1];
+                        unsigned int        index = (unsigned int)a.position.x;
+
+                        bool pairIntact = a.position.x == b.position.x && a.position.y == 0.0f &&
+                                          b.position.y == 1.0f && a.color.y == 1.0f && b.color.x == 1.0f;
+                        if (pairIntact == false || index >= lineCount || seenCounts[index]++ > 0)
+                                problems++;
+                }
+                return problems + (vertCount % 2);
+        }
+} // namespace
+
+ENGINE_TEST(DebugRenderer_ParallelLinesMergeIntact)
+{
+        const unsigned int lineCount = 50000;
+
+        std::vector<unsigned int> seenCounts;
+        for (int frame = 0; frame < 3; ++frame)
+        {
+                AddIndexedLinesParallel(lineCount);
+                debug_renderer::merge_lines();
+
+                CHECK(debug_renderer::get_line_vert_count() == lineCount * 2);
+                CHECK(CheckMergedLines(lineCount, seenCounts) == 0);
+
+                unsigned int missingCount = 0;
+                for (unsigned int count : seenCounts)
+                        missingCount += count == 0;
+                CHECK(missingCount == 0);
+
+                debug_renderer::clear_lines();
+
+                debug_renderer::FDebugLineStats stats = debug_renderer::get_line_stats();
+                CHECK(stats.submittedVerts == lineCount * 2);
+                CHECK(stats.mergedVerts == lineCount * 2);
+                CHECK(stats.droppedVerts == 0);
+                CHECK(stats.threadCount >= 1 && stats.threadCount <= JobScheduler::GetThreadCount());
+                CHECK(stats.flushCount >= stats.threadCount);
+                CHECK(debug_renderer::get_line_vert_count() == 0);
+        }
+}
+
+ENGINE_TEST(DebugRenderer_OverflowIsDroppedAndCounted)
+{
+        const size_t       capacity  = debug_renderer::get_line_vert_capacity();
+        const unsigned int lineCount = (unsigned int)(capacity / 2) + 20000;
+
+        AddIndexedLinesParallel(lineCount);
+        debug_renderer::merge_lines();
+
+        // The block fills up to the capacity, every merged line is still whole and unique
+        std::vector<unsigned int> seenCounts;
+        CHECK(debug_renderer::get_line_vert_count() == capacity);
+        CHECK(CheckMergedLines(lineCount, seenCounts) == 0);
+
+        debug_renderer::clear_lines();
+
+        debug_renderer::FDebugLineStats stats = debug_renderer::get_line_stats();
+        CHECK(stats.submittedVerts == lineCount * 2);
+        CHECK(stats.mergedVerts == capacity);
+        CHECK(stats.droppedVerts == lineCount * 2 - capacity);
+
+        // The next frame starts empty
+        AddIndexedLine(7);
+        debug_renderer::merge_lines();
+        CHECK(debug_renderer::get_line_vert_count() == 2);
+        CHECK(CheckMergedLines(8, seenCounts) == 0 && seenCounts[7] == 1);
+        debug_renderer::clear_lines();
+}
+
+ENGINE_BENCHMARK(DebugRenderer_LineThroughput)
+{
+        const unsigned int lineCount   = (unsigned int)(debug_renderer::get_line_vert_capacity() / 2);
+        const int          repeatCount = 10;
+
+        double mainThreadSeconds = 0.0;
+        double parallelSeconds   = 0.0;
+        double mergeSeconds      = 0.0;
+        for (int i = 0; i < repeatCount; ++i)
+        {
+                double start = EngineTests::GetSeconds();
+                for (unsigned int line = 0; line < lineCount; ++line)
+                        AddIndexedLine(line);
+                debug_renderer::merge_lines();
+                mainThreadSeconds += EngineTests::GetSeconds() - start;
+                debug_renderer::clear_lines();
+
+                start = EngineTests::GetSeconds();
+                AddIndexedLinesParallel(lineCount);
+                double mergeStart = EngineTests::GetSeconds();
+                debug_renderer::merge_lines();
+                mergeSeconds += EngineTests::GetSeconds() - mergeStart;
+                parallelSeconds += EngineTests::GetSeconds() - start;
+                debug_renderer::clear_lines();
+        }
+
+        char label[64];
+        snprintf(label, sizeof(label), "main thread, %u lines", lineCount);
+        EngineTests::ReportBenchmark(label, lineCount * repeatCount / mainThreadSeconds, "lines/s");
+        snprintf(label, sizeof(label), "%u job threads, %u lines", JobScheduler::GetThreadCount(), lineCount);
+        EngineTests::ReportBenchmark(label, lineCount * repeatCount / parallelSeconds, "lines/s");
+        EngineTests::ReportBenchmark("merge_lines", mergeSeconds * 1000.0 / repeatCount, "ms");
+}
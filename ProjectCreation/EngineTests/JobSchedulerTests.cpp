@@ -0,0 +1,207 @@
+#include "TestFramework.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#include <JobScheduler.h>
+#include <Profiling.h>
+
+// The chunk size sweep only covers grains, the scheduler's thread count is fixed once it is initialized. Run the
+// benchmark with -threads 1, 2, 4 and 8 for the thread count axis.
+
+namespace
+{
+        struct FTelemetryTotals
+        {
+                uint64_t pushes       = 0;
+                uint64_t pops         = 0;
+                uint64_t steals       = 0;
+                uint64_t failedSteals = 0;
+                uint64_t executed     = 0;
+                uint64_t executeTicks = 0;
+                uint64_t idleTicks    = 0;
+        };
+
+        FTelemetryTotals SumTelemetry()
+        {
+                FTelemetryTotals totals;
+                for (unsigned thread = 0; thread < JobScheduler::GetThreadCount(); ++thread)
+                {
+                        JobThreadTelemetry telemetry = JobScheduler::GetThreadTelemetry(thread);
+                        totals.pushes += telemetry.pushes;
+                        totals.pops += telemetry.pops;
+                        totals.steals += telemetry.steals;
+                        totals.failedSteals += telemetry.failed_steals;
+                        totals.executed += telemetry.executed;
+                        totals.executeTicks += telemetry.execute_ticks;
+                        totals.idleTicks += telemetry.idle_ticks;
+                }
+                return totals;
+        }
+
+        // A worker counts a job as executed only after finishing it, so it can lag behind a Wait that already
+        // returned. Gives the workers up to a second to catch up with every job taken from a queue.
+        FTelemetryTotals SumSettledTelemetry()
+        {
+                FTelemetryTotals totals   = SumTelemetry();
+                double           deadline = EngineTests::GetSeconds() + 1.0;
+                while (totals.executed < totals.pops + totals.steals && EngineTests::GetSeconds() < deadline)
+                        totals = SumTelemetry();
+                return totals;
+        }
+
+        const ChunkHistogram* FindChunkHistogram(const char* name)
+        {
+                for (unsigned i = 0; i < JobScheduler::GetChunkHistogramCount(); ++i)
+                {
+                        const ChunkHistogram& histogram = JobScheduler::GetChunkHistogram(i);
+                        if (histogram.name && strcmp(histogram.name, name) == 0)
+                                return &histogram;
+                }
+                return nullptr;
+        }
+
+        uint64_t SumBuckets(const ChunkHistogram& histogram)
+        {
+                uint64_t sum = 0;
+                for (unsigned bucket = 0; bucket < ChunkHistogram::BUCKET_COUNT; ++bucket)
+                        sum += histogram.buckets[bucket];
+                return sum;
+        }
+
+        // Stand in for per component work, rounds sets the cost of one iteration
+        inline uint32_t Work(uint32_t seed, unsigned rounds)
+        {
+                uint32_t x = seed;
+                for (unsigned r = 0; r < rounds; ++r)
+                {
+                        x = x * 1664525u + 1013904223u;
+                        x ^= x >> 16;
+                }
+                return x;
+        }
+} // namespace
+
+ENGINE_TEST(JobScheduler_TelemetryAccountsForEveryJob)
+{
+        const unsigned int itemCount  = 1 << 18;
+        const unsigned int grain      = 256;
+        const unsigned int grainCount = (itemCount + grain - 1) / grain;
+
+        std::vector<uint32_t> visits(itemCount, 0);
+        uint32_t*             visitData = visits.data();
+
+        for (int round = 0; round < 10; ++round)
+        {
+                FTelemetryTotals before = SumSettledTelemetry();
+
+                auto job = ParallelFor([visitData](unsigned i) { visitData[i]++; });
+                job.SetName("Telemetry test");
+                job.SetRange(0, itemCount, grain);
+
+                const ChunkHistogram* histogram = FindChunkHistogram("Telemetry test");
+                CHECK(histogram != nullptr);
+                if (histogram == nullptr)
+                        return;
+                uint64_t chunksBefore  = histogram->count;
+                uint64_t bucketsBefore = SumBuckets(*histogram);
+
+                job();
+                job.Wait();
+
+                FTelemetryTotals after    = SumSettledTelemetry();
+                uint64_t         pushes   = after.pushes - before.pushes;
+                uint64_t         taken    = after.pops + after.steals - before.pops - before.steals;
+                uint64_t         executed = after.executed - before.executed;
+
+                // Every pushed job is taken exactly once, by its owner or a thief, and executed once
+                CHECK(pushes >= 1 && taken == pushes && executed == pushes);
+                // Splitting stops at the grain, so there are never more jobs than grains
+                CHECK(executed <= grainCount);
+
+                // Every grain is recorded once, besides full grains each split can leave one short grain behind
+                uint64_t chunks = histogram->count - chunksBefore;
+                CHECK(chunks >= grainCount && chunks <= grainCount + executed);
+                CHECK(SumBuckets(*histogram) - bucketsBefore == chunks);
+        }
+
+        unsigned int wrongCount = 0;
+        for (uint32_t visitCount : visits)
+                wrongCount += visitCount != 10;
+        CHECK(wrongCount == 0);
+}
+
+ENGINE_BENCHMARK(JobScheduler_ChunkSizeSweep)
+{
+        struct FWorkload
+        {
+                const char*  name;
+                unsigned int itemCount;
+                unsigned int rounds;
+        };
+        // Cheap iterations like transform updates, and expensive ones like animation sampling
+        const FWorkload    workloads[] = {{"light", 1 << 20, 8}, {"heavy", 1 << 14, 1000}};
+        const unsigned int grains[]    = {0, 16, 64, 256, 1024, 4096};
+        const int          repeatCount = 20;
+
+        const double ticksPerMicrosecond = Profiler::GetTicksPerMicrosecond();
+
+        std::vector<uint32_t> output(workloads[0].itemCount);
+        uint32_t*             outputData = output.data();
+
+        printf("        %u job threads\n", JobScheduler::GetThreadCount());
+        for (const FWorkload& workload : workloads)
+        {
+                for (unsigned int grain : grains)
+                {
+                        const unsigned int rounds = workload.rounds;
+
+                        auto job = ParallelFor([outputData, rounds](unsigned i) { outputData[i] = Work(i, rounds); });
+                        job.SetName("Chunk size sweep");
+
+                        const ChunkHistogram* histogram   = FindChunkHistogram("Chunk size sweep");
+                        uint64_t              chunksBefore = histogram ? histogram->count : 0;
+                        uint64_t              ticksBefore  = histogram ? histogram->total_ticks : 0;
+
+                        FTelemetryTotals before = SumSettledTelemetry();
+                        double           start  = EngineTests::GetSeconds();
+                        for (int repeat = 0; repeat < repeatCount; ++repeat)
+                        {
+                                job.SetRange(0, workload.itemCount, grain);
+                                job();
+                                job.Wait();
+                        }
+                        double           seconds = EngineTests::GetSeconds() - start;
+                        FTelemetryTotals after   = SumSettledTelemetry();
+
+                        double jobs   = double(after.executed - before.executed) / repeatCount;
+                        double steals = double(after.steals - before.steals) / repeatCount;
+                        double idleMilliseconds =
+                            double(after.idleTicks - before.idleTicks) / ticksPerMicrosecond / 1000.0 / repeatCount;
+
+                        uint64_t chunks      = histogram ? histogram->count - chunksBefore : 0;
+                        double   chunkMicros = chunks ? double(histogram->total_ticks - ticksBefore) / chunks /
+                                                          ticksPerMicrosecond
+                                                      : 0.0;
+
+                        char label[64];
+                        char grainName[16];
+                        if (grain)
+                                snprintf(grainName, sizeof(grainName), "grain %u", grain);
+                        else
+                                snprintf(grainName, sizeof(grainName), "adaptive");
+
+                        snprintf(label, sizeof(label), "%s, %s, items", workload.name, grainName);
+                        EngineTests::ReportBenchmark(label, workload.itemCount * repeatCount / seconds, "items/s");
+                        snprintf(label, sizeof(label), "%s, %s, jobs", workload.name, grainName);
+                        EngineTests::ReportBenchmark(label, jobs, "per call");
+                        snprintf(label, sizeof(label), "%s, %s, steals", workload.name, grainName);
+                        EngineTests::ReportBenchmark(label, steals, "per call");
+                        snprintf(label, sizeof(label), "%s, %s, idle", workload.name, grainName);
+                        EngineTests::ReportBenchmark(label, idleMilliseconds, "ms per call, all threads");
+                        snprintf(label, sizeof(label), "%s, %s, mean chunk", workload.name, grainName);
+                        EngineTests::ReportBenchmark(label, chunkMicros, "us");
+                }
+        }
+}
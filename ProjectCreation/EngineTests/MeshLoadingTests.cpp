@@ -0,0 +1,151 @@
+#include "TestFramework.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <FileIO.h>
+
+namespace
+{
+        // Same count as ResourceManager's loader threads
+        constexpr unsigned int kLoaderThreadCount = 2;
+
+        // Names of every loose .mesh file, in the form LoadStaticMesh takes them
+        std::vector<std::string> FindMeshNames()
+        {
+                namespace fs = std::filesystem;
+
+                std::vector<std::string> names;
+                std::error_code          error;
+                for (const fs::directory_entry& entry : fs::directory_iterator("../Assets/Models", error))
+                {
+                        if (entry.path().extension() == ".mesh")
+                                names.push_back(entry.path().stem().string());
+                }
+                return names;
+        }
+
+        // The loader thread half of LoadStaticMeshAsync: map, validate and prefetch, no device involved. Every thread
+        // takes the next name until the list is done.
+        void MapMeshesParallel(const std::vector<std::string>&       names,
+                               unsigned int                          threadCount,
+                               std::vector<FileIO::FStaticMeshView>& views,
+                               std::vector<EResult>&                 results)
+        {
+                views.clear();
+                views.resize(names.size());
+                results.assign(names.size(), EResult{ERESULT_FLAG::INVALID});
+
+                std::atomic<unsigned int> next{0};
+                std::vector<std::thread>  threads;
+                for (unsigned int t = 0; t < threadCount; ++t)
+                {
+                        threads.emplace_back([&]() {
+                                for (unsigned int i = next++; i < names.size(); i = next++)
+                                {
+                                        results[i] = FileIO::MapStaticMeshFile(names[i].c_str(), &views[i]);
+                                        if (results[i].m_Flags == ERESULT_FLAG::SUCCESS)
+                                                views[i].file.Prefetch();
+                                }
+                        });
+                }
+                for (std::thread& thread : threads)
+                        thread.join();
+        }
+
+        bool MatchesSerialLoad(const FileIO::FStaticMeshView& view, const FileIO::FStaticMeshData& data)
+        {
+                return view.vertexCount == data.vertices.size() && view.indexCount == data.indices.size() &&
+                       strncmp(view.materialName, data.materialName.data(), data.materialName.size()) == 0 &&
+                       memcmp(view.vertices, data.vertices.data(), data.vertices.size() * sizeof(FVertex)) == 0 &&
+                       memcmp(view.indices, data.indices.data(), data.indices.size() * sizeof(uint32_t)) == 0;
+        }
+} // namespace
+
+ENGINE_TEST(MeshLoading_ParallelMappingMatchesSerialLoads)
+{
+        std::vector<std::string> names = FindMeshNames();
+        CHECK(names.empty() == false);
+
+        std::vector<FileIO::FStaticMeshData> serial(names.size());
+        unsigned int                         failedCount = 0;
+        for (size_t i = 0; i < names.size(); ++i)
+        {
+                EResult result = FileIO::LoadStaticMeshDataFromFile(names[i].c_str(), &serial[i]);
+                failedCount += result.m_Flags != ERESULT_FLAG::SUCCESS;
+        }
+        CHECK(failedCount == 0);
+
+        // Every name twice, so both loader threads also map the same file at the same time
+        std::vector<std::string> requests = names;
+        requests.insert(requests.end(), names.begin(), names.end());
+
+        std::vector<FileIO::FStaticMeshView> views;
+        std::vector<EResult>                 results;
+        MapMeshesParallel(requests, kLoaderThreadCount, views, results);
+
+        unsigned int mismatchCount = 0;
+        for (size_t i = 0; i < requests.size(); ++i)
+        {
+                failedCount += results[i].m_Flags != ERESULT_FLAG::SUCCESS;
+                mismatchCount += MatchesSerialLoad(views[i], serial[i % names.size()]) == false;
+        }
+        CHECK(failedCount == 0);
+        CHECK(mismatchCount == 0);
+
+        // The spans stay valid until the view is gone, not only until the load returns
+        views.resize(names.size());
+        mismatchCount = 0;
+        for (size_t i = 0; i < names.size(); ++i)
+                mismatchCount += MatchesSerialLoad(views[i], serial[i]) == false;
+        CHECK(mismatchCount == 0);
+}
+
+ENGINE_BENCHMARK(MeshLoading_Throughput)
+{
+        std::vector<std::string> names = FindMeshNames();
+        if (names.empty())
+                return;
+
+        // The asset directory is small, repeat it so the timings aren't dominated by the first open
+        const int                repeatCount = 20;
+        std::vector<std::string> requests;
+        for (int i = 0; i < repeatCount; ++i)
+                requests.insert(requests.end(), names.begin(), names.end());
+
+        std::unique_ptr<FileIO::FStaticMeshData> data  = std::make_unique<FileIO::FStaticMeshData>();
+        double                                   bytes = 0.0;
+        double                                   start = EngineTests::GetSeconds();
+        for (const std::string& name : requests)
+        {
+                FileIO::LoadStaticMeshDataFromFile(name.c_str(), data.get());
+                bytes += data->vertices.size() * sizeof(FVertex) + data->indices.size() * sizeof(uint32_t);
+        }
+        double serialSeconds = EngineTests::GetSeconds() - start;
+
+        EngineTests::ReportBenchmark("serial copy, meshes", requests.size() / serialSeconds, "meshes/s");
+        EngineTests::ReportBenchmark("serial copy, geometry", bytes / serialSeconds / (1024.0 * 1024.0), "MB/s");
+
+        const unsigned int threadCounts[] = {1, kLoaderThreadCount, 4};
+        for (unsigned int threadCount : threadCounts)
+        {
+                std::vector<FileIO::FStaticMeshView> views;
+                std::vector<EResult>                 results;
+
+                start = EngineTests::GetSeconds();
+                MapMeshesParallel(requests, threadCount, views, results);
+                double seconds = EngineTests::GetSeconds() - start;
+
+                char label[64];
+                snprintf(label, sizeof(label), "mapped, %u loader threads, meshes", threadCount);
+                EngineTests::ReportBenchmark(label, requests.size() / seconds, "meshes/s");
+                snprintf(label, sizeof(label), "mapped, %u loader threads, geometry", threadCount);
+                EngineTests::ReportBenchmark(label, bytes / seconds / (1024.0 * 1024.0), "MB/s");
+        }
+}
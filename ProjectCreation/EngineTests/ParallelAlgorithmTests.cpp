@@ -0,0 +1,252 @@
+#include "TestFramework.h"
+
+#include <stdio.h>
+#include <algorithm>
+#include <execution>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <JobScheduler.h>
+
+namespace
+{
+        // Counts around the block count edges: empty, fewer items than blocks, uneven blocks, many items per block
+        const unsigned int kCounts[] = {0, 1, 3, 255, 100003};
+
+        // 2x2 matrix product with wrapping arithmetic, associative but not commutative, so the block partials have
+        // to be combined in order
+        struct FMatrix2
+        {
+                uint32_t m[4];
+        };
+        inline void Multiply(FMatrix2& lhs, const FMatrix2& rhs)
+        {
+                FMatrix2 product = {lhs.m[0] * rhs.m[0] + lhs.m[1] * rhs.m[2],
+                                    lhs.m[0] * rhs.m[1] + lhs.m[1] * rhs.m[3],
+                                    lhs.m[2] * rhs.m[0] + lhs.m[3] * rhs.m[2],
+                                    lhs.m[2] * rhs.m[1] + lhs.m[3] * rhs.m[3]};
+                lhs              = product;
+        }
+        inline bool operator==(const FMatrix2& lhs, const FMatrix2& rhs)
+        {
+                return std::equal(lhs.m, lhs.m + 4, rhs.m);
+        }
+        const FMatrix2 kIdentity = {{1, 0, 0, 1}};
+
+        std::vector<uint64_t> MakeValues(unsigned int count, uint32_t seed)
+        {
+                std::mt19937          random(seed);
+                std::vector<uint64_t> values(count);
+                for (uint64_t& value : values)
+                        value = random() % 1000;
+                return values;
+        }
+
+        std::vector<FMatrix2> MakeMatrices(unsigned int count, uint32_t seed)
+        {
+                std::mt19937          random(seed);
+                std::vector<FMatrix2> matrices(count);
+                for (FMatrix2& matrix : matrices)
+                        for (uint32_t& element : matrix.m)
+                                element = random();
+                return matrices;
+        }
+} // namespace
+
+ENGINE_TEST(ParallelAlgorithms_ReduceMatchesSerial)
+{
+        for (unsigned int count : kCounts)
+        {
+                std::vector<uint64_t> values = MakeValues(count, count);
+                uint64_t              sum    = ParallelReduce(
+                    count,
+                    uint64_t(0),
+                    [&](uint64_t& value, unsigned i) { value += values[i]; },
+                    [](uint64_t& lhs, const uint64_t& rhs) { lhs += rhs; });
+                CHECK(sum == std::reduce(values.begin(), values.end(), uint64_t(0)));
+
+                std::vector<FMatrix2> matrices = MakeMatrices(count, count);
+                FMatrix2              product  = ParallelReduce(
+                    count,
+                    kIdentity,
+                    [&](FMatrix2& value, unsigned i) { Multiply(value, matrices[i]); },
+                    [](FMatrix2& lhs, const FMatrix2& rhs) { Multiply(lhs, rhs); });
+
+                FMatrix2 expected = kIdentity;
+                for (const FMatrix2& matrix : matrices)
+                        Multiply(expected, matrix);
+                CHECK(product == expected);
+        }
+}
+
+ENGINE_TEST(ParallelAlgorithms_ScansMatchSerial)
+{
+        auto add = [](uint64_t& lhs, const uint64_t& rhs) { lhs += rhs; };
+
+        for (unsigned int count : kCounts)
+        {
+                std::vector<uint64_t> values = MakeValues(count, count + 1);
+                std::vector<uint64_t> expected(count);
+                std::vector<uint64_t> output(count, UINT64_MAX);
+
+                uint64_t total = ParallelExclusiveScan(
+                    count,
+                    uint64_t(0),
+                    [&](unsigned i) { return values[i]; },
+                    add,
+                    [&](unsigned i, const uint64_t& running) { output[i] = running; });
+                std::exclusive_scan(values.begin(), values.end(), expected.begin(), uint64_t(0));
+                CHECK(output == expected);
+                CHECK(total == std::reduce(values.begin(), values.end(), uint64_t(0)));
+
+                std::fill(output.begin(), output.end(), UINT64_MAX);
+                total = ParallelInclusiveScan(
+                    count,
+                    uint64_t(0),
+                    [&](unsigned i) { return values[i]; },
+                    add,
+                    [&](unsigned i, const uint64_t& running) { output[i] = running; });
+                std::inclusive_scan(values.begin(), values.end(), expected.begin());
+                CHECK(output == expected);
+                CHECK(count == 0 || total == expected.back());
+
+                // Prefix products only come out right if every block starts from the product of the blocks before it
+                std::vector<FMatrix2> matrices = MakeMatrices(count, count + 2);
+                std::vector<FMatrix2> products(count);
+                ParallelInclusiveScan(
+                    count,
+                    kIdentity,
+                    [&](unsigned i) { return matrices[i]; },
+                    [](FMatrix2& lhs, const FMatrix2& rhs) { Multiply(lhs, rhs); },
+                    [&](unsigned i, const FMatrix2& running) { products[i] = running; });
+
+                unsigned int wrongCount = 0;
+                FMatrix2     running    = kIdentity;
+                for (unsigned int i = 0; i < count; ++i)
+                {
+                        Multiply(running, matrices[i]);
+                        wrongCount += (products[i] == running) == false;
+                }
+                CHECK(wrongCount == 0);
+        }
+}
+
+ENGINE_TEST(ParallelAlgorithms_PartitionIsStable)
+{
+        for (unsigned int count : kCounts)
+        {
+                std::vector<uint64_t> values = MakeValues(count, count + 3);
+
+                // Sparse, half and full matches
+                const uint64_t thresholds[] = {50, 500, 1000};
+                for (uint64_t threshold : thresholds)
+                {
+                        auto matches = [&](unsigned i) { return values[i] < threshold; };
+
+                        std::vector<uint64_t> output(count);
+                        unsigned int          matchCount = ParallelPartition(
+                            count, output.data(), [&](unsigned i) { return values[i]; }, matches);
+
+                        std::vector<uint64_t> expected = values;
+                        auto                  middle   = std::stable_partition(
+                            expected.begin(), expected.end(), [&](uint64_t value) { return value < threshold; });
+                        CHECK(matchCount == unsigned(middle - expected.begin()));
+                        CHECK(output == expected);
+                }
+        }
+}
+
+ENGINE_BENCHMARK(ParallelAlgorithms_Throughput)
+{
+        const unsigned int    count       = 1 << 22;
+        const int             repeatCount = 10;
+        std::vector<uint64_t> values      = MakeValues(count, 49);
+        std::vector<uint64_t> output(count);
+
+        auto add = [](uint64_t& lhs, const uint64_t& rhs) { lhs += rhs; };
+
+        // Each algorithm against the serial standard library and the standard library's parallel policy
+        double   serialSeconds   = 0.0;
+        double   stdParSeconds   = 0.0;
+        double   parallelSeconds = 0.0;
+        uint64_t checksum        = 0;
+        for (int repeat = 0; repeat < repeatCount; ++repeat)
+        {
+                double start = EngineTests::GetSeconds();
+                checksum += std::reduce(values.begin(), values.end(), uint64_t(0));
+                serialSeconds += EngineTests::GetSeconds() - start;
+
+                start = EngineTests::GetSeconds();
+                checksum += std::reduce(std::execution::par, values.begin(), values.end(), uint64_t(0));
+                stdParSeconds += EngineTests::GetSeconds() - start;
+
+                start = EngineTests::GetSeconds();
+                checksum -= 2 * ParallelReduce(
+                    count, uint64_t(0), [&](uint64_t& value, unsigned i) { value += values[i]; }, add);
+                parallelSeconds += EngineTests::GetSeconds() - start;
+        }
+        CHECK(checksum == 0);
+        EngineTests::ReportBenchmark("std::reduce", count * repeatCount / serialSeconds, "items/s");
+        EngineTests::ReportBenchmark("std::reduce(par)", count * repeatCount / stdParSeconds, "items/s");
+        EngineTests::ReportBenchmark("ParallelReduce", count * repeatCount / parallelSeconds, "items/s");
+
+        serialSeconds   = 0.0;
+        stdParSeconds   = 0.0;
+        parallelSeconds = 0.0;
+        for (int repeat = 0; repeat < repeatCount; ++repeat)
+        {
+                double start = EngineTests::GetSeconds();
+                std::exclusive_scan(values.begin(), values.end(), output.begin(), uint64_t(0));
+                serialSeconds += EngineTests::GetSeconds() - start;
+
+                start = EngineTests::GetSeconds();
+                std::exclusive_scan(std::execution::par, values.begin(), values.end(), output.begin(), uint64_t(0));
+                stdParSeconds += EngineTests::GetSeconds() - start;
+
+                start = EngineTests::GetSeconds();
+                ParallelExclusiveScan(
+                    count,
+                    uint64_t(0),
+                    [&](unsigned i) { return values[i]; },
+                    add,
+                    [&](unsigned i, const uint64_t& running) { output[i] = running; });
+                parallelSeconds += EngineTests::GetSeconds() - start;
+        }
+        EngineTests::ReportBenchmark("std::exclusive_scan", count * repeatCount / serialSeconds, "items/s");
+        EngineTests::ReportBenchmark("std::exclusive_scan(par)", count * repeatCount / stdParSeconds, "items/s");
+        EngineTests::ReportBenchmark("ParallelExclusiveScan", count * repeatCount / parallelSeconds, "items/s");
+
+        std::vector<uint64_t> partitioned(count);
+        serialSeconds   = 0.0;
+        stdParSeconds   = 0.0;
+        parallelSeconds = 0.0;
+        for (int repeat = 0; repeat < repeatCount; ++repeat)
+        {
+                // stable_partition works in place, time it on a fresh copy like ParallelPartition writes one
+                double start = EngineTests::GetSeconds();
+                partitioned  = values;
+                std::stable_partition(
+                    partitioned.begin(), partitioned.end(), [](uint64_t value) { return value < 500; });
+                serialSeconds += EngineTests::GetSeconds() - start;
+
+                start       = EngineTests::GetSeconds();
+                partitioned = values;
+                std::stable_partition(std::execution::par,
+                                      partitioned.begin(),
+                                      partitioned.end(),
+                                      [](uint64_t value) { return value < 500; });
+                stdParSeconds += EngineTests::GetSeconds() - start;
+
+                start = EngineTests::GetSeconds();
+                ParallelPartition(
+                    count,
+                    output.data(),
+                    [&](unsigned i) { return values[i]; },
+                    [&](unsigned i) { return values[i] < 500; });
+                parallelSeconds += EngineTests::GetSeconds() - start;
+        }
+        EngineTests::ReportBenchmark("std::stable_partition", count * repeatCount / serialSeconds, "items/s");
+        EngineTests::ReportBenchmark("std::stable_partition(par)", count * repeatCount / stdParSeconds, "items/s");
+        EngineTests::ReportBenchmark("ParallelPartition", count * repeatCount / parallelSeconds, "items/s");
+}
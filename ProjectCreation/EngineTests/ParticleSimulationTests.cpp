@@ -0,0 +1,328 @@
+#include "TestFramework.h"
+
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <ParticleSegmentAllocator.h>
+#include <ParticleSimulationCPU.h>
+
+using namespace ParticleData;
+using namespace DirectX;
+
+namespace
+{
+        struct FParticleScene
+        {
+                std::vector<FEmitterGPU>                  emitters = std::vector<FEmitterGPU>(gMaxEmitterSlotCount);
+                std::unique_ptr<FSegmentBuffer>           segments = std::make_unique<FSegmentBuffer>();
+                std::unique_ptr<ParticleSegmentAllocator> allocator =
+                    std::make_unique<ParticleSegmentAllocator>();
+
+                void SetEmitter(unsigned int slot, unsigned int count, const FEmitterGPU& emitter)
+                {
+                        emitters[slot] = emitter;
+                        allocator->SetRequest(slot, count, 0.0f);
+                }
+
+                // Packs the requests like ParticleManager, the unused slots end up empty at the total count
+                void Allocate()
+                {
+                        allocator->Allocate(gMaxParticleCount);
+                        memset(segments.get(), 0, sizeof(FSegmentBuffer));
+                        memcpy(segments->segments,
+                               allocator->GetSegments(),
+                               sizeof(FEmitterSegment) * gMaxEmitterSlotCount);
+                }
+        };
+
+        // Every range collapsed to a single value, so rand() can't make the two implementations disagree
+        FEmitterGPU MakeFixedEmitter(float lifeTime, float height)
+        {
+                FEmitterGPU emitter        = {};
+                emitter.lifeSpan           = XMFLOAT4(lifeTime, 0.0f, 0.1f, 0.2f);
+                emitter.emitterPosition    = XMFLOAT3(1.0f, height, -2.0f);
+                emitter.minOffset          = XMFLOAT3(0.5f, 0.0f, 0.25f);
+                emitter.maxOffset          = emitter.minOffset;
+                emitter.initialColor       = XMFLOAT4(1.0f, 0.5f, 0.25f, 1.0f);
+                emitter.finalColor         = XMFLOAT4(0.0f, 0.0f, 1.0f, 0.0f);
+                emitter.minInitialVelocity = XMFLOAT3(0.0f, 4.0f, height);
+                emitter.maxInitialVelocity = emitter.minInitialVelocity;
+                emitter.particleScale      = XMFLOAT2(0.1f, 0.2f);
+                emitter.acceleration       = XMFLOAT3(0.0f, -9.8f, 0.5f);
+                emitter.textureIndex       = (unsigned int)height;
+                return emitter;
+        }
+
+        // FindEmitterIndex from ParticleData.hlsl
+        int FindEmitterIndex(const FSegmentBuffer& segments, unsigned int id)
+        {
+                int low  = 0;
+                int high = gMaxEmitterSlotCount - 1;
+                while (low < high)
+                {
+                        int mid = (low + high + 1) / 2;
+                        if (segments.segments[mid].offset <= id)
+                                low = mid;
+                        else
+                                high = mid - 1;
+                }
+                return low;
+        }
+
+        // EmittionComputeShader_CS then SimulationComputeShader_CS for one particle, one thread at a time. Emitters in
+        // these tests have no ranges, so rand() isn't needed.
+        void SimulateParticle(FParticleGPU&                    p,
+                              unsigned int                     id,
+                              const FEmitterGPU*               emitters,
+                              const FSegmentBuffer&            segments,
+                              const FParticleSimulationParams& params,
+                              FParticleSimulationStats&        stats)
+        {
+                int emitterIndex  = FindEmitterIndex(segments, id);
+                int emitterOffset = id - segments.segments[emitterIndex].offset;
+                int desired       = segments.segments[emitterIndex].count;
+
+                if (p.time <= 0.0f)
+                {
+                        if (emitterOffset < desired)
+                        {
+                                const FEmitterGPU& emitter = emitters[emitterIndex];
+
+                                p.time         = emitter.lifeSpan.x;
+                                p.lifeSpan     = XMFLOAT3(p.time, emitter.lifeSpan.z, emitter.lifeSpan.w);
+                                p.velocity     = emitter.minInitialVelocity;
+                                p.acceleration = emitter.acceleration;
+                                p.position     = XMFLOAT4(emitter.emitterPosition.x + emitter.minOffset.x,
+                                                      emitter.emitterPosition.y + emitter.minOffset.y,
+                                                      emitter.emitterPosition.z + emitter.minOffset.z,
+                                                      1.0f);
+                                p.prevPos      = p.position;
+                                p.flags        = emitter.flags;
+                                p.scale        = emitter.particleScale;
+                                p.initialColor = emitter.initialColor;
+                                p.finalColor   = emitter.finalColor;
+                                p.textureIndex = emitter.textureIndex;
+                                stats.spawnedCount++;
+                        }
+                }
+                else
+                {
+                        p.time -= params.deltaTime;
+                }
+
+                p.prevPos = p.position;
+                p.velocity.x += p.acceleration.x * params.deltaTime;
+                p.velocity.y += p.acceleration.y * params.deltaTime;
+                p.velocity.z += p.acceleration.z * params.deltaTime;
+
+                if (p.time > 0.0f)
+                {
+                        stats.aliveCount++;
+                        p.time -= params.deltaTime;
+                        p.position.x += p.velocity.x * params.deltaTime + params.worldOffsetDelta.x;
+                        p.position.y += p.velocity.y * params.deltaTime + params.worldOffsetDelta.y;
+                        p.position.z += p.velocity.z * params.deltaTime + params.worldOffsetDelta.z;
+                }
+        }
+
+        bool NearlyEqual(float a, float b)
+        {
+                return fabsf(a - b) <= 1e-4f * std::max(1.0f, fabsf(b));
+        }
+
+        bool SameParticle(const FParticleGPU& a, const FParticleGPU& b)
+        {
+                return NearlyEqual(a.position.x, b.position.x) && NearlyEqual(a.position.y, b.position.y) &&
+                       NearlyEqual(a.position.z, b.position.z) && NearlyEqual(a.prevPos.x, b.prevPos.x) &&
+                       NearlyEqual(a.prevPos.y, b.prevPos.y) && NearlyEqual(a.prevPos.z, b.prevPos.z) &&
+                       NearlyEqual(a.velocity.x, b.velocity.x) && NearlyEqual(a.velocity.y, b.velocity.y) &&
+                       NearlyEqual(a.velocity.z, b.velocity.z) && NearlyEqual(a.time, b.time) &&
+                       a.lifeSpan.x == b.lifeSpan.x && a.lifeSpan.y == b.lifeSpan.y && a.lifeSpan.z == b.lifeSpan.z &&
+                       a.acceleration.x == b.acceleration.x && a.acceleration.y == b.acceleration.y &&
+                       a.acceleration.z == b.acceleration.z && a.scale.x == b.scale.x && a.scale.y == b.scale.y &&
+                       memcmp(&a.initialColor, &b.initialColor, sizeof(XMFLOAT4)) == 0 &&
+                       memcmp(&a.finalColor, &b.finalColor, sizeof(XMFLOAT4)) == 0 && a.flags == b.flags &&
+                       a.textureIndex == b.textureIndex;
+        }
+} // namespace
+
+ENGINE_TEST(ParticleSimulationCPU_MatchesShaderReference)
+{
+        // Segment boundaries fall inside quads and one slot is empty, only the first kCompareCount particles are
+        // ever owned by an emitter
+        const unsigned int kCompareCount = 4096;
+
+        FParticleScene scene;
+        scene.SetEmitter(0, 10, MakeFixedEmitter(0.25f, 1.0f));
+        scene.SetEmitter(1, 0, MakeFixedEmitter(1.0f, 2.0f));
+        scene.SetEmitter(2, 37, MakeFixedEmitter(0.5f, 3.0f));
+        scene.SetEmitter(5, 1001, MakeFixedEmitter(0.1f, 4.0f));
+        scene.SetEmitter(9, 2, MakeFixedEmitter(2.0f, 5.0f));
+        scene.Allocate();
+
+        ParticleSimulationCPU simulation;
+        simulation.Initialize();
+
+        std::vector<FParticleGPU> reference(kCompareCount);
+        std::vector<FParticleGPU> output(kCompareCount);
+        simulation.ReadGPULayout(reference.data(), 0, kCompareCount);
+
+        FParticleSimulationParams params;
+        params.deltaTime        = 1.0f / 60.0f;
+        params.worldOffsetDelta = XMFLOAT3(0.01f, 0.0f, -0.02f);
+
+        unsigned int mismatchCount = 0;
+        for (int frame = 0; frame < 90; ++frame)
+        {
+                params.time += params.deltaTime;
+                simulation.Update(scene.emitters.data(), *scene.segments, params);
+
+                FParticleSimulationStats stats;
+                for (unsigned int i = 0; i < kCompareCount; ++i)
+                        SimulateParticle(reference[i], i, scene.emitters.data(), *scene.segments, params, stats);
+
+                simulation.WriteGPULayout(output.data(), 0, kCompareCount);
+                for (unsigned int i = 0; i < kCompareCount; ++i)
+                        mismatchCount += !SameParticle(output[i], reference[i]);
+
+                CHECK(simulation.GetStats().spawnedCount == stats.spawnedCount);
+                CHECK(simulation.GetStats().aliveCount == stats.aliveCount);
+        }
+
+        CHECK(mismatchCount == 0);
+        simulation.Shutdown();
+}
+
+ENGINE_TEST(ParticleSimulationCPU_SpawnsWithinEmitterRanges)
+{
+        FEmitterGPU emitter        = MakeFixedEmitter(1.0f, 0.0f);
+        emitter.lifeSpan.y         = 0.5f;
+        emitter.minOffset          = XMFLOAT3(-1.0f, -2.0f, -3.0f);
+        emitter.maxOffset          = XMFLOAT3(1.0f, 2.0f, 3.0f);
+        emitter.minInitialVelocity = XMFLOAT3(-5.0f, 0.0f, 1.0f);
+        emitter.maxInitialVelocity = XMFLOAT3(5.0f, 10.0f, 2.0f);
+        emitter.acceleration       = XMFLOAT3(0.0f, 0.0f, 0.0f);
+
+        const unsigned int count = 1000;
+        FParticleScene     scene;
+        scene.SetEmitter(3, count, emitter);
+        scene.Allocate();
+
+        ParticleSimulationCPU simulation;
+        simulation.Initialize();
+
+        FParticleSimulationParams params;
+        params.time      = 12.5f;
+        params.deltaTime = 1.0f / 60.0f;
+        simulation.Update(scene.emitters.data(), *scene.segments, params);
+        CHECK(simulation.GetStats().spawnedCount == count);
+        CHECK(simulation.GetStats().aliveCount == count);
+
+        std::vector<FParticleGPU> output(count);
+        simulation.WriteGPULayout(output.data(), 0, count);
+
+        const float  epsilon       = 1e-4f;
+        unsigned int outsideCount  = 0;
+        unsigned int distinctCount = 0;
+        for (unsigned int i = 0; i < count; ++i)
+        {
+                const FParticleGPU& p = output[i];
+                outsideCount += p.lifeSpan.x < 0.5f - epsilon || p.lifeSpan.x > 1.5f + epsilon;
+                outsideCount += !NearlyEqual(p.time, p.lifeSpan.x - params.deltaTime);
+                outsideCount += p.velocity.x < -5.0f - epsilon || p.velocity.x > 5.0f + epsilon;
+                outsideCount += p.velocity.y < 0.0f - epsilon || p.velocity.y > 10.0f + epsilon;
+                outsideCount += p.velocity.z < 1.0f - epsilon || p.velocity.z > 2.0f + epsilon;
+                outsideCount += p.prevPos.x < 0.0f - epsilon || p.prevPos.x > 2.0f + epsilon;
+                outsideCount += p.prevPos.y < -2.0f - epsilon || p.prevPos.y > 2.0f + epsilon;
+                outsideCount += p.prevPos.z < -5.0f - epsilon || p.prevPos.z > 1.0f + epsilon;
+                distinctCount += i > 0 && p.velocity.x != output[i - 1].velocity.x;
+        }
+
+        CHECK(outsideCount == 0);
+        CHECK(distinctCount > count / 2);
+        simulation.Shutdown();
+}
+
+ENGINE_TEST(ParticleSimulationCPU_GPULayoutRoundTrip)
+{
+        const unsigned int        count = 777;
+        std::vector<FParticleGPU> input(count);
+        for (unsigned int i = 0; i < count; ++i)
+        {
+                FParticleGPU& p = input[i];
+                float         f = float(i);
+                p.position      = XMFLOAT4(f, f + 0.5f, -f, 1.0f);
+                p.prevPos       = XMFLOAT4(f - 1.0f, f, 0.0f, 1.0f);
+                p.initialColor  = XMFLOAT4(0.1f, 0.2f, 0.3f, f);
+                p.finalColor    = XMFLOAT4(f, 0.4f, 0.5f, 0.6f);
+                p.velocity      = XMFLOAT3(f * 2.0f, 1.0f, 2.0f);
+                p.time          = f * 0.01f;
+                p.lifeSpan      = XMFLOAT3(f, 0.25f, 0.75f);
+                p.flags         = i;
+                p.scale         = XMFLOAT2(f, 1.0f);
+                p.acceleration  = XMFLOAT3(0.0f, -f, 0.0f);
+                p.textureIndex  = i * 3;
+        }
+
+        ParticleSimulationCPU simulation;
+        simulation.Initialize();
+
+        // Odd offset so the copy doesn't line up with the quads
+        const unsigned int        begin = 123;
+        std::vector<FParticleGPU> output(count);
+        simulation.ReadGPULayout(input.data(), begin, begin + count);
+        simulation.WriteGPULayout(output.data(), begin, begin + count);
+
+        unsigned int mismatchCount = 0;
+        for (unsigned int i = 0; i < count; ++i)
+                mismatchCount += !SameParticle(output[i], input[i]);
+
+        CHECK(mismatchCount == 0);
+        simulation.Shutdown();
+}
+
+ENGINE_BENCHMARK(ParticleSimulationCPU_FullBufferThroughput)
+{
+        // One emitter owns the whole buffer, with short lives so every frame respawns a share of it
+        FEmitterGPU emitter        = MakeFixedEmitter(0.5f, 0.0f);
+        emitter.lifeSpan.y         = 0.25f;
+        emitter.maxOffset          = XMFLOAT3(10.0f, 10.0f, 10.0f);
+        emitter.maxInitialVelocity = XMFLOAT3(1.0f, 8.0f, 1.0f);
+
+        FParticleScene scene;
+        scene.SetEmitter(0, gMaxParticleCount, emitter);
+        scene.Allocate();
+
+        ParticleSimulationCPU simulation;
+        simulation.Initialize();
+
+        FParticleSimulationParams params;
+        params.deltaTime = 1.0f / 60.0f;
+
+        const int    frameCount   = 120;
+        double       seconds      = 0.0;
+        unsigned int spawnedCount = 0;
+        for (int frame = -10; frame < frameCount; ++frame)
+        {
+                params.time += params.deltaTime;
+
+                double start = EngineTests::GetSeconds();
+                simulation.Update(scene.emitters.data(), *scene.segments, params);
+                if (frame >= 0)
+                {
+                        seconds += EngineTests::GetSeconds() - start;
+                        spawnedCount += simulation.GetStats().spawnedCount;
+                }
+        }
+
+        CHECK(simulation.GetStats().aliveCount > 0);
+        simulation.Shutdown();
+
+        EngineTests::ReportBenchmark("particles", gMaxParticleCount, "");
+        EngineTests::ReportBenchmark("update", seconds * 1000.0 / frameCount, "ms/frame");
+        EngineTests::ReportBenchmark("simulated", double(gMaxParticleCount) * frameCount / seconds, "particles/s");
+        EngineTests::ReportBenchmark("spawned", double(spawnedCount) / frameCount, "particles/frame");
+}
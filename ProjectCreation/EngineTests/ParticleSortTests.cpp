@@ -0,0 +1,204 @@
+#include "TestFramework.h"
+
+#include <stdio.h>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <ParticleSimulationCPU.h>
+#include <ParticleSort.h>
+
+using namespace ParticleData;
+using namespace DirectX;
+
+namespace
+{
+        // Every particle gets a random position, aliveCount of them spread over the buffer get time left
+        void FillParticles(ParticleSimulationCPU& simulation, unsigned int aliveCount, unsigned int seed)
+        {
+                using E = E_PARTICLE_STREAM;
+
+                std::mt19937                          random(seed);
+                std::uniform_real_distribution<float> coordinate(-500.0f, 500.0f);
+
+                float* time      = simulation.GetStream(E::TIME);
+                float* positionX = simulation.GetStream(E::POSITION_X);
+                float* positionY = simulation.GetStream(E::POSITION_Y);
+                float* positionZ = simulation.GetStream(E::POSITION_Z);
+
+                std::vector<unsigned int> order(gMaxParticleCount);
+                for (unsigned int i = 0; i < gMaxParticleCount; ++i)
+                {
+                        order[i]     = i;
+                        time[i]      = 0.0f;
+                        positionX[i] = coordinate(random);
+                        positionY[i] = coordinate(random);
+                        positionZ[i] = coordinate(random);
+                }
+                std::shuffle(order.begin(), order.end(), random);
+                for (unsigned int i = 0; i < aliveCount; ++i)
+                        time[order[i]] = 1.0f;
+        }
+
+        float Depth(const ParticleSimulationCPU& simulation, unsigned int index, FXMVECTOR eye, FXMVECTOR forward)
+        {
+                using E = E_PARTICLE_STREAM;
+
+                XMVECTOR position = XMVectorSet(simulation.GetStream(E::POSITION_X)[index],
+                                                simulation.GetStream(E::POSITION_Y)[index],
+                                                simulation.GetStream(E::POSITION_Z)[index],
+                                                0.0f);
+                return XMVectorGetX(XMVector3Dot(XMVectorSubtract(position, eye), XMVector3Normalize(forward)));
+        }
+
+        // Returns the number of problems with the draw order: missing or repeated live particles, dead particles, and
+        // neighbours in the wrong order by more than one key step
+        unsigned int CheckDrawOrder(const ParticleSimulationCPU& simulation,
+                                    const ParticleSort&          sort,
+                                    FXMVECTOR                    eye,
+                                    FXMVECTOR                    forward)
+        {
+                const float*              time    = simulation.GetStream(E_PARTICLE_STREAM::TIME);
+                const uint32_t*           indices = sort.GetSortedIndices();
+                const FParticleSortStats& stats   = sort.GetStats();
+
+                unsigned int      problems = 0;
+                std::vector<bool> seen(gMaxParticleCount);
+                float             keyStep   = (stats.farDepth - stats.nearDepth) / 65535.0f;
+                float             lastDepth = stats.farDepth;
+                for (unsigned int i = 0; i < stats.sortedCount; ++i)
+                {
+                        uint32_t index = indices[i];
+                        if (index >= gMaxParticleCount || seen[index] || time[index] <= 0.0f)
+                        {
+                                problems++;
+                                continue;
+                        }
+                        seen[index] = true;
+
+                        float depth = Depth(simulation, index, eye, forward);
+                        problems += depth > lastDepth + keyStep * 1.01f + 1e-4f;
+                        lastDepth = depth;
+                }
+
+                unsigned int aliveCount = 0;
+                for (unsigned int i = 0; i < gMaxParticleCount; ++i)
+                        aliveCount += time[i] > 0.0f;
+                problems += aliveCount != stats.sortedCount;
+
+                return problems;
+        }
+} // namespace
+
+ENGINE_TEST(ParticleSort_DrawsBackToFront)
+{
+        // The per block histograms make the sort too large for the stack
+        ParticleSimulationCPU         simulation;
+        std::unique_ptr<ParticleSort> sortPointer = std::make_unique<ParticleSort>();
+        ParticleSort&                 sort        = *sortPointer;
+        simulation.Initialize();
+        sort.Initialize();
+
+        const XMVECTOR eye     = XMVectorSet(10.0f, 20.0f, -30.0f, 1.0f);
+        const XMVECTOR forward = XMVectorSet(0.3f, -0.2f, 1.0f, 0.0f);
+
+        const unsigned int aliveCounts[] = {1, 3, 1000, 100000, gMaxParticleCount};
+        for (unsigned int aliveCount : aliveCounts)
+        {
+                FillParticles(simulation, aliveCount, aliveCount);
+                sort.Sort(simulation, eye, forward);
+
+                CHECK(sort.GetStats().sortedCount == aliveCount);
+                CHECK(sort.GetStats().nearDepth <= sort.GetStats().farDepth);
+                CHECK(CheckDrawOrder(simulation, sort, eye, forward) == 0);
+        }
+
+        sort.Shutdown();
+        simulation.Shutdown();
+}
+
+ENGINE_TEST(ParticleSort_EmptyAndFlatSets)
+{
+        using E = E_PARTICLE_STREAM;
+
+        ParticleSimulationCPU         simulation;
+        std::unique_ptr<ParticleSort> sortPointer = std::make_unique<ParticleSort>();
+        ParticleSort&                 sort        = *sortPointer;
+        simulation.Initialize();
+        sort.Initialize();
+
+        const XMVECTOR eye     = XMVectorZero();
+        const XMVECTOR forward = XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f);
+
+        // Nothing alive
+        FillParticles(simulation, 0, 1);
+        sort.Sort(simulation, eye, forward);
+        CHECK(sort.GetStats().sortedCount == 0);
+        CHECK(sort.GetStats().occupiedBins == 0);
+
+        // Every live particle at the same depth shares key 0, the scatter keeps them in buffer order
+        FillParticles(simulation, 5000, 2);
+        float* positionZ = simulation.GetStream(E::POSITION_Z);
+        for (unsigned int i = 0; i < gMaxParticleCount; ++i)
+                positionZ[i] = 42.0f;
+        sort.Sort(simulation, eye, forward);
+
+        const uint32_t* indices = sort.GetSortedIndices();
+        CHECK(sort.GetStats().sortedCount == 5000);
+        CHECK(sort.GetStats().occupiedBins == 1);
+        CHECK(std::is_sorted(indices, indices + sort.GetStats().sortedCount));
+        CHECK(CheckDrawOrder(simulation, sort, eye, forward) == 0);
+
+        sort.Shutdown();
+        simulation.Shutdown();
+}
+
+ENGINE_BENCHMARK(ParticleSort_Throughput)
+{
+        ParticleSimulationCPU         simulation;
+        std::unique_ptr<ParticleSort> sortPointer = std::make_unique<ParticleSort>();
+        ParticleSort&                 sort        = *sortPointer;
+        simulation.Initialize();
+        sort.Initialize();
+
+        const XMVECTOR eye     = XMVectorSet(0.0f, 10.0f, -600.0f, 1.0f);
+        const XMVECTOR forward = XMVectorSet(0.0f, -0.1f, 1.0f, 0.0f);
+
+        const unsigned int aliveCounts[] = {100000, 250000, gMaxParticleCount};
+        for (unsigned int aliveCount : aliveCounts)
+        {
+                FillParticles(simulation, aliveCount, 33);
+
+                const int repeatCount = 20;
+                sort.Sort(simulation, eye, forward);
+                double start = EngineTests::GetSeconds();
+                for (int i = 0; i < repeatCount; ++i)
+                        sort.Sort(simulation, eye, forward);
+                double seconds = (EngineTests::GetSeconds() - start) / repeatCount;
+
+                // Single threaded comparison sort of (depth, index) over the same live set
+                const float*                               time = simulation.GetStream(E_PARTICLE_STREAM::TIME);
+                std::vector<std::pair<float, unsigned int>> pairs;
+                pairs.reserve(aliveCount);
+                double baselineStart = EngineTests::GetSeconds();
+                for (unsigned int i = 0; i < gMaxParticleCount; ++i)
+                {
+                        if (time[i] > 0.0f)
+                                pairs.push_back({-Depth(simulation, i, eye, forward), i});
+                }
+                std::sort(pairs.begin(), pairs.end());
+                double baselineSeconds = EngineTests::GetSeconds() - baselineStart;
+
+                char label[64];
+                snprintf(label, sizeof(label), "%u particles, sort", aliveCount);
+                EngineTests::ReportBenchmark(label, seconds * 1000.0, "ms");
+                snprintf(label, sizeof(label), "%u particles, sort throughput", aliveCount);
+                EngineTests::ReportBenchmark(label, aliveCount / seconds, "particles/s");
+                snprintf(label, sizeof(label), "%u particles, std::sort baseline", aliveCount);
+                EngineTests::ReportBenchmark(label, baselineSeconds * 1000.0, "ms");
+        }
+
+        sort.Shutdown();
+        simulation.Shutdown();
+}
@@ -0,0 +1,260 @@
+#include "TestFramework.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <BitwiseUtility.h>
+#include <ParticleSegmentAllocator.h>
+
+using namespace ParticleData;
+
+namespace
+{
+        constexpr unsigned int kDirtyWords = gMaxEmitterSlotCount / 64;
+
+        struct FRange
+        {
+                unsigned int begin;
+                unsigned int end;
+
+                bool operator==(const FRange& other) const
+                {
+                        return begin == other.begin && end == other.end;
+                }
+        };
+
+        std::vector<FRange> CollectRanges(const uint64_t* bits, unsigned int count)
+        {
+                std::vector<FRange> ranges;
+                ForEachSetBitRange(
+                    bits, count, [&](unsigned int begin, unsigned int end) { ranges.push_back({begin, end}); });
+                return ranges;
+        }
+
+        std::vector<FRange> CollectRangesNaive(const uint64_t* bits, unsigned int count)
+        {
+                std::vector<FRange> ranges;
+                for (unsigned int i = 0; i < count; ++i)
+                {
+                        if ((bits[i / 64] >> (i % 64) & 1) == 0)
+                                continue;
+                        if (ranges.empty() || ranges.back().end != i)
+                                ranges.push_back({i, i});
+                        ranges.back().end = i + 1;
+                }
+                return ranges;
+        }
+
+        void SetBit(uint64_t* bits, unsigned int index)
+        {
+                bits[index / 64] |= 1ULL << (index % 64);
+        }
+
+        // The emitter and segment side of ParticleManager::update and UploadDirtyRanges, without the device. Emitters
+        // keep their slot, a slot is dirty when its data or its segment changed since the last upload.
+        class FEmitterUploadModel
+        {
+            public:
+                FEmitterUploadModel(unsigned int activeCount) : m_ActiveCount(activeCount)
+                {
+                        for (unsigned int slot = 0; slot < activeCount; ++slot)
+                                m_Positions[slot] = float(slot);
+                }
+
+                FEmitterUploadStats Update(const std::vector<float>& positions, const std::vector<unsigned int>& counts)
+                {
+                        FEmitterUploadStats stats;
+                        stats.activeSlots = m_ActiveCount;
+
+                        for (unsigned int slot = 0; slot < m_ActiveCount; ++slot)
+                        {
+                                if (m_Positions[slot] != positions[slot])
+                                {
+                                        m_Positions[slot] = positions[slot];
+                                        SetBit(m_EmitterDirtyBits, slot);
+                                }
+                                m_Allocator->SetRequest(slot, counts[slot], positions[slot]);
+                        }
+
+                        m_Allocator->Allocate(gMaxParticleCount);
+                        const FEmitterSegment* segments = m_Allocator->GetSegments();
+                        for (unsigned int slot = 0; slot < gMaxEmitterSlotCount; ++slot)
+                        {
+                                if (m_Segments[slot].offset != segments[slot].offset ||
+                                    m_Segments[slot].count != segments[slot].count)
+                                {
+                                        m_Segments[slot] = segments[slot];
+                                        SetBit(m_SegmentDirtyBits, slot);
+                                }
+                        }
+
+                        Upload(m_EmitterDirtyBits, sizeof(FEmitterGPU), stats.dirtyEmitters, stats);
+                        Upload(m_SegmentDirtyBits, sizeof(FEmitterSegment), stats.dirtySegments, stats);
+                        return stats;
+                }
+
+            private:
+                void Upload(uint64_t*            dirtyBits,
+                            unsigned int         stride,
+                            unsigned int&        dirtyCount,
+                            FEmitterUploadStats& stats)
+                {
+                        ForEachSetBitRange(dirtyBits, gMaxEmitterSlotCount, [&](unsigned int begin, unsigned int end) {
+                                dirtyCount += end - begin;
+                                stats.uploadedBytes += (end - begin) * stride;
+                                stats.uploadedRanges++;
+                        });
+                        memset(dirtyBits, 0, sizeof(uint64_t) * kDirtyWords);
+                }
+
+                unsigned int                              m_ActiveCount;
+                float                                     m_Positions[gMaxEmitterSlotCount] = {};
+                FEmitterSegment                           m_Segments[gMaxEmitterSlotCount]  = {};
+                uint64_t                                  m_EmitterDirtyBits[kDirtyWords]   = {};
+                uint64_t                                  m_SegmentDirtyBits[kDirtyWords]   = {};
+                std::unique_ptr<ParticleSegmentAllocator> m_Allocator = std::make_unique<ParticleSegmentAllocator>();
+        };
+} // namespace
+
+ENGINE_TEST(BitwiseUtility_SetBitRangesMatchNaiveScan)
+{
+        std::mt19937 random(30);
+
+        // Densities from a few scattered bits to nearly full words, counts that end mid word
+        const double       densities[] = {0.0, 0.01, 0.2, 0.5, 0.9, 0.999, 1.0};
+        const unsigned int counts[]    = {1, 63, 64, 65, 200, gMaxEmitterSlotCount};
+
+        unsigned int mismatchCount = 0;
+        for (double density : densities)
+        {
+                for (unsigned int count : counts)
+                {
+                        for (int round = 0; round < 20; ++round)
+                        {
+                                std::bernoulli_distribution bit(density);
+                                uint64_t                    bits[kDirtyWords] = {};
+                                for (unsigned int i = 0; i < gMaxEmitterSlotCount; ++i)
+                                {
+                                        if (bit(random))
+                                                SetBit(bits, i);
+                                }
+
+                                mismatchCount += CollectRanges(bits, count) != CollectRangesNaive(bits, count);
+                        }
+                }
+        }
+        CHECK(mismatchCount == 0);
+
+        // A run across a word boundary is one range, the last bit of the buffer closes its run
+        uint64_t bits[kDirtyWords] = {};
+        for (unsigned int i = 60; i < 70; ++i)
+                SetBit(bits, i);
+        SetBit(bits, gMaxEmitterSlotCount - 1);
+
+        std::vector<FRange> ranges = CollectRanges(bits, gMaxEmitterSlotCount);
+        CHECK(ranges.size() == 2);
+        CHECK(ranges.size() == 2 && ranges[0] == FRange({60, 70}));
+        CHECK(ranges.size() == 2 && ranges[1] == FRange({gMaxEmitterSlotCount - 1, gMaxEmitterSlotCount}));
+}
+
+ENGINE_TEST(ParticleUpload_OnlyChangedEmittersAreUploaded)
+{
+        const unsigned int activeCount = 300;
+
+        std::vector<float>        positions(activeCount);
+        std::vector<unsigned int> counts(activeCount, 100);
+        for (unsigned int slot = 0; slot < activeCount; ++slot)
+                positions[slot] = float(slot);
+
+        std::unique_ptr<FEmitterUploadModel> model = std::make_unique<FEmitterUploadModel>(activeCount);
+
+        // The first frame uploads every segment, the emitters already match
+        FEmitterUploadStats stats = model->Update(positions, counts);
+        CHECK(stats.dirtyEmitters == 0);
+        CHECK(stats.dirtySegments == gMaxEmitterSlotCount);
+        CHECK(stats.uploadedRanges == 1);
+
+        // Nothing changed
+        stats = model->Update(positions, counts);
+        CHECK(stats.uploadedBytes == 0);
+        CHECK(stats.uploadedRanges == 0);
+
+        // Two separate emitters and a neighbouring pair move
+        positions[3] += 1.0f;
+        positions[100] += 1.0f;
+        positions[200] += 1.0f;
+        positions[201] += 1.0f;
+        stats = model->Update(positions, counts);
+        CHECK(stats.dirtyEmitters == 4);
+        CHECK(stats.dirtySegments == 0);
+        CHECK(stats.uploadedRanges == 3);
+        CHECK(stats.uploadedBytes == 4 * sizeof(FEmitterGPU));
+
+        // A count change moves the offsets of every later segment, up to the empty slots at the end
+        counts[250] = 150;
+        stats = model->Update(positions, counts);
+        CHECK(stats.dirtyEmitters == 0);
+        CHECK(stats.dirtySegments == gMaxEmitterSlotCount - 250);
+        CHECK(stats.uploadedBytes == (gMaxEmitterSlotCount - 250) * sizeof(FEmitterSegment));
+}
+
+ENGINE_BENCHMARK(ParticleUpload_BytesPerFrame)
+{
+        const unsigned int activeCount = 1024;
+        const int          frameCount  = 600;
+
+        struct FScenario
+        {
+                const char* name;
+                double      movingShare;
+                double      countChangeShare;
+        };
+        const FScenario scenarios[] = {
+            {"static emitters", 0.0, 0.0},
+            {"10% of emitters moving", 0.1, 0.0},
+            {"10% moving, 1% changing count", 0.1, 0.01},
+            {"all emitters moving", 1.0, 0.0},
+        };
+
+        // What the full rebuild uploaded every frame, every active emitter plus the whole segment buffer
+        double fullBytes = activeCount * sizeof(FEmitterGPU) + sizeof(FSegmentBuffer);
+        EngineTests::ReportBenchmark("full upload", fullBytes, "bytes/frame");
+
+        for (const FScenario& scenario : scenarios)
+        {
+                std::mt19937                         random(30);
+                std::bernoulli_distribution          moving(scenario.movingShare);
+                std::bernoulli_distribution          countChange(scenario.countChangeShare);
+                std::vector<float>                   positions(activeCount);
+                std::vector<unsigned int>            counts(activeCount, 200);
+                std::unique_ptr<FEmitterUploadModel> model = std::make_unique<FEmitterUploadModel>(activeCount);
+                for (unsigned int slot = 0; slot < activeCount; ++slot)
+                        positions[slot] = float(slot);
+                model->Update(positions, counts);
+
+                double bytes  = 0.0;
+                double ranges = 0.0;
+                for (int frame = 0; frame < frameCount; ++frame)
+                {
+                        for (unsigned int slot = 0; slot < activeCount; ++slot)
+                        {
+                                if (moving(random))
+                                        positions[slot] += 0.1f;
+                                if (countChange(random))
+                                        counts[slot] = 100 + random() % 200;
+                        }
+
+                        FEmitterUploadStats stats = model->Update(positions, counts);
+                        bytes += stats.uploadedBytes;
+                        ranges += stats.uploadedRanges;
+                }
+
+                char label[64];
+                snprintf(label, sizeof(label), "%s, ranges", scenario.name);
+                EngineTests::ReportBenchmark(scenario.name, bytes / frameCount, "bytes/frame");
+                EngineTests::ReportBenchmark(label, ranges / frameCount, "copies/frame");
+        }
+}
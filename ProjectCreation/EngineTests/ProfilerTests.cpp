@@ -0,0 +1,80 @@
+#include "TestFramework.h"
+
+#include <atomic>
+#include <thread>
+
+#include <Profiling.h>
+
+// Profiler::Shutdown writes profiling.json and profiling.bin to the working directory
+
+ENGINE_TEST(Profiler_ThreadsKeepTheirBuffersAcrossSessions)
+{
+        // 0 waits for the main thread, 1 records, 2 has recorded, 3 exits
+        std::atomic<int>         state{0};
+        Profiler::FThreadBuffer* firstBuffer  = nullptr;
+        Profiler::FThreadBuffer* secondBuffer = nullptr;
+        uint64_t                 firstCount   = 0;
+        uint64_t                 secondCount  = 0;
+
+        auto recordWhenAsked = [&state](Profiler::FThreadBuffer*& buffer, uint64_t& count) {
+                while (state.load() != 1)
+                        std::this_thread::yield();
+                for (int i = 0; i < 10; ++i)
+                        PROFILE_SCOPE("Test", "Worker");
+                buffer = Profiler::t_Buffer;
+                count  = buffer ? buffer->writeCount.load() : 0;
+                state.store(2);
+        };
+
+        // The worker outlives the first session, its t_Buffer has to stay usable through Shutdown
+        std::thread worker([&]() {
+                recordWhenAsked(firstBuffer, firstCount);
+                recordWhenAsked(secondBuffer, secondCount);
+        });
+
+        for (int session = 0; session < 2; ++session)
+        {
+                Profiler::Initialize();
+                state.store(1);
+                while (state.load() != 2)
+                        std::this_thread::yield();
+                Profiler::Shutdown();
+        }
+        worker.join();
+
+        CHECK(firstBuffer != nullptr && firstBuffer == secondBuffer);
+        CHECK(firstCount == 10);
+        // Shutdown emptied the ring, the second session only holds its own events
+        CHECK(secondCount == 10);
+        CHECK(secondBuffer->writeCount.load() == 0);
+
+        // Nothing records while no session is running
+        {
+                PROFILE_SCOPE("Test", "Inactive");
+        }
+        CHECK(Profiler::t_Buffer != nullptr && Profiler::t_Buffer->writeCount.load() == 0);
+}
+
+ENGINE_BENCHMARK(Profiler_ScopeOverhead)
+{
+        // Far more scopes than a ring holds, so most of them overwrite older events like a long capture does
+        const int scopeCount = 10000000;
+
+        // With no session running a scope only reads the clock and checks g_Active
+        double start = EngineTests::GetSeconds();
+        for (int i = 0; i < scopeCount; ++i)
+                PROFILE_SCOPE("Test", "Empty");
+        double inactiveSeconds = EngineTests::GetSeconds() - start;
+
+        Profiler::Initialize();
+        start = EngineTests::GetSeconds();
+        for (int i = 0; i < scopeCount; ++i)
+                PROFILE_SCOPE("Test", "Empty");
+        double activeSeconds = EngineTests::GetSeconds() - start;
+        CHECK(Profiler::t_Buffer && Profiler::t_Buffer->writeCount.load() == uint64_t(scopeCount));
+        Profiler::Shutdown();
+
+        // The target is under 50 ns per recorded scope
+        EngineTests::ReportBenchmark("recorded scope", activeSeconds * 1e9 / scopeCount, "ns");
+        EngineTests::ReportBenchmark("scope without a session", inactiveSeconds * 1e9 / scopeCount, "ns");
+}
@@ -0,0 +1,145 @@
+#include "TestFramework.h"
+
+#include <stdio.h>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <ResourceManager.h>
+
+namespace
+{
+        class FTestResource : public Resource<FTestResource>
+        {
+            public:
+                int  m_Payload  = 0;
+                bool m_Released = false;
+
+                virtual void Release() override
+                {
+                        m_Released = true;
+                }
+        };
+
+        std::string MakeName(unsigned int i)
+        {
+                return "Resource" + std::to_string(i);
+        }
+} // namespace
+
+ENGINE_TEST(ResourceContainer_HandlesSurviveDestruction)
+{
+        const unsigned int               count = 1000;
+        ResourceContainer<FTestResource> container;
+        std::vector<ResourceHandle>      handles;
+        for (unsigned int i = 0; i < count; ++i)
+        {
+                handles.push_back(container.CreateResource(MakeName(i)));
+                container.GetResource(handles.back())->m_Payload = i;
+        }
+
+        CHECK(container.IsValid(ResourceHandle()) == false);
+
+        // Destroy every third resource, the others have to keep resolving to themselves
+        for (unsigned int i = 0; i < count; i += 3)
+                container.DestroyResource(handles[i]);
+
+        unsigned int wrongCount = 0;
+        for (unsigned int i = 0; i < count; ++i)
+        {
+                bool destroyed = i % 3 == 0;
+                if (container.IsValid(handles[i]) == destroyed)
+                {
+                        wrongCount++;
+                        continue;
+                }
+
+                FAssetId       id    = FAssetId(MakeName(i).c_str());
+                ResourceHandle found = container.FindResource(id);
+                if (destroyed)
+                {
+                        wrongCount += found.m_Data != 0;
+                }
+                else
+                {
+                        FTestResource* resource = container.GetResource(handles[i]);
+                        wrongCount += resource->m_Payload != (int)i || resource->GetName() != MakeName(i);
+                        wrongCount += (found == handles[i]) == false;
+                }
+        }
+        CHECK(wrongCount == 0);
+
+        // New resources take the freed slots with a new generation, the old handles stay dead
+        ResourceHandle reused = container.CreateResource("Reused");
+        CHECK(reused.m_Id % 3 == 0 && reused.m_Id < count);
+        CHECK(container.IsValid(reused));
+        CHECK(container.IsValid(handles[reused.m_Id]) == false);
+        CHECK(reused.m_DeletionAccumulator != handles[reused.m_Id].m_DeletionAccumulator);
+        CHECK(container.GetResource(reused)->m_Payload == 0);
+}
+
+ENGINE_TEST(ResourceContainer_ReleaseDestroysAtZero)
+{
+        ResourceContainer<FTestResource> container;
+        ResourceHandle                   handle = container.CreateResource("Shared");
+
+        container.AcquireResource(handle);
+        FTestResource* resource = container.AcquireResource(handle);
+        CHECK(container.ReleaseResource(handle) == 1);
+        CHECK(container.IsValid(handle) && resource->m_Released == false);
+        CHECK(container.ReleaseResource(handle) == 0);
+        CHECK(container.IsValid(handle) == false);
+        CHECK(container.FindResource(FAssetId("Shared")).m_Data == 0);
+
+        // The name is free again and resolves to the new resource only
+        ResourceHandle recreated = container.CreateResource("Shared");
+        CHECK(container.FindResource(FAssetId("shared")) == recreated);
+        CHECK(container.IsValid(handle) == false);
+}
+
+ENGINE_BENCHMARK(ResourceContainer_LookupThroughput)
+{
+        const unsigned int resourceCounts[] = {64, 1024, 16384};
+        const unsigned int lookupCount      = 1 << 22;
+
+        for (unsigned int resourceCount : resourceCounts)
+        {
+                ResourceContainer<FTestResource> container;
+                std::vector<ResourceHandle>      handles;
+                for (unsigned int i = 0; i < resourceCount; ++i)
+                {
+                        handles.push_back(container.CreateResource(MakeName(i)));
+                        container.GetResource(handles.back())->m_Payload = 1;
+                }
+
+                // Draw lists look resources up in no particular order
+                std::mt19937              random(41);
+                std::vector<unsigned int> order(lookupCount);
+                for (unsigned int& index : order)
+                        index = random() % resourceCount;
+
+                size_t sum   = 0;
+                double start = EngineTests::GetSeconds();
+                for (unsigned int index : order)
+                        sum += container.GetResource(handles[index])->m_Payload;
+                double slotMapSeconds = EngineTests::GetSeconds() - start;
+
+                // The handle set lookup GetResource used to do, one hash probe per call
+                std::unordered_map<ResourceHandle, FTestResource*> handleSet;
+                for (const ResourceHandle& handle : handles)
+                        handleSet[handle] = container.GetResource(handle);
+
+                start = EngineTests::GetSeconds();
+                for (unsigned int index : order)
+                        sum += handleSet.find(handles[index])->second->m_Payload;
+                double hashSeconds = EngineTests::GetSeconds() - start;
+                CHECK(sum == 2 * (size_t)lookupCount);
+
+                char label[64];
+                snprintf(label, sizeof(label), "%u resources, slot map", resourceCount);
+                EngineTests::ReportBenchmark(label, lookupCount / slotMapSeconds, "lookups/s");
+                snprintf(label, sizeof(label), "%u resources, hash probe", resourceCount);
+                EngineTests::ReportBenchmark(label, lookupCount / hashSeconds, "lookups/s");
+        }
+}
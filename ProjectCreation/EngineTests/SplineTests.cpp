@@ -0,0 +1,220 @@
+#include "TestFramework.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <FGoodSpline.h>
+
+using namespace DirectX;
+
+namespace
+{
+        // A random walk like CreateRandomPath's, legs of up to 20 units
+        std::vector<XMVECTOR> MakePath(unsigned int pointCount, uint32_t seed)
+        {
+                std::mt19937                          random(seed);
+                std::uniform_real_distribution<float> step(-20.0f, 20.0f);
+
+                std::vector<XMVECTOR> points;
+                XMVECTOR              point = XMVectorZero();
+                for (unsigned int i = 0; i < pointCount; ++i)
+                {
+                        point += XMVectorSet(step(random), step(random) * 0.25f, step(random), 0.0f);
+                        points.push_back(point);
+                }
+                return points;
+        }
+
+        // The uniform quadratic B-spline from its basis functions, independent of FGoodSpline's segment polynomials
+        XMVECTOR EvaluateReference(const std::vector<XMVECTOR>& points, double time)
+        {
+                unsigned int segmentCount = (unsigned int)points.size() - 2;
+                double       x            = std::min(std::max(time, 0.0), 1.0) * segmentCount;
+                unsigned int segment      = std::min((unsigned int)x, segmentCount - 1);
+                double       u            = x - segment;
+
+                float b0 = float(0.5 * (1.0 - u) * (1.0 - u));
+                float b1 = float(0.5 * (1.0 + 2.0 * u - 2.0 * u * u));
+                float b2 = float(0.5 * u * u);
+                return points[segment] * b0 + points[segment + 1] * b1 + points[segment + 2] * b2;
+        }
+
+        float Distance(FXMVECTOR a, FXMVECTOR b)
+        {
+                return XMVectorGetX(XMVector3Length(a - b));
+        }
+
+        // Arc length from time 0 to every one of the sampleCount + 1 evenly spaced times, from dense chords
+        std::vector<double> MeasureArcLengths(const std::vector<XMVECTOR>& points, unsigned int sampleCount)
+        {
+                std::vector<double> lengths(sampleCount + 1, 0.0);
+                XMVECTOR            previous = EvaluateReference(points, 0.0);
+                for (unsigned int i = 1; i <= sampleCount; ++i)
+                {
+                        XMVECTOR current = EvaluateReference(points, double(i) / sampleCount);
+                        lengths[i]       = lengths[i - 1] + Distance(current, previous);
+                        previous         = current;
+                }
+                return lengths;
+        }
+} // namespace
+
+ENGINE_TEST(Spline_PointsMatchBasisFunctions)
+{
+        std::vector<XMVECTOR> points = MakePath(40, 50);
+        FGoodSpline           spline(points);
+
+        // Positions are a few hundred units out, float evaluation keeps them within a thousandth of a unit
+        float worstError = 0.0f;
+        for (unsigned int i = 0; i <= 10000; ++i)
+        {
+                float time  = i / 10000.0f;
+                float error = Distance(spline.GetPointAtTime(time), EvaluateReference(points, time));
+                worstError  = std::max(worstError, error);
+        }
+        CHECK(worstError < 1e-3f);
+
+        // Times outside [0, 1] clamp to the ends, which are the midpoints of the first and last legs
+        CHECK(Distance(spline.GetPointAtTime(-0.5f), (points[0] + points[1]) * 0.5f) < 1e-4f);
+        CHECK(Distance(spline.GetPointAtTime(1.5f), (points[38] + points[39]) * 0.5f) < 1e-3f);
+}
+
+ENGINE_TEST(Spline_EvaluateNMatchesSingleEvaluation)
+{
+        std::vector<XMVECTOR> points = MakePath(40, 51);
+        FGoodSpline           spline(points);
+
+        // Not a multiple of four so the scalar tail runs too, with clamped times and the exact ends mixed in
+        std::mt19937                          random(51);
+        std::uniform_real_distribution<float> timeDistribution(-0.1f, 1.1f);
+        std::vector<float>                    times(1003);
+        for (float& time : times)
+                time = timeDistribution(random);
+        times[0] = 0.0f;
+        times[1] = 1.0f;
+        times[5] = 1.0f;
+
+        std::vector<XMVECTOR> output(times.size());
+        spline.EvaluateN(times.data(), output.data(), (unsigned int)times.size());
+
+        unsigned int wrongCount = 0;
+        for (size_t i = 0; i < times.size(); ++i)
+                wrongCount += Distance(output[i], spline.GetPointAtTime(times[i])) > 1e-4f;
+        CHECK(wrongCount == 0);
+}
+
+ENGINE_TEST(Spline_DistanceFollowsArcLength)
+{
+        std::vector<XMVECTOR> points = MakePath(40, 52);
+        FGoodSpline           spline(points);
+
+        const unsigned int  denseSampleCount = 1 << 18;
+        std::vector<double> arcLengths       = MeasureArcLengths(points, denseSampleCount);
+        const double        trueLength       = arcLengths.back();
+
+        // The table's chords cut corners, 16 samples per span keep the error well under a percent
+        CHECK(fabs(spline.GetLength() - trueLength) < trueLength * 1e-3);
+        CHECK(spline.GetLength() <= trueLength * (1.0 + 1e-5));
+
+        // Equal distance steps have to be equal steps along the curve, not in time
+        double worstError = 0.0;
+        float  lastTime   = 0.0f;
+        bool   monotonic  = true;
+        for (unsigned int i = 0; i <= 1000; ++i)
+        {
+                float distance = spline.GetLength() * i / 1000.0f;
+                float time     = spline.GetTimeAtDistance(distance);
+                monotonic      = monotonic && time >= lastTime;
+                lastTime       = time;
+
+                unsigned int sample    = std::min((unsigned int)lround(time * denseSampleCount), denseSampleCount);
+                double       travelled = arcLengths[sample];
+                worstError             = std::max(worstError, fabs(travelled - distance));
+        }
+        CHECK(monotonic);
+        CHECK(worstError < trueLength * 2e-3);
+
+        // AdvanceDistance walks the same mapping and stops at both ends
+        spline.ResetPointer();
+        spline.AdvanceDistance(spline.GetLength() * 0.25f);
+        CHECK(Distance(spline.GetCurrentPoint(), spline.GetPointAtDistance(spline.GetLength() * 0.25f)) < 1e-4f);
+        spline.AdvanceDistance(spline.GetLength() * 2.0f);
+        CHECK(spline.GetCurrentDistance() == spline.GetLength());
+        spline.AdvanceDistance(-spline.GetLength() * 3.0f);
+        CHECK(spline.GetCurrentDistance() == 0.0f);
+}
+
+ENGINE_TEST(Spline_ShortPointListsAreLines)
+{
+        FGoodSpline empty(std::vector<XMVECTOR>{});
+        CHECK(empty.GetLength() == 0.0f);
+        CHECK(Distance(empty.GetPointAtTime(0.5f), XMVectorZero()) == 0.0f);
+
+        XMVECTOR    a = XMVectorSet(1.0f, 2.0f, 3.0f, 0.0f);
+        FGoodSpline single(std::vector<XMVECTOR>{a});
+        CHECK(single.GetLength() == 0.0f);
+        CHECK(Distance(single.GetPointAtDistance(1.0f), a) == 0.0f);
+
+        XMVECTOR    b = XMVectorSet(11.0f, 2.0f, 3.0f, 0.0f);
+        FGoodSpline line(std::vector<XMVECTOR>{a, b});
+        CHECK(fabs(line.GetLength() - 10.0f) < 1e-4f);
+        CHECK(Distance(line.GetPointAtTime(0.5f), XMVectorSet(6.0f, 2.0f, 3.0f, 0.0f)) < 1e-5f);
+        CHECK(Distance(line.GetPointAtDistance(2.5f), XMVectorSet(3.5f, 2.0f, 3.0f, 0.0f)) < 1e-4f);
+        CHECK(Distance(line.GetPointAtTime(1.0f), b) < 1e-5f);
+}
+
+ENGINE_BENCHMARK(Spline_EvaluationThroughput)
+{
+        std::vector<XMVECTOR> points = MakePath(40, 53);
+        FGoodSpline           spline(points);
+
+        const unsigned int count       = 1 << 16;
+        const int          repeatCount = 50;
+
+        std::vector<float>    times(count);
+        std::vector<float>    distances(count);
+        std::vector<XMVECTOR> output(count);
+        for (unsigned int i = 0; i < count; ++i)
+        {
+                times[i]     = float(i) / count;
+                distances[i] = spline.GetLength() * times[i];
+        }
+
+        // Summed so the evaluations can't be dropped
+        XMVECTOR sum   = XMVectorZero();
+        double   start = EngineTests::GetSeconds();
+        for (int repeat = 0; repeat < repeatCount; ++repeat)
+                for (unsigned int i = 0; i < count; ++i)
+                        sum += spline.GetPointAtTime(times[i]);
+        double timeSeconds = EngineTests::GetSeconds() - start;
+
+        start = EngineTests::GetSeconds();
+        for (int repeat = 0; repeat < repeatCount; ++repeat)
+        {
+                spline.EvaluateN(times.data(), output.data(), count);
+                sum += output[repeat];
+        }
+        double batchSeconds = EngineTests::GetSeconds() - start;
+
+        start = EngineTests::GetSeconds();
+        for (int repeat = 0; repeat < repeatCount; ++repeat)
+                for (unsigned int i = 0; i < count; ++i)
+                        sum += spline.GetPointAtDistance(distances[i]);
+        double distanceSeconds = EngineTests::GetSeconds() - start;
+
+        start = EngineTests::GetSeconds();
+        for (int repeat = 0; repeat < repeatCount; ++repeat)
+                for (unsigned int i = 0; i < count; ++i)
+                        sum += EvaluateReference(points, times[i]);
+        double referenceSeconds = EngineTests::GetSeconds() - start;
+        CHECK(isfinite(XMVectorGetX(sum)));
+
+        const double evaluationCount = double(count) * repeatCount;
+        EngineTests::ReportBenchmark("GetPointAtTime", evaluationCount / timeSeconds, "points/s");
+        EngineTests::ReportBenchmark("EvaluateN", evaluationCount / batchSeconds, "points/s");
+        EngineTests::ReportBenchmark("GetPointAtDistance", evaluationCount / distanceSeconds, "points/s");
+        EngineTests::ReportBenchmark("basis functions", evaluationCount / referenceSeconds, "points/s");
+}
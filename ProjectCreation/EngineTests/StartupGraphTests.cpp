@@ -0,0 +1,100 @@
+#include "TestFramework.h"
+
+#include <limits.h>
+#include <stdio.h>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <StartupGraph.h>
+
+namespace
+{
+        void Spin(double microseconds)
+        {
+                double end = EngineTests::GetSeconds() + microseconds * 1e-6;
+                while (EngineTests::GetSeconds() < end)
+                        ;
+        }
+} // namespace
+
+ENGINE_TEST(StartupGraph_RunsStepsAfterTheirDependencies)
+{
+        const unsigned int    stepCount    = 120;
+        const std::thread::id mainThreadId = std::this_thread::get_id();
+        std::mt19937          random(44);
+
+        for (int round = 0; round < 5; ++round)
+        {
+                // Sequence numbers taken when a step starts and when it ends, shared by every thread
+                std::atomic<unsigned int>    sequence{0};
+                std::vector<unsigned int>    startSequence(stepCount, UINT_MAX);
+                std::vector<unsigned int>    endSequence(stepCount, UINT_MAX);
+                std::vector<unsigned int>    runCounts(stepCount, 0);
+                std::vector<std::thread::id> threadIds(stepCount);
+
+                StartupGraph graph;
+                for (unsigned int i = 0; i < stepCount; ++i)
+                {
+                        int    thread = random() % 3 == 0 ? E_STARTUP_THREAD::MAIN : E_STARTUP_THREAD::ANY;
+                        double work   = random() % 200;
+
+                        auto function = [&, i, work]() {
+                                startSequence[i] = sequence++;
+                                threadIds[i]     = std::this_thread::get_id();
+                                runCounts[i]++;
+                                Spin(work);
+                                endSequence[i] = sequence++;
+                        };
+
+                        // Up to three dependencies on earlier steps, duplicates are allowed
+                        unsigned int dependencyCount = i == 0 ? 0 : random() % 4;
+                        unsigned int dependencies[3] = {};
+                        for (unsigned int d = 0; d < dependencyCount; ++d)
+                                dependencies[d] = random() % i;
+
+                        if (dependencyCount == 0)
+                                graph.Add("Step", thread, function);
+                        else if (dependencyCount == 1)
+                                graph.Add("Step", thread, function, {dependencies[0]});
+                        else if (dependencyCount == 2)
+                                graph.Add("Step", thread, function, {dependencies[0], dependencies[1]});
+                        else
+                                graph.Add(
+                                    "Step", thread, function, {dependencies[0], dependencies[1], dependencies[2]});
+                }
+
+                graph.Run();
+
+                const std::vector<FStartupStep>& steps      = graph.GetSteps();
+                unsigned int                     wrongCount = 0;
+                for (unsigned int i = 0; i < stepCount; ++i)
+                {
+                        const FStartupStep& step = steps[i];
+                        wrongCount += runCounts[i] != 1;
+                        wrongCount += step.start > step.end;
+                        if (step.thread == E_STARTUP_THREAD::MAIN)
+                                wrongCount += threadIds[i] != mainThreadId || step.threadIndex != 0;
+
+                        for (unsigned int dependency : step.dependencies)
+                        {
+                                wrongCount += endSequence[dependency] > startSequence[i];
+                                wrongCount += steps[dependency].end > step.start;
+                        }
+                }
+                CHECK(wrongCount == 0);
+
+                // The steps marked critical form the longest chain, their durations add up to the critical path
+                int64_t criticalSum = 0;
+                for (const FStartupStep& step : steps)
+                        criticalSum += step.critical ? step.end - step.start : 0;
+                CHECK(criticalSum == graph.GetCriticalPathMicroseconds());
+                CHECK(graph.GetCriticalPathMicroseconds() <= graph.GetTotalMicroseconds());
+        }
+
+        // An empty graph returns straight away
+        StartupGraph empty;
+        empty.Run();
+        CHECK(empty.GetTotalMicroseconds() >= 0 && empty.GetCriticalPathMicroseconds() == 0);
+}
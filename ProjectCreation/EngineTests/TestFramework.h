@@ -0,0 +1,48 @@
+#pragma once
+
+#include <stdint.h>
+
+// Tests and benchmarks register themselves during static initialization. The runner executes every test, and the
+// benchmarks as well when started with -bench. A failed CHECK reports and lets the test carry on.
+namespace EngineTests
+{
+        typedef void (*TestFunction)();
+
+        struct E_TEST_KIND
+        {
+                enum
+                {
+                        TEST = 0,
+                        BENCHMARK,
+                        COUNT
+                };
+        };
+
+        struct FTestRegistration
+        {
+                FTestRegistration(const char* name, TestFunction function, int kind);
+        };
+
+        void ReportFailure(const char* file, int line, const char* expression);
+
+        // One result line of the running benchmark, e.g. ReportBenchmark("lookups", 1.5e8, "/s")
+        void ReportBenchmark(const char* label, double value, const char* unit);
+
+        // Performance counter time since the runner started
+        double GetSeconds();
+} // namespace EngineTests
+
+#define ENGINE_TEST_CASE(name, kind)                                                                                   \
+        static void                          name();                                                                   \
+        static EngineTests::FTestRegistration name##Registration(#name, name, kind);                                   \
+        static void                          name()
+
+#define ENGINE_TEST(name) ENGINE_TEST_CASE(name, EngineTests::E_TEST_KIND::TEST)
+#define ENGINE_BENCHMARK(name) ENGINE_TEST_CASE(name, EngineTests::E_TEST_KIND::BENCHMARK)
+
+#define CHECK(expression)                                                                                              \
+        do                                                                                                             \
+        {                                                                                                              \
+                if (!(expression))                                                                                     \
+                        EngineTests::ReportFailure(__FILE__, __LINE__, #expression);                                   \
+        } while (0)
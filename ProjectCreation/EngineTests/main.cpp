@@ -0,0 +1,118 @@
+#include "TestFramework.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+#include <FrameAllocator.h>
+#include <JobScheduler.h>
+#include <MemoryDefines.h>
+
+// Engine test runner.
+//      EngineTests.exe [-bench] [-threads N] [name filter]
+// Runs every test whose name contains the filter, and the matching benchmarks with -bench. -threads sets the job
+// scheduler's thread count so the concurrency tests see contention on machines with few cores. Returns the number
+// of failed tests. Assets are read relative to the working directory, like the game's ../Assets.
+
+namespace
+{
+        struct FTestCase
+        {
+                const char*               name;
+                EngineTests::TestFunction function;
+                int                       kind;
+        };
+
+        std::vector<FTestCase>& GetTestCases()
+        {
+                static std::vector<FTestCase> testCases;
+                return testCases;
+        }
+
+        unsigned int g_FailureCount = 0;
+        double       g_Frequency    = 0.0;
+        int64_t      g_Origin       = 0;
+} // namespace
+
+EngineTests::FTestRegistration::FTestRegistration(const char* name, TestFunction function, int kind)
+{
+        GetTestCases().push_back({name, function, kind});
+}
+
+void EngineTests::ReportFailure(const char* file, int line, const char* expression)
+{
+        ++g_FailureCount;
+        printf("        %s(%d): CHECK(%s) failed\n", file, line, expression);
+}
+
+void EngineTests::ReportBenchmark(const char* label, double value, const char* unit)
+{
+        printf("        %-48s %14.2f %s\n", label, value, unit);
+}
+
+double EngineTests::GetSeconds()
+{
+        LARGE_INTEGER counter;
+        QueryPerformanceCounter(&counter);
+        return double(counter.QuadPart - g_Origin) / g_Frequency;
+}
+
+int main(int argc, char** argv)
+{
+        bool        runBenchmarks = false;
+        const char* filter        = nullptr;
+        for (int i = 1; i < argc; ++i)
+        {
+                if (strcmp(argv[i], "-bench") == 0)
+                        runBenchmarks = true;
+                else if (strcmp(argv[i], "-threads") == 0 && i + 1 < argc)
+                        JobSchedulerGlobals::g_num_threads = std::min(std::max(atoi(argv[++i]), 1), 64);
+                else
+                        filter = argv[i];
+        }
+
+        LARGE_INTEGER frequency;
+        LARGE_INTEGER origin;
+        QueryPerformanceFrequency(&frequency);
+        QueryPerformanceCounter(&origin);
+        g_Frequency = double(frequency.QuadPart);
+        g_Origin    = origin.QuadPart;
+
+        // Same order as GEngine::Initialize, without the profiler so runs don't write traces
+        JobScheduler::Initialize();
+        NMemory::FrameAllocator::Initialize(MB(2));
+
+        unsigned int runCount    = 0;
+        unsigned int failedCount = 0;
+        for (const FTestCase& testCase : GetTestCases())
+        {
+                if (testCase.kind == EngineTests::E_TEST_KIND::BENCHMARK && runBenchmarks == false)
+                        continue;
+                if (filter && strstr(testCase.name, filter) == nullptr)
+                        continue;
+
+                printf("[ RUN    ] %s\n", testCase.name);
+
+                unsigned int failuresBefore = g_FailureCount;
+                double       start          = EngineTests::GetSeconds();
+                testCase.function();
+                double elapsed = EngineTests::GetSeconds() - start;
+
+                // Every test is one frame, frame memory allocated by the jobs it ran is released here
+                NMemory::FrameAllocator::EndFrame();
+
+                bool failed = g_FailureCount != failuresBefore;
+                printf("[ %s ] %s (%.1f ms)\n", failed ? "FAILED" : "    OK", testCase.name, elapsed * 1000.0);
+
+                ++runCount;
+                failedCount += failed;
+        }
+
+        JobScheduler::Shutdown();
+        NMemory::FrameAllocator::Shutdown();
+
+        printf("%u of %u passed\n", runCount - failedCount, runCount);
+        return (int)failedCount;
+}
@@ -22,6 +22,7 @@ void AnimationComponent::AddAnims(size_t count, float* weights, ResourceHandle*
 {
         m_Clips.insert(m_Clips.begin(), animHandles, animHandles + count);
         m_Weights.insert(m_Weights.begin(), weights, weights + count);
+        m_KeyFrameCursors.insert(m_KeyFrameCursors.begin(), count, 0);
 
         MathLibrary::NormalizeArray(m_Weights.size(), m_Weights.data());
 }
@@ -0,0 +1,270 @@
+#include <AnimationCompression.h>
+
+#include <assert.h>
+
+using namespace DirectX;
+
+namespace
+{
+        constexpr float    kQuatComponentRange = 0.707106781f;
+        constexpr uint32_t kQuatComponentMax   = (1 << 15) - 1;
+
+        inline XMVECTOR LoadPoint(const XMFLOAT3& value)
+        {
+                return XMVectorSetW(XMLoadFloat3(&value), 1.0f);
+        }
+
+        inline XMFLOAT3 StorePoint(FXMVECTOR value)
+        {
+                XMFLOAT3 output;
+                XMStoreFloat3(&output, value);
+                return output;
+        }
+
+        inline float VectorError(FXMVECTOR a, FXMVECTOR b)
+        {
+                return XMVectorGetX(XMVector3LengthEst(XMVectorSubtract(a, b)));
+        }
+
+        // Rotation angle between a and b. acos of the dot product loses everything below ~7e-4 radians in floats, the
+        // chord |a - b| = 2 sin(angle / 4) stays accurate for the small angles the tolerances are about.
+        inline float QuaternionError(FXMVECTOR a, FXMVECTOR b)
+        {
+                float chord = std::min(XMVectorGetX(XMVector4Length(XMVectorSubtract(a, b))),
+                                       XMVectorGetX(XMVector4Length(XMVectorAdd(a, b))));
+                return 4.0f * asinf(std::min(chord * 0.5f, 1.0f));
+        }
+
+        // Returns true when every frame in (first, last) can be rebuilt by interpolating first and last
+        bool CanRemoveFrames(const Animation::FAnimClip&                animClip,
+                             int                                        first,
+                             int                                        last,
+                             const Animation::FAnimCompressionSettings& settings)
+        {
+                uint32_t jointCount = animClip.jointCount;
+                double   span       = animClip.times[last] - animClip.times[first];
+
+                for (int frame = first + 1; frame < last; ++frame)
+                {
+                        float ratio = float((animClip.times[frame] - animClip.times[first]) / span);
+
+                        size_t a = (size_t)first * jointCount;
+                        size_t b = (size_t)last * jointCount;
+                        size_t f = (size_t)frame * jointCount;
+
+                        for (uint32_t j = 0; j < jointCount; ++j)
+                        {
+                                XMVECTOR t = XMVectorLerp(animClip.translations[a + j], animClip.translations[b + j], ratio);
+                                if (VectorError(t, animClip.translations[f + j]) > settings.translationTolerance)
+                                        return false;
+
+                                XMVECTOR r = XMQuaternionSlerp(animClip.rotations[a + j], animClip.rotations[b + j], ratio);
+                                if (QuaternionError(r, animClip.rotations[f + j]) > settings.rotationTolerance)
+                                        return false;
+
+                                XMVECTOR s = XMVectorLerp(animClip.scales[a + j], animClip.scales[b + j], ratio);
+                                if (VectorError(s, animClip.scales[f + j]) > settings.scaleTolerance)
+                                        return false;
+                        }
+                }
+
+                return true;
+        }
+
+        template <typename ErrorFunc>
+        bool IsConstantTrack(const std::vector<XMVECTOR>& track,
+                             uint32_t                     joint,
+                             uint32_t                     jointCount,
+                             int                          frameCount,
+                             float                        tolerance,
+                             ErrorFunc                    errorFunc)
+        {
+                for (int frame = 1; frame < frameCount; ++frame)
+                {
+                        if (errorFunc(track[joint], track[(size_t)frame * jointCount + joint]) > tolerance)
+                                return false;
+                }
+
+                return true;
+        }
+} // namespace
+
+size_t Animation::FCompressedAnimClip::GetMemoryUsage() const
+{
+        return sizeof(*this) + times.size() * sizeof(double) +
+               (constRotations.size() + rotationKeys.size()) * sizeof(FQuantizedQuaternion) +
+               (constTranslations.size() + constScales.size() + translationKeys.size() + scaleKeys.size()) *
+                   sizeof(XMFLOAT3) +
+               (animatedRotationJoints.size() + animatedTranslationJoints.size() + animatedScaleJoints.size()) *
+                   sizeof(uint16_t);
+}
+
+Animation::FQuantizedQuaternion Animation::QuantizeQuaternion(FXMVECTOR quaternion)
+{
+        XMFLOAT4 q;
+        XMStoreFloat4(&q, XMQuaternionNormalize(quaternion));
+        float components[4] = {q.x, q.y, q.z, q.w};
+
+        int largest = 0;
+        for (int i = 1; i < 4; ++i)
+        {
+                if (fabsf(components[i]) > fabsf(components[largest]))
+                        largest = i;
+        }
+
+        // q and -q are the same rotation, flip so the dropped component is positive
+        float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+
+        FQuantizedQuaternion output;
+        for (int i = 0, k = 0; i < 4; ++i)
+        {
+                if (i == largest)
+                        continue;
+
+                float normalized = (components[i] * sign / kQuatComponentRange) * 0.5f + 0.5f;
+                normalized       = std::min(std::max(normalized, 0.0f), 1.0f);
+                output.data[k++] = uint16_t(uint32_t(normalized * kQuatComponentMax + 0.5f) << 1);
+        }
+
+        output.data[0] |= (largest >> 1) & 1;
+        output.data[1] |= largest & 1;
+
+        return output;
+}
+
+DirectX::XMVECTOR Animation::DequantizeQuaternion(const FQuantizedQuaternion& quantized)
+{
+        int largest = ((quantized.data[0] & 1) << 1) | (quantized.data[1] & 1);
+
+        float components[4];
+        float sumSq = 0.0f;
+        for (int i = 0, k = 0; i < 4; ++i)
+        {
+                if (i == largest)
+                        continue;
+
+                float value   = float(quantized.data[k++] >> 1) / kQuatComponentMax;
+                components[i] = (value * 2.0f - 1.0f) * kQuatComponentRange;
+                sumSq += components[i] * components[i];
+        }
+        components[largest] = sqrtf(std::max(1.0f - sumSq, 0.0f));
+
+        return XMVectorSet(components[0], components[1], components[2], components[3]);
+}
+
+void Animation::CompressAnimClip(const FAnimClip&                animClip,
+                                 FCompressedAnimClip&            compressedClip,
+                                 const FAnimCompressionSettings& settings)
+{
+        uint32_t jointCount = animClip.jointCount;
+        int      frameCount = animClip.GetFrameCount();
+
+        assert(frameCount >= 2);
+
+        compressedClip            = FCompressedAnimClip();
+        compressedClip.duration   = animClip.duration;
+        compressedClip.jointCount = jointCount;
+
+        // Greedily drop keyframes that the surrounding kept keyframes can rebuild within tolerance.
+        // The first and last keyframes are always kept so the clip still covers [0, duration].
+        std::vector<int> keptFrames;
+        keptFrames.push_back(0);
+        int anchor = 0;
+        for (int candidate = 2; candidate < frameCount; ++candidate)
+        {
+                if (!CanRemoveFrames(animClip, anchor, candidate, settings))
+                {
+                        anchor = candidate - 1;
+                        keptFrames.push_back(anchor);
+                }
+        }
+        keptFrames.push_back(frameCount - 1);
+
+        compressedClip.times.reserve(keptFrames.size());
+        for (int frame : keptFrames)
+                compressedClip.times.push_back(animClip.times[frame]);
+
+        compressedClip.constRotations.resize(jointCount);
+        compressedClip.constTranslations.resize(jointCount);
+        compressedClip.constScales.resize(jointCount);
+
+        for (uint32_t j = 0; j < jointCount; ++j)
+        {
+                compressedClip.constRotations[j]    = QuantizeQuaternion(animClip.rotations[j]);
+                compressedClip.constTranslations[j] = StorePoint(animClip.translations[j]);
+                compressedClip.constScales[j]       = StorePoint(animClip.scales[j]);
+
+                if (!IsConstantTrack(
+                        animClip.rotations, j, jointCount, frameCount, settings.rotationTolerance, QuaternionError))
+                        compressedClip.animatedRotationJoints.push_back((uint16_t)j);
+
+                if (!IsConstantTrack(
+                        animClip.translations, j, jointCount, frameCount, settings.translationTolerance, VectorError))
+                        compressedClip.animatedTranslationJoints.push_back((uint16_t)j);
+
+                if (!IsConstantTrack(animClip.scales, j, jointCount, frameCount, settings.scaleTolerance, VectorError))
+                        compressedClip.animatedScaleJoints.push_back((uint16_t)j);
+        }
+
+        for (int frame : keptFrames)
+        {
+                size_t offset = (size_t)frame * jointCount;
+
+                for (uint16_t j : compressedClip.animatedRotationJoints)
+                        compressedClip.rotationKeys.push_back(QuantizeQuaternion(animClip.rotations[offset + j]));
+
+                for (uint16_t j : compressedClip.animatedTranslationJoints)
+                        compressedClip.translationKeys.push_back(StorePoint(animClip.translations[offset + j]));
+
+                for (uint16_t j : compressedClip.animatedScaleJoints)
+                        compressedClip.scaleKeys.push_back(StorePoint(animClip.scales[offset + j]));
+        }
+}
+
+void Animation::SampleCompressedAnimClip(const FCompressedAnimClip& animClip, int prevFrame, float ratio, FTransform* outPose)
+{
+        uint32_t jointCount = animClip.jointCount;
+
+        for (uint32_t j = 0; j < jointCount; ++j)
+        {
+                outPose[j].rotation.data = DequantizeQuaternion(animClip.constRotations[j]);
+                outPose[j].translation   = LoadPoint(animClip.constTranslations[j]);
+                outPose[j].scale         = LoadPoint(animClip.constScales[j]);
+        }
+
+        size_t rotationCount = animClip.animatedRotationJoints.size();
+        if (rotationCount)
+        {
+                const FQuantizedQuaternion* prevKeys = animClip.rotationKeys.data() + prevFrame * rotationCount;
+                const FQuantizedQuaternion* nextKeys = prevKeys + rotationCount;
+                for (size_t i = 0; i < rotationCount; ++i)
+                {
+                        outPose[animClip.animatedRotationJoints[i]].rotation.data = XMQuaternionSlerp(
+                            DequantizeQuaternion(prevKeys[i]), DequantizeQuaternion(nextKeys[i]), ratio);
+                }
+        }
+
+        size_t translationCount = animClip.animatedTranslationJoints.size();
+        if (translationCount)
+        {
+                const XMFLOAT3* prevKeys = animClip.translationKeys.data() + prevFrame * translationCount;
+                const XMFLOAT3* nextKeys = prevKeys + translationCount;
+                for (size_t i = 0; i < translationCount; ++i)
+                {
+                        outPose[animClip.animatedTranslationJoints[i]].translation =
+                            XMVectorLerp(LoadPoint(prevKeys[i]), LoadPoint(nextKeys[i]), ratio);
+                }
+        }
+
+        size_t scaleCount = animClip.animatedScaleJoints.size();
+        if (scaleCount)
+        {
+                const XMFLOAT3* prevKeys = animClip.scaleKeys.data() + prevFrame * scaleCount;
+                const XMFLOAT3* nextKeys = prevKeys + scaleCount;
+                for (size_t i = 0; i < scaleCount; ++i)
+                {
+                        outPose[animClip.animatedScaleJoints[i]].scale =
+                            XMVectorLerp(LoadPoint(prevKeys[i]), LoadPoint(nextKeys[i]), ratio);
+                }
+        }
+}
\ No newline at end of file
@@ -11,7 +11,7 @@
 
 #include <MathLibrary.h>
 
-#include <debug_renderer.h>
+#include <JobScheduler.h>
 
 using namespace DirectX;
 
@@ -40,59 +40,95 @@ static FQuaternion BlendVectors(int vecCount, XMVECTOR* vecs, float* weights)
         return output;
 }
 
-void AnimationSystem::calcTransforms(Animation::FJoint*          joints,
-                                     int                         jointCount,
-                                     double                      time,
-                                     const Animation::FAnimClip& animClip,
-                                     float                       accumWeight,
-                                     float                       currweight)
+void AnimationSystem::calcTransforms(Animation::FJoint*                    joints,
+                                     int                                   jointCount,
+                                     double                                time,
+                                     const Animation::FCompressedAnimClip& animClip,
+                                     int&                                  keyFrameCursor,
+                                     float                                 accumWeight,
+                                     float                                 currweight)
 {
-        int   prevFrame  = 0;
-        int   nextFrame  = 1;
-        float ratio      = 0.0f;
-        int   frameCount = (int)animClip.frames.size();
-        float animTime   = MathLibrary::Warprange(float(time), 0.0f, (float)animClip.duration);
+        float animTime  = MathLibrary::Warprange(float(time), 0.0f, (float)animClip.duration);
+        int   prevFrame = animClip.FindKeyFrame(animTime, keyFrameCursor);
+        int   nextFrame = prevFrame + 1;
 
-        while (nextFrame < frameCount - 1)
+        auto prevTime = animClip.times[prevFrame];
+        auto nextTime = animClip.times[nextFrame];
+
+        float ratio = float(((double)animTime - prevTime) / (nextTime - prevTime));
+
+        ratio = MathLibrary::clamp(ratio, 0.0f, 1.0f);
+
+        float c = currweight, p = accumWeight;
+        MathLibrary::NormalizeValues(c, p);
+
+        m_SampledPose.resize(animClip.jointCount);
+        Animation::SampleCompressedAnimClip(animClip, prevFrame, ratio, m_SampledPose.data());
+
+        for (int i = 0; i < jointCount; ++i)
         {
-                if (animTime >= animClip.frames[prevFrame].time && animTime < animClip.frames[nextFrame].time)
-                {
-                        break;
-                }
+                const FTransform& sampled = m_SampledPose[i];
 
-                prevFrame++;
-                nextFrame++;
+                joints[i].transform.rotation.data =
+                    XMQuaternionSlerp(joints[i].transform.rotation.data, sampled.rotation.data, c);
+                joints[i].transform.translation = XMVectorLerp(joints[i].transform.translation, sampled.translation, c);
+                joints[i].transform.scale       = XMVectorLerp(joints[i].transform.scale, sampled.scale, c);
         }
+}
 
-        auto prevTime = animClip.frames[prevFrame].time;
-        auto nextTime = animClip.frames[nextFrame].time;
+void AnimationSystem::BuildSkinningPalette(SkeletalMeshComponent& meshComp)
+{
+        const Animation::FSkeleton& skel       = meshComp.m_Skeleton;
+        int                         jointCount = (int)skel.jointTransforms.size();
 
-        ratio = float(((double)animTime - prevTime) / (nextTime - prevTime));
+        if (meshComp.m_InverseBindMatrices.size() != jointCount)
+        {
+                meshComp.m_InverseBindMatrices.resize(jointCount);
+                for (int i = 0; i < jointCount; ++i)
+                {
+                        meshComp.m_InverseBindMatrices[i] = skel.inverseBindPose[i].transform.CreateMatrix();
+                }
+        }
 
-        ratio = MathLibrary::clamp(ratio, 0.0f, 1.0f);
+        meshComp.m_GlobalJointTransforms.resize(jointCount);
+        XMMATRIX* globals = meshComp.m_GlobalJointTransforms.data();
 
+        // Parents always come before their children
         for (int i = 0; i < jointCount; ++i)
         {
-                auto& prevTransform = animClip.frames[prevFrame].joints[i];
-                auto& nextTransform = animClip.frames[nextFrame].joints[i];
+                globals[i]      = skel.jointTransforms[i].transform.CreateMatrix();
+                int parentIndex = skel.jointTransforms[i].parent_index;
+                if (parentIndex >= 0)
+                {
+                        globals[i] = globals[i] * globals[parentIndex];
+                }
+        }
 
-                // skeletalMesh.joints[i].transform = Transform::Lerp(skeletalMesh.joints[i].transform,
-                // nextTransform, ratio);
-                XMVECTOR outVec   = XMVectorLerp(prevTransform.translation, nextTransform.translation, ratio);
-                XMVECTOR outQuat  = XMQuaternionSlerp(prevTransform.rotation.data, nextTransform.rotation.data, ratio);
-                XMVECTOR outScale = XMVectorLerp(prevTransform.scale, nextTransform.scale, ratio);
+        int                    backPalette = 1 - meshComp.m_FrontPalette;
+        std::vector<XMMATRIX>& palette     = meshComp.m_SkinningPalettes[backPalette];
+        palette.resize(jointCount);
 
-                float c = currweight, p = accumWeight;
-                MathLibrary::NormalizeValues(c, p);
+        for (int i = 0; i < jointCount; ++i)
+        {
+                palette[i] = XMMatrixTranspose(meshComp.m_InverseBindMatrices[i] * globals[i]);
+        }
 
-                joints[i].transform.rotation.data = XMQuaternionSlerp(joints[i].transform.rotation.data, outQuat, c);
-                joints[i].transform.translation   = XMVectorLerp(joints[i].transform.translation, outVec, c);
-                joints[i].transform.scale         = XMVectorLerp(joints[i].transform.scale, outScale, c);
+        meshComp.m_FrontPalette = backPalette;
+}
+
+void AnimationSystem::WaitForSkinningPalettes()
+{
+        if (m_SkinningPaletteJob)
+        {
+                JobSchedulerInternal::Wait(m_SkinningPaletteJob);
+                m_SkinningPaletteJob = nullptr;
         }
 }
 
 void AnimationSystem::OnPreUpdate(float deltaTime)
-{}
+{
+        WaitForSkinningPalettes();
+}
 
 void AnimationSystem::OnUpdate(float deltaTime)
 {
@@ -126,8 +162,6 @@ void AnimationSystem::OnUpdate(float deltaTime)
 
                 int jointCount = (int)skel.jointTransforms.size();
 
-                std::vector<float> weights;
-                weights         = animComp.m_Weights;
                 float sumWeight = 0.0f;
                 for (int currTrack = 0; currTrack < clipCount; ++currTrack)
                 {
@@ -136,6 +170,7 @@ void AnimationSystem::OnUpdate(float deltaTime)
                                        jointCount,
                                        animComp.m_Time,
                                        clip->m_AnimClip,
+                                       animComp.m_KeyFrameCursors[currTrack],
                                        sumWeight,
                                        animComp.m_Weights[currTrack]);
 
@@ -145,7 +180,16 @@ void AnimationSystem::OnUpdate(float deltaTime)
 }
 
 void AnimationSystem::OnPostUpdate(float deltaTime)
-{}
+{
+        // Poses are final, build the skinning palettes on the workers while the remaining systems update.
+        // RenderSystem waits on this before it uploads them.
+        auto SkinningPaletteJob = ParallelForActiveComponents<SkeletalMeshComponent>(
+            [](SkeletalMeshComponent& meshComp) { BuildSkinningPalette(meshComp); }, 4);
+        SkinningPaletteJob.SetName("Skinning palettes");
+
+        SkinningPaletteJob();
+        m_SkinningPaletteJob = SkinningPaletteJob.GetRootJob();
+}
 
 void AnimationSystem::OnInitialize()
 {
@@ -154,7 +198,9 @@ void AnimationSystem::OnInitialize()
 }
 
 void AnimationSystem::OnShutdown()
-{}
+{
+        WaitForSkinningPalettes();
+}
 
 void AnimationSystem::OnResume()
 {}
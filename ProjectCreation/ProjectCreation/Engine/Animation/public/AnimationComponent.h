@@ -11,6 +11,7 @@ class AnimationComponent : public Component<AnimationComponent>
         double                      m_Time = 0.0f;
         std::vector<ResourceHandle> m_Clips;
         std::vector<float>          m_Weights;
+        std::vector<int>            m_KeyFrameCursors;
 
     public:
         void SetWeights(int count, float* weights);
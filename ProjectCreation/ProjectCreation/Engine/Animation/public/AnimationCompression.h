@@ -0,0 +1,66 @@
+#pragma once
+
+#include <AnimationContainers.h>
+
+namespace Animation
+{
+        // Compressed .anim files start with this magic and version, raw files start with the clip duration
+        constexpr uint32_t kCompressedAnimClipMagic   = 0x434D4E41; // "ANMC"
+        constexpr uint32_t kCompressedAnimClipVersion = 2;
+
+        // Smallest-three quaternion packed into 48 bits: the three smallest components are stored as 15 bit
+        // fixed point values and the index of the dropped (largest) component is split across the low bits
+        struct FQuantizedQuaternion
+        {
+                uint16_t data[3];
+        };
+
+        struct FAnimCompressionSettings
+        {
+                float translationTolerance = 0.0005f;
+                float rotationTolerance    = 0.0005f; // radians
+                float scaleTolerance       = 0.0001f;
+        };
+
+        // Compressed clip used at runtime.
+        // Channels that never change are stored once per joint in the const arrays.
+        // Channels that do change are listed in the animated*Joints arrays and their keys are frame-major,
+        // keyframes that can be rebuilt by interpolating their neighbours are removed from the times array.
+        struct FCompressedAnimClip
+        {
+                double                            duration   = 0.0;
+                uint32_t                          jointCount = 0;
+                std::vector<double>               times;
+                std::vector<FQuantizedQuaternion> constRotations;
+                std::vector<DirectX::XMFLOAT3>    constTranslations;
+                std::vector<DirectX::XMFLOAT3>    constScales;
+                std::vector<uint16_t>             animatedRotationJoints;
+                std::vector<uint16_t>             animatedTranslationJoints;
+                std::vector<uint16_t>             animatedScaleJoints;
+                std::vector<FQuantizedQuaternion> rotationKeys;
+                std::vector<DirectX::XMFLOAT3>    translationKeys;
+                std::vector<DirectX::XMFLOAT3>    scaleKeys;
+
+                inline int GetFrameCount() const
+                {
+                        return (int)times.size();
+                }
+
+                inline int FindKeyFrame(double time, int& cursor) const
+                {
+                        return Animation::FindKeyFrame(times, time, cursor);
+                }
+
+                size_t GetMemoryUsage() const;
+        };
+
+        FQuantizedQuaternion QuantizeQuaternion(DirectX::FXMVECTOR quaternion);
+        DirectX::XMVECTOR    DequantizeQuaternion(const FQuantizedQuaternion& quantized);
+
+        void CompressAnimClip(const FAnimClip&                animClip,
+                              FCompressedAnimClip&            compressedClip,
+                              const FAnimCompressionSettings& settings = FAnimCompressionSettings());
+
+        // Decodes and interpolates the pose between prevFrame and prevFrame + 1 into outPose (jointCount entries)
+        void SampleCompressedAnimClip(const FCompressedAnimClip& animClip, int prevFrame, float ratio, FTransform* outPose);
+} // namespace Animation
\ No newline at end of file
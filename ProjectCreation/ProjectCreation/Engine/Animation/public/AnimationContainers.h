@@ -3,20 +3,56 @@
 #pragma once
 
 #include <MathLibrary.h>
+#include <algorithm>
 #include <vector>
 
 namespace Animation
 {
-        struct FKeyFrame
+        // Returns the index of the keyframe that starts the [prev, prev + 1] pair containing time.
+        // cursor is the caller's cached result from the previous sample. Playing forward usually
+        // lands in the same or the next pair, otherwise fall back to a binary search.
+        inline int FindKeyFrame(const std::vector<double>& times, double time, int& cursor)
         {
-                double                 time;
-                std::vector<FTransform> joints;
-        };
+                int lastPair = (int)times.size() - 2;
+
+                if (lastPair <= 0)
+                {
+                        cursor = 0;
+                        return cursor;
+                }
+
+                cursor = std::min(std::max(cursor, 0), lastPair);
+
+                if (time >= times[cursor])
+                {
+                        if (time < times[cursor + 1] || cursor == lastPair)
+                                return cursor;
 
+                        if (cursor + 1 == lastPair || time < times[cursor + 2])
+                                return ++cursor;
+                }
+
+                auto it = std::upper_bound(times.begin(), times.end() - 1, time);
+                cursor  = std::min(std::max(int(it - times.begin()) - 1, 0), lastPair);
+                return cursor;
+        }
+
+        // Keyframes are stored as one contiguous time array plus one SoA array per channel.
+        // This is the raw import format, runtime sampling uses FCompressedAnimClip.
+        // Channel arrays are frame-major: the pose of frame f starts at f * jointCount.
         struct FAnimClip
         {
-                double                duration;
-                std::vector<FKeyFrame> frames;
+                double                         duration;
+                uint32_t                       jointCount = 0;
+                std::vector<double>            times;
+                std::vector<DirectX::XMVECTOR> translations;
+                std::vector<DirectX::XMVECTOR> rotations;
+                std::vector<DirectX::XMVECTOR> scales;
+
+                inline int GetFrameCount() const
+                {
+                        return (int)times.size();
+                }
         };
 
         struct FJoint
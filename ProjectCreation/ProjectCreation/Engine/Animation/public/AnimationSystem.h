@@ -6,9 +6,16 @@
 #include <WinProcTypes.h>
 
 #include "AnimationComponent.h"
+#include "AnimationCompression.h"
 #include "AnimationContainers.h"
 
 class ResourceManager;
+struct SkeletalMeshComponent;
+
+inline namespace JobScheduler
+{
+        struct JobInternal;
+}
 
 class AnimationSystem : public ISystem
 {
@@ -17,10 +24,17 @@ class AnimationSystem : public ISystem
         HandleManager*   m_HandleManager;
         ResourceManager* m_ResourceManager;
 
+        std::vector<FTransform> m_SampledPose;
+
+        JobInternal* m_SkinningPaletteJob = nullptr;
+
+        static void BuildSkinningPalette(SkeletalMeshComponent& meshComp);
+
         void calcTransforms(Animation::FJoint*          sumVec,
                             int                         jointCount,
                             double                      time,
-                            const Animation::FAnimClip& animClip,
+                            const Animation::FCompressedAnimClip& animClip,
+                            int&                        keyFrameCursor,
                             float                       prevweight,
                             float                       currweight);
 
@@ -34,4 +48,6 @@ class AnimationSystem : public ISystem
         virtual void OnSuspend() override;
 
     public:
+        // Blocks until the skinning palettes kicked in OnPostUpdate are ready to upload
+        void WaitForSkinningPalettes();
 };
@@ -102,13 +102,18 @@ void AudioManager::StopAllMusic()
         }
 }
 
-void AudioManager::ResetMusic()
+void AudioManager::PreloadMusic()
 {
-        StopAllMusic();
-
         LoadMusic("Ambience_andWaves", 0.6f);
         LoadMusic("EARTHQUAKE_SFX", 0.3f);
         LoadMusic("LEVEL_4_AMBIENCE", 0.6f);
+        LoadMusic("Ambience 16-48k", 1.0f);
+}
+
+void AudioManager::ResetMusic()
+{
+        StopAllMusic();
+        PreloadMusic();
 
         auto fmusic = LoadMusic("Ambience 16-48k", 1.0f);
         ActivateMusicAndPause(fmusic, true);
@@ -8,6 +8,8 @@
 #include "AudioManager.h"
 #include "SoundComponent.h"
 
+#include <sstream>
+
 void SpatialSoundSystem::OnPreUpdate(float deltaTime)
 {}
 
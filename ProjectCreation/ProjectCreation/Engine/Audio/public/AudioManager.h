@@ -61,6 +61,8 @@ class AudioManager
         void _shutdown();
 
         void StopAllMusic();
+        // Opens every music stream without playing it
+        void PreloadMusic();
         void ResetMusic();
 
     public:
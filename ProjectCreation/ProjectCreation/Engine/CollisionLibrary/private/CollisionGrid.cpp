@@ -57,10 +57,11 @@ int CollisionGrid::ComputeHashBucketIndex(Cell cellPos)
 
 using namespace Collision;
 
-std::vector<const CollisionGrid::CellContainer*> CollisionGrid::GetPossibleCollisions(Shapes::FCollisionShape* shape)
+NMemory::FrameVector<const CollisionGrid::CellContainer*> CollisionGrid::GetPossibleCollisions(
+    Shapes::FCollisionShape* shape)
 {
-        Shapes::ECollisionObjectTypes                    typeID = shape->GetID();
-        std::vector<const CollisionGrid::CellContainer*> output;
+        Shapes::ECollisionObjectTypes                             typeID = shape->GetID();
+        NMemory::FrameVector<const CollisionGrid::CellContainer*> output(9);
 
         Cell checkCell = GetCellFromShape(shape);
 
@@ -5,6 +5,7 @@
 #include <unordered_set>
 #include <vector>
 #include <ECSTypes.h>
+#include <FrameAllocator.h>
 #include <PairHash.h>
 #include <CollisionHelpers.h>
 #include <CollisionShapes.h>
@@ -34,8 +35,8 @@ class CollisionGrid
 
         static constexpr int CellSize = 5;
         CollisionGrid();
-        std::unordered_map<int, CellContainer> m_Container;
-        Cell                                   GetCellFromShape(const Shapes::FCollisionShape* shape);
-        int                                    ComputeHashBucketIndex(Cell cellPos);
-        std::vector<const CellContainer*>      GetPossibleCollisions(Shapes::FCollisionShape* shape);
+        std::unordered_map<int, CellContainer>     m_Container;
+        Cell                                       GetCellFromShape(const Shapes::FCollisionShape* shape);
+        int                                        ComputeHashBucketIndex(Cell cellPos);
+        NMemory::FrameVector<const CellContainer*> GetPossibleCollisions(Shapes::FCollisionShape* shape);
 };
@@ -93,7 +93,7 @@ void GCoreInput::GatherInput(HWND hWnd, UINT message, WPARAM wParam, LPARAM lPar
 
 void GCoreInput::UpdateInput()
 {
-        GEngine::Get()->m_MainThreadProfilingContext.Begin("Message Processing", "Input");
+        PROFILE_SCOPE("Message Processing", "Input");
         for (int i = 0; i < 256; i++)
         {
                 const uint8_t last = 1 & keyStates[i];
@@ -105,7 +105,6 @@ void GCoreInput::UpdateInput()
                 const uint8_t last = 1 & MouseStates[i];
                 MouseStates[i]     = (MouseStates[i] << 1) | last;
         }
-		GEngine::Get()->m_MainThreadProfilingContext.End();
 
         ResetAxes();
 }
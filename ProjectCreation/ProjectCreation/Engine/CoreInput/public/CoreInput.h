@@ -100,6 +100,18 @@ enum class KeyCode
         Num10,
         Plus  = 0x6B,
         Minus = 0x6D,
+        F1    = 0x70,
+        F2,
+        F3,
+        F4,
+        F5,
+        F6,
+        F7,
+        F8,
+        F9,
+        F10,
+        F11,
+        F12,
         Left  = 0x25,
         Up,
         Right,
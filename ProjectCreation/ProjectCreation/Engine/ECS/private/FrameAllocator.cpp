@@ -0,0 +1,127 @@
+#include <FrameAllocator.h>
+#include <MemoryTracking.h>
+#include <malloc.h>
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+namespace NMemory
+{
+        namespace FrameAllocator
+        {
+                namespace
+                {
+                        struct FThreadArena
+                        {
+                                MemoryStack        buffers[2];
+                                std::vector<void*> overflow[2];
+                                unsigned int       allocationCount     = 0;
+                                unsigned int       overflowAllocations = 0;
+                        };
+
+                        memsize                   g_BytesPerThread = 0;
+                        unsigned int              g_BufferIndex    = 0;
+                        std::atomic<unsigned int> g_ThreadCount{0};
+                        FThreadArena              g_Arenas[kMaxThreads];
+                        FFrameAllocatorStats      g_Stats;
+                        thread_local int          t_ArenaIndex = -1;
+
+                        FThreadArena& GetThreadArena()
+                        {
+                                if (t_ArenaIndex < 0)
+                                {
+                                        unsigned int index = g_ThreadCount.fetch_add(1);
+                                        assert(index < kMaxThreads);
+                                        FThreadArena& arena = g_Arenas[index];
+                                        ReserveGameMemory(arena.buffers[0], g_BytesPerThread, E_MEMORY_TAG::FRAME_ARENA);
+                                        ReserveGameMemory(arena.buffers[1], g_BytesPerThread, E_MEMORY_TAG::FRAME_ARENA);
+                                        t_ArenaIndex = (int)index;
+                                }
+                                return g_Arenas[t_ArenaIndex];
+                        }
+
+                        void ResetBuffer(FThreadArena& arena, unsigned int bufferIndex)
+                        {
+                                arena.buffers[bufferIndex].m_MemCurr = arena.buffers[bufferIndex].m_MemStart;
+                                for (void* memory : arena.overflow[bufferIndex])
+                                        _aligned_free(memory);
+                                arena.overflow[bufferIndex].clear();
+                        }
+                } // namespace
+
+                void Initialize(memsize bytesPerThread)
+                {
+                        assert(g_BytesPerThread == 0);
+                        g_BytesPerThread = bytesPerThread;
+                        g_BufferIndex    = 0;
+                        g_Stats          = FFrameAllocatorStats();
+                        MemoryTracking::SetBudget(E_MEMORY_TAG::FRAME_ARENA, bytesPerThread * 2 * kMaxThreads);
+                }
+
+                void Shutdown()
+                {
+                        for (unsigned int i = 0; i < g_ThreadCount; ++i)
+                        {
+                                for (unsigned int bufferIndex = 0; bufferIndex < 2; ++bufferIndex)
+                                {
+                                        ResetBuffer(g_Arenas[i], bufferIndex);
+                                        FreeGameMemory(g_Arenas[i].buffers[bufferIndex]);
+                                        g_Arenas[i].buffers[bufferIndex] = MemoryStack();
+                                }
+                        }
+                        g_BytesPerThread = 0;
+                }
+
+                void EndFrame()
+                {
+                        FFrameAllocatorStats stats;
+                        stats.threadCount = g_ThreadCount;
+                        for (unsigned int i = 0; i < stats.threadCount; ++i)
+                        {
+                                FThreadArena&      arena  = g_Arenas[i];
+                                const MemoryStack& buffer = arena.buffers[g_BufferIndex];
+                                stats.usedBytes += buffer.m_MemCurr - buffer.m_MemStart;
+                                stats.allocationCount += arena.allocationCount;
+                                stats.overflowAllocations += arena.overflowAllocations;
+                                arena.allocationCount     = 0;
+                                arena.overflowAllocations = 0;
+                        }
+                        stats.peakBytes = std::max<memsize>(g_Stats.peakBytes, stats.usedBytes);
+                        g_Stats         = stats;
+
+                        // The buffer being switched to holds the previous frame's allocations
+                        g_BufferIndex ^= 1;
+                        for (unsigned int i = 0; i < stats.threadCount; ++i)
+                                ResetBuffer(g_Arenas[i], g_BufferIndex);
+                }
+
+                void* Allocate(memsize size, memsize alignment)
+                {
+                        assert(g_BytesPerThread > 0);
+                        assert((alignment & (alignment - 1)) == 0);
+
+                        FThreadArena& arena  = GetThreadArena();
+                        MemoryStack&  buffer = arena.buffers[g_BufferIndex];
+                        arena.allocationCount++;
+
+                        uintptr_t address = ((uintptr_t)buffer.m_MemCurr + alignment - 1) & ~(uintptr_t)(alignment - 1);
+                        if (address + size <= (uintptr_t)buffer.m_MemMax)
+                        {
+                                buffer.m_MemCurr = reinterpret_cast<byte*>(address + size);
+                                return reinterpret_cast<void*>(address);
+                        }
+
+                        arena.overflowAllocations++;
+                        void* memory = _aligned_malloc(size, alignment);
+                        assert(memory);
+                        arena.overflow[g_BufferIndex].push_back(memory);
+                        return memory;
+                }
+
+                const FFrameAllocatorStats& GetStats()
+                {
+                        return g_Stats;
+                }
+        } // namespace FrameAllocator
+} // namespace NMemory
\ No newline at end of file
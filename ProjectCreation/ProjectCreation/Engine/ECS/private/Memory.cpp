@@ -4,10 +4,11 @@
 #include <assert.h>
 #include <malloc.h>
 #include <MemoryLeakDetection.h>
+#include <MemoryTracking.h>
 
 namespace NMemory
 {
-        void ReserveGameMemory(MemoryStack& poolMemory, memsize allocSize)
+        void ReserveGameMemory(MemoryStack& poolMemory, memsize allocSize, int tag)
         {
                 // LPVOID ptr = VirtualAlloc(0, allocSize, MEM_RESERVE, PAGE_READWRITE);
                 // ptr        = VirtualAlloc(ptr, allocSize, MEM_COMMIT, PAGE_READWRITE);
@@ -15,6 +16,8 @@ namespace NMemory
                 poolMemory.m_MemStart = reinterpret_cast<byte*>(malloc(allocSize));
                 poolMemory.m_MemCurr  = poolMemory.m_MemStart;
                 poolMemory.m_MemMax   = poolMemory.m_MemStart + allocSize;
+                poolMemory.m_Tag      = tag;
+                MemoryTracking::TrackAllocation(tag, allocSize);
         }
         void FreeGameMemory(MemoryStack& poolMemory)
         {
@@ -26,6 +29,7 @@ namespace NMemory
                 //        assert(false);
                 //}
                 // free(GameMemory_Singleton::GameMemory_Start);
+                MemoryTracking::TrackFree(poolMemory.m_Tag, poolMemory.m_MemMax - poolMemory.m_MemStart);
                 free(poolMemory.m_MemStart);
         }
 }; // namespace NMemory
\ No newline at end of file
@@ -0,0 +1,240 @@
+#include <MemoryTracking.h>
+#include <assert.h>
+#include <crtdbg.h>
+#include <stdlib.h>
+#include <atomic>
+#include <fstream>
+#include <new>
+
+namespace NMemory
+{
+        namespace MemoryTracking
+        {
+                namespace
+                {
+                        // Zero initialized before any dynamic initialization, operator new may run before main
+                        struct FTagCounters
+                        {
+                                std::atomic<int64_t>  liveBytes;
+                                std::atomic<int64_t>  peakBytes;
+                                std::atomic<int64_t>  staticBytes;
+                                std::atomic<uint64_t> allocationCount;
+                                std::atomic<uint64_t> freeCount;
+                                std::atomic<memsize>  budget;
+                        };
+
+                        FTagCounters     g_Counters[E_MEMORY_TAG::COUNT];
+                        thread_local int t_CurrentTag = E_MEMORY_TAG::UNTAGGED;
+
+                        const char* const g_TagNames[E_MEMORY_TAG::COUNT] = {
+                            "Untagged", "ECSPools", "FrameArena", "Resources", "DebugRenderer", "Terrain", "Particles"};
+
+                        // Budgets of tags whose owner does not set one, sized from the arrays they allocate
+                        const memsize g_DefaultBudgets[E_MEMORY_TAG::COUNT] = {
+                            0,       // UNTAGGED
+                            0,       // ECS_POOLS, set by GEngine from its pool size
+                            0,       // FRAME_ARENA, set by FrameAllocator::Initialize
+                            MB(256), // RESOURCES
+                            MB(8),   // DEBUG_RENDERER, 4 MB of line vertices
+                            MB(8),   // TERRAIN, instance transforms and instance data
+                            MB(160), // PARTICLES, CPU simulation streams, upload staging and sort buffers
+                        };
+
+                        inline FTagCounters& GetCounters(int tag)
+                        {
+                                assert(tag >= 0 && tag < E_MEMORY_TAG::COUNT);
+                                return g_Counters[tag];
+                        }
+
+                        inline memsize GetBudget(int tag)
+                        {
+                                memsize budget = g_Counters[tag].budget.load(std::memory_order_relaxed);
+                                return budget ? budget : g_DefaultBudgets[tag];
+                        }
+
+                        void AddLiveBytes(int tag, memsize bytes)
+                        {
+                                FTagCounters& counters = GetCounters(tag);
+                                int64_t       live     = counters.liveBytes.fetch_add((int64_t)bytes) + (int64_t)bytes;
+                                int64_t       peak     = counters.peakBytes.load(std::memory_order_relaxed);
+                                while (live > peak && !counters.peakBytes.compare_exchange_weak(peak, live))
+                                {}
+
+                                memsize budget = GetBudget(tag);
+                                assert((budget == 0 || live <= (int64_t)budget) && "Memory budget exceeded");
+                        }
+                } // namespace
+
+                void TrackAllocation(int tag, memsize bytes)
+                {
+                        GetCounters(tag).allocationCount.fetch_add(1, std::memory_order_relaxed);
+                        AddLiveBytes(tag, bytes);
+                }
+
+                void TrackFree(int tag, memsize bytes)
+                {
+                        FTagCounters& counters = GetCounters(tag);
+                        counters.freeCount.fetch_add(1, std::memory_order_relaxed);
+                        counters.liveBytes.fetch_sub((int64_t)bytes);
+                }
+
+                void TrackStatic(int tag, memsize bytes)
+                {
+                        GetCounters(tag).staticBytes.fetch_add((int64_t)bytes, std::memory_order_relaxed);
+                        AddLiveBytes(tag, bytes);
+                }
+
+                void SetBudget(int tag, memsize bytes)
+                {
+                        GetCounters(tag).budget.store(bytes);
+                }
+
+                FMemoryTagStats GetTagStats(int tag)
+                {
+                        FTagCounters&   counters = GetCounters(tag);
+                        FMemoryTagStats output;
+                        output.liveBytes       = counters.liveBytes;
+                        output.peakBytes       = counters.peakBytes;
+                        output.staticBytes     = counters.staticBytes;
+                        output.allocationCount = counters.allocationCount;
+                        output.freeCount       = counters.freeCount;
+                        output.budget          = GetBudget(tag);
+                        return output;
+                }
+
+                const char* GetTagName(int tag)
+                {
+                        assert(tag >= 0 && tag < E_MEMORY_TAG::COUNT);
+                        return g_TagNames[tag];
+                }
+
+                int SetCurrentTag(int tag)
+                {
+                        assert(tag >= 0 && tag < E_MEMORY_TAG::COUNT);
+                        int previous = t_CurrentTag;
+                        t_CurrentTag = tag;
+                        return previous;
+                }
+
+                int GetCurrentTag()
+                {
+                        return t_CurrentTag;
+                }
+
+                void WriteReport(const char* fileName)
+                {
+                        FMemoryTagStats stats[E_MEMORY_TAG::COUNT];
+                        for (int tag = 0; tag < E_MEMORY_TAG::COUNT; ++tag)
+                                stats[tag] = GetTagStats(tag);
+
+                        std::fstream fs(fileName, std::ios::out);
+                        fs << "[";
+                        for (int tag = 0; tag < E_MEMORY_TAG::COUNT; ++tag)
+                        {
+                                fs << (tag ? "," : "") << "\n{ \"tag\":\"" << g_TagNames[tag]
+                                   << "\",\"liveBytes\":" << stats[tag].liveBytes
+                                   << ",\"peakBytes\":" << stats[tag].peakBytes
+                                   << ",\"staticBytes\":" << stats[tag].staticBytes
+                                   << ",\"allocations\":" << stats[tag].allocationCount
+                                   << ",\"frees\":" << stats[tag].freeCount << ",\"budget\":" << stats[tag].budget
+                                   << "}";
+                        }
+                        fs << "\n]";
+                        fs.close();
+                }
+        } // namespace MemoryTracking
+} // namespace NMemory
+
+#ifdef MEMORY_TRACKING
+namespace
+{
+        constexpr uint32_t kHeaderMagic = 0x544D454D;
+
+        // Keeps the 16 byte alignment of the block returned by malloc
+        struct alignas(16) FAllocationHeader
+        {
+                uint64_t size;
+                uint32_t tag;
+                uint32_t magic;
+        };
+
+        void* TrackedAllocate(size_t size, int blockUse, const char* fileName, int line)
+        {
+                FAllocationHeader* header =
+                    static_cast<FAllocationHeader*>(_malloc_dbg(sizeof(FAllocationHeader) + size, blockUse, fileName, line));
+                if (header == nullptr)
+                        throw std::bad_alloc();
+
+                header->size  = size;
+                header->tag   = (uint32_t)NMemory::MemoryTracking::GetCurrentTag();
+                header->magic = kHeaderMagic;
+                NMemory::MemoryTracking::TrackAllocation(header->tag, size);
+                return header + 1;
+        }
+
+        void TrackedFree(void* memory)
+        {
+                if (memory == nullptr)
+                        return;
+
+                FAllocationHeader* header = static_cast<FAllocationHeader*>(memory) - 1;
+                assert(header->magic == kHeaderMagic && "Freed memory was not allocated by the tracked operator new");
+                header->magic = 0;
+                NMemory::MemoryTracking::TrackFree(header->tag, header->size);
+                _free_dbg(header, _UNKNOWN_BLOCK);
+        }
+} // namespace
+
+void* operator new(size_t size)
+{
+        return TrackedAllocate(size, _NORMAL_BLOCK, nullptr, 0);
+}
+
+void* operator new[](size_t size)
+{
+        return TrackedAllocate(size, _NORMAL_BLOCK, nullptr, 0);
+}
+
+void operator delete(void* memory) noexcept
+{
+        TrackedFree(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+        TrackedFree(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+        TrackedFree(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept
+{
+        TrackedFree(memory);
+}
+
+#ifdef _DEBUG
+// Used by the new macro in MemoryLeakDetection.h, keeps the file and line in the CRT leak report
+void* operator new(size_t size, int blockUse, const char* fileName, int line)
+{
+        return TrackedAllocate(size, blockUse, fileName, line);
+}
+
+void* operator new[](size_t size, int blockUse, const char* fileName, int line)
+{
+        return TrackedAllocate(size, blockUse, fileName, line);
+}
+
+void operator delete(void* memory, int, const char*, int) noexcept
+{
+        TrackedFree(memory);
+}
+
+void operator delete[](void* memory, int, const char*, int) noexcept
+{
+        TrackedFree(memory);
+}
+#endif
+#endif
\ No newline at end of file
@@ -1,19 +1,21 @@
 #include <SystemManager.h>
+#include <Counters.h>
 #include <GEngine.h>
 #include <Profiling.h>
+#include <algorithm>
 void SystemManager::Update(float deltaTime)
 {
-        auto queue = GetSystemQueue();
-        while (!queue.empty())
+        for (ISystem* system : GetSystemQueue())
         {
-                ISystem* system = queue.top();
-                GEngine::Get()->m_MainThreadProfilingContext.Begin("Systems", system->m_SystemName);
+                PROFILE_SCOPE("Systems", system->m_SystemName.c_str());
+#ifdef COUNTERS
+                if (system->m_CounterId == UINT_MAX)
+                        system->m_CounterId = Counters::Register("Systems/" + system->m_SystemName + " us");
+                Counters::FScopeTimer counterTimer(system->m_CounterId);
+#endif
                 system->OnPreUpdate(deltaTime);
                 system->OnUpdate(deltaTime);
                 system->OnPostUpdate(deltaTime);
-                queue.pop();
-                GEngine::Get()->m_MainThreadProfilingContext.End();
-
         }
 }
 
@@ -52,9 +54,18 @@ void SystemManager::FilterSystemQueue(int flags)
         m_CurrentSystemQueue = &m_FilteredSystemsQueue;
 }
 
-SystemQueue SystemManager::GetSystemQueue()
+NMemory::FrameSpan<ISystem*> SystemManager::GetSystemQueue()
 {
-        return *m_CurrentSystemQueue;
+        const auto&                    heap = m_CurrentSystemQueue->GetContainer();
+        NMemory::FrameVector<ISystem*> order(heap.begin(), heap.end());
+
+        // Popping the heap in place leaves the systems in reverse pop order, which keeps the order of systems with
+        // equal priority the same as popping the queue
+        for (auto end = order.end(); end - order.begin() > 1; --end)
+                std::pop_heap(order.begin(), end, PriorityComparator());
+        std::reverse(order.begin(), order.end());
+
+        return order.Span();
 }
 
 void SystemManager::Initialize()
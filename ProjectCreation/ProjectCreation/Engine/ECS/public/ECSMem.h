@@ -28,10 +28,11 @@ namespace NMemory
                 byte* m_MemStart = 0;
                 byte* m_MemCurr  = 0;
                 byte* m_MemMax   = 0;
+                int   m_Tag      = 0;
         };
 
 
-        // Allocates memory on the system level
-        void ReserveGameMemory(MemoryStack& poolMemory, memsize allocSize);
+        // Allocates memory on the system level, charged to the E_MEMORY_TAG given
+        void ReserveGameMemory(MemoryStack& poolMemory, memsize allocSize, int tag);
         void FreeGameMemory(MemoryStack& poolMemory);
 } // namespace NMemory
@@ -1,5 +1,6 @@
 #pragma once
 #include <ECSMem.h>
+#include <FrameAllocator.h>
 struct HandleManager;
 struct ComponentHandle;
 struct Entity;
@@ -26,7 +27,7 @@ struct EntityHandle
         bool operator==(const EntityHandle& other) const;
 
         template <typename T>
-        std::vector<ComponentHandle> GetComponents();
+        NMemory::FrameVector<ComponentHandle> GetComponents();
 
         void FreeComponents();
 
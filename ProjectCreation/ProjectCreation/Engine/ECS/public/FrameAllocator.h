@@ -0,0 +1,218 @@
+#pragma once
+#include <assert.h>
+#include <string.h>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include "ECSMem.h"
+
+namespace NMemory
+{
+        struct FFrameAllocatorStats
+        {
+                memsize      usedBytes           = 0;
+                memsize      peakBytes           = 0;
+                unsigned int allocationCount     = 0;
+                unsigned int overflowAllocations = 0;
+                unsigned int threadCount         = 0;
+        };
+
+        // Linear allocator for data that lives for one frame.
+        // Every thread allocates from its own sub-arena, created the first time the thread allocates. Each sub-arena is
+        // double buffered so memory allocated during a frame stays valid until the end of the following frame.
+        // Allocations that do not fit fall back to malloc and are freed when their buffer is reset.
+        namespace FrameAllocator
+        {
+                static constexpr unsigned int kMaxThreads = 64;
+
+                void Initialize(memsize bytesPerThread);
+                void Shutdown();
+
+                // Flips every sub-arena to its other buffer and resets it. Must be called from the main thread while no
+                // job is allocating frame memory.
+                void EndFrame();
+
+                void* Allocate(memsize size, memsize alignment);
+
+                template <typename T>
+                inline T* Allocate(size_t count)
+                {
+                        return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+                }
+
+                // Totals of the last completed frame
+                const FFrameAllocatorStats& GetStats();
+        } // namespace FrameAllocator
+
+        template <typename T>
+        class FrameSpan
+        {
+                T*     m_Data = nullptr;
+                size_t m_Size = 0;
+
+            public:
+                FrameSpan() = default;
+                FrameSpan(T* data, size_t size) : m_Data(data), m_Size(size)
+                {}
+
+                inline T* begin() const
+                {
+                        return m_Data;
+                }
+                inline T* end() const
+                {
+                        return m_Data + m_Size;
+                }
+                inline T* data() const
+                {
+                        return m_Data;
+                }
+                inline size_t size() const
+                {
+                        return m_Size;
+                }
+                inline bool empty() const
+                {
+                        return m_Size == 0;
+                }
+                inline T& operator[](size_t index) const
+                {
+                        assert(index < m_Size);
+                        return m_Data[index];
+                }
+        };
+
+        // Vector backed by frame memory. Growing abandons the old storage until the frame's buffer is reset, reserve
+        // up front when the element count is known. Destructors are never run so T must be trivially destructible.
+        template <typename T>
+        class FrameVector
+        {
+                static_assert(std::is_trivially_destructible<T>::value,
+                              "Error. Frame memory is released without running destructors");
+
+                T*     m_Data     = nullptr;
+                size_t m_Size     = 0;
+                size_t m_Capacity = 0;
+
+            public:
+                FrameVector() = default;
+                explicit FrameVector(size_t capacity)
+                {
+                        reserve(capacity);
+                }
+                template <typename Iterator>
+                FrameVector(Iterator first, Iterator last)
+                {
+                        reserve((size_t)std::distance(first, last));
+                        for (; first != last; ++first)
+                                emplace_back(*first);
+                }
+                FrameVector(const FrameVector&) = delete;
+                FrameVector& operator=(const FrameVector&) = delete;
+                FrameVector(FrameVector&& other) : m_Data(other.m_Data), m_Size(other.m_Size), m_Capacity(other.m_Capacity)
+                {
+                        other.m_Data     = nullptr;
+                        other.m_Size     = 0;
+                        other.m_Capacity = 0;
+                }
+                FrameVector& operator=(FrameVector&& other)
+                {
+                        std::swap(m_Data, other.m_Data);
+                        std::swap(m_Size, other.m_Size);
+                        std::swap(m_Capacity, other.m_Capacity);
+                        return *this;
+                }
+
+                void reserve(size_t capacity)
+                {
+                        if (capacity <= m_Capacity)
+                                return;
+
+                        T* data = FrameAllocator::Allocate<T>(capacity);
+                        for (size_t i = 0; i < m_Size; ++i)
+                        {
+#pragma push_macro("new")
+#undef new
+                                new (data + i) T(std::move(m_Data[i]));
+#pragma pop_macro("new")
+                        }
+                        m_Data     = data;
+                        m_Capacity = capacity;
+                }
+
+                template <typename... Args>
+                inline T& emplace_back(Args&&... args)
+                {
+                        if (m_Size == m_Capacity)
+                                reserve(m_Capacity < 8 ? 8 : m_Capacity * 2);
+#pragma push_macro("new")
+#undef new
+                        T* element = new (m_Data + m_Size) T(std::forward<Args>(args)...);
+#pragma pop_macro("new")
+                        ++m_Size;
+                        return *element;
+                }
+                inline void push_back(const T& value)
+                {
+                        emplace_back(value);
+                }
+
+                // Keeps the storage, which is only valid for the frame it was allocated in
+                inline void clear()
+                {
+                        m_Size = 0;
+                }
+
+                inline T* begin()
+                {
+                        return m_Data;
+                }
+                inline T* end()
+                {
+                        return m_Data + m_Size;
+                }
+                inline const T* begin() const
+                {
+                        return m_Data;
+                }
+                inline const T* end() const
+                {
+                        return m_Data + m_Size;
+                }
+                inline T* data()
+                {
+                        return m_Data;
+                }
+                inline size_t size() const
+                {
+                        return m_Size;
+                }
+                inline size_t capacity() const
+                {
+                        return m_Capacity;
+                }
+                inline bool empty() const
+                {
+                        return m_Size == 0;
+                }
+                inline T& back()
+                {
+                        assert(m_Size > 0);
+                        return m_Data[m_Size - 1];
+                }
+                inline T& operator[](size_t index)
+                {
+                        assert(index < m_Size);
+                        return m_Data[index];
+                }
+                inline const T& operator[](size_t index) const
+                {
+                        assert(index < m_Size);
+                        return m_Data[index];
+                }
+                inline FrameSpan<T> Span()
+                {
+                        return FrameSpan<T>(m_Data, m_Size);
+                }
+        };
+} // namespace NMemory
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include <ECSPools.h>
+#include <FrameAllocator.h>
 #include <Range.h>
 #include <SpookyHashV2.h>
 #include <TypeIndexFactory.h>
@@ -166,15 +167,15 @@ inline ComponentHandle HandleManager::AddComponent(EntityHandle parentHandle)
 }
 
 template <typename T>
-inline std::vector<ComponentHandle> EntityHandle::GetComponents()
+inline NMemory::FrameVector<ComponentHandle> EntityHandle::GetComponents()
 {
         NMemory::type_index _type_index = T::SGetTypeIndex();
         // size_t              element_count = this->Get()->m_OwnedComponents.count(_type_index);
-        std::vector<ComponentHandle> out;
-        auto                         chs = this->Get()->m_OwnedComponents;
+        NMemory::FrameVector<ComponentHandle> out;
+        const auto&                           chs = this->Get()->m_OwnedComponents;
         for (auto e : chs)
         {
-                if (chs.pool_index == _type_index)
+                if (e.pool_index == _type_index)
                         out.push_back(e);
         }
 
@@ -193,7 +194,7 @@ inline ComponentHandle EntityHandle::GetComponentHandle()
         //    this->Get()->m_OwnedComponents.find(_type_index);
 
         // return ComponentHandle(itr->first, itr->second);
-        auto chs = this->Get()->m_OwnedComponents;
+        const auto& chs = this->Get()->m_OwnedComponents;
         for (auto e : chs)
         {
                 if (e.pool_index == _type_index)
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <limits.h>
 #include <stdint.h>
 #include <type_traits>
 #include "ECSTypes.h"
@@ -36,6 +37,8 @@ class ISystem
 
     private:
         FSystemProperties m_Properties;
+        // Update time counter, registered on the first update once the name is set
+        unsigned m_CounterId = UINT_MAX;
     protected:
         virtual void OnPreUpdate(float deltaTime)  = 0;
         virtual void OnUpdate(float deltaTime)     = 0;
@@ -2,13 +2,17 @@
 
 #define WIN_32_LEAN_AND_MEAN
 #include <Windows.h>
+#include <algorithm>
 #include <atomic>
 #include <random>
 #include <thread>
 #include <tuple>
+#include <typeinfo>
 #undef GetJob
 
 #include <BitwiseUtility.h>
+#include <FrameAllocator.h>
+#include <Profiling.h>
 #include <Range.h>
 
 inline namespace JobSchedulerInternalUtility
@@ -211,6 +215,11 @@ inline namespace JobScheduler
                                 return nullptr;
                         }
                 }
+                // Only meaningful to the owning thread, thieves can empty the queue at any time
+                bool IsEmpty() volatile
+                {
+                        return m_bottom <= m_top;
+                }
                 JobInternal* Steal(void) volatile
                 {
                         int64_t t = m_top;
@@ -250,6 +259,47 @@ inline namespace JobSchedulerGlobals
         inline thread_local JobAllocator<MAX_JOBS_PER_FRAME> g_thread_local_job_allocator_static;
 
         alignas(8) volatile inline JobQueue<MAX_JOBS_PER_FRAME>* volatile g_job_queues;
+
+        // Written by the owning thread only, one cache line per thread. Ticks are Profiler::Ticks and only counted
+        // when profiling is compiled in
+        struct alignas(CACHE_LINE_SIZE) JobThreadTelemetry
+        {
+                volatile uint64_t pushes;
+                volatile uint64_t pops;
+                volatile uint64_t steals;
+                volatile uint64_t failed_steals;
+                volatile uint64_t executed;
+                // A job waiting on other jobs executes them, their time is counted by both
+                volatile uint64_t execute_ticks;
+                // Time spent looking for a job without finding one
+                volatile uint64_t idle_ticks;
+        };
+        inline JobThreadTelemetry* g_job_thread_telemetry;
+        inline char                g_job_thread_names[64][16];
+
+        // Grain durations of one ParallelFor call site, bucket i counts grains taking [2^i, 2^(i+1)) ticks
+        struct ChunkHistogram
+        {
+                static constexpr unsigned BUCKET_COUNT = 48;
+
+                const char*        name = nullptr;
+                volatile long      buckets[BUCKET_COUNT];
+                volatile long long total_ticks;
+                volatile long      count;
+                bool               registered = false;
+        };
+        inline ChunkHistogram* g_chunk_histograms[256];
+        inline unsigned        g_chunk_histogram_count = 0;
+
+        // Measured cost of one iteration of a ParallelFor call site, a moving average in sixteenths of a tick. Threads
+        // update it with relaxed loads and stores, concurrent updates only ever lose a sample
+        struct GrainEstimate
+        {
+                std::atomic<uint64_t> ticks_per_item_x16{0};
+        };
+        // Adaptive grains are sized to run for about this long between two split checks
+        inline constexpr unsigned    GRAIN_TARGET_MICROSECONDS = 10;
+        inline std::atomic<uint64_t> g_grain_target_ticks{0};
 } // namespace JobSchedulerGlobals
 inline namespace JobSchedulerInternal
 {
@@ -257,10 +307,15 @@ inline namespace JobSchedulerInternal
         {
                 return g_job_queues[reinterpret_cast<unsigned long long>(TlsGetValue(g_tls_access_value))];
         }
+        inline JobThreadTelemetry& GetWorkerThreadTelemetry()
+        {
+                return g_job_thread_telemetry[reinterpret_cast<unsigned long long>(TlsGetValue(g_tls_access_value))];
+        }
         inline void Run(JobInternal* job)
         {
                 auto& queue = GetWorkerThreadQueue();
                 queue.Push(job);
+                GetWorkerThreadTelemetry().pushes++;
         }
         inline JobInternal* AllocateJob()
         {
@@ -297,8 +352,16 @@ inline namespace JobSchedulerInternal
         }
         inline void Execute(JobInternal* job)
         {
+                auto& telemetry = GetWorkerThreadTelemetry();
+#ifdef PROFILING
+                uint64_t start = Profiler::Ticks();
                 job->function(job);
+                telemetry.execute_ticks += Profiler::Ticks() - start;
+#else
+                job->function(job);
+#endif
                 Finish(job);
+                telemetry.executed++;
         }
         inline JobInternal* GetJob()
         {
@@ -312,6 +375,7 @@ inline namespace JobSchedulerInternal
                         if (&stealQueue == &queue)
                         {
                                 // don't try to steal from ourselves
+                                GetWorkerThreadTelemetry().failed_steals++;
                                 Sleep(0);
                                 return nullptr;
                         }
@@ -321,19 +385,143 @@ inline namespace JobSchedulerInternal
                         {
                                 // we couldn't steal a job from the other queue either, so we just yield our time slice
                                 // for now
+                                GetWorkerThreadTelemetry().failed_steals++;
                                 Sleep(0);
                                 return nullptr;
                         }
 
+                        GetWorkerThreadTelemetry().steals++;
                         return stolenJob;
                 }
+                GetWorkerThreadTelemetry().pops++;
                 return job;
         }
+        // Looks for a job, the time until one is found is counted as idle
+        inline JobInternal* GetJobTimed()
+        {
+#ifdef PROFILING
+                uint64_t     start = Profiler::Ticks();
+                JobInternal* job   = GetJob();
+                if (!job)
+                        GetWorkerThreadTelemetry().idle_ticks += Profiler::Ticks() - start;
+                return job;
+#else
+                return GetJob();
+#endif
+        }
+        inline void RecordChunk(ChunkHistogram& histogram, uint64_t ticks)
+        {
+                unsigned long bucket = 0;
+                if (ticks)
+                        _BitScanReverse64(&bucket, ticks);
+                if (bucket >= ChunkHistogram::BUCKET_COUNT)
+                        bucket = ChunkHistogram::BUCKET_COUNT - 1;
+
+                InterlockedIncrement(&histogram.buckets[bucket]);
+                InterlockedAdd64(&histogram.total_ticks, (long long)ticks);
+                InterlockedIncrement(&histogram.count);
+        }
+        // Call sites are only registered on the main thread, where every ParallelFor is created
+        inline void RegisterChunkHistogram(ChunkHistogram& histogram, const char* name)
+        {
+                if (histogram.registered || g_chunk_histogram_count == std::size(g_chunk_histograms))
+                        return;
+
+                histogram.name       = name;
+                histogram.registered = true;
+                g_chunk_histograms[g_chunk_histogram_count++] = &histogram;
+        }
+        // Iterations of a ParallelFor job, stored in the job right after its lambda
+        struct ParallelForRange
+        {
+                unsigned begin;
+                unsigned end;
+                // Iterations run between two split checks, 0 sizes it from the call site's measured cost
+                unsigned grain;
+        };
+        // Called on the main thread as ParallelFors are dispatched, the tick rate is only known after a while
+        inline void UpdateGrainTarget()
+        {
+                double ticksPerMicrosecond = Profiler::GetTicksPerMicrosecond();
+                g_grain_target_ticks.store(static_cast<uint64_t>(ticksPerMicrosecond * GRAIN_TARGET_MICROSECONDS),
+                                           std::memory_order_relaxed);
+        }
+        inline unsigned GetGrainSize(const GrainEstimate& estimate, unsigned fixedGrain)
+        {
+                if (fixedGrain)
+                        return fixedGrain;
+
+                // Nothing measured yet, the first grain is a single iteration
+                uint64_t ticksPerItemX16 = estimate.ticks_per_item_x16.load(std::memory_order_relaxed);
+                if (!ticksPerItemX16)
+                        return 1;
+
+                uint64_t grain = g_grain_target_ticks.load(std::memory_order_relaxed) * 16 / ticksPerItemX16;
+                return grain ? static_cast<unsigned>(std::min<uint64_t>(grain, UINT_MAX)) : 1;
+        }
+        inline void UpdateGrainEstimate(GrainEstimate& estimate, uint64_t ticks, unsigned items)
+        {
+                uint64_t sample  = ticks * 16 / items;
+                uint64_t current = estimate.ticks_per_item_x16.load(std::memory_order_relaxed);
+                estimate.ticks_per_item_x16.store(current ? current - current / 8 + sample / 8 : sample,
+                                                  std::memory_order_relaxed);
+        }
+        // Lazy binary splitting. The job runs its range a grain at a time, and whenever the thread's own queue has run
+        // dry the upper half of what is left is split off into a new job for an idle thread to steal. Ranges are only
+        // split as far as there are thieves, so the job count no longer grows with the range.
+        template <typename Lambda, typename ArgsTuple, typename RangeFunction>
+        inline void ExecuteParallelForRange(JobInternal*    job,
+                                            GrainEstimate&  estimate,
+                                            ChunkHistogram& histogram,
+                                            RangeFunction   rangeFunction)
+        {
+                constexpr size_t RANGE_OFFSET = sizeof(Lambda);
+                constexpr size_t ARGS_OFFSET  = sizeof(Lambda) + sizeof(ParallelForRange);
+
+                char*             bufferAlias = job->padding;
+                Lambda&           lambda      = *reinterpret_cast<Lambda*>(bufferAlias);
+                ParallelForRange& range       = *reinterpret_cast<ParallelForRange*>(bufferAlias + RANGE_OFFSET);
+                ArgsTuple&        args        = *reinterpret_cast<ArgsTuple*>(bufferAlias + ARGS_OFFSET);
+
+                auto&    queue = GetWorkerThreadQueue();
+                unsigned begin = range.begin;
+                unsigned end   = range.end;
+                while (begin < end)
+                {
+                        unsigned grain = GetGrainSize(estimate, range.grain);
+                        if (end - begin > grain && queue.IsEmpty())
+                        {
+                                unsigned middle = begin + (end - begin) / 2;
+
+                                JobInternal* splitJob   = CreateJobAsChild(job->parent, job->function);
+                                char*        splitAlias = splitJob->padding;
+                                InPlaceForwardConstruct(splitAlias, Lambda(lambda));
+                                ParallelForRange splitRange = {middle, end, range.grain};
+                                InPlaceForwardConstruct(splitAlias + RANGE_OFFSET, std::move(splitRange));
+                                InPlaceForwardConstruct(splitAlias + ARGS_OFFSET, ArgsTuple(args));
+                                Run(splitJob);
+
+                                end = middle;
+                                continue;
+                        }
+
+                        unsigned grainEnd = begin + std::min(grain, end - begin);
+                        uint64_t start    = Profiler::Ticks();
+                        rangeFunction(lambda, args, begin, grainEnd);
+                        uint64_t ticks = Profiler::Ticks() - start;
+
+                        UpdateGrainEstimate(estimate, ticks, grainEnd - begin);
+#ifdef PROFILING
+                        RecordChunk(histogram, ticks);
+#endif
+                        begin = grainEnd;
+                }
+        }
         inline void Wait(JobInternal* job)
         {
                 while (!HasJobCompleted(job))
                 {
-                        JobInternal* nextJob = GetJob();
+                        JobInternal* nextJob = GetJobTimed();
                         if (nextJob)
                         {
                                 Execute(nextJob);
@@ -344,14 +532,22 @@ inline namespace JobSchedulerInternal
         inline void WorkerThreadMain(uint64_t index)
         {
                 TlsSetValue(g_tls_access_value, (LPVOID)index);
+
+                Profiler::SetThreadName(g_job_thread_names[index]);
+
+                // ParallelFor jobs split themselves on whichever thread runs them
+                g_thread_local_job_allocator_temp.Initialize();
+
                 while (g_worker_thread_active)
                 {
-                        JobInternal* job = GetJob();
+                        JobInternal* job = GetJobTimed();
                         if (job)
                         {
                                 Execute(job);
                         }
                 }
+
+                g_thread_local_job_allocator_temp.Release();
         }
 } // namespace JobSchedulerInternal
 inline namespace JobScheduler
@@ -371,6 +567,15 @@ inline namespace JobScheduler
                         thread_index++;
                 }
 
+                g_job_thread_telemetry = (JobThreadTelemetry*)_aligned_malloc(sizeof(JobThreadTelemetry) * g_num_threads,
+                                                                              alignof(JobThreadTelemetry));
+                assert(g_job_thread_telemetry);
+                memset(g_job_thread_telemetry, 0, sizeof(JobThreadTelemetry) * g_num_threads);
+
+                assert(g_num_threads <= std::size(g_job_thread_names));
+                for (unsigned i = 0; i < g_num_threads; i++)
+                        snprintf(g_job_thread_names[i], sizeof(g_job_thread_names[i]), i ? "Worker %u" : "Main", i);
+
                 thread_index = 0;
                 TlsSetValue(g_tls_access_value, reinterpret_cast<LPVOID>(thread_index));
                 thread_index++;
@@ -389,8 +594,44 @@ inline namespace JobScheduler
                 for (unsigned i = 0; i < g_num_threads; i++)
                         g_job_queues[i].Shutdown();
                 _aligned_free(const_cast<JobQueue<MAX_JOBS_PER_FRAME>*>(g_job_queues));
+                _aligned_free(g_job_thread_telemetry);
                 TlsFree(g_tls_access_value);
         }
+
+        inline unsigned GetThreadCount()
+        {
+                return g_num_threads;
+        }
+        // Totals since Initialize, thread 0 is the thread that initialized the scheduler
+        inline JobThreadTelemetry GetThreadTelemetry(unsigned thread)
+        {
+                assert(thread < g_num_threads);
+                const volatile JobThreadTelemetry& telemetry = g_job_thread_telemetry[thread];
+
+                JobThreadTelemetry output;
+                output.pushes        = telemetry.pushes;
+                output.pops          = telemetry.pops;
+                output.steals        = telemetry.steals;
+                output.failed_steals = telemetry.failed_steals;
+                output.executed      = telemetry.executed;
+                output.execute_ticks = telemetry.execute_ticks;
+                output.idle_ticks    = telemetry.idle_ticks;
+                return output;
+        }
+        inline const char* GetThreadName(unsigned thread)
+        {
+                assert(thread < g_num_threads);
+                return g_job_thread_names[thread];
+        }
+        inline unsigned GetChunkHistogramCount()
+        {
+                return g_chunk_histogram_count;
+        }
+        inline const ChunkHistogram& GetChunkHistogram(unsigned index)
+        {
+                assert(index < g_chunk_histogram_count);
+                return *g_chunk_histograms[index];
+        }
 } // namespace JobScheduler
 
 void function(int x, float y, char b);
@@ -429,33 +670,29 @@ inline namespace JobSchedulerAbstractionsInternal
         struct ParallelForJobImpl
         {
             protected:
-                JobInternal*              root;
-                std::vector<JobInternal*> children;
-                ParallelForJobImpl(Lambda&& lambda, unsigned begin, unsigned end, unsigned chunkSize)
-                {
-                        root     = CreateJobData([]() {});
-                        children = CreateParallelForSubJobs(std::forward<Lambda>(lambda), begin, end, chunkSize);
-                }
+                JobInternal*                 root;
+                JobInternal*                 child;
+                static inline ChunkHistogram s_chunk_histogram;
+                static inline GrainEstimate  s_grain_estimate;
 
-            private:
-                template <unsigned... Is>
-                static R ParallelForApplyImpl(Lambda&&              lambda,
-                                              unsigned              index,
-                                              std::tuple<Args...>&& tuple,
-                                              std::index_sequence<Is...>)
+                ParallelForJobImpl(Lambda&& lambda, unsigned begin, unsigned end, unsigned grain)
                 {
-                        return lambda(index, std::get<Is>(tuple)...);
+                        static_assert(sizeof(Lambda) + sizeof(ParallelForRange) + sizeof(std::tuple<Args...>) <=
+                                          JobInternal::PADDING_SIZE,
+                                      "lambda is too large to fit the Job's padding buffer");
+                        RegisterChunkHistogram(s_chunk_histogram, typeid(Lambda).name());
+                        root  = CreateJobData([]() {});
+                        child = CreateParallelForJob(std::forward<Lambda>(lambda), begin, end, grain);
                 }
 
-                static void ParallelForApply(Lambda&& lambda, unsigned index, std::tuple<Args...>&& tuple)
+            private:
+                static void ExecuteRange(Lambda& lambda, std::tuple<Args...>& args, unsigned begin, unsigned end)
                 {
-                        ParallelForApplyImpl(std::forward<Lambda>(lambda),
-                                             index,
-                                             std::forward<std::tuple<Args...>>(tuple),
-                                             std::make_index_sequence<sizeof...(Args)>{});
+                        for (unsigned i = begin; i < end; i++)
+                                std::apply([&](auto&... _args) { lambda(i, _args...); }, args);
                 }
 
-                JobInternal* CreateParallelForSubJobImpl(Lambda&& lambda, unsigned begin, unsigned end)
+                JobInternal* CreateParallelForJob(Lambda&& lambda, unsigned begin, unsigned end, unsigned grain)
                 {
                         JobInternal* thisJob     = Allocator::Allocate();
                         char*        bufferAlias = thisJob->padding;
@@ -463,80 +700,28 @@ inline namespace JobSchedulerAbstractionsInternal
                         InPlaceForwardConstruct(bufferAlias, std::forward<Lambda>(lambda));
                         bufferAlias += sizeof(Lambda);
 
-                        InPlaceForwardConstruct(bufferAlias, std::tuple<unsigned, unsigned>(begin, end));
+                        InPlaceForwardConstruct(bufferAlias, ParallelForRange{begin, end, grain});
 
                         thisJob->function = [](JobInternal* job) {
-                                char* bufferAlias = job->padding;
-                                auto* lambda      = reinterpret_cast<Lambda*>(bufferAlias);
-                                bufferAlias += sizeof(Lambda);
-
-                                auto [_begin, _end] = *reinterpret_cast<std::tuple<unsigned, unsigned>*>(bufferAlias);
-                                if constexpr (sizeof...(Args))
-                                {
-                                        bufferAlias += sizeof(std::tuple<unsigned, unsigned>);
-                                        auto _args = *reinterpret_cast<std::tuple<Args...>*>(bufferAlias);
-                                        for (unsigned i = _begin; i < _end; i++)
-                                        {
-                                                ParallelForApply(
-                                                    std::forward<Lambda>(*lambda), i, std::forward<std::tuple<Args...>>(_args));
-                                        }
-                                }
-                                else
-                                {
-                                        for (unsigned i = _begin; i < _end; i++)
-                                        {
-                                                (*lambda)(i);
-                                        }
-                                }
+                                ExecuteParallelForRange<Lambda, std::tuple<Args...>>(
+                                    job, s_grain_estimate, s_chunk_histogram, ExecuteRange);
                         };
                         return thisJob;
                 }
 
-                template <typename Lambda>
-                std::vector<JobInternal*> CreateParallelForSubJobs(Lambda&& lambda,
-                                                                   unsigned begin,
-                                                                   unsigned end,
-                                                                   unsigned chunkSize)
-                {
-                        std::vector<JobInternal*> output;
-                        if (end - begin <= chunkSize)
-                                output.push_back(CreateParallelForSubJobImpl(std::forward<Lambda>(lambda), begin, end));
-                        else
-                        {
-                                unsigned leftBegin  = begin;
-                                unsigned leftEnd    = ((end - begin) / 2) + begin;
-                                unsigned rightBegin = leftEnd;
-                                unsigned rightEnd   = end;
-
-                                auto left =
-                                    CreateParallelForSubJobs(std::forward<Lambda>(lambda), leftBegin, leftEnd, chunkSize);
-
-                                auto right =
-                                    CreateParallelForSubJobs(std::forward<Lambda>(lambda), rightBegin, rightEnd, chunkSize);
-
-                                output.insert(output.end(), left.begin(), left.end());
-                                output.insert(output.end(), right.begin(), right.end());
-                        }
-
-                        return output;
-                }
-
                 void ResetJobs()
                 {
-                        root->unfinished_jobs = children.size() + 1;
-                        root->parent          = 0;
-                        for (const auto& itr : children)
-                        {
-                                itr->parent          = root;
-                                itr->unfinished_jobs = 1;
-                        }
+                        // The root is never queued, it completes when the range job and all of its splits have
+                        root->unfinished_jobs  = 1;
+                        root->parent           = 0;
+                        child->parent          = root;
+                        child->unfinished_jobs = 1;
                 }
 
                 void Run()
                 {
-                        JobSchedulerInternal::Run(root);
-                        for (const auto& itr : children)
-                                JobSchedulerInternal::Run(itr);
+                        UpdateGrainTarget();
+                        JobSchedulerInternal::Run(child);
                 }
 
             public:
@@ -544,21 +729,23 @@ inline namespace JobSchedulerAbstractionsInternal
                 {
                         JobSchedulerInternal::Wait(root);
                 }
+                // Names the call site's chunk histogram, the lambda's type name otherwise
+                void SetName(const char* name)
+                {
+                        s_chunk_histogram.name = name;
+                }
                 void SetArgs(Args... args)
                 {
-                        for (const auto& itr : children)
-                        {
-                                char* bufferAlias = itr->padding;
-                                bufferAlias += sizeof(Lambda) + sizeof(std::tuple<unsigned, unsigned>);
-                                auto bufferArgsAlias = reinterpret_cast<std::tuple<Args...>*>(bufferAlias);
-                                InPlaceForwardConstruct(bufferArgsAlias, std::tuple(args...));
-                        }
+                        char* bufferAlias = child->padding;
+                        bufferAlias += sizeof(Lambda) + sizeof(ParallelForRange);
+                        auto bufferArgsAlias = reinterpret_cast<std::tuple<Args...>*>(bufferAlias);
+                        InPlaceForwardConstruct(bufferArgsAlias, std::tuple(args...));
                 }
-                void SetRange(unsigned begin, unsigned end, unsigned chunkSize = 256)
+                // A grain of 0 lets the call site's measured cost per iteration decide how finely the range is split
+                void SetRange(unsigned begin, unsigned end, unsigned grain = 0)
                 {
-                        char* bufferAlias = children[0]->padding;
-                        auto& lambda      = *reinterpret_cast<Lambda*>(bufferAlias);
-                        children          = CreateParallelForSubJobs(std::forward<Lambda>(lambda), begin, end, chunkSize);
+                        char* bufferAlias = child->padding + sizeof(Lambda);
+                        *reinterpret_cast<ParallelForRange*>(bufferAlias) = ParallelForRange{begin, end, grain};
                 }
                 void operator()(Args... args)
                 {
@@ -574,11 +761,11 @@ inline namespace JobSchedulerAbstractionsInternal
         template <typename Allocator, typename Lambda>
         struct ParallelForJob : public ParallelForJob<Allocator, decltype(&Lambda::operator())>
         {
-                ParallelForJob(Lambda&& lambda, unsigned begin, unsigned end, unsigned chunkSize = 256) :
+                ParallelForJob(Lambda&& lambda, unsigned begin, unsigned end, unsigned grain = 0) :
                     ParallelForJob<Allocator, decltype(&Lambda::operator())>(std::forward<Lambda>(lambda),
                                                                              begin,
                                                                              end,
-                                                                             chunkSize)
+                                                                             grain)
                 {}
                 ParallelForJob(Lambda&& lambda) :
                     ParallelForJob<Allocator, decltype(&Lambda::operator())>(std::forward<Lambda>(lambda), 0, 0, 0)
@@ -588,16 +775,16 @@ inline namespace JobSchedulerAbstractionsInternal
         struct ParallelForJob<Allocator, R (Lambda::*)(unsigned, Args...)>
             : public ParallelForJobImpl<Allocator, R, Lambda, Args...>
         {
-                ParallelForJob(Lambda&& lambda, unsigned begin, unsigned end, unsigned chunkSize) :
-                    ParallelForJobImpl<Allocator, R, Lambda, Args...>(std::forward<Lambda>(lambda), begin, end, chunkSize)
+                ParallelForJob(Lambda&& lambda, unsigned begin, unsigned end, unsigned grain) :
+                    ParallelForJobImpl<Allocator, R, Lambda, Args...>(std::forward<Lambda>(lambda), begin, end, grain)
                 {}
         };
         template <typename Allocator, typename R, typename Lambda, typename... Args>
         struct ParallelForJob<Allocator, R (Lambda::*)(unsigned, Args...) const>
             : public ParallelForJobImpl<Allocator, R, Lambda, Args...>
         {
-                ParallelForJob(Lambda&& lambda, unsigned begin, unsigned end, unsigned chunkSize) :
-                    ParallelForJobImpl<Allocator, R, Lambda, Args...>(std::forward<Lambda>(lambda), begin, end, chunkSize)
+                ParallelForJob(Lambda&& lambda, unsigned begin, unsigned end, unsigned grain) :
+                    ParallelForJobImpl<Allocator, R, Lambda, Args...>(std::forward<Lambda>(lambda), begin, end, grain)
                 {}
         };
 
@@ -605,140 +792,72 @@ inline namespace JobSchedulerAbstractionsInternal
         struct ParallelForActiveImpl
         {
             protected:
-                ParallelForActiveImpl(Lambda&& lambda, unsigned chunkSize)
+                static inline ChunkHistogram s_chunk_histogram;
+                static inline GrainEstimate  s_grain_estimate;
+
+                ParallelForActiveImpl(Lambda&& lambda, unsigned grain)
                 {
+                        static_assert(sizeof(Lambda) + sizeof(ParallelForRange) + sizeof(std::tuple<Args...>) <=
+                                          JobInternal::PADDING_SIZE,
+                                      "lambda is too large to fit the Job's padding buffer");
+                        RegisterChunkHistogram(s_chunk_histogram, typeid(Lambda).name());
                         root = CreateJobData([]() {});
 
                         auto  rg_PoolIndex                  = Component::SGetTypeIndex();
                         auto& rg_ComponentRandomAccessPools = GEngine::Get()->GetHandleManager()->m_ComponentRandomAccessPools;
-                        if (rg_ComponentRandomAccessPools.m_mem_starts.size() <= rg_PoolIndex)
-                                return;
-                        auto rg_ComponentCount = rg_ComponentRandomAccessPools.m_element_counts[rg_PoolIndex];
-                        children = CreateParallelForSubJobs(std::forward<Lambda>(lambda), 0, rg_ComponentCount, chunkSize);
+                        auto  rg_ComponentCount             = 0U;
+                        if (rg_ComponentRandomAccessPools.m_mem_starts.size() > rg_PoolIndex)
+                                rg_ComponentCount = rg_ComponentRandomAccessPools.m_element_counts[rg_PoolIndex];
+                        child = CreateParallelForJob(std::forward<Lambda>(lambda), 0, rg_ComponentCount, grain);
                 }
 
             private:
-                JobInternal*              root;
-                std::vector<JobInternal*> children;
+                JobInternal* root;
+                JobInternal* child;
 
-                JobInternal* CreateParallelForSubJobImpl(Lambda&& lambda, unsigned begin, unsigned end)
+                static void ExecuteRange(Lambda& lambda, std::tuple<Args...>& args, unsigned begin, unsigned end)
                 {
+                        auto  _PoolIndex = Component::SGetTypeIndex();
+                        auto& _ComponentRandomAccessPools =
+                            GEngine::Get()->GetHandleManager()->m_ComponentRandomAccessPools;
+                        auto& _IsActives                  = _ComponentRandomAccessPools.m_element_isactives[_PoolIndex];
+                        auto  _Components =
+                            reinterpret_cast<Component*>(_ComponentRandomAccessPools.m_mem_starts[_PoolIndex]);
+                        for (unsigned i = begin; i < end; i++)
+                        {
+                                if (_IsActives[i])
+                                        std::apply([&](auto&... _args) { lambda(_Components[i], _args...); }, args);
+                        }
+                }
 
-
+                JobInternal* CreateParallelForJob(Lambda&& lambda, unsigned begin, unsigned end, unsigned grain)
+                {
                         JobInternal* thisJob     = JobAllocator::Allocate();
                         char*        bufferAlias = thisJob->padding;
 
                         InPlaceForwardConstruct(bufferAlias, std::forward<Lambda>(lambda));
                         bufferAlias += sizeof(Lambda);
 
-                        InPlaceForwardConstruct(bufferAlias, std::tuple<unsigned, unsigned>(begin, end));
+                        InPlaceForwardConstruct(bufferAlias, ParallelForRange{begin, end, grain});
 
                         thisJob->function = [](JobInternal* job) {
-                                char* bufferAlias = job->padding;
-                                auto* lambda      = reinterpret_cast<Lambda*>(bufferAlias);
-                                bufferAlias += sizeof(Lambda);
-
-                                auto [_begin, _end] = *reinterpret_cast<std::tuple<unsigned, unsigned>*>(bufferAlias);
-
-                                if constexpr (sizeof...(Args))
-                                {
-                                        auto  _PoolIndex = Component::SGetTypeIndex();
-                                        auto& _ComponentRandomAccessPools =
-                                            GEngine::Get()->GetHandleManager()->m_ComponentRandomAccessPools;
-                                        auto  _ComponentCount = _ComponentRandomAccessPools.m_element_counts[_PoolIndex];
-                                        auto& _IsActives      = _ComponentRandomAccessPools.m_element_isactives[_PoolIndex];
-                                        auto  _ComponentsBegin =
-                                            reinterpret_cast<Component*>(_ComponentRandomAccessPools.m_mem_starts[_PoolIndex]);
-                                        active_range<Component> _active_range(
-                                            _ComponentsBegin + _begin, _ComponentCount + _end, _IsActives);
-                                        bufferAlias += sizeof(std::tuple<unsigned, unsigned>);
-                                        auto _args = *reinterpret_cast<std::tuple<Args...>*>(bufferAlias);
-                                        for (auto& itr : _active_range)
-                                        {
-                                                ParallelForApply(std::forward<Lambda>(*lambda),
-                                                                 itr,
-                                                                 std::forward<std::tuple<Args...>>(_args));
-                                        }
-                                }
-                                else
-                                {
-                                        auto  _PoolIndex = Component::SGetTypeIndex();
-                                        auto& _ComponentRandomAccessPools =
-                                            GEngine::Get()->GetHandleManager()->m_ComponentRandomAccessPools;
-                                        auto  _ComponentCount = _ComponentRandomAccessPools.m_element_counts[_PoolIndex];
-                                        auto& _IsActives      = _ComponentRandomAccessPools.m_element_isactives[_PoolIndex];
-                                        auto  _ComponentsBegin =
-                                            reinterpret_cast<Component*>(_ComponentRandomAccessPools.m_mem_starts[_PoolIndex]);
-                                        active_range<Component> _active_range(
-                                            _ComponentsBegin + _begin, _ComponentCount + _end, _IsActives);
-
-                                        for (auto& itr : _active_range)
-                                        {
-                                                (*lambda)(itr);
-                                        }
-                                }
+                                ExecuteParallelForRange<Lambda, std::tuple<Args...>>(
+                                    job, s_grain_estimate, s_chunk_histogram, ExecuteRange);
                         };
                         return thisJob;
                 }
-                template <typename Lambda>
-                std::vector<JobInternal*> CreateParallelForSubJobs(Lambda&& lambda,
-                                                                   unsigned begin,
-                                                                   unsigned end,
-                                                                   unsigned chunkSize)
-                {
-                        std::vector<JobInternal*> output;
-                        if (end - begin <= chunkSize)
-                                output.push_back(CreateParallelForSubJobImpl(std::forward<Lambda>(lambda), begin, end));
-                        else
-                        {
-                                unsigned leftBegin  = begin;
-                                unsigned leftEnd    = ((end - begin) / 2) + begin;
-                                unsigned rightBegin = leftEnd;
-                                unsigned rightEnd   = end;
-
-                                auto left =
-                                    CreateParallelForSubJobs(std::forward<Lambda>(lambda), leftBegin, leftEnd, chunkSize);
-
-                                auto right =
-                                    CreateParallelForSubJobs(std::forward<Lambda>(lambda), rightBegin, rightEnd, chunkSize);
-
-                                output.insert(output.end(), left.begin(), left.end());
-                                output.insert(output.end(), right.begin(), right.end());
-                        }
-
-                        return output;
-                }
-                template <unsigned... Is>
-                static R ParallelForApplyImpl(Lambda&&              lambda,
-                                              Component&            component,
-                                              std::tuple<Args...>&& tuple,
-                                              std::index_sequence<Is...>)
-                {
-                        return lambda(component, std::get<Is>(tuple)...);
-                }
-
-                static void ParallelForApply(Lambda&& lambda, Component& component, std::tuple<Args...>&& tuple)
-                {
-                        ParallelForApplyImpl(std::forward<Lambda>(lambda),
-                                             component,
-                                             std::forward<std::tuple<Args...>>(tuple),
-                                             std::make_index_sequence<sizeof...(Args)>{});
-                }
                 void ResetJobs()
                 {
-                        root->unfinished_jobs = static_cast<long>(children.size()) + 1;
-                        root->parent          = 0;
-                        for (const auto& itr : children)
-                        {
-                                itr->parent          = root;
-                                itr->unfinished_jobs = 1;
-                        }
+                        // The root is never queued, it completes when the range job and all of its splits have
+                        root->unfinished_jobs  = 1;
+                        root->parent           = 0;
+                        child->parent          = root;
+                        child->unfinished_jobs = 1;
                 }
                 void Run()
                 {
-                        JobSchedulerInternal::Run(root);
-                        for (const auto& itr : children)
-                                JobSchedulerInternal::Run(itr);
+                        UpdateGrainTarget();
+                        JobSchedulerInternal::Run(child);
                 }
 
             public:
@@ -746,21 +865,23 @@ inline namespace JobSchedulerAbstractionsInternal
                 {
                         JobSchedulerInternal::Wait(root);
                 }
+                // Names the call site's chunk histogram, the lambda's type name otherwise
+                void SetName(const char* name)
+                {
+                        s_chunk_histogram.name = name;
+                }
                 void SetArgs(Args... args)
                 {
-                        for (const auto& itr : children)
-                        {
-                                char* bufferAlias = itr->padding;
-                                bufferAlias += sizeof(Lambda) + sizeof(std::tuple<unsigned, unsigned>);
-                                auto bufferArgsAlias = reinterpret_cast<std::tuple<Args...>*>(bufferAlias);
-                                InPlaceForwardConstruct(bufferArgsAlias, std::tuple(args...));
-                        }
+                        char* bufferAlias = child->padding;
+                        bufferAlias += sizeof(Lambda) + sizeof(ParallelForRange);
+                        auto bufferArgsAlias = reinterpret_cast<std::tuple<Args...>*>(bufferAlias);
+                        InPlaceForwardConstruct(bufferArgsAlias, std::tuple(args...));
                 }
-                void SetRange(unsigned begin, unsigned end, unsigned chunkSize = 256)
+                // A grain of 0 lets the call site's measured cost per iteration decide how finely the range is split
+                void SetRange(unsigned begin, unsigned end, unsigned grain = 0)
                 {
-                        char* bufferAlias = children[0]->padding;
-                        auto& lambda      = *reinterpret_cast<Lambda*>(bufferAlias);
-                        children          = CreateParallelForSubJobs(std::forward<Lambda>(lambda), begin, end, chunkSize);
+                        char* bufferAlias = child->padding + sizeof(Lambda);
+                        *reinterpret_cast<ParallelForRange*>(bufferAlias) = ParallelForRange{begin, end, grain};
                 }
                 void operator()(Args... args)
                 {
@@ -777,26 +898,26 @@ inline namespace JobSchedulerAbstractionsInternal
         struct ParallelForActiveComponentsLambdaExpander
             : public ParallelForActiveComponentsLambdaExpander<Component, JobAllocator, decltype(&Lambda::operator())>
         {
-                ParallelForActiveComponentsLambdaExpander(Lambda&& lambda, unsigned chunkSize) :
+                ParallelForActiveComponentsLambdaExpander(Lambda&& lambda, unsigned grain) :
                     ParallelForActiveComponentsLambdaExpander<Component, JobAllocator, decltype(&Lambda::operator())>(
                         std::forward<Lambda>(lambda),
-                        chunkSize)
+                        grain)
                 {}
         };
         template <typename Component, typename JobAllocator, typename R, typename Lambda, typename... Args>
         struct ParallelForActiveComponentsLambdaExpander<Component, JobAllocator, R (Lambda::*)(Component&, Args...) const>
             : public ParallelForActiveImpl<Component, JobAllocator, R, Lambda, Args...>
         {
-                ParallelForActiveComponentsLambdaExpander(Lambda&& lambda, unsigned chunkSize) :
-                    ParallelForActiveImpl<Component, JobAllocator, R, Lambda, Args...>(std::forward<Lambda>(lambda), chunkSize)
+                ParallelForActiveComponentsLambdaExpander(Lambda&& lambda, unsigned grain) :
+                    ParallelForActiveImpl<Component, JobAllocator, R, Lambda, Args...>(std::forward<Lambda>(lambda), grain)
                 {}
         };
         template <typename Component, typename JobAllocator, typename R, typename Lambda, typename... Args>
         struct ParallelForActiveComponentsLambdaExpander<Component, JobAllocator, R (Lambda::*)(Component&, Args...)>
             : public ParallelForActiveImpl<Component, JobAllocator, R, Lambda, Args...>
         {
-                ParallelForActiveComponentsLambdaExpander(Lambda&& lambda, unsigned chunkSize) :
-                    ParallelForActiveImpl<Component, JobAllocator, R, Lambda, Args...>(std::forward<Lambda>(lambda), chunkSize)
+                ParallelForActiveComponentsLambdaExpander(Lambda&& lambda, unsigned grain) :
+                    ParallelForActiveImpl<Component, JobAllocator, R, Lambda, Args...>(std::forward<Lambda>(lambda), grain)
                 {}
         };
 
@@ -804,22 +925,41 @@ inline namespace JobSchedulerAbstractionsInternal
         struct ParallelForComponentsImpl
         {
             protected:
-                ParallelForComponentsImpl(Lambda&& lambda, unsigned chunkSize)
+                static inline ChunkHistogram s_chunk_histogram;
+                static inline GrainEstimate  s_grain_estimate;
+
+                ParallelForComponentsImpl(Lambda&& lambda, unsigned grain)
                 {
+                        static_assert(sizeof(Lambda) + sizeof(ParallelForRange) + sizeof(std::tuple<Args...>) <=
+                                          JobInternal::PADDING_SIZE,
+                                      "lambda is too large to fit the Job's padding buffer");
+                        RegisterChunkHistogram(s_chunk_histogram, typeid(Lambda).name());
                         root = CreateJobData([]() {});
 
                         auto  rg_PoolIndex                  = Component::SGetTypeIndex();
                         auto& rg_ComponentRandomAccessPools = GEngine::Get()->GetHandleManager()->m_ComponentRandomAccessPools;
-                        auto  rg_ComponentCount             = rg_ComponentRandomAccessPools.m_element_counts[rg_PoolIndex];
-
-                        children = CreateParallelForSubJobs(std::forward<Lambda>(lambda), 0, rg_ComponentCount, chunkSize);
+                        auto  rg_ComponentCount             = 0U;
+                        if (rg_ComponentRandomAccessPools.m_mem_starts.size() > rg_PoolIndex)
+                                rg_ComponentCount = rg_ComponentRandomAccessPools.m_element_counts[rg_PoolIndex];
+                        child = CreateParallelForJob(std::forward<Lambda>(lambda), 0, rg_ComponentCount, grain);
                 }
 
             private:
-                JobInternal*              root;
-                std::vector<JobInternal*> children;
+                JobInternal* root;
+                JobInternal* child;
 
-                JobInternal* CreateParallelForSubJobImpl(Lambda&& lambda, unsigned begin, unsigned end)
+                static void ExecuteRange(Lambda& lambda, std::tuple<Args...>& args, unsigned begin, unsigned end)
+                {
+                        auto  _PoolIndex = Component::SGetTypeIndex();
+                        auto& _ComponentRandomAccessPools =
+                            GEngine::Get()->GetHandleManager()->m_ComponentRandomAccessPools;
+                        auto  _Components =
+                            reinterpret_cast<Component*>(_ComponentRandomAccessPools.m_mem_starts[_PoolIndex]);
+                        for (unsigned i = begin; i < end; i++)
+                                std::apply([&](auto&... _args) { lambda(_Components[i], _args...); }, args);
+                }
+
+                JobInternal* CreateParallelForJob(Lambda&& lambda, unsigned begin, unsigned end, unsigned grain)
                 {
                         JobInternal* thisJob     = JobAllocator::Allocate();
                         char*        bufferAlias = thisJob->padding;
@@ -827,112 +967,26 @@ inline namespace JobSchedulerAbstractionsInternal
                         InPlaceForwardConstruct(bufferAlias, std::forward<Lambda>(lambda));
                         bufferAlias += sizeof(Lambda);
 
-                        InPlaceForwardConstruct(bufferAlias, std::tuple<unsigned, unsigned>(begin, end));
+                        InPlaceForwardConstruct(bufferAlias, ParallelForRange{begin, end, grain});
 
                         thisJob->function = [](JobInternal* job) {
-                                char* bufferAlias = job->padding;
-                                auto* lambda      = reinterpret_cast<Lambda*>(bufferAlias);
-                                bufferAlias += sizeof(Lambda);
-
-                                auto [_begin, _end] = *reinterpret_cast<std::tuple<unsigned, unsigned>*>(bufferAlias);
-
-                                if constexpr (sizeof...(Args))
-                                {
-                                        auto  _PoolIndex = Component::SGetTypeIndex();
-                                        auto& _ComponentRandomAccessPools =
-                                            GEngine::Get()->GetHandleManager()->m_ComponentRandomAccessPools;
-                                        auto _ComponentCount = _ComponentRandomAccessPools.m_element_counts[_PoolIndex];
-                                        auto _ComponentsBegin =
-                                            reinterpret_cast<Component*>(_ComponentRandomAccessPools.m_mem_starts[_PoolIndex]);
-                                        range<Component> _range(_ComponentsBegin + _begin, _ComponentCount + _end);
-
-
-                                        bufferAlias += sizeof(std::tuple<unsigned, unsigned>);
-                                        auto _args = *reinterpret_cast<std::tuple<Args...>*>(bufferAlias);
-                                        for (auto& itr : _range)
-                                        {
-                                                ParallelForApply(std::forward<Lambda>(*lambda),
-                                                                 itr,
-                                                                 std::forward<std::tuple<Args...>>(_args));
-                                        }
-                                }
-                                else
-                                {
-                                        auto  _PoolIndex = Component::SGetTypeIndex();
-                                        auto& _ComponentRandomAccessPools =
-                                            GEngine::Get()->GetHandleManager()->m_ComponentRandomAccessPools;
-                                        auto _ComponentCount = _ComponentRandomAccessPools.m_element_counts[_PoolIndex];
-                                        auto _ComponentsBegin =
-                                            reinterpret_cast<Component*>(_ComponentRandomAccessPools.m_mem_starts[_PoolIndex]);
-                                        range<Component> _range(_ComponentsBegin + _begin, _ComponentCount + _end);
-
-                                        for (auto& itr : _range)
-                                        {
-                                                (*lambda)(itr);
-                                        }
-                                }
+                                ExecuteParallelForRange<Lambda, std::tuple<Args...>>(
+                                    job, s_grain_estimate, s_chunk_histogram, ExecuteRange);
                         };
                         return thisJob;
                 }
-                template <typename Lambda>
-                std::vector<JobInternal*> CreateParallelForSubJobs(Lambda&& lambda,
-                                                                   unsigned begin,
-                                                                   unsigned end,
-                                                                   unsigned chunkSize)
-                {
-                        std::vector<JobInternal*> output;
-                        if (end - begin <= chunkSize)
-                                output.push_back(CreateParallelForSubJobImpl(std::forward<Lambda>(lambda), begin, end));
-                        else
-                        {
-                                unsigned leftBegin  = begin;
-                                unsigned leftEnd    = ((end - begin) / 2) + begin;
-                                unsigned rightBegin = leftEnd;
-                                unsigned rightEnd   = end;
-
-                                auto left =
-                                    CreateParallelForSubJobs(std::forward<Lambda>(lambda), leftBegin, leftEnd, chunkSize);
-
-                                auto right =
-                                    CreateParallelForSubJobs(std::forward<Lambda>(lambda), rightBegin, rightEnd, chunkSize);
-
-                                output.insert(output.end(), left.begin(), left.end());
-                                output.insert(output.end(), right.begin(), right.end());
-                        }
-
-                        return output;
-                }
-                template <unsigned... Is>
-                static R ParallelForApplyImpl(Lambda&&              lambda,
-                                              Component&            component,
-                                              std::tuple<Args...>&& tuple,
-                                              std::index_sequence<Is...>)
-                {
-                        return lambda(component, std::get<Is>(tuple)...);
-                }
-
-                static void ParallelForApply(Lambda&& lambda, Component& component, std::tuple<Args...>&& tuple)
-                {
-                        ParallelForApplyImpl(std::forward<Lambda>(lambda),
-                                             component,
-                                             std::forward<std::tuple<Args...>>(tuple),
-                                             std::make_index_sequence<sizeof...(Args)>{});
-                }
                 void ResetJobs()
                 {
-                        root->unfinished_jobs = children.size() + 1;
-                        root->parent          = 0;
-                        for (const auto& itr : children)
-                        {
-                                itr->parent          = root;
-                                itr->unfinished_jobs = 1;
-                        }
+                        // The root is never queued, it completes when the range job and all of its splits have
+                        root->unfinished_jobs  = 1;
+                        root->parent           = 0;
+                        child->parent          = root;
+                        child->unfinished_jobs = 1;
                 }
                 void Run()
                 {
-                        JobSchedulerInternal::Run(root);
-                        for (const auto& itr : children)
-                                JobSchedulerInternal::Run(itr);
+                        UpdateGrainTarget();
+                        JobSchedulerInternal::Run(child);
                 }
 
             public:
@@ -940,21 +994,23 @@ inline namespace JobSchedulerAbstractionsInternal
                 {
                         JobSchedulerInternal::Wait(root);
                 }
+                // Names the call site's chunk histogram, the lambda's type name otherwise
+                void SetName(const char* name)
+                {
+                        s_chunk_histogram.name = name;
+                }
                 void SetArgs(Args... args)
                 {
-                        for (const auto& itr : children)
-                        {
-                                char* bufferAlias = itr->padding;
-                                bufferAlias += sizeof(Lambda) + sizeof(std::tuple<unsigned, unsigned>);
-                                auto bufferArgsAlias = reinterpret_cast<std::tuple<Args...>*>(bufferAlias);
-                                InPlaceForwardConstruct(bufferArgsAlias, std::tuple(args...));
-                        }
+                        char* bufferAlias = child->padding;
+                        bufferAlias += sizeof(Lambda) + sizeof(ParallelForRange);
+                        auto bufferArgsAlias = reinterpret_cast<std::tuple<Args...>*>(bufferAlias);
+                        InPlaceForwardConstruct(bufferArgsAlias, std::tuple(args...));
                 }
-                void SetRange(unsigned begin, unsigned end, unsigned chunkSize = 256)
+                // A grain of 0 lets the call site's measured cost per iteration decide how finely the range is split
+                void SetRange(unsigned begin, unsigned end, unsigned grain = 0)
                 {
-                        char* bufferAlias = children[0]->padding;
-                        auto& lambda      = *reinterpret_cast<Lambda*>(bufferAlias);
-                        children          = CreateParallelForSubJobs(std::forward<Lambda>(lambda), begin, end, chunkSize);
+                        char* bufferAlias = child->padding + sizeof(Lambda);
+                        *reinterpret_cast<ParallelForRange*>(bufferAlias) = ParallelForRange{begin, end, grain};
                 }
                 void operator()(Args... args)
                 {
@@ -971,28 +1027,28 @@ inline namespace JobSchedulerAbstractionsInternal
         struct ParallelForComponentsLambdaExpander
             : public ParallelForComponentsLambdaExpander<Component, JobAllocator, decltype(&Lambda::operator())>
         {
-                ParallelForComponentsLambdaExpander(Lambda&& lambda, unsigned chunkSize) :
+                ParallelForComponentsLambdaExpander(Lambda&& lambda, unsigned grain) :
                     ParallelForComponentsLambdaExpander<Component, JobAllocator, decltype(&Lambda::operator())>(
                         std::forward<Lambda>(lambda),
-                        chunkSize)
+                        grain)
                 {}
         };
         template <typename Component, typename JobAllocator, typename R, typename Lambda, typename... Args>
         struct ParallelForComponentsLambdaExpander<Component, JobAllocator, R (Lambda::*)(Component&, Args...) const>
             : public ParallelForComponentsImpl<Component, JobAllocator, R, Lambda, Args...>
         {
-                ParallelForComponentsLambdaExpander(Lambda&& lambda, unsigned chunkSize) :
+                ParallelForComponentsLambdaExpander(Lambda&& lambda, unsigned grain) :
                     ParallelForComponentsImpl<Component, JobAllocator, R, Lambda, Args...>(std::forward<Lambda>(lambda),
-                                                                                           chunkSize)
+                                                                                           grain)
                 {}
         };
         template <typename Component, typename JobAllocator, typename R, typename Lambda, typename... Args>
         struct ParallelForComponentsLambdaExpander<Component, JobAllocator, R (Lambda::*)(Component&, Args...)>
             : public ParallelForComponentsImpl<Component, JobAllocator, R, Lambda, Args...>
         {
-                ParallelForComponentsLambdaExpander(Lambda&& lambda, unsigned chunkSize) :
+                ParallelForComponentsLambdaExpander(Lambda&& lambda, unsigned grain) :
                     ParallelForComponentsImpl<Component, JobAllocator, R, Lambda, Args...>(std::forward<Lambda>(lambda),
-                                                                                           chunkSize)
+                                                                                           grain)
                 {}
         };
 } // namespace JobSchedulerAbstractionsInternal
@@ -1137,16 +1193,16 @@ inline namespace JobSchedulerAbstractions
                 return ParallelForJob<JobAllocator, Lambda>(std::forward<Lambda>(lambda));
         }
         template <typename Component, typename JobAllocator = TempJobAllocator, typename Lambda>
-        auto ParallelForActiveComponents(Lambda&& lambda, unsigned chunkSize = 256)
+        auto ParallelForActiveComponents(Lambda&& lambda, unsigned grain = 0)
         {
                 return ParallelForActiveComponentsLambdaExpander<Component, JobAllocator, Lambda>(std::forward<Lambda>(lambda),
-                                                                                                  chunkSize);
+                                                                                                  grain);
         }
         template <typename Component, typename JobAllocator = TempJobAllocator, typename Lambda>
-        auto ParallelForComponents(Lambda&& lambda, unsigned chunkSize = 256)
+        auto ParallelForComponents(Lambda&& lambda, unsigned grain = 0)
         {
                 return ParallelForComponentsLambdaExpander<Component, JobAllocator, Lambda>(std::forward<Lambda>(lambda),
-                                                                                            chunkSize);
+                                                                                            grain);
         }
 
         template <typename Allocator = TempJobAllocator>
@@ -1175,4 +1231,261 @@ inline namespace JobSchedulerAbstractions
                         JobSchedulerInternal::Run(rootJob);
                 }
         };
+        // Ranges of the data parallel algorithms below are cut into a few contiguous blocks per thread. Blocks are
+        // spread over the workers by ParallelFor and their partial results are combined serially, in block order, so
+        // combine only has to be associative.
+        inline unsigned GetParallelBlockCount(unsigned count)
+        {
+                return std::min(count, g_num_threads * 4);
+        }
+        inline void
+        GetParallelBlockRange(unsigned block, unsigned blockCount, unsigned count, unsigned& begin, unsigned& end)
+        {
+                begin = static_cast<unsigned>(uint64_t(count) * block / blockCount);
+                end   = static_cast<unsigned>(uint64_t(count) * (block + 1) / blockCount);
+        }
+        template <typename Component>
+        inline unsigned GetComponentPool(Component*& components, NMemory::dynamic_bitset*& isActives)
+        {
+                auto  poolIndex                  = Component::SGetTypeIndex();
+                auto& componentRandomAccessPools = GEngine::Get()->GetHandleManager()->m_ComponentRandomAccessPools;
+                if (componentRandomAccessPools.m_mem_starts.size() <= poolIndex)
+                        return 0;
+
+                components = reinterpret_cast<Component*>(componentRandomAccessPools.m_mem_starts[poolIndex]);
+                isActives  = &componentRandomAccessPools.m_element_isactives[poolIndex];
+                return static_cast<unsigned>(componentRandomAccessPools.m_element_counts[poolIndex]);
+        }
+
+        // The algorithms below run to completion before returning and must be called from the main thread. Their per
+        // block results live in frame memory, so T must be trivially destructible.
+
+        // accumulate(T& value, unsigned index) folds index into value, combine(T& lhs, const T& rhs) folds rhs into lhs
+        template <typename T, typename Accumulate, typename Combine>
+        T ParallelReduce(unsigned count, T identity, Accumulate&& accumulate, Combine&& combine)
+        {
+                static_assert(std::is_trivially_destructible<T>::value,
+                              "Error. Frame memory is released without running destructors");
+
+                unsigned blockCount = GetParallelBlockCount(count);
+                if (blockCount == 0)
+                        return identity;
+
+                T* partials = NMemory::FrameAllocator::Allocate<T>(blockCount);
+
+                auto reduceBlock = [&](unsigned block) {
+                        unsigned begin, end;
+                        GetParallelBlockRange(block, blockCount, count, begin, end);
+
+                        T value = identity;
+                        for (unsigned i = begin; i < end; i++)
+                                accumulate(value, i);
+                        InPlaceForwardConstruct(partials + block, std::move(value));
+                };
+                auto reduceJob = ParallelFor([&reduceBlock](unsigned block) { reduceBlock(block); });
+                reduceJob.SetName("ParallelReduce");
+                reduceJob.SetRange(0, blockCount, 1);
+                reduceJob();
+                reduceJob.Wait();
+
+                T output = partials[0];
+                for (unsigned block = 1; block < blockCount; block++)
+                        combine(output, partials[block]);
+                return output;
+        }
+        // accumulate(T& value, Component& component) is only called for active components
+        template <typename Component, typename T, typename Accumulate, typename Combine>
+        T ParallelReduceActiveComponents(T identity, Accumulate&& accumulate, Combine&& combine)
+        {
+                Component*               components = nullptr;
+                NMemory::dynamic_bitset* isActives  = nullptr;
+                unsigned                 count      = GetComponentPool(components, isActives);
+
+                return ParallelReduce(count,
+                                      identity,
+                                      [&](T& value, unsigned i) {
+                                              if ((*isActives)[i])
+                                                      accumulate(value, components[i]);
+                                      },
+                                      combine);
+        }
+
+        // Passes the running combination of value(i) to store(i, const T&) and returns the total. Exclusive scans pass
+        // the combination of the values before i, inclusive scans include value(i). value is called twice per index
+        // and must return the same value both times.
+        template <bool INCLUSIVE, typename T, typename Value, typename Combine, typename Store>
+        T ParallelScan(unsigned count, T identity, Value&& value, Combine&& combine, Store&& store)
+        {
+                static_assert(std::is_trivially_destructible<T>::value,
+                              "Error. Frame memory is released without running destructors");
+
+                unsigned blockCount = GetParallelBlockCount(count);
+                if (blockCount == 0)
+                        return identity;
+
+                // Block totals first, then every block scans itself again from the total of the blocks before it
+                T* blockBases = NMemory::FrameAllocator::Allocate<T>(blockCount);
+
+                auto reduceBlock = [&](unsigned block) {
+                        unsigned begin, end;
+                        GetParallelBlockRange(block, blockCount, count, begin, end);
+
+                        T total = identity;
+                        for (unsigned i = begin; i < end; i++)
+                                combine(total, value(i));
+                        InPlaceForwardConstruct(blockBases + block, std::move(total));
+                };
+                auto reduceJob = ParallelFor([&reduceBlock](unsigned block) { reduceBlock(block); });
+                reduceJob.SetName("ParallelScan");
+                reduceJob.SetRange(0, blockCount, 1);
+                reduceJob();
+                reduceJob.Wait();
+
+                T total = identity;
+                for (unsigned block = 0; block < blockCount; block++)
+                {
+                        T blockTotal      = blockBases[block];
+                        blockBases[block] = total;
+                        combine(total, blockTotal);
+                }
+
+                auto scanBlock = [&](unsigned block) {
+                        unsigned begin, end;
+                        GetParallelBlockRange(block, blockCount, count, begin, end);
+
+                        T running = blockBases[block];
+                        for (unsigned i = begin; i < end; i++)
+                        {
+                                if constexpr (INCLUSIVE)
+                                {
+                                        combine(running, value(i));
+                                        store(i, running);
+                                }
+                                else
+                                {
+                                        store(i, running);
+                                        combine(running, value(i));
+                                }
+                        }
+                };
+                auto scanJob = ParallelFor([&scanBlock](unsigned block) { scanBlock(block); });
+                scanJob.SetName("ParallelScan");
+                scanJob.SetRange(0, blockCount, 1);
+                scanJob();
+                scanJob.Wait();
+
+                return total;
+        }
+        template <typename T, typename Value, typename Combine, typename Store>
+        T ParallelExclusiveScan(unsigned count, T identity, Value&& value, Combine&& combine, Store&& store)
+        {
+                return ParallelScan<false>(count, identity, value, combine, store);
+        }
+        template <typename T, typename Value, typename Combine, typename Store>
+        T ParallelInclusiveScan(unsigned count, T identity, Value&& value, Combine&& combine, Store&& store)
+        {
+                return ParallelScan<true>(count, identity, value, combine, store);
+        }
+        // Indices passed to store are pool indices, inactive components contribute identity
+        template <typename Component, typename T, typename Value, typename Combine, typename Store>
+        T ParallelExclusiveScanActiveComponents(T identity, Value&& value, Combine&& combine, Store&& store)
+        {
+                Component*               components = nullptr;
+                NMemory::dynamic_bitset* isActives  = nullptr;
+                unsigned                 count      = GetComponentPool(components, isActives);
+
+                return ParallelExclusiveScan(
+                    count,
+                    identity,
+                    [&](unsigned i) { return (*isActives)[i] ? value(components[i]) : identity; },
+                    combine,
+                    store);
+        }
+        template <typename Component, typename T, typename Value, typename Combine, typename Store>
+        T ParallelInclusiveScanActiveComponents(T identity, Value&& value, Combine&& combine, Store&& store)
+        {
+                Component*               components = nullptr;
+                NMemory::dynamic_bitset* isActives  = nullptr;
+                unsigned                 count      = GetComponentPool(components, isActives);
+
+                return ParallelInclusiveScan(
+                    count,
+                    identity,
+                    [&](unsigned i) { return (*isActives)[i] ? value(components[i]) : identity; },
+                    combine,
+                    store);
+        }
+
+        // Stable partition of item(i) for i in [0, count) into output, the items matching predicate(i) first. Returns
+        // how many matched. predicate is called twice per index and must give the same answer both times.
+        template <typename T, typename Item, typename Predicate>
+        unsigned ParallelPartition(unsigned count, T* output, Item&& item, Predicate&& predicate)
+        {
+                unsigned blockCount = GetParallelBlockCount(count);
+                if (blockCount == 0)
+                        return 0;
+
+                unsigned* matchOffsets = NMemory::FrameAllocator::Allocate<unsigned>(blockCount);
+
+                auto countBlock = [&](unsigned block) {
+                        unsigned begin, end;
+                        GetParallelBlockRange(block, blockCount, count, begin, end);
+
+                        unsigned matches = 0;
+                        for (unsigned i = begin; i < end; i++)
+                                matches += predicate(i) ? 1 : 0;
+                        matchOffsets[block] = matches;
+                };
+                auto countJob = ParallelFor([&countBlock](unsigned block) { countBlock(block); });
+                countJob.SetName("ParallelPartition");
+                countJob.SetRange(0, blockCount, 1);
+                countJob();
+                countJob.Wait();
+
+                unsigned matchCount = 0;
+                for (unsigned block = 0; block < blockCount; block++)
+                {
+                        unsigned matches    = matchOffsets[block];
+                        matchOffsets[block] = matchCount;
+                        matchCount += matches;
+                }
+
+                // A block's non matching items go after the matching ones, past those of the blocks before it
+                auto scatterBlock = [&](unsigned block) {
+                        unsigned begin, end;
+                        GetParallelBlockRange(block, blockCount, count, begin, end);
+
+                        unsigned match   = matchOffsets[block];
+                        unsigned noMatch = matchCount + (begin - matchOffsets[block]);
+                        for (unsigned i = begin; i < end; i++)
+                                output[predicate(i) ? match++ : noMatch++] = item(i);
+                };
+                auto scatterJob = ParallelFor([&scatterBlock](unsigned block) { scatterBlock(block); });
+                scatterJob.SetName("ParallelPartition");
+                scatterJob.SetRange(0, blockCount, 1);
+                scatterJob();
+                scatterJob.Wait();
+
+                return matchCount;
+        }
+        // Partitions the pointers of the active components into output, which needs room for every active component
+        template <typename Component, typename Predicate>
+        unsigned ParallelPartitionActiveComponents(Component** output, Predicate&& predicate)
+        {
+                Component*               components = nullptr;
+                NMemory::dynamic_bitset* isActives  = nullptr;
+                unsigned                 count      = GetComponentPool(components, isActives);
+
+                // Inactive components are compacted away first, then the active ones are partitioned in place of them
+                Component** active      = NMemory::FrameAllocator::Allocate<Component*>(count);
+                unsigned    activeCount = ParallelPartition(count,
+                                                         active,
+                                                         [&](unsigned i) { return components + i; },
+                                                         [&](unsigned i) { return bool((*isActives)[i]); });
+
+                return ParallelPartition(activeCount,
+                                         output,
+                                         [&](unsigned i) { return active[i]; },
+                                         [&](unsigned i) { return predicate(*active[i]); });
+        }
 } // namespace JobSchedulerAbstractions
\ No newline at end of file
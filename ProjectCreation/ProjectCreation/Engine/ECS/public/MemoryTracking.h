@@ -0,0 +1,78 @@
+#pragma once
+#include <stdint.h>
+#include "ECSMem.h"
+
+// Routes the global operator new and delete through the tracker. Each allocation carries a small header with its tag
+// and size.
+#define MEMORY_TRACKING
+
+namespace NMemory
+{
+        struct E_MEMORY_TAG
+        {
+                enum
+                {
+                        UNTAGGED = 0,
+                        ECS_POOLS,
+                        FRAME_ARENA,
+                        RESOURCES,
+                        DEBUG_RENDERER,
+                        TERRAIN,
+                        PARTICLES,
+                        COUNT
+                };
+        };
+
+        struct FMemoryTagStats
+        {
+                int64_t  liveBytes       = 0;
+                int64_t  peakBytes       = 0;
+                int64_t  staticBytes     = 0;
+                uint64_t allocationCount = 0;
+                uint64_t freeCount       = 0;
+                memsize  budget          = 0;
+        };
+
+        // Live bytes, peak bytes and allocation counts per subsystem.
+        // Heap allocations made through operator new are charged to the calling thread's current tag. Memory that does
+        // not come from operator new (arenas, aligned blocks, static arrays) is reported explicitly by its owner.
+        // Debug builds assert when a tag's live bytes exceed its budget, a budget of 0 is unbounded.
+        namespace MemoryTracking
+        {
+                void TrackAllocation(int tag, memsize bytes);
+                void TrackFree(int tag, memsize bytes);
+                // Memory with static storage duration, counted as live for the lifetime of the program
+                void TrackStatic(int tag, memsize bytes);
+
+                void            SetBudget(int tag, memsize bytes);
+                FMemoryTagStats GetTagStats(int tag);
+                const char*     GetTagName(int tag);
+
+                // Tag charged for operator new on the calling thread, returns the previous tag
+                int SetCurrentTag(int tag);
+                int GetCurrentTag();
+
+                // Writes the stats of every tag as JSON
+                void WriteReport(const char* fileName);
+        } // namespace MemoryTracking
+
+        struct ScopedMemoryTag
+        {
+                int m_PreviousTag;
+
+                inline ScopedMemoryTag(int tag) : m_PreviousTag(MemoryTracking::SetCurrentTag(tag))
+                {}
+                inline ~ScopedMemoryTag()
+                {
+                        MemoryTracking::SetCurrentTag(m_PreviousTag);
+                }
+        };
+
+        struct FStaticMemoryRegistration
+        {
+                inline FStaticMemoryRegistration(int tag, memsize bytes)
+                {
+                        MemoryTracking::TrackStatic(tag, bytes);
+                }
+        };
+} // namespace NMemory
\ No newline at end of file
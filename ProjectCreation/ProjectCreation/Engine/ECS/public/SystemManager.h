@@ -4,6 +4,7 @@
 #include <queue>
 #include <unordered_map>
 #include <ErrorTypes.h>
+#include <FrameAllocator.h>
 #include <MemoryLeakDetection.h>
 #include "ECSTypes.h"
 #include "ISystem.h"
@@ -16,7 +17,14 @@ struct PriorityComparator
         }
 };
 
-using SystemQueue = std::priority_queue<ISystem*, std::vector<ISystem*>, PriorityComparator>;
+class SystemQueue : public std::priority_queue<ISystem*, std::vector<ISystem*>, PriorityComparator>
+{
+    public:
+        inline const container_type& GetContainer() const
+        {
+                return c;
+        }
+};
 
 class SystemManager
 {
@@ -37,8 +45,9 @@ class SystemManager
         template <typename T>
         T* GetSystem();
 
-        void        FilterSystemQueue(int flags = 0);
-        SystemQueue GetSystemQueue();
+        void FilterSystemQueue(int flags = 0);
+        // Systems of the current queue in update order, allocated from frame memory
+        NMemory::FrameSpan<ISystem*> GetSystemQueue();
 
         void Initialize();
         void Shutdown();
@@ -0,0 +1,360 @@
+#include <AssetArchive.h>
+
+#include <assert.h>
+#include <ctype.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include <BitwiseUtility.h>
+#include <LZ4.h>
+#include <Profiling.h>
+
+namespace FileIO
+{
+        namespace
+        {
+                constexpr const char* kLooseAssetRoot = "../Assets/";
+
+                // Directories FileIO loads from, relative to the asset root
+                constexpr const char* kArchivedDirectories[] = {"Models", "Materials", "Shaders", "Animations", "Textures"};
+
+                FMappedFile           g_Archive;
+                const FArchiveHeader* g_Header = nullptr;
+                const FArchiveEntry*  g_Table  = nullptr;
+
+                std::atomic<uint32_t> g_ArchiveReads{0};
+                std::atomic<uint32_t> g_LooseFileOpens{0};
+                std::atomic<uint64_t> g_BytesServed{0};
+                std::atomic<uint64_t> g_DecompressedBytes{0};
+                std::atomic<uint64_t> g_OpenMicroseconds{0};
+
+                char NormalizePathChar(char c)
+                {
+                        return c == '\\' ? '/' : (char)tolower((unsigned char)c);
+                }
+
+                bool MatchesPath(const FArchiveEntry& entry, const char* relativePath)
+                {
+                        const char* stored = g_Archive.GetData() + entry.pathOffset;
+                        for (uint32_t i = 0; i < entry.pathLength; ++i)
+                        {
+                                if (relativePath[i] == '\0' || NormalizePathChar(relativePath[i]) != stored[i])
+                                        return false;
+                        }
+                        return relativePath[entry.pathLength] == '\0';
+                }
+
+                bool IsMappedInPlace(const std::string& extension)
+                {
+                        return extension == ".mesh" || extension == ".skel";
+                }
+
+                uint64_t AlignArchiveOffset(uint64_t offset)
+                {
+                        return (offset + kArchiveAlignment - 1) & ~(kArchiveAlignment - 1);
+                }
+
+                void WritePadding(std::ofstream& stream, uint64_t alignedOffset)
+                {
+                        static const char zeros[kArchiveAlignment] = {};
+                        uint64_t          padding              = alignedOffset - (uint64_t)stream.tellp();
+                        stream.write(zeros, padding);
+                }
+        } // namespace
+
+        EResult FAssetFile::Open(const char* directory, const char* fileName, const char* extension)
+        {
+                EResult output;
+                output.m_Flags = ERESULT_FLAG::INVALID;
+
+                LARGE_INTEGER startTime = TimeStamp();
+
+                m_Data = nullptr;
+                m_Size = 0;
+
+                std::string relativePath = std::string(directory) + "/" + fileName + extension;
+
+                if (const FArchiveEntry* entry = AssetArchive::Find(relativePath.c_str()))
+                {
+                        const char* stored = g_Archive.GetData() + entry->offset;
+
+                        if (entry->compression == E_ARCHIVE_COMPRESSION::NONE && entry->storedSize == entry->size)
+                        {
+                                m_Data         = stored;
+                                m_Size         = (size_t)entry->size;
+                                output.m_Flags = ERESULT_FLAG::SUCCESS;
+                        }
+                        else if (entry->compression == E_ARCHIVE_COMPRESSION::LZ4)
+                        {
+                                m_Decompressed.resize((size_t)entry->size);
+                                if (LZ4::Decompress(stored, (size_t)entry->storedSize, m_Decompressed.data(), m_Decompressed.size()))
+                                {
+                                        m_Data         = m_Decompressed.data();
+                                        m_Size         = m_Decompressed.size();
+                                        output.m_Flags = ERESULT_FLAG::SUCCESS;
+                                        g_DecompressedBytes += entry->size;
+                                }
+                        }
+
+                        ++g_ArchiveReads;
+                }
+                else if (m_LooseFile.Open((kLooseAssetRoot + relativePath).c_str()).m_Flags == ERESULT_FLAG::SUCCESS)
+                {
+                        m_Data         = m_LooseFile.GetData();
+                        m_Size         = m_LooseFile.GetSize();
+                        output.m_Flags = ERESULT_FLAG::SUCCESS;
+
+                        ++g_LooseFileOpens;
+                }
+
+                g_BytesServed += m_Size;
+                g_OpenMicroseconds += TimeStamp().QuadPart - startTime.QuadPart;
+
+                return output;
+        }
+
+        void FAssetFile::Prefetch() const
+        {
+                constexpr size_t pageSize = 4096;
+
+                volatile char sink = 0;
+                for (size_t offset = 0; offset < m_Size; offset += pageSize)
+                        sink = m_Data[offset];
+                (void)sink;
+        }
+
+        namespace AssetArchive
+        {
+                EResult Mount(const char* archivePath)
+                {
+                        Unmount();
+
+                        EResult output = g_Archive.Open(archivePath);
+                        if (output.m_Flags != ERESULT_FLAG::SUCCESS)
+                                return output;
+
+                        output.m_Flags = ERESULT_FLAG::INVALID;
+
+                        const FArchiveHeader* header = reinterpret_cast<const FArchiveHeader*>(g_Archive.GetData());
+                        uint64_t              size   = g_Archive.GetSize();
+
+                        bool valid = size >= sizeof(FArchiveHeader) && header->magic == kArchiveMagic &&
+                                     header->version == kArchiveVersion && header->tableSize != 0 &&
+                                     (header->tableSize & (header->tableSize - 1)) == 0 && header->tocOffset <= size &&
+                                     (uint64_t)header->tableSize * sizeof(FArchiveEntry) <= size - header->tocOffset;
+
+                        const FArchiveEntry* table = valid ? reinterpret_cast<const FArchiveEntry*>(g_Archive.GetData() + header->tocOffset) : nullptr;
+
+                        // Blobs and paths must lie inside the file so lookups can trust the table afterwards
+                        uint32_t usedSlots = 0;
+                        for (uint32_t i = 0; valid && i < header->tableSize; ++i)
+                        {
+                                const FArchiveEntry& entry = table[i];
+                                if (entry.pathHash == 0)
+                                        continue;
+
+                                valid = entry.offset <= size && entry.storedSize <= size - entry.offset &&
+                                        entry.pathOffset <= size && entry.pathLength <= size - entry.pathOffset &&
+                                        entry.compression < E_ARCHIVE_COMPRESSION::COUNT;
+                                ++usedSlots;
+                        }
+
+                        // Probing stops at an empty slot, a full table would make every miss walk all of it
+                        valid = valid && usedSlots < header->tableSize;
+
+                        if (!valid)
+                        {
+                                g_Archive.Close();
+                                return output;
+                        }
+
+                        g_Header       = header;
+                        g_Table        = table;
+                        output.m_Flags = ERESULT_FLAG::SUCCESS;
+                        return output;
+                }
+
+                void Unmount()
+                {
+                        g_Header = nullptr;
+                        g_Table  = nullptr;
+                        g_Archive.Close();
+                }
+
+                bool IsMounted()
+                {
+                        return g_Header != nullptr;
+                }
+
+                uint64_t HashPath(const char* relativePath)
+                {
+                        // 64 bit FNV-1a
+                        uint64_t hash = 14695981039346656037ULL;
+                        for (const char* c = relativePath; *c; ++c)
+                        {
+                                hash = (hash ^ (uint8_t)NormalizePathChar(*c)) * 1099511628211ULL;
+                        }
+
+                        // Zero marks empty table slots
+                        return hash ? hash : 1;
+                }
+
+                const FArchiveEntry* Find(const char* relativePath)
+                {
+                        if (!g_Header)
+                                return nullptr;
+
+                        uint64_t hash = HashPath(relativePath);
+                        uint32_t mask = g_Header->tableSize - 1;
+
+                        uint32_t slot = (uint32_t)hash & mask;
+                        for (uint32_t probe = 0; probe < g_Header->tableSize; ++probe, slot = (slot + 1) & mask)
+                        {
+                                const FArchiveEntry& entry = g_Table[slot];
+                                if (entry.pathHash == 0)
+                                        return nullptr;
+                                if (entry.pathHash == hash && MatchesPath(entry, relativePath))
+                                        return &entry;
+                        }
+
+                        return nullptr;
+                }
+
+                const char* GetArchiveData()
+                {
+                        return g_Archive.GetData();
+                }
+
+                size_t GetArchiveSize()
+                {
+                        return g_Archive.GetSize();
+                }
+
+                EResult Build(const char* assetRoot, const char* archivePath)
+                {
+                        namespace fs = std::filesystem;
+
+                        EResult output;
+                        output.m_Flags = ERESULT_FLAG::INVALID;
+
+                        std::vector<std::string> relativePaths;
+                        for (const char* directory : kArchivedDirectories)
+                        {
+                                fs::path directoryPath = fs::path(assetRoot) / directory;
+                                if (!fs::is_directory(directoryPath))
+                                        continue;
+
+                                for (const auto& file : fs::recursive_directory_iterator(directoryPath))
+                                {
+                                        if (file.is_regular_file())
+                                                relativePaths.push_back(
+                                                    std::string(directory) + "/" + fs::relative(file.path(), directoryPath).generic_string());
+                                }
+                        }
+
+                        std::ofstream archive(archivePath, std::ios::out | std::ios::binary | std::ios::trunc);
+                        if (!archive.is_open())
+                                return output;
+
+                        FArchiveHeader header{};
+                        header.magic      = kArchiveMagic;
+                        header.version    = kArchiveVersion;
+                        header.entryCount = (uint32_t)relativePaths.size();
+                        header.tableSize  = nextPowerOf2(std::max<uint32_t>(16, header.entryCount * 2));
+                        archive.write((const char*)&header, sizeof(header));
+
+                        std::vector<FArchiveEntry> table(header.tableSize);
+                        std::vector<char>          compressed;
+                        std::string                paths;
+
+                        for (const auto& relativePath : relativePaths)
+                        {
+                                std::ifstream     file(fs::path(assetRoot) / relativePath, std::ios::in | std::ios::binary);
+                                std::vector<char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+                                std::string normalizedPath = relativePath;
+                                for (char& c : normalizedPath)
+                                        c = NormalizePathChar(c);
+
+                                FArchiveEntry entry{};
+                                entry.pathHash    = HashPath(relativePath.c_str());
+                                entry.pathOffset  = paths.size();
+                                entry.pathLength  = (uint32_t)normalizedPath.size();
+                                entry.offset      = AlignArchiveOffset((uint64_t)archive.tellp());
+                                entry.size        = bytes.size();
+                                entry.storedSize  = bytes.size();
+                                entry.compression = E_ARCHIVE_COMPRESSION::NONE;
+
+                                const char* stored = bytes.data();
+                                if (!IsMappedInPlace(fs::path(relativePath).extension().string()))
+                                {
+                                        compressed.resize(LZ4::CompressBound(bytes.size()));
+                                        size_t compressedSize =
+                                            LZ4::Compress(bytes.data(), bytes.size(), compressed.data(), compressed.size());
+
+                                        if (compressedSize != 0 && compressedSize <= bytes.size() - bytes.size() / 4)
+                                        {
+                                                entry.storedSize  = compressedSize;
+                                                entry.compression = E_ARCHIVE_COMPRESSION::LZ4;
+                                                stored            = compressed.data();
+                                        }
+                                }
+
+                                WritePadding(archive, entry.offset);
+                                archive.write(stored, entry.storedSize);
+                                paths += normalizedPath;
+
+                                uint32_t mask = header.tableSize - 1;
+                                uint32_t slot = (uint32_t)entry.pathHash & mask;
+                                while (table[slot].pathHash != 0)
+                                {
+                                        // Paths differing only in case or separators would make one of them unreachable
+                                        const FArchiveEntry& other = table[slot];
+                                        if (other.pathHash == entry.pathHash &&
+                                            paths.compare(other.pathOffset, other.pathLength, normalizedPath) == 0)
+                                                return output;
+                                        slot = (slot + 1) & mask;
+                                }
+                                table[slot] = entry;
+                        }
+
+                        // Path offsets were recorded relative to the path block
+                        uint64_t pathBase = (uint64_t)archive.tellp();
+                        archive.write(paths.data(), paths.size());
+                        for (FArchiveEntry& entry : table)
+                        {
+                                if (entry.pathHash != 0)
+                                        entry.pathOffset += pathBase;
+                        }
+
+                        header.tocOffset = AlignArchiveOffset((uint64_t)archive.tellp());
+                        WritePadding(archive, header.tocOffset);
+                        archive.write((const char*)table.data(), sizeof(FArchiveEntry) * table.size());
+
+                        archive.seekp(0, std::ios::beg);
+                        archive.write((const char*)&header, sizeof(header));
+                        archive.close();
+
+                        if (!archive.fail())
+                                output.m_Flags = ERESULT_FLAG::SUCCESS;
+
+                        return output;
+                }
+
+                FAssetIOStats GetStats()
+                {
+                        FAssetIOStats stats;
+                        stats.archiveReads      = g_ArchiveReads;
+                        stats.looseFileOpens    = g_LooseFileOpens;
+                        stats.bytesServed       = g_BytesServed;
+                        stats.decompressedBytes = g_DecompressedBytes;
+                        stats.openMicroseconds  = g_OpenMicroseconds;
+                        return stats;
+                }
+        } // namespace AssetArchive
+} // namespace FileIO
\ No newline at end of file
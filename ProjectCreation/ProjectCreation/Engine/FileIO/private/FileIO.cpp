@@ -4,85 +4,194 @@
 #include <fstream>
 #include <sstream>
 
-EResult FileIO::LoadStaticMeshDataFromFile(const char* fileName, FStaticMeshData* staticMeshOutput)
+namespace
 {
-        using namespace std;
+        // Bounds checked walk over a mapped asset
+        struct FMappedReader
+        {
+                const char* data;
+                size_t      size;
+                size_t      offset = 0;
 
-        assert(staticMeshOutput != nullptr);
-        EResult output;
-        output.m_Flags = ERESULT_FLAG::INVALID;
+                FMappedReader(const FileIO::FAssetFile& file) : data(file.GetData()), size(file.GetSize())
+                {}
 
-        std::ostringstream filePathStream;
-        filePathStream << "../Assets/Models/" << fileName << ".mesh";
+                const char* Take(uint64_t bytes)
+                {
+                        if (bytes > size - offset)
+                                return nullptr;
+                        const char* out = data + offset;
+                        offset += (size_t)bytes;
+                        return out;
+                }
 
-        ifstream myfile;
-        myfile.open(filePathStream.str(), ios::in | ios::binary);
+                bool Read(void* out, size_t bytes)
+                {
+                        const char* in = Take(bytes);
+                        if (in)
+                                memcpy(out, in, bytes);
+                        return in != nullptr;
+                }
+        };
 
-        if (myfile.is_open())
+        // Read-only stream over asset bytes, so the stream based readers work the same on archive and loose data
+        struct FMemoryStreamBuf : public std::streambuf
         {
-                uint32_t vertCount;
-                uint32_t indCount;
-                myfile.seekg(0, ios::beg);
-                myfile.read((char*)staticMeshOutput->materialName.data(), staticMeshOutput->materialName.size());
-                myfile.read((char*)&vertCount, sizeof(uint32_t));
-                myfile.read((char*)&indCount, sizeof(uint32_t));
-                staticMeshOutput->vertices.resize(vertCount);
-                staticMeshOutput->indices.resize(indCount);
-                myfile.read((char*)staticMeshOutput->vertices.data(), sizeof(FVertex) * vertCount);
-                myfile.read((char*)staticMeshOutput->indices.data(), sizeof(uint32_t) * indCount);
-                staticMeshOutput->name = fileName;
+                FMemoryStreamBuf(const char* data, size_t size)
+                {
+                        char* begin = const_cast<char*>(data);
+                        setg(begin, begin, begin + size);
+                }
 
-                myfile.close();
+                virtual pos_type seekoff(off_type offset, std::ios_base::seekdir dir, std::ios_base::openmode) override
+                {
+                        char* base = dir == std::ios_base::beg ? eback() : dir == std::ios_base::cur ? gptr() : egptr();
+                        if (base + offset < eback() || base + offset > egptr())
+                                return pos_type(off_type(-1));
+                        setg(eback(), base + offset, egptr());
+                        return pos_type(gptr() - eback());
+                }
 
-                output.m_Flags = ERESULT_FLAG::SUCCESS;
+                virtual pos_type seekpos(pos_type position, std::ios_base::openmode mode) override
+                {
+                        return seekoff(off_type(position), std::ios_base::beg, mode);
+                }
+        };
+
+        struct FMemoryStream : private FMemoryStreamBuf, public std::istream
+        {
+                FMemoryStream(const FileIO::FAssetFile& file) :
+                    FMemoryStreamBuf(file.GetData(), file.GetSize()),
+                    std::istream(static_cast<std::streambuf*>(this))
+                {}
+        };
+} // namespace
+
+EResult FileIO::MapStaticMeshFile(const char* fileName, FStaticMeshView* staticMeshOutput)
+{
+        assert(staticMeshOutput != nullptr);
+        EResult output;
+        output.m_Flags = ERESULT_FLAG::INVALID;
+
+        FAssetFile file;
+        if (file.Open("Models", fileName, ".mesh").m_Flags == ERESULT_FLAG::SUCCESS)
+        {
+                // Material name, vertex count, index count, vertices, indices
+                FMappedReader reader(file);
+                uint32_t      vertCount;
+                uint32_t      indCount;
+                const char*   materialName = reader.Take(sizeof(file_path_t));
+
+                if (materialName && reader.Read(&vertCount, sizeof(uint32_t)) && reader.Read(&indCount, sizeof(uint32_t)))
+                {
+                        const char* vertices = reader.Take((uint64_t)sizeof(FVertex) * vertCount);
+                        const char* indices  = vertices ? reader.Take((uint64_t)sizeof(uint32_t) * indCount) : nullptr;
+
+                        if (indices)
+                        {
+                                staticMeshOutput->materialName = materialName;
+                                staticMeshOutput->vertices     = reinterpret_cast<const FVertex*>(vertices);
+                                staticMeshOutput->indices      = reinterpret_cast<const uint32_t*>(indices);
+                                staticMeshOutput->vertexCount  = vertCount;
+                                staticMeshOutput->indexCount   = indCount;
+                                staticMeshOutput->file         = std::move(file);
+
+                                output.m_Flags = ERESULT_FLAG::SUCCESS;
+                        }
+                }
         }
         assert(output.m_Flags != ERESULT_FLAG::INVALID);
 
         return output;
 }
 
-EResult FileIO::LoadSkeletalMeshDataFromFile(const char* fileName, FSkeletalMeshData* skeletalMeshOutput)
+EResult FileIO::MapSkeletalMeshFile(const char* fileName, FSkeletalMeshView* skeletalMeshOutput)
 {
-        using namespace std;
-
         assert(skeletalMeshOutput != nullptr);
         EResult output;
         output.m_Flags = ERESULT_FLAG::INVALID;
 
-        std::ostringstream filePathStream;
-        filePathStream << "../Assets/Models/" << fileName << ".skel";
+        FAssetFile file;
+        if (file.Open("Models", fileName, ".skel").m_Flags == ERESULT_FLAG::SUCCESS)
+        {
+                // Joint count, joints, inverse joints, then the same layout as a .mesh file
+                FMappedReader reader(file);
+                uint32_t      jointCount;
 
-        ifstream myfile;
-        myfile.open(filePathStream.str(), ios::in | ios::binary);
+                if (reader.Read(&jointCount, sizeof(uint32_t)))
+                {
+                        const char* joints        = reader.Take((uint64_t)sizeof(Animation::FJoint) * jointCount);
+                        const char* inverseJoints = joints ? reader.Take((uint64_t)sizeof(Animation::FJoint) * jointCount) : nullptr;
+                        const char* materialName  = inverseJoints ? reader.Take(sizeof(file_path_t)) : nullptr;
+
+                        uint32_t vertCount;
+                        uint32_t indCount;
+                        if (materialName && reader.Read(&vertCount, sizeof(uint32_t)) && reader.Read(&indCount, sizeof(uint32_t)))
+                        {
+                                const char* vertices = reader.Take((uint64_t)sizeof(FSkinnedVertex) * vertCount);
+                                const char* indices  = vertices ? reader.Take((uint64_t)sizeof(uint32_t) * indCount) : nullptr;
+
+                                if (indices)
+                                {
+                                        skeletalMeshOutput->joints.resize(jointCount);
+                                        skeletalMeshOutput->inverseJoints.resize(jointCount);
+                                        memcpy(skeletalMeshOutput->joints.data(), joints, sizeof(Animation::FJoint) * jointCount);
+                                        memcpy(skeletalMeshOutput->inverseJoints.data(),
+                                               inverseJoints,
+                                               sizeof(Animation::FJoint) * jointCount);
+
+                                        skeletalMeshOutput->materialName = materialName;
+                                        skeletalMeshOutput->vertices     = reinterpret_cast<const FSkinnedVertex*>(vertices);
+                                        skeletalMeshOutput->indices      = reinterpret_cast<const uint32_t*>(indices);
+                                        skeletalMeshOutput->vertexCount  = vertCount;
+                                        skeletalMeshOutput->indexCount   = indCount;
+                                        skeletalMeshOutput->file         = std::move(file);
+
+                                        output.m_Flags = ERESULT_FLAG::SUCCESS;
+                                }
+                        }
+                }
+        }
+        assert(output.m_Flags != ERESULT_FLAG::INVALID);
 
-        if (myfile.is_open())
+        return output;
+}
+
+EResult FileIO::LoadStaticMeshDataFromFile(const char* fileName, FStaticMeshData* staticMeshOutput)
+{
+        assert(staticMeshOutput != nullptr);
+
+        FStaticMeshView meshView;
+        EResult         output = MapStaticMeshFile(fileName, &meshView);
+
+        if (output.m_Flags == ERESULT_FLAG::SUCCESS)
         {
+                // Copies straight out of the mapping, without zero filling the vectors first
+                memcpy(staticMeshOutput->materialName.data(), meshView.materialName, staticMeshOutput->materialName.size());
+                staticMeshOutput->vertices.assign(meshView.vertices, meshView.vertices + meshView.vertexCount);
+                staticMeshOutput->indices.assign(meshView.indices, meshView.indices + meshView.indexCount);
+                staticMeshOutput->name = fileName;
+        }
 
-                uint32_t jointCount;
-                myfile.seekg(0, ios::beg);
-                myfile.read((char*)&jointCount, sizeof(jointCount));
-                skeletalMeshOutput->joints.resize(jointCount);
-                skeletalMeshOutput->inverseJoints.resize(jointCount);
-                myfile.read((char*)skeletalMeshOutput->joints.data(), sizeof(Animation::FJoint) * jointCount);
-                myfile.read((char*)skeletalMeshOutput->inverseJoints.data(), sizeof(Animation::FJoint) * jointCount);
-
-
-                uint32_t vertCount;
-                uint32_t indCount;
-                myfile.read((char*)skeletalMeshOutput->materialName.data(), skeletalMeshOutput->materialName.size());
-                myfile.read((char*)&vertCount, sizeof(uint32_t));
-                myfile.read((char*)&indCount, sizeof(uint32_t));
-                skeletalMeshOutput->vertices.resize(vertCount);
-                skeletalMeshOutput->indices.resize(indCount);
-                myfile.read((char*)skeletalMeshOutput->vertices.data(), sizeof(FSkinnedVertex) * vertCount);
-                myfile.read((char*)skeletalMeshOutput->indices.data(), sizeof(uint32_t) * indCount);
-                skeletalMeshOutput->name = fileName;
+        return output;
+}
 
-                myfile.close();
+EResult FileIO::LoadSkeletalMeshDataFromFile(const char* fileName, FSkeletalMeshData* skeletalMeshOutput)
+{
+        assert(skeletalMeshOutput != nullptr);
 
-                output.m_Flags = ERESULT_FLAG::SUCCESS;
+        FSkeletalMeshView meshView;
+        EResult           output = MapSkeletalMeshFile(fileName, &meshView);
+
+        if (output.m_Flags == ERESULT_FLAG::SUCCESS)
+        {
+                skeletalMeshOutput->joints        = std::move(meshView.joints);
+                skeletalMeshOutput->inverseJoints = std::move(meshView.inverseJoints);
+                memcpy(skeletalMeshOutput->materialName.data(), meshView.materialName, skeletalMeshOutput->materialName.size());
+                skeletalMeshOutput->vertices.assign(meshView.vertices, meshView.vertices + meshView.vertexCount);
+                skeletalMeshOutput->indices.assign(meshView.indices, meshView.indices + meshView.indexCount);
+                skeletalMeshOutput->name = fileName;
         }
-        assert(output.m_Flags != ERESULT_FLAG::INVALID);
 
         return output;
 }
@@ -95,14 +204,11 @@ EResult FileIO::LoadMaterialDataFromFile(const char* fileName, FMaterialData* ma
         EResult output;
         output.m_Flags = ERESULT_FLAG::INVALID;
 
-        std::ostringstream filePathStream;
-        filePathStream << "../Assets/Materials/" << fileName << ".material";
-
-        ifstream myfile;
-        myfile.open(filePathStream.str(), ios::in | ios::binary);
-
-        if (myfile.is_open())
+        FAssetFile asset;
+        if (asset.Open("Materials", fileName, ".material").m_Flags == ERESULT_FLAG::SUCCESS)
         {
+                FMemoryStream myfile(asset);
+
                 FMaterialData inMat;
                 myfile.read((char*)&inMat.surfaceProperties, sizeof(inMat.surfaceProperties));
 
@@ -118,7 +224,6 @@ EResult FileIO::LoadMaterialDataFromFile(const char* fileName, FMaterialData* ma
                         myfile.read(desc.filePath.data(), desc.filePath.size());
                         inMat.textureDescs.push_back(desc);
                 }
-                myfile.close();
 
 				*materialOutput = inMat;
                 output.m_Flags = ERESULT_FLAG::SUCCESS;
@@ -135,17 +240,10 @@ EResult FileIO::LoadShaderDataFromFile(const char* fileName, const char* suffix,
         EResult output;
         output.m_Flags = ERESULT_FLAG::INVALID;
 
-        std::ostringstream filePathStream;
-        filePathStream << "../Assets/Shaders/" << fileName << suffix << ".cso";
-
-        std::basic_ifstream<char> stream(filePathStream.str(), std::ios::binary);
-
-        if (stream.is_open())
+        FAssetFile asset;
+        if (asset.Open("Shaders", (std::string(fileName) + suffix).c_str(), ".cso").m_Flags == ERESULT_FLAG::SUCCESS)
         {
-                shaderDataOutput->bytes =
-                    std::vector<char>((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
-
-                stream.close();
+                shaderDataOutput->bytes.assign(asset.GetData(), asset.GetData() + asset.GetSize());
 
                 output.m_Flags = ERESULT_FLAG::SUCCESS;
         }
@@ -160,37 +258,170 @@ EResult FileIO::LoadShaderDataFromFile(const char* fileName, const char* suffix,
         return output;
 }
 
+namespace
+{
+        void ReadRawAnimClip(std::istream& stream, Animation::FAnimClip& animClip, int jointCount)
+        {
+                stream.read((char*)&animClip.duration, sizeof(animClip.duration));
+                uint32_t frameCount;
+                stream.read((char*)&frameCount, sizeof(uint32_t));
+
+                // The last frame repeats the first one so looping clips blend back to the start
+                size_t keyCount = (size_t)(frameCount + 1) * jointCount;
+
+                animClip.jointCount = (uint32_t)jointCount;
+                animClip.times.resize(frameCount + 1);
+                animClip.translations.resize(keyCount);
+                animClip.rotations.resize(keyCount);
+                animClip.scales.resize(keyCount);
+
+                std::vector<FTransform> framePose(jointCount);
+
+                for (int i = 0; i < (int)frameCount; ++i)
+                {
+                        stream.read((char*)&animClip.times[i], sizeof(animClip.times[i]));
+                        stream.read((char*)framePose.data(), sizeof(FTransform) * jointCount);
+
+                        size_t offset = (size_t)i * jointCount;
+                        for (int j = 0; j < jointCount; ++j)
+                        {
+                                animClip.translations[offset + j] = framePose[j].translation;
+                                animClip.rotations[offset + j]    = framePose[j].rotation.data;
+                                animClip.scales[offset + j]       = framePose[j].scale;
+                        }
+                }
+
+                size_t loopOffset = (size_t)frameCount * jointCount;
+                std::copy_n(animClip.translations.begin(), jointCount, animClip.translations.begin() + loopOffset);
+                std::copy_n(animClip.rotations.begin(), jointCount, animClip.rotations.begin() + loopOffset);
+                std::copy_n(animClip.scales.begin(), jointCount, animClip.scales.begin() + loopOffset);
+
+                animClip.duration += 1.0f / 24.0f;
+                animClip.times.back() = animClip.duration;
+        }
+
+        template <typename T>
+        void ReadArray(std::istream& stream, std::vector<T>& data)
+        {
+                uint32_t count;
+                stream.read((char*)&count, sizeof(uint32_t));
+                data.resize(count);
+                stream.read((char*)data.data(), sizeof(T) * count);
+        }
+
+        template <typename T>
+        void WriteArray(std::ostream& stream, const std::vector<T>& data)
+        {
+                uint32_t count = (uint32_t)data.size();
+                stream.write((const char*)&count, sizeof(uint32_t));
+                stream.write((const char*)data.data(), sizeof(T) * count);
+        }
+} // namespace
+
 EResult FileIO::ImportAnimClipData(const char* fileName, Animation::FAnimClip& animClip, const Animation::FSkeleton& skeleton)
 {
         EResult output;
         output.m_Flags = ERESULT_FLAG::INVALID;
 
-        std::ostringstream filePathStream;
-        filePathStream << "../Assets/Animations/" << fileName << ".anim";
+        FAssetFile asset;
+        EResult    opened = asset.Open("Animations", fileName, ".anim");
+
+        int jointCount = (int)skeleton.jointTransforms.size();
+
+        if (opened.m_Flags == ERESULT_FLAG::SUCCESS)
+        {
+                FMemoryStream myfile(asset);
+
+                ReadRawAnimClip(myfile, animClip, jointCount);
+
+                output.m_Flags = ERESULT_FLAG::SUCCESS;
+        }
+        assert(output.m_Flags != ERESULT_FLAG::INVALID);
 
-        std::ifstream myfile;
-        myfile.open(filePathStream.str(), std::ios::in | std::ios::binary);
+        return output;
+}
+
+EResult FileIO::ImportCompressedAnimClipData(const char*                     fileName,
+                                             Animation::FCompressedAnimClip& animClip,
+                                             const Animation::FSkeleton&     skeleton)
+{
+        EResult output;
+        output.m_Flags = ERESULT_FLAG::INVALID;
+
+        FAssetFile asset;
+        EResult    opened = asset.Open("Animations", fileName, ".anim");
 
         int jointCount = (int)skeleton.jointTransforms.size();
 
-        if (myfile.is_open())
+        if (opened.m_Flags == ERESULT_FLAG::SUCCESS)
         {
-                myfile.read((char*)&animClip.duration, sizeof(animClip.duration));
-                uint32_t frameCount;
-                myfile.read((char*)&frameCount, sizeof(uint32_t));
-                animClip.frames.resize(frameCount);
+                FMemoryStream myfile(asset);
 
-                for (int i = 0; i < (int)frameCount; ++i)
+                uint32_t header[2] = {};
+                myfile.read((char*)header, sizeof(header));
+
+                if (header[0] == Animation::kCompressedAnimClipMagic && header[1] == Animation::kCompressedAnimClipVersion)
                 {
-                        animClip.frames[i].joints.resize(jointCount);
-                        myfile.read((char*)&animClip.frames[i].time, sizeof(animClip.frames[i].time));
-                        myfile.read((char*)animClip.frames[i].joints.data(), sizeof(FTransform) * jointCount);
+                        myfile.read((char*)&animClip.duration, sizeof(animClip.duration));
+                        myfile.read((char*)&animClip.jointCount, sizeof(animClip.jointCount));
+                        ReadArray(myfile, animClip.times);
+                        ReadArray(myfile, animClip.constRotations);
+                        ReadArray(myfile, animClip.constTranslations);
+                        ReadArray(myfile, animClip.constScales);
+                        ReadArray(myfile, animClip.animatedRotationJoints);
+                        ReadArray(myfile, animClip.animatedTranslationJoints);
+                        ReadArray(myfile, animClip.animatedScaleJoints);
+                        ReadArray(myfile, animClip.rotationKeys);
+                        ReadArray(myfile, animClip.translationKeys);
+                        ReadArray(myfile, animClip.scaleKeys);
+
+                        assert(animClip.jointCount == (uint32_t)jointCount);
                 }
+                else
+                {
+                        // Raw clip, compress it at load
+                        myfile.clear();
+                        myfile.seekg(0, std::ios::beg);
 
-                animClip.frames.push_back(animClip.frames.front());
-                animClip.duration += 1.0f / 24.0f;
-                animClip.frames.back().time = animClip.duration;
+                        Animation::FAnimClip rawClip;
+                        ReadRawAnimClip(myfile, rawClip, jointCount);
+                        Animation::CompressAnimClip(rawClip, animClip);
+                }
 
+                output.m_Flags = ERESULT_FLAG::SUCCESS;
+        }
+        assert(output.m_Flags != ERESULT_FLAG::INVALID);
+
+        return output;
+}
+
+EResult FileIO::ExportCompressedAnimClipData(const char* fileName, const Animation::FCompressedAnimClip& animClip)
+{
+        EResult output;
+        output.m_Flags = ERESULT_FLAG::INVALID;
+
+        std::ostringstream filePathStream;
+        filePathStream << "../Assets/Animations/" << fileName << ".anim";
+
+        std::ofstream myfile;
+        myfile.open(filePathStream.str(), std::ios::out | std::ios::binary | std::ios::trunc);
+
+        if (myfile.is_open())
+        {
+                uint32_t header[2] = {Animation::kCompressedAnimClipMagic, Animation::kCompressedAnimClipVersion};
+                myfile.write((const char*)header, sizeof(header));
+                myfile.write((const char*)&animClip.duration, sizeof(animClip.duration));
+                myfile.write((const char*)&animClip.jointCount, sizeof(animClip.jointCount));
+                WriteArray(myfile, animClip.times);
+                WriteArray(myfile, animClip.constRotations);
+                WriteArray(myfile, animClip.constTranslations);
+                WriteArray(myfile, animClip.constScales);
+                WriteArray(myfile, animClip.animatedRotationJoints);
+                WriteArray(myfile, animClip.animatedTranslationJoints);
+                WriteArray(myfile, animClip.animatedScaleJoints);
+                WriteArray(myfile, animClip.rotationKeys);
+                WriteArray(myfile, animClip.translationKeys);
+                WriteArray(myfile, animClip.scaleKeys);
 
                 myfile.close();
 
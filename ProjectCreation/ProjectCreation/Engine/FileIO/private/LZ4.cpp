@@ -0,0 +1,194 @@
+#include <LZ4.h>
+
+#include <stdint.h>
+#include <string.h>
+
+namespace FileIO
+{
+        namespace LZ4
+        {
+                namespace
+                {
+                        constexpr size_t   kMinMatch     = 4;
+                        // The last 5 bytes are always literals and the last match starts at least 12 bytes before the end
+                        constexpr size_t   kLastLiterals = 5;
+                        constexpr size_t   kMatchLimit   = 12;
+                        constexpr size_t   kMaxOffset    = 65535;
+                        constexpr unsigned kHashBits     = 12;
+
+                        inline uint32_t Read32(const char* p)
+                        {
+                                uint32_t value;
+                                memcpy(&value, p, sizeof(value));
+                                return value;
+                        }
+
+                        inline uint32_t Hash(uint32_t sequence)
+                        {
+                                return (sequence * 2654435761U) >> (32 - kHashBits);
+                        }
+
+                        // Token nibbles hold lengths up to 14, 15 means more length bytes follow
+                        inline bool WriteLength(char*& op, const char* end, size_t length)
+                        {
+                                for (; length >= 255; length -= 255)
+                                {
+                                        if (op == end)
+                                                return false;
+                                        *op++ = (char)255;
+                                }
+                                if (op == end)
+                                        return false;
+                                *op++ = (char)length;
+                                return true;
+                        }
+
+                        inline bool ReadLength(const uint8_t*& ip, const uint8_t* end, size_t& length)
+                        {
+                                uint8_t next;
+                                do
+                                {
+                                        if (ip == end)
+                                                return false;
+                                        next = *ip++;
+                                        length += next;
+                                } while (next == 255);
+                                return true;
+                        }
+
+                        bool WriteSequence(char*&      op,
+                                           const char* end,
+                                           const char* literals,
+                                           size_t      literalCount,
+                                           size_t      offset,
+                                           size_t      matchLength)
+                        {
+                                if (op == end)
+                                        return false;
+
+                                char*  token        = op++;
+                                size_t matchNibble  = matchLength ? matchLength - kMinMatch : 0;
+                                *token              = (char)((literalCount < 15 ? literalCount : 15) << 4);
+                                *token             |= (char)(matchNibble < 15 ? matchNibble : 15);
+
+                                if (literalCount >= 15 && !WriteLength(op, end, literalCount - 15))
+                                        return false;
+                                if ((size_t)(end - op) < literalCount)
+                                        return false;
+                                if (literalCount)
+                                        memcpy(op, literals, literalCount);
+                                op += literalCount;
+
+                                // The final sequence carries literals only
+                                if (matchLength == 0)
+                                        return true;
+
+                                if (end - op < 2)
+                                        return false;
+                                *op++ = (char)(offset & 0xFF);
+                                *op++ = (char)(offset >> 8);
+
+                                return matchNibble < 15 || WriteLength(op, end, matchNibble - 15);
+                        }
+                } // namespace
+
+                size_t Compress(const char* src, size_t srcSize, char* dst, size_t dstCapacity)
+                {
+                        char*       op     = dst;
+                        const char* end    = dst + dstCapacity;
+                        size_t      anchor = 0;
+
+                        if (srcSize > kMatchLimit)
+                        {
+                                uint32_t table[1 << kHashBits];
+                                memset(table, 0xFF, sizeof(table));
+
+                                const size_t matchEnd = srcSize - kLastLiterals;
+                                const size_t ipLimit  = srcSize - kMatchLimit;
+
+                                size_t ip = 0;
+                                while (ip < ipLimit)
+                                {
+                                        uint32_t sequence  = Read32(src + ip);
+                                        uint32_t hash      = Hash(sequence);
+                                        uint32_t candidate = table[hash];
+                                        table[hash]        = (uint32_t)ip;
+
+                                        if (candidate == UINT32_MAX || ip - candidate > kMaxOffset ||
+                                            Read32(src + candidate) != sequence)
+                                        {
+                                                ++ip;
+                                                continue;
+                                        }
+
+                                        size_t length = kMinMatch;
+                                        while (ip + length < matchEnd && src[candidate + length] == src[ip + length])
+                                                ++length;
+
+                                        if (!WriteSequence(op, end, src + anchor, ip - anchor, ip - candidate, length))
+                                                return 0;
+
+                                        ip += length;
+                                        anchor = ip;
+                                }
+                        }
+
+                        if (!WriteSequence(op, end, src + anchor, srcSize - anchor, 0, 0))
+                                return 0;
+
+                        return (size_t)(op - dst);
+                }
+
+                bool Decompress(const char* src, size_t srcSize, char* dst, size_t dstSize)
+                {
+                        const uint8_t* ip     = reinterpret_cast<const uint8_t*>(src);
+                        const uint8_t* ipEnd  = ip + srcSize;
+                        char*          op     = dst;
+                        char*          opEnd  = dst + dstSize;
+
+                        while (ip < ipEnd)
+                        {
+                                uint8_t token = *ip++;
+
+                                size_t literalCount = token >> 4;
+                                if (literalCount == 15 && !ReadLength(ip, ipEnd, literalCount))
+                                        return false;
+                                if ((size_t)(ipEnd - ip) < literalCount || (size_t)(opEnd - op) < literalCount)
+                                        return false;
+                                if (literalCount)
+                                        memcpy(op, ip, literalCount);
+                                ip += literalCount;
+                                op += literalCount;
+
+                                // A block ends right after the literals of its last sequence
+                                if (ip == ipEnd)
+                                        break;
+
+                                if (ipEnd - ip < 2)
+                                        return false;
+                                size_t offset = (size_t)ip[0] | ((size_t)ip[1] << 8);
+                                ip += 2;
+
+                                size_t matchLength = token & 0xF;
+                                if (matchLength == 15 && !ReadLength(ip, ipEnd, matchLength))
+                                        return false;
+                                matchLength += kMinMatch;
+
+                                if (offset == 0 || offset > (size_t)(op - dst) || (size_t)(opEnd - op) < matchLength)
+                                        return false;
+
+                                // Matches closer than their length overlap their own output and repeat it, so those are
+                                // copied forward one byte at a time
+                                const char* match = op - offset;
+                                if (offset >= matchLength)
+                                        memcpy(op, match, matchLength);
+                                else
+                                        for (size_t i = 0; i < matchLength; ++i)
+                                                op[i] = match[i];
+                                op += matchLength;
+                        }
+
+                        return op == opEnd;
+                }
+        } // namespace LZ4
+} // namespace FileIO
@@ -0,0 +1,101 @@
+#include <MappedFile.h>
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#include <utility>
+
+namespace FileIO
+{
+        FMappedFile::~FMappedFile()
+        {
+                Close();
+        }
+
+        FMappedFile::FMappedFile(FMappedFile&& other) noexcept
+        {
+                *this = std::move(other);
+        }
+
+        FMappedFile& FMappedFile::operator=(FMappedFile&& other) noexcept
+        {
+                if (this != &other)
+                {
+                        Close();
+                        std::swap(m_File, other.m_File);
+                        std::swap(m_Mapping, other.m_Mapping);
+                        std::swap(m_Data, other.m_Data);
+                        std::swap(m_Size, other.m_Size);
+                }
+                return *this;
+        }
+
+        EResult FMappedFile::Open(const char* filePath)
+        {
+                Close();
+
+                EResult output;
+                output.m_Flags = ERESULT_FLAG::INVALID;
+
+                HANDLE file = CreateFileA(
+                    filePath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+                if (file == INVALID_HANDLE_VALUE)
+                        return output;
+
+                LARGE_INTEGER fileSize;
+                if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+                {
+                        // Empty files can't be mapped
+                        CloseHandle(file);
+                        return output;
+                }
+
+                HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if (mapping == nullptr)
+                {
+                        CloseHandle(file);
+                        return output;
+                }
+
+                const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                if (data == nullptr)
+                {
+                        CloseHandle(mapping);
+                        CloseHandle(file);
+                        return output;
+                }
+
+                m_File    = file;
+                m_Mapping = mapping;
+                m_Data    = static_cast<const char*>(data);
+                m_Size    = (size_t)fileSize.QuadPart;
+
+                output.m_Flags = ERESULT_FLAG::SUCCESS;
+                return output;
+        }
+
+        void FMappedFile::Close()
+        {
+                if (m_Data)
+                        UnmapViewOfFile(m_Data);
+                if (m_Mapping)
+                        CloseHandle(m_Mapping);
+                if (m_File)
+                        CloseHandle(m_File);
+
+                m_File    = nullptr;
+                m_Mapping = nullptr;
+                m_Data    = nullptr;
+                m_Size    = 0;
+        }
+
+        void FMappedFile::Prefetch() const
+        {
+                constexpr size_t pageSize = 4096;
+
+                volatile char sink = 0;
+                for (size_t offset = 0; offset < m_Size; offset += pageSize)
+                        sink = m_Data[offset];
+                (void)sink;
+        }
+} // namespace FileIO
\ No newline at end of file
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include <ErrorTypes.h>
+#include <MappedFile.h>
+
+namespace FileIO
+{
+        struct E_ARCHIVE_COMPRESSION
+        {
+                enum
+                {
+                        NONE,
+                        LZ4,
+                        COUNT
+                };
+        };
+
+        // Archive layout: header, blobs each starting on a kArchiveAlignment boundary, the normalized entry paths, then
+        // the table of contents at tocOffset. The table is open addressed on the path hash with linear probing, empty
+        // slots have a zero hash and at least one slot is always empty.
+        constexpr uint32_t kArchiveMagic     = 0x4B415050; // "PPAK"
+        constexpr uint32_t kArchiveVersion   = 2;
+        constexpr uint64_t kArchiveAlignment = 4096;
+
+        struct FArchiveHeader
+        {
+                uint32_t magic;
+                uint32_t version;
+                uint32_t entryCount;
+                // Number of table slots, a power of two
+                uint32_t tableSize;
+                uint64_t tocOffset;
+        };
+
+        struct FArchiveEntry
+        {
+                uint64_t pathHash;
+                // Lowercase path with '/' separators, compared on lookup so a hash collision can't return another asset
+                uint64_t pathOffset;
+                uint64_t offset;
+                uint64_t size;
+                uint64_t storedSize;
+                uint32_t compression;
+                uint32_t pathLength;
+        };
+
+        struct FAssetIOStats
+        {
+                uint32_t archiveReads      = 0;
+                uint32_t looseFileOpens    = 0;
+                uint64_t bytesServed       = 0;
+                uint64_t decompressedBytes = 0;
+                uint64_t openMicroseconds  = 0;
+        };
+
+        // Bytes of one asset, served from the mounted archive when it has the asset and from the loose file under
+        // ../Assets otherwise. Uncompressed archive entries are used in place.
+        class FAssetFile
+        {
+            public:
+                FAssetFile() = default;
+                FAssetFile(FAssetFile&&) = default;
+                FAssetFile& operator=(FAssetFile&&) = default;
+
+                // e.g. Open("Models", "Sphere01", ".mesh")
+                EResult Open(const char* directory, const char* fileName, const char* extension);
+
+                // Touches every page so later reads don't fault, meant to be called from loader threads
+                void Prefetch() const;
+
+                inline const char* GetData() const
+                {
+                        return m_Data;
+                }
+
+                inline size_t GetSize() const
+                {
+                        return m_Size;
+                }
+
+            private:
+                FMappedFile       m_LooseFile;
+                std::vector<char> m_Decompressed;
+                const char*       m_Data = nullptr;
+                size_t            m_Size = 0;
+        };
+
+        namespace AssetArchive
+        {
+                constexpr const char* kDefaultArchivePath = "../Assets/Assets.pak";
+
+                // Maps the archive for the lifetime of the mount. Without a mounted archive every asset is read loose
+                EResult Mount(const char* archivePath);
+                void    Unmount();
+                bool    IsMounted();
+
+                // Case insensitive, '\\' and '/' are treated the same
+                uint64_t HashPath(const char* relativePath);
+
+                // Looks an asset up by its path relative to the asset root, e.g. "Models/Sphere01.mesh"
+                const FArchiveEntry* Find(const char* relativePath);
+                const char*          GetArchiveData();
+                size_t               GetArchiveSize();
+
+                // Packs every file in the directories FileIO reads from into one archive. Entries that shrink by at least
+                // a quarter are LZ4 compressed, except meshes which are mapped in place.
+                EResult Build(const char* assetRoot, const char* archivePath);
+
+                FAssetIOStats GetStats();
+        } // namespace AssetArchive
+} // namespace FileIO
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <BasicIOTypes.h>
+#include <AssetArchive.h>
 
 #include <vector>
 
@@ -19,5 +20,19 @@ namespace FileIO
                 file_path_t                   materialName;
         };
 
+        // .skel file mapped in place. Joints hold SIMD transforms that need more alignment than the file gives them,
+        // so only they are copied out.
+        struct FSkeletalMeshView
+        {
+                FAssetFile                     file;
+                std::vector<Animation::FJoint> joints;
+                std::vector<Animation::FJoint> inverseJoints;
+                const char*                    materialName = nullptr;
+                const FSkinnedVertex*          vertices     = nullptr;
+                const uint32_t*                indices      = nullptr;
+                uint32_t                       vertexCount  = 0;
+                uint32_t                       indexCount   = 0;
+        };
+
 
 } // namespace FileIO
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <vector>
 
 #include <BasicIOTypes.h>
+#include <AssetArchive.h>
 
 #include <Vertex.h>
 
@@ -16,4 +17,15 @@ namespace FileIO
                 std::vector<uint32_t> indices;
                 file_path_t           materialName;
         };
+
+        // .mesh file mapped in place. The pointers point into the asset data and stay valid while the view lives.
+        struct FStaticMeshView
+        {
+                FAssetFile      file;
+                const char*     materialName = nullptr;
+                const FVertex*  vertices     = nullptr;
+                const uint32_t* indices      = nullptr;
+                uint32_t        vertexCount  = 0;
+                uint32_t        indexCount   = 0;
+        };
 } // namespace FileIO
\ No newline at end of file
@@ -6,7 +6,7 @@
 
 #include <DDSTextureLoader.h>
 
-#include <AnimationContainers.h>
+#include <AnimationCompression.h>
 
 #include <FMaterial.h>
 #include <FSkeletalMesh.h>
@@ -17,7 +17,15 @@ namespace FileIO
 {
         EResult LoadStaticMeshDataFromFile(const char* fileName, FStaticMeshData* staticMeshOutput);
         EResult LoadSkeletalMeshDataFromFile(const char* fileName, FSkeletalMeshData* skelMeshOutput);
+        // Map the file and validate its counts against the file size instead of copying the vertex and index data
+        EResult MapStaticMeshFile(const char* fileName, FStaticMeshView* staticMeshOutput);
+        EResult MapSkeletalMeshFile(const char* fileName, FSkeletalMeshView* skelMeshOutput);
         EResult LoadMaterialDataFromFile(const char* fileName, FMaterialData* matDataOutput);
         EResult LoadShaderDataFromFile(const char* fileName, const char* suffix, FShaderData* shaderDataOutput);
         EResult ImportAnimClipData(const char* fileName, Animation::FAnimClip& animClip, const Animation::FSkeleton& skeleton);
+        // Reads a compressed .anim, raw .anim files are compressed at load
+        EResult ImportCompressedAnimClipData(const char*                     fileName,
+                                             Animation::FCompressedAnimClip& animClip,
+                                             const Animation::FSkeleton&     skeleton);
+        EResult ExportCompressedAnimClipData(const char* fileName, const Animation::FCompressedAnimClip& animClip);
 }
\ No newline at end of file
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <stddef.h>
+
+// Compressor and decompressor for the LZ4 block format (https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md).
+// Blocks are interchangeable with the reference implementation, the compressor is a plain greedy single hash probe.
+namespace FileIO
+{
+        namespace LZ4
+        {
+                // Worst case compressed size of incompressible input
+                inline constexpr size_t CompressBound(size_t size)
+                {
+                        return size + size / 255 + 16;
+                }
+
+                // Returns the compressed size, or 0 if the output didn't fit in dstCapacity
+                size_t Compress(const char* src, size_t srcSize, char* dst, size_t dstCapacity);
+
+                // Returns false for malformed input or if the block doesn't decompress to exactly dstSize bytes
+                bool Decompress(const char* src, size_t srcSize, char* dst, size_t dstSize);
+        } // namespace LZ4
+} // namespace FileIO
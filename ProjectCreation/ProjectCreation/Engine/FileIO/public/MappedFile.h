@@ -0,0 +1,51 @@
+#pragma once
+
+#include <stddef.h>
+
+#include <ErrorTypes.h>
+
+namespace FileIO
+{
+        // Read-only mapping of a whole file. Pages are faulted in on first touch and stay backed by the file itself, so
+        // keeping a large asset mapped costs address space rather than heap memory.
+        class FMappedFile
+        {
+            public:
+                FMappedFile() = default;
+                ~FMappedFile();
+
+                FMappedFile(FMappedFile&& other) noexcept;
+                FMappedFile& operator=(FMappedFile&& other) noexcept;
+
+                FMappedFile(const FMappedFile&) = delete;
+                FMappedFile& operator=(const FMappedFile&) = delete;
+
+                EResult Open(const char* filePath);
+                void    Close();
+
+                // Touches every page so later reads don't fault, meant to be called from loader threads
+                void Prefetch() const;
+
+                inline const char* GetData() const
+                {
+                        return m_Data;
+                }
+
+                inline size_t GetSize() const
+                {
+                        return m_Size;
+                }
+
+                inline bool IsOpen() const
+                {
+                        return m_Data != nullptr;
+                }
+
+            private:
+                // Win32 HANDLEs, kept as void* so Windows.h stays out of the header
+                void*       m_File    = nullptr;
+                void*       m_Mapping = nullptr;
+                const char* m_Data    = nullptr;
+                size_t      m_Size    = 0;
+        };
+} // namespace FileIO
\ No newline at end of file
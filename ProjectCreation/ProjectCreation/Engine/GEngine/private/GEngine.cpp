@@ -3,9 +3,20 @@
 #include <JobScheduler.h>
 #include "GEngine.h"
 #include <MathLibrary.h>
-GEngine*         GEngine::instance        = 0;
-bool             GEngine::ShowFPS         = false;
-NMemory::memsize GEngine::s_PoolAllocSize = MB(64);
+#include <MemoryTracking.h>
+#include <fstream>
+GEngine*         GEngine::instance         = 0;
+bool             GEngine::ShowFPS          = false;
+NMemory::memsize GEngine::s_PoolAllocSize  = MB(64);
+NMemory::memsize GEngine::s_FrameAllocSize = MB(2);
+
+namespace
+{
+        constexpr const char* kJobTelemetryPath = "jobs.json";
+
+        // Scheduler totals at the end of the previous frame
+        std::vector<JobThreadTelemetry> g_LastJobTelemetry;
+} // namespace
 
 void GEngine::SetGamePaused(bool val)
 {
@@ -22,16 +33,17 @@ void GEngine::SetGamePaused(bool val)
 
 void GEngine::Initialize()
 {
+        Profiler::Initialize();
         JobScheduler::Initialize();
         instance = new GEngine;
 
-        NMemory::ReserveGameMemory(instance->m_PoolMemory, s_PoolAllocSize);
+        NMemory::MemoryTracking::SetBudget(NMemory::E_MEMORY_TAG::ECS_POOLS, s_PoolAllocSize);
+        NMemory::ReserveGameMemory(instance->m_PoolMemory, s_PoolAllocSize, NMemory::E_MEMORY_TAG::ECS_POOLS);
+        NMemory::FrameAllocator::Initialize(s_FrameAllocSize);
 
         instance->m_HandleManager =
             new HandleManager(instance->m_ComponentPools, instance->m_EntityPools, instance->m_PoolMemory);
 
-        instance->m_MainThreadProfilingContext.Initialize();
-
         instance->m_SystemManager     = new     SystemManager;
         instance->m_ResourceManager   = new   ResourceManager;
         instance->m_LevelStateManager = new LevelStateManager;
@@ -46,13 +58,18 @@ void GEngine::Shutdown()
         instance->m_ResourceManager->Shutdown();
         instance->m_HandleManager->Shutdown();
         instance->m_LevelStateManager->Shutdown();
+        instance->WriteJobTelemetry(kJobTelemetryPath);
         JobScheduler::Shutdown();
+        // Workers have stopped and the systems naming the events still exist
+        Profiler::Shutdown();
+        NMemory::FrameAllocator::Shutdown();
         NMemory::FreeGameMemory(instance->m_PoolMemory);
         delete instance->m_HandleManager;
         delete instance->m_SystemManager;
         delete instance->m_ResourceManager;
         delete instance->m_LevelStateManager;
-        GEngine::Get()->m_MainThreadProfilingContext.Dump();
+        Counters::Shutdown();
+        NMemory::MemoryTracking::WriteReport("memory.json");
         delete instance;
 }
 
@@ -73,9 +90,130 @@ float GEngine::Update()
         m_CurrentPuzzleState = MathLibrary::MoveTowards(m_CurrentPuzzleState, m_TargetPuzzleState, 1.0f * deltaTime);
 
         GetLevelStateManager()->Update(deltaTime);
+        m_ResourceManager->Update();
         return deltaTime;
 }
 
+void GEngine::EndFrame()
+{
+#ifdef COUNTERS
+        COUNTER_SET("Frame/Time us", GetDeltaTime() * 1000000.0f);
+
+        // Live elements per pool, pools are appended as component types get used
+        const auto& componentCounts = m_ComponentPools.m_element_counts;
+        for (size_t i = m_ComponentPoolCounterIds.size(); i < componentCounts.size(); ++i)
+                m_ComponentPoolCounterIds.push_back(
+                    Counters::Register("ECS/Component pool " + std::to_string(i), E_COUNTER_MODE::SAMPLE));
+        for (size_t i = 0; i < componentCounts.size(); ++i)
+                Counters::Set(m_ComponentPoolCounterIds[i], componentCounts[i]);
+        COUNTER_SET("ECS/Entities", m_EntityPools.m_element_counts.empty() ? 0 : m_EntityPools.m_element_counts[0]);
+
+        uint64_t allocationCount = 0;
+        for (int tag = 0; tag < NMemory::E_MEMORY_TAG::COUNT; ++tag)
+                allocationCount += NMemory::MemoryTracking::GetTagStats(tag).allocationCount;
+        COUNTER_SET("Memory/Allocations", allocationCount - m_LastAllocationCount);
+        m_LastAllocationCount = allocationCount;
+
+#endif
+        RecordJobTelemetry();
+#ifdef COUNTERS
+        Counters::EndFrame();
+#endif
+}
+
+void GEngine::RecordJobTelemetry()
+{
+        // Frame deltas of the scheduler totals, summed into counters and per thread as profiler counter tracks
+        unsigned threadCount         = JobScheduler::GetThreadCount();
+        double   ticksPerMicrosecond = Profiler::GetTicksPerMicrosecond();
+        g_LastJobTelemetry.resize(threadCount, JobThreadTelemetry{});
+
+        JobThreadTelemetry frame{};
+        for (unsigned i = 0; i < threadCount; ++i)
+        {
+                JobThreadTelemetry  current = JobScheduler::GetThreadTelemetry(i);
+                JobThreadTelemetry& last    = g_LastJobTelemetry[i];
+
+                JobThreadTelemetry delta;
+                delta.pushes        = current.pushes - last.pushes;
+                delta.pops          = current.pops - last.pops;
+                delta.steals        = current.steals - last.steals;
+                delta.failed_steals = current.failed_steals - last.failed_steals;
+                delta.executed      = current.executed - last.executed;
+                delta.execute_ticks = current.execute_ticks - last.execute_ticks;
+                delta.idle_ticks    = current.idle_ticks - last.idle_ticks;
+                last                = current;
+
+#ifdef PROFILING
+                const char* name = JobScheduler::GetThreadName(i);
+                Profiler::RecordCounter("Job steals", name, double(delta.steals));
+                Profiler::RecordCounter("Job failed steals", name, double(delta.failed_steals));
+                Profiler::RecordCounter("Job executed", name, double(delta.executed));
+                Profiler::RecordCounter("Job execute us", name, double(delta.execute_ticks) / ticksPerMicrosecond);
+                Profiler::RecordCounter("Job idle us", name, double(delta.idle_ticks) / ticksPerMicrosecond);
+#endif
+                frame.pushes += delta.pushes;
+                frame.pops += delta.pops;
+                frame.steals += delta.steals;
+                frame.failed_steals += delta.failed_steals;
+                frame.executed += delta.executed;
+                frame.execute_ticks += delta.execute_ticks;
+                frame.idle_ticks += delta.idle_ticks;
+        }
+
+        COUNTER_SET("Jobs/Pushes", frame.pushes);
+        COUNTER_SET("Jobs/Pops", frame.pops);
+        COUNTER_SET("Jobs/Steals", frame.steals);
+        COUNTER_SET("Jobs/Failed steals", frame.failed_steals);
+        COUNTER_SET("Jobs/Executed", frame.executed);
+        COUNTER_SET("Jobs/Execute us", double(frame.execute_ticks) / ticksPerMicrosecond);
+        COUNTER_SET("Jobs/Idle us", double(frame.idle_ticks) / ticksPerMicrosecond);
+}
+
+void GEngine::WriteJobTelemetry(const char* fileName)
+{
+        std::ofstream file(fileName, std::ios::out | std::ios::trunc);
+        if (!file.is_open())
+                return;
+
+        double ticksPerMicrosecond = Profiler::GetTicksPerMicrosecond();
+
+        file << "{\n  \"threads\": [\n";
+        unsigned threadCount = JobScheduler::GetThreadCount();
+        for (unsigned i = 0; i < threadCount; ++i)
+        {
+                JobThreadTelemetry telemetry = JobScheduler::GetThreadTelemetry(i);
+                file << "    { \"name\": \"" << JobScheduler::GetThreadName(i) << "\", \"pushes\": " << telemetry.pushes
+                     << ", \"pops\": " << telemetry.pops << ", \"steals\": " << telemetry.steals
+                     << ", \"failed_steals\": " << telemetry.failed_steals << ", \"executed\": " << telemetry.executed
+                     << ", \"execute_us\": " << double(telemetry.execute_ticks) / ticksPerMicrosecond
+                     << ", \"idle_us\": " << double(telemetry.idle_ticks) / ticksPerMicrosecond << " }"
+                     << (i + 1 < threadCount ? ",\n" : "\n");
+        }
+
+        // Buckets are written as their lower edge in microseconds, empty buckets are skipped
+        file << "  ],\n  \"parallel_for\": [\n";
+        unsigned histogramCount = JobScheduler::GetChunkHistogramCount();
+        for (unsigned i = 0; i < histogramCount; ++i)
+        {
+                const ChunkHistogram& histogram = JobScheduler::GetChunkHistogram(i);
+                double average = histogram.count ? double(histogram.total_ticks) / histogram.count / ticksPerMicrosecond : 0.0;
+                file << "    { \"name\": \"" << histogram.name << "\", \"chunks\": " << histogram.count
+                     << ", \"average_us\": " << average << ", \"buckets\": {";
+                bool first = true;
+                for (unsigned bucket = 0; bucket < ChunkHistogram::BUCKET_COUNT; ++bucket)
+                {
+                        if (histogram.buckets[bucket] == 0)
+                                continue;
+                        file << (first ? " \"" : ", \"") << double(1ULL << bucket) / ticksPerMicrosecond
+                             << "\": " << histogram.buckets[bucket];
+                        first = false;
+                }
+                file << " } }" << (i + 1 < histogramCount ? ",\n" : "\n");
+        }
+        file << "  ]\n}";
+}
+
 void GEngine::Signal()
 {
         m_XTime.Signal();
@@ -8,6 +8,7 @@
 #define ENTITY_MANAGER GEngine::Get()->GetHandleManager()
 #define RESOURCE_MANAGER GEngine::Get()->GetResourceManager()
 
+#include <Counters.h>
 #include <HandleManager.h>
 #include <Profiling.h>
 #include <ResourceManager.h>
@@ -20,17 +21,25 @@
 class GEngine
 {
         static NMemory::memsize            s_PoolAllocSize;
+        static NMemory::memsize            s_FrameAllocSize;
         NMemory::MemoryStack               m_PoolMemory;
         NMemory::NPools::RandomAccessPools m_ComponentPools;
         NMemory::NPools::RandomAccessPools m_EntityPools;
 
         HandleManager*   m_HandleManager;
         SystemManager*   m_SystemManager;
+
+        std::vector<unsigned> m_ComponentPoolCounterIds;
+        uint64_t              m_LastAllocationCount = 0;
         ResourceManager* m_ResourceManager;
 
         XTime m_XTime;
 
         static GEngine* instance;
+
+        void RecordJobTelemetry();
+        // Per thread scheduler totals and the ParallelFor chunk histograms
+        void WriteJobTelemetry(const char* fileName);
     public:
         bool            m_DebugMode     = false;
         bool            m_GameIsPaused  = false;
@@ -66,9 +75,8 @@ class GEngine
                 return m_PlayerRadius;
         }
 
-        float           m_TerrainAlpha = 0.0f;
-        EntityHandle    m_SunHandle;
-        ProfilerContext m_MainThreadProfilingContext;
+        float        m_TerrainAlpha = 0.0f;
+        EntityHandle m_SunHandle;
 
         void        SetGamePaused(bool val);
         inline bool GetGamePaused()
@@ -82,6 +90,8 @@ class GEngine
         static GEngine* Get();
 
         float Update();
+        // Samples the engine wide counters and closes the frame's counter windows
+        void EndFrame();
 
         HandleManager*          GetHandleManager();
         SystemManager*          GetSystemManager();
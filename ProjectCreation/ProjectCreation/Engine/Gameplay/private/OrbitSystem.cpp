@@ -27,13 +27,14 @@ EntityHandle OrbitSystem::CreateGoal(int color, DirectX::XMVECTOR position)
         /*** REFACTORING CODE START ***/
         ComponentHandle transHandle, transHandle2;
 
-        auto entityH1   = EntityFactory::CreateStaticMeshEntity(planetMeshNames[color], materialNames[color], &transHandle);
+        auto entityH1 =
+            EntityFactory::CreateStaticMeshEntity(m_PlanetMeshHandles[color], m_MaterialHandles[color], &transHandle);
         auto goalHandle = entityH1.AddComponent<GoalComponent>();
         auto goalComp   = goalHandle.Get<GoalComponent>();
         auto transComp  = transHandle.Get<TransformComponent>();
 
-        auto entityH2 =
-            EntityFactory::CreateStaticMeshEntity(planetMeshNames[color], materialNames[color], &transHandle2, nullptr, false);
+        auto entityH2 = EntityFactory::CreateStaticMeshEntity(
+            m_PlanetMeshHandles[color], m_MaterialHandles[color], &transHandle2, nullptr, false);
         auto transComp2           = transHandle2.Get<TransformComponent>();
         goalComp->color           = color;
         goalComp->collisionHandle = transHandle2;
@@ -57,7 +58,7 @@ EntityHandle OrbitSystem::CreateGoal(int color, DirectX::XMVECTOR position)
         for (int i = 0; i < 3; ++i)
         {
                 ComponentHandle torusTransHandle;
-                EntityFactory::CreateStaticMeshEntity("GoalTorus00", materialNames[color], &torusTransHandle);
+                EntityFactory::CreateStaticMeshEntity(m_GoalTorusMeshHandle, m_MaterialHandles[color], &torusTransHandle);
                 goalComp->goalRings.push_back(torusTransHandle);
                 auto trans                   = torusTransHandle.Get<TransformComponent>();
                 trans->transform.translation = position;
@@ -294,44 +295,29 @@ void OrbitSystem::OnInitialize()
                 auto mat    = m_ResourceManager->GetResource<Material>(handle);
                 XMStoreFloat3(&mat->m_SurfaceProperties.emissiveColor,
                               4.5f * DirectX::PackedVector::XMLoadColor(&E_LIGHT_ORBS::RING_COLORS[i]));
+                m_MaterialHandles[i] = handle;
         }
-
-        std::string ring1MaterialName = "Ring01Mat", ring2MaterialName = "Ring02Mat", ring3MaterialName = "Ring03Mat";
+        m_MaterialHandles[3] = m_ResourceManager->LoadMaterialAsync(materialNames[3]);
 
         auto baseRingMaterial = m_ResourceManager->LoadMaterial("GlowMatRing");
 
-        // Red Ring Material
-        {
-                auto ring1MaterialHandle =
-                    m_ResourceManager->CopyResource<Material>(baseRingMaterial, ring1MaterialName.c_str());
-
-                auto ring1Material = m_ResourceManager->GetResource<Material>(ring1MaterialHandle);
-
-                XMStoreFloat3(&ring1Material->m_SurfaceProperties.emissiveColor,
-                              1.5f * DirectX::PackedVector::XMLoadColor(&E_LIGHT_ORBS::RING_COLORS[0]));
-        }
-
-        // Green Ring Material
+        // Red, green and blue ring materials
+        for (int i = 0; i < 3; ++i)
         {
-                auto ring2MaterialHandle =
-                    m_ResourceManager->CopyResource<Material>(baseRingMaterial, ring2MaterialName.c_str());
-
-                auto ring2Material = m_ResourceManager->GetResource<Material>(ring2MaterialHandle);
-
-                XMStoreFloat3(&ring2Material->m_SurfaceProperties.emissiveColor,
-                              1.5f * DirectX::PackedVector::XMLoadColor(&E_LIGHT_ORBS::RING_COLORS[1]));
+                auto handle = m_ResourceManager->CopyResource<Material>(baseRingMaterial, ringMaterialNames[i]);
+                auto mat    = m_ResourceManager->GetResource<Material>(handle);
+                XMStoreFloat3(&mat->m_SurfaceProperties.emissiveColor,
+                              1.5f * DirectX::PackedVector::XMLoadColor(&E_LIGHT_ORBS::RING_COLORS[i]));
+                m_RingMaterialHandles[i] = handle;
         }
 
-        // Blue Ring Material
+        for (int i = 0; i < 3; ++i)
         {
-                auto ring3MaterialHandle =
-                    m_ResourceManager->CopyResource<Material>(baseRingMaterial, ring3MaterialName.c_str());
-
-                auto ring3Material = m_ResourceManager->GetResource<Material>(ring3MaterialHandle);
-
-                XMStoreFloat3(&ring3Material->m_SurfaceProperties.emissiveColor,
-                              1.5f * DirectX::PackedVector::XMLoadColor(&E_LIGHT_ORBS::RING_COLORS[2]));
+                m_RingMeshHandles[i]   = m_ResourceManager->LoadStaticMeshAsync(ringMeshNames[i]);
+                m_PlanetMeshHandles[i] = m_ResourceManager->LoadStaticMeshAsync(planetMeshNames[i]);
         }
+        m_GoalTorusMeshHandle = m_ResourceManager->LoadStaticMeshAsync("GoalTorus00");
+        m_SunMeshHandle       = m_ResourceManager->LoadStaticMeshAsync("Sphere01");
 }
 
 void OrbitSystem::OnShutdown()
@@ -346,7 +332,8 @@ void OrbitSystem::OnSuspend()
 EntityHandle OrbitSystem::CreateSun()
 {
         ComponentHandle transHandle;
-        auto            eh = EntityFactory::CreateStaticMeshEntity("Sphere01", "GlowMatSun", &transHandle, nullptr, false);
+        auto            eh =
+            EntityFactory::CreateStaticMeshEntity(m_SunMeshHandle, m_MaterialHandles[3], &transHandle, nullptr, false);
         auto            sunTransform = transHandle.Get<TransformComponent>();
         sunTransform->transform.SetScale(0.0f);
         sunAlignedTransforms.push_back(transHandle);
@@ -357,8 +344,8 @@ EntityHandle OrbitSystem::CreateSun()
 EntityHandle OrbitSystem::CreateRing(int color)
 {
         ComponentHandle transHandle;
-        auto            eh =
-            EntityFactory::CreateStaticMeshEntity(ringMeshNames[color], ringMaterialNames[color], &transHandle, nullptr, false);
+        auto            eh = EntityFactory::CreateStaticMeshEntity(
+            m_RingMeshHandles[color], m_RingMaterialHandles[color], &transHandle, nullptr, false);
         auto transformComp = transHandle.Get<TransformComponent>();
         transformComp->transform.SetScale(0.0f);
         sunAlignedTransforms.push_back(transHandle);
@@ -205,9 +205,9 @@ EntityHandle SpeedBoostSystem::SpawnSplineOrb(SplineCluster& cluster, int cluste
 
 EntityHandle SpeedBoostSystem::SpawnLightOrb(const DirectX::XMVECTOR& pos, int color)
 {
-        std::string name = speedboostMeshNames[3];
+        ResourceHandle mesh = speedboostMeshes[3];
         if (color >= 4)
-                name = speedboostMeshNames[color % 4];
+                mesh = speedboostMeshes[color % 4];
 
         color = color % 4;
 
@@ -215,8 +215,7 @@ EntityHandle SpeedBoostSystem::SpawnLightOrb(const DirectX::XMVECTOR& pos, int c
         ComponentHandle transHandle;
 
 
-        auto entityHandle =
-            EntityFactory::CreateStaticMeshEntity(name.c_str(), speedboostMaterialNames[color].c_str(), &orbHandle);
+        auto entityHandle = EntityFactory::CreateStaticMeshEntity(mesh, speedboostMaterials[color], &orbHandle);
         orbHandle = m_HandleManager->AddComponent<OrbComponent>(entityHandle);
 
         OrbComponent*       orbComp       = orbHandle.Get<OrbComponent>();
@@ -678,26 +677,38 @@ void SpeedBoostSystem::OnUpdate(float deltaTime)
 
                 float checkRadius = m_SplineLatchRadius;
                 bool  foundFriend = false;
-                float prevDistance;
-                float prevDot;
+
+                // The spline orb to latch onto, combined in component order so the result matches a serial loop
+                struct FSplineCandidate
+                {
+                        float           distance;
+                        ComponentHandle handle;
+                        bool            found;
+                };
+                FSplineCandidate latched = {INFINITY, ComponentHandle(), false};
 
                 if (latchedSplineIndex != -1)
                 {
                         SpeedboostSplineComponent* closestSplineComp = latchedSplineHandle.Get<SpeedboostSplineComponent>();
                         TransformComponent* transComp = closestSplineComp->GetParent().GetComponent<TransformComponent>();
                         XMVECTOR prevVector = transComp->transform.translation - playerTransform->transform.translation;
-                        prevDistance        = MathLibrary::CalulateVectorLength(prevVector);
-                        prevVector          = XMVector3Normalize(prevVector);
-                        prevDot = MathLibrary::VectorDotProduct(prevVector, playerTransform->transform.GetForward());
-                }
-                else
-                {
-                        prevDistance = INFINITY;
-                        prevDot      = -1.0f;
+                        latched.distance    = MathLibrary::CalulateVectorLength(prevVector);
                 }
 
-                bool shouldLatch = false;
+                // While unlatched any orb in range replaces the previous one, otherwise only a closer one does
+                const bool isLatched        = latchedSplineIndex != -1;
+                auto       replaceCandidate = [isLatched](FSplineCandidate& lhs, const FSplineCandidate& rhs) {
+                        if (rhs.found && (!isLatched || rhs.distance < lhs.distance))
+                                lhs = rhs;
+                };
 
+                // Cached points are refreshed serially, the reduce below only compares the orbs that can be latched
+                struct FSplineOrb
+                {
+                        XMVECTOR        pos;
+                        ComponentHandle handle;
+                };
+                NMemory::FrameVector<FSplineOrb> orbs;
 
                 for (auto& splineComp : m_HandleManager->GetActiveComponents<SpeedboostSplineComponent>())
                 {
@@ -706,32 +717,32 @@ void SpeedBoostSystem::OnUpdate(float deltaTime)
 
                         auto clusterIt = m_SplineClusterSpawners.find(clusterID);
 
-
                         XMVECTOR pos = splineComp.GetParent().GetComponent<TransformComponent>()->transform.translation;
                         clusterIt->second.cachedPoints[index].pos   = pos;
                         clusterIt->second.cachedPoints[index].color = splineComp.color;
-                        int splineColor                             = splineComp.color;
-
-                        XMVECTOR dirVector = pos - playerTransform->transform.translation;
-                        float    distance  = MathLibrary::CalulateVectorLength(dirVector);
-                        dirVector          = XMVector3Normalize(dirVector);
-                        float dot          = MathLibrary::VectorDotProduct(dirVector, playerTransform->transform.GetForward());
 
                         if (clusterIt->second.shouldDestroy == true)
                                 continue;
 
-                        if (distance < (checkRadius))
-                        {
-                                if ((latchedSplineIndex == -1 || distance < prevDistance))
-                                {
-                                        prevDistance        = distance;
-                                        prevDot             = dot;
-                                        latchedSplineHandle = splineComp.GetHandle();
-                                        shouldLatch         = true;
-                                }
-                        }
+                        orbs.push_back({pos, splineComp.GetHandle()});
                 }
 
+                const XMVECTOR   playerPos = playerTransform->transform.translation;
+                FSplineCandidate closest   = ParallelReduce((unsigned)orbs.size(),
+                                                          latched,
+                                                          [&](FSplineCandidate& candidate, unsigned i) {
+                                                                  float distance =
+                                                                      MathLibrary::CalulateVectorLength(orbs[i].pos - playerPos);
+                                                                  if (distance < checkRadius)
+                                                                          replaceCandidate(candidate,
+                                                                                           {distance, orbs[i].handle, true});
+                                                          },
+                                                          replaceCandidate);
+
+                bool shouldLatch = closest.found;
+                if (shouldLatch)
+                        latchedSplineHandle = closest.handle;
+
                 int latchedColor = -1;
 
                 bool inPath = false;
@@ -1049,6 +1060,7 @@ void SpeedBoostSystem::OnInitialize()
                 speedboostMaterials[i] = handle;
                 XMStoreFloat3(&mat->m_SurfaceProperties.emissiveColor,
                               2.0f * DirectX::PackedVector::XMLoadColor(&E_LIGHT_ORBS::ORB_COLORS[i]));
+                speedboostMeshes[i] = m_ResourceManager->LoadStaticMeshAsync(speedboostMeshNames[i].c_str());
         }
 
 
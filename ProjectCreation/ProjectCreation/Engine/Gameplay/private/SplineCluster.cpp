@@ -10,15 +10,14 @@ SplineCluster::SplineCluster(const FGoodSpline& _spline) : spline(_spline)
 
 void SplineCluster::BakeStartAndEnd()
 {
-        start           = spline.GetPointAtTime(0.0f);
-        start           = XMVector3Transform(start, transform);
-        XMVECTOR start2 = spline.GetPointAtTime(0.01f);
-        start2          = XMVector3Transform(start2, transform);
-
-        end           = spline.GetPointAtTime(1.0f);
-        end           = XMVector3Transform(end, transform);
-        XMVECTOR end2 = spline.GetPointAtTime(0.99f);
-        end2          = XMVector3Transform(end2, transform);
+        const float times[4] = {0.0f, 0.01f, 1.0f, 0.99f};
+        XMVECTOR    points[4];
+        spline.EvaluateN(times, points, 4);
+
+        start           = XMVector3Transform(points[0], transform);
+        XMVECTOR start2 = XMVector3Transform(points[1], transform);
+        end             = XMVector3Transform(points[2], transform);
+        XMVECTOR end2   = XMVector3Transform(points[3], transform);
 
         start -= XMVector3Normalize(start - start2) * 5.0f;
         end += XMVector3Normalize(end - end2) * 5.0f;
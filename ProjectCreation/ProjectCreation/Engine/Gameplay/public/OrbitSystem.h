@@ -26,6 +26,15 @@ class OrbitSystem : public ISystem
         const char* ringMaterialNames[3] = {"Ring01Mat", "Ring02Mat", "Ring03Mat"};
         const char* ringMeshNames[3]     = {"Ring01", "Ring02", "Ring03"};
         const char* planetMeshNames[3]     = {"Planet00", "Planet01", "Planet02"};
+
+        // Resolved once in OnInitialize, spawning creates entities straight from the handles
+        ResourceHandle m_MaterialHandles[4];
+        ResourceHandle m_RingMaterialHandles[3];
+        ResourceHandle m_RingMeshHandles[3];
+        ResourceHandle m_PlanetMeshHandles[3];
+        ResourceHandle m_GoalTorusMeshHandle;
+        ResourceHandle m_SunMeshHandle;
+
         int         m_Stage              = 0;
         EntityHandle CreateGoal(int color, DirectX::XMVECTOR position);
 
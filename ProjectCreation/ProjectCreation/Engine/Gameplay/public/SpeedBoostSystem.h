@@ -38,6 +38,7 @@ class SpeedBoostSystem : public ISystem
         ResourceHandle speedboostMaterials[E_LIGHT_ORBS::COUNT]  = {};
         std::string speedboostMaterialNames[E_LIGHT_ORBS::COUNT] = {"SpeedboostR", "SpeedboostG", "SpeedboostB", "SpeedboostW"};
         std::string speedboostMeshNames[E_LIGHT_ORBS::COUNT]     = {"RedOrb00", "GreenOrb00", "BlueOrb00", "Sphere01"};
+        ResourceHandle speedboostMeshes[E_LIGHT_ORBS::COUNT]     = {};
 
         // GW::AUDIO::GMusic* m_Spline_Ambience;
 
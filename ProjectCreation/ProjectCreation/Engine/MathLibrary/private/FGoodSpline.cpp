@@ -1,37 +1,139 @@
 #include <FGoodSpline.h>
 #include <MathLibrary.h>
 
+#include <algorithm>
+
+using namespace DirectX;
+
 FGoodSpline::FGoodSpline(const std::vector<DirectX::XMVECTOR>& points)
 {
-        m_Spline = Spline<DirectX::XMVECTOR, float>(3, spline::eUNIFORM);
-
-        length      = 0.0f;
         size_t size = points.size();
 
-        for (size_t i = 1; i < size; ++i)
+        if (size < 3)
         {
-                length += MathLibrary::CalulateDistance(points[i], points[i - 1]);
+                // Too few points for a quadratic span, the curve falls back to the straight line through them, a single
+                // point or the origin
+                FSegment segment;
+                segment.a = size > 0 ? points[0] : XMVectorZero();
+                segment.b = size > 1 ? points[1] - points[0] : XMVectorZero();
+                segment.c = XMVectorZero();
+                m_Segments.push_back(segment);
         }
-		
-        m_Spline.set_ctrl_points(points);
+        else
+        {
+                // Each knot span blends three neighbouring control points, the curve starts and ends at the midpoints
+                // of the first and last legs
+                m_Segments.resize(size - 2);
+                for (size_t i = 0; i < m_Segments.size(); ++i)
+                {
+                        const XMVECTOR& p0 = points[i];
+                        const XMVECTOR& p1 = points[i + 1];
+                        const XMVECTOR& p2 = points[i + 2];
 
+                        m_Segments[i].a = (p0 + p1) * 0.5f;
+                        m_Segments[i].b = p1 - p0;
+                        m_Segments[i].c = (p0 - p1 * 2.0f + p2) * 0.5f;
+                }
+        }
+
+        unsigned int sampleCount = (unsigned int)m_Segments.size() * kArcSamplesPerSegment;
+        m_ArcLengths.resize(sampleCount + 1);
+        m_ArcLengths[0] = 0.0f;
+
+        XMVECTOR prev = m_Segments[0].a;
+        for (unsigned int i = 1; i <= sampleCount; ++i)
+        {
+                unsigned int segment = (i - 1) / kArcSamplesPerSegment;
+                float        t       = float(i - segment * kArcSamplesPerSegment) / kArcSamplesPerSegment;
+                XMVECTOR     curr    = EvaluateSegment(segment, XMVectorReplicate(t));
+                m_ArcLengths[i]      = m_ArcLengths[i - 1] + MathLibrary::CalulateDistance(curr, prev);
+                prev                 = curr;
+        }
 
+        length  = m_ArcLengths.back();
         pointer = 0.0f;
 }
 
-DirectX::XMVECTOR FGoodSpline::GetCurrentPoint()
+DirectX::XMVECTOR FGoodSpline::EvaluateSegment(unsigned int segment, DirectX::FXMVECTOR t) const
 {
-        return m_Spline.eval_f(pointer / length);
+        const FSegment& coefficients = m_Segments[segment];
+        return XMVectorMultiplyAdd(XMVectorMultiplyAdd(coefficients.c, t, coefficients.b), t, coefficients.a);
 }
 
-DirectX::XMVECTOR FGoodSpline::GetPointAtTime(float time)
+DirectX::XMVECTOR FGoodSpline::GetCurrentPoint() const
 {
-        return m_Spline.eval_f(time);
+        return GetPointAtDistance(pointer);
 }
 
-DirectX::XMVECTOR FGoodSpline::GetSpeedAtTime(float time)
+DirectX::XMVECTOR FGoodSpline::GetPointAtTime(float time) const
 {
-        return m_Spline.eval_df(time);
+        unsigned int segmentCount = (unsigned int)m_Segments.size();
+
+        float        x       = MathLibrary::clamp(time, 0.0f, 1.0f) * segmentCount;
+        unsigned int segment = std::min((unsigned int)x, segmentCount - 1);
+        return EvaluateSegment(segment, XMVectorReplicate(x - segment));
+}
+
+DirectX::XMVECTOR FGoodSpline::GetPointAtDistance(float distance) const
+{
+        return GetPointAtTime(GetTimeAtDistance(distance));
+}
+
+DirectX::XMVECTOR FGoodSpline::GetSpeedAtTime(float time) const
+{
+        unsigned int segmentCount = (unsigned int)m_Segments.size();
+
+        float           x            = MathLibrary::clamp(time, 0.0f, 1.0f) * segmentCount;
+        unsigned int    segment      = std::min((unsigned int)x, segmentCount - 1);
+        const FSegment& coefficients = m_Segments[segment];
+
+        // dp/dtime, each segment covers 1 / segmentCount of time
+        XMVECTOR tangent = XMVectorMultiplyAdd(coefficients.c, XMVectorReplicate(2.0f * (x - segment)), coefficients.b);
+        return tangent * (float)segmentCount;
+}
+
+float FGoodSpline::GetTimeAtDistance(float distance) const
+{
+        unsigned int sampleCount = (unsigned int)m_ArcLengths.size() - 1;
+
+        distance = MathLibrary::clamp(distance, 0.0f, length);
+
+        // Last sample at or before distance, chords between samples are treated as linear in time
+        auto         it     = std::upper_bound(m_ArcLengths.begin(), m_ArcLengths.end(), distance);
+        unsigned int sample = std::min((unsigned int)(it - m_ArcLengths.begin()) - 1, sampleCount - 1);
+
+        float chord    = m_ArcLengths[sample + 1] - m_ArcLengths[sample];
+        float fraction = chord > 0.0f ? (distance - m_ArcLengths[sample]) / chord : 0.0f;
+        return (sample + fraction) / sampleCount;
+}
+
+void FGoodSpline::EvaluateN(const float* times, DirectX::XMVECTOR* output, unsigned int count) const
+{
+        unsigned int segmentCount = (unsigned int)m_Segments.size();
+
+        const XMVECTOR scale       = XMVectorReplicate((float)segmentCount);
+        const XMVECTOR lastSegment = XMVectorReplicate((float)(segmentCount - 1));
+
+        unsigned int i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+                XMVECTOR x = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(times + i));
+                x          = XMVectorSaturate(x) * scale;
+
+                XMVECTOR segments = XMVectorMin(XMVectorFloor(x), lastSegment);
+                XMVECTOR t        = x - segments;
+
+                uint32_t indices[4];
+                XMStoreInt4(indices, XMConvertVectorFloatToUInt(segments, 0));
+
+                output[i + 0] = EvaluateSegment(indices[0], XMVectorSplatX(t));
+                output[i + 1] = EvaluateSegment(indices[1], XMVectorSplatY(t));
+                output[i + 2] = EvaluateSegment(indices[2], XMVectorSplatZ(t));
+                output[i + 3] = EvaluateSegment(indices[3], XMVectorSplatW(t));
+        }
+
+        for (; i < count; ++i)
+                output[i] = GetPointAtTime(times[i]);
 }
 
 void FGoodSpline::AdvanceDistance(float distance)
@@ -2,22 +2,27 @@
 #include <DirectXMath.h>
 #include <Windows.h>
 #include <vector>
-#include <splines.hpp>
 
+// Uniform quadratic B-spline over the control points, time runs over [0, 1] and distance over [0, GetLength()].
+// Fewer than three control points give the straight line through them.
 struct FGoodSpline
 {
     public:
         FGoodSpline(const std::vector<DirectX::XMVECTOR>& points);
-        DirectX::XMVECTOR GetCurrentPoint();
-        DirectX::XMVECTOR GetPointAtTime(float time);
-        DirectX::XMVECTOR GetSpeedAtTime(float time);
+        DirectX::XMVECTOR GetCurrentPoint() const;
+        DirectX::XMVECTOR GetPointAtTime(float time) const;
+        DirectX::XMVECTOR GetPointAtDistance(float distance) const;
+        DirectX::XMVECTOR GetSpeedAtTime(float time) const;
+        float             GetTimeAtDistance(float distance) const;
+        // Evaluates four times per batch, output may not alias times
+        void              EvaluateN(const float* times, DirectX::XMVECTOR* output, unsigned int count) const;
         void              AdvanceDistance(float distance);
-        inline float      GetCurrentDistance()
+        inline float      GetCurrentDistance() const
         {
                 return pointer;
         }
 
-        inline float GetLength()
+        inline float GetLength() const
         {
                 return length;
         }
@@ -27,9 +32,22 @@ struct FGoodSpline
                 pointer = 0.0f;
         }
 
+        static constexpr unsigned int kArcSamplesPerSegment = 16;
+
     private:
-        float                            pointer;
-        float                            length;
-        int                              m_Subdivisions;
-        Spline<DirectX::XMVECTOR, float> m_Spline;
+        // p(t) = a + b * t + c * t^2 for t in [0, 1] across one knot span
+        struct FSegment
+        {
+                DirectX::XMVECTOR a;
+                DirectX::XMVECTOR b;
+                DirectX::XMVECTOR c;
+        };
+
+        DirectX::XMVECTOR EvaluateSegment(unsigned int segment, DirectX::FXMVECTOR t) const;
+
+        float                 pointer;
+        float                 length;
+        std::vector<FSegment> m_Segments;
+        // Distance along the curve at every 1 / (segments * kArcSamplesPerSegment) step of time
+        std::vector<float>    m_ArcLengths;
 };
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include <ParticleLOD.h>
+#include <assert.h>
+#include <math.h>
+#include <algorithm>
+
+using namespace ParticleData;
+
+void ParticleLOD::BeginFrame(float frameTime)
+{
+        m_SmoothedFrameTime += (frameTime - m_SmoothedFrameTime) * 0.1f;
+
+        // Back off quickly when over budget and recover slowly, nothing changes inside the band around the target
+        if (m_SmoothedFrameTime > m_Settings.targetFrameTime * 1.05f)
+                m_GlobalScale = std::max<float>(m_Settings.minScale, m_GlobalScale - frameTime * 0.5f);
+        else if (m_SmoothedFrameTime < m_Settings.targetFrameTime * 0.9f)
+                m_GlobalScale = std::min<float>(1.0f, m_GlobalScale + frameTime * 0.25f);
+
+        if (m_SimulationInterval == 1 && m_GlobalScale < m_Settings.halfRateEnterScale)
+                m_SimulationInterval = 2;
+        else if (m_SimulationInterval == 2 && m_GlobalScale > m_Settings.halfRateExitScale)
+                m_SimulationInterval = 1;
+
+        m_Stats                    = FParticleLODStats();
+        m_Stats.globalScale        = m_GlobalScale;
+        m_Stats.simulationInterval = m_SimulationInterval;
+}
+
+void ParticleLOD::ResetEmitter(unsigned int slot)
+{
+        assert(slot < gMaxEmitterSlotCount);
+        m_Scales[slot]     = 1.0f;
+        m_Converging[slot] = false;
+}
+
+float ParticleLOD::UpdateEmitter(unsigned int slot,
+                                 float        radius,
+                                 float        distance,
+                                 float        projectionScale,
+                                 float        deltaTime)
+{
+        assert(slot < gMaxEmitterSlotCount);
+
+        float projectedSize = radius * projectionScale / std::max<float>(distance, 1.0f);
+        float sizeRange     = m_Settings.fullDetailSize - m_Settings.minDetailSize;
+        float sizeAlpha     = (projectedSize - m_Settings.minDetailSize) / sizeRange;
+        sizeAlpha           = std::min<float>(std::max<float>(sizeAlpha, 0.0f), 1.0f);
+        float target        = (m_Settings.minScale + (1.0f - m_Settings.minScale) * sizeAlpha) * m_GlobalScale;
+        target              = std::max<float>(target, m_Settings.minScale);
+
+        float& scale = m_Scales[slot];
+        float  delta = target - scale;
+        if (fabsf(delta) > m_Settings.hysteresis)
+                m_Converging[slot] = true;
+
+        if (m_Converging[slot])
+        {
+                float step = m_Settings.response * deltaTime;
+                scale += std::min<float>(std::max<float>(delta, -step), step);
+                if (fabsf(target - scale) <= 0.0001f)
+                        m_Converging[slot] = false;
+        }
+
+        if (scale < 1.0f)
+                m_Stats.reducedEmitters++;
+        return scale;
+}
+
+void ParticleLOD::RecordEmitter(unsigned int requested, unsigned int lodRequested)
+{
+        m_Stats.requestedParticles += requested;
+        m_Stats.lodParticles += lodRequested;
+        m_Stats.savedParticles += requested - lodRequested;
+}
\ No newline at end of file
@@ -12,12 +12,15 @@
 #include <GeometryShader.h>
 #include <PixelShader.h>
 #include <ResourceManager.h>
+#include <ShaderCache.h>
 #include <Texture2D.h>
 #include <VertexShader.h>
 
 
 #include <TransformComponent.h>
 #include <ParticleBufferSetup.h>
+#include <MemoryTracking.h>
+#include <BitwiseUtility.h>
 using namespace ParticleData;
 using namespace DirectX;
 using namespace Pools;
@@ -35,58 +38,84 @@ void ParticleManager::update(float deltaTime)
 {
         ID3D11ShaderResourceView* nullSRV = nullptr;
 
-        GEngine::Get()->m_MainThreadProfilingContext.Begin("ParticleManager", "ParticleManager");
+        PROFILE_SCOPE("ParticleManager", "ParticleManager");
 
         // update emitter container
         m_RenderSystem->m_Context->OMSetRenderTargets(0, nullptr, nullptr);
-        int emitterIndex = 0;
-        // Build update list
-        for (auto& emitterComp : m_Emitters) {}
+        ++m_FrameIndex;
+        m_UploadStats        = FEmitterUploadStats();
+        XMVECTOR eyePosition = XMLoadFloat3(&m_RenderSystem->m_ConstantBuffer_SCENE.eyePosition);
+
+        // Projected size of a unit radius at unit distance, as a fraction of the screen height
+        float projectionScale = 0.5f * XMVectorGetY(m_RenderSystem->m_CachedMainProjectionMatrix.r[1]);
+        m_LOD.BeginFrame(deltaTime);
         for (auto& emitterComponent : GEngine::Get()->GetHandleManager()->GetActiveComponents<EmitterComponent>())
         {
-                if (emitterComponent.active == true)
+                if (emitterComponent.active == false)
+                        continue;
+
+                int slot = AcquireEmitterSlot(emitterComponent);
+                if (slot < 0)
+                        continue;
+
+                EntityHandle        parent             = emitterComponent.GetParent();
+                TransformComponent* transformComponent = parent.GetComponent<TransformComponent>();
+
+                if (emitterComponent.rotate == true)
                 {
+                        XMMATRIX rotation =
+                            XMMatrixRotationAxis(emitterComponent.rotationAxis, emitterComponent.rotationRate * deltaTime);
+                        FEmitterGPU& data = emitterComponent.EmitterData;
+                        XMStoreFloat3(&data.minInitialVelocity,
+                                      XMVector3TransformNormal(XMLoadFloat3(&data.minInitialVelocity), rotation));
+                        XMStoreFloat3(&data.maxInitialVelocity,
+                                      XMVector3TransformNormal(XMLoadFloat3(&data.maxInitialVelocity), rotation));
+                        XMStoreFloat3(&data.acceleration, XMVector3TransformNormal(XMLoadFloat3(&data.acceleration), rotation));
+                }
+                XMVECTOR    emitterPos  = transformComponent->transform.translation + emitterComponent.offset;
+                FEmitterGPU emitterData = emitterComponent.EmitterData;
+                XMStoreFloat3(&emitterData.emitterPosition, emitterPos);
 
-                        if (emitterIndex >= gMaxEmitterCount)
-                        {
-                                // emitterIndex--;
-                                break;
-                        }
-                        EntityHandle        parent             = emitterComponent.GetParent();
-                        TransformComponent* transformComponent = parent.GetComponent<TransformComponent>();
-
-                        if (emitterComponent.rotate == true)
-                        {
-                                XMVECTOR minVel   = XMLoadFloat3(&emitterComponent.EmitterData.minInitialVelocity);
-                                XMVECTOR maxVel   = XMLoadFloat3(&emitterComponent.EmitterData.maxInitialVelocity);
-                                XMVECTOR accel    = XMLoadFloat3(&emitterComponent.EmitterData.acceleration);
-                                XMVECTOR rotation = XMQuaternionRotationAxis(emitterComponent.rotationAxis,
-                                                                             emitterComponent.rotationRate * deltaTime);
-                                XMStoreFloat3(&emitterComponent.EmitterData.minInitialVelocity,
-                                              XMVector3Rotate(minVel, rotation));
-                                XMStoreFloat3(&emitterComponent.EmitterData.maxInitialVelocity,
-                                              XMVector3Rotate(maxVel, rotation));
-                                XMStoreFloat3(&emitterComponent.EmitterData.acceleration, XMVector3Rotate(accel, rotation));
-                        }
-                        XMVECTOR emitterPos         = transformComponent->transform.translation + emitterComponent.offset;
-                        m_EmittersCPU[emitterIndex] = emitterComponent.EmitterData;
-                        XMStoreFloat3(&m_EmittersCPU[emitterIndex].emitterPosition, emitterPos);
-
-                        emitterComponent.desiredCount += emitterComponent.spawnRate * deltaTime * 0.5f;
-                        emitterComponent.desiredCount =
-                            std::min<float>(emitterComponent.desiredCount, (float)emitterComponent.maxCount);
-
-                        m_SegmentBufferCPU.desiredCount[emitterIndex] = (int)emitterComponent.desiredCount;
-
-                        emitterIndex++;
+                if (memcmp(&m_EmittersCPU[slot], &emitterData, sizeof(FEmitterGPU)) != 0)
+                {
+                        m_EmittersCPU[slot] = emitterData;
+                        m_EmitterDirtyBits[slot / 64] |= 1ULL << (slot % 64);
                 }
+
+                XMVECTOR toEmitter  = emitterPos - eyePosition;
+                float    distanceSq = MathLibrary::VectorDotProduct(toEmitter, toEmitter);
+
+                // Rough emitter bounds: half the spawn box plus the particle size
+                XMVECTOR spawnExtent = XMLoadFloat3(&emitterData.maxOffset) - XMLoadFloat3(&emitterData.minOffset);
+                float    radius      = 0.5f * MathLibrary::CalulateVectorLength(spawnExtent) + emitterData.particleScale.y;
+                float    lodScale    = m_LOD.UpdateEmitter(slot, radius, sqrtf(distanceSq), projectionScale, deltaTime);
+
+                emitterComponent.desiredCount += emitterComponent.spawnRate * lodScale * deltaTime * 0.5f;
+                emitterComponent.desiredCount =
+                    std::min<float>(emitterComponent.desiredCount, (float)emitterComponent.maxCount);
+
+                unsigned int requested    = (unsigned int)emitterComponent.desiredCount;
+                unsigned int lodMaxCount  = (unsigned int)(emitterComponent.maxCount * lodScale);
+                unsigned int lodRequested = std::min<unsigned int>(requested, lodMaxCount);
+                m_LOD.RecordEmitter(requested, lodRequested);
+                m_SegmentAllocator.SetRequest(slot, lodRequested, distanceSq);
         }
+        ReleaseStaleEmitterSlots();
 
-        for (int i = emitterIndex; i < m_PreviousEmitterCount; i++)
+        m_SegmentAllocator.Allocate(m_ParticleBudget);
+        const FEmitterSegment* segments = m_SegmentAllocator.GetSegments();
+        for (unsigned int slot = 0; slot < gMaxEmitterSlotCount; ++slot)
         {
-                m_SegmentBufferCPU.desiredCount[i] = 0;
+                FEmitterSegment& segment = m_SegmentBufferCPU.segments[slot];
+                if (segment.offset != segments[slot].offset || segment.count != segments[slot].count)
+                {
+                        segment = segments[slot];
+                        m_SegmentDirtyBits[slot / 64] |= 1ULL << (slot % 64);
+                }
         }
-        m_PreviousEmitterCount = emitterIndex;
+        m_SimulatedParticleCount = std::max<unsigned int>(m_SimulatedParticleCount, m_ParticleBudget);
+
+        UploadDirtyRanges();
 
 
         // Send data to gpu
@@ -97,9 +126,6 @@ void ParticleManager::update(float deltaTime)
         GeometryShader* geometryShader        = RESOURCE_MANAGER->GetResource<GeometryShader>(m_GeometryShaderHandle);
         Texture2D*      texture               = RESOURCE_MANAGER->GetResource<Texture2D>(m_TextureHandle);
 
-        m_RenderSystem->UpdateConstantBuffer(
-            m_EmitterBuffer.m_StructuredBuffer, m_EmittersCPU, sizeof(ParticleData::FEmitterGPU) * emitterIndex);
-
         ID3D11ShaderResourceView* null[]{nullptr};
         m_RenderSystem->m_Context->VSSetShaderResources(0, 1, null);
         // set input layout
@@ -121,16 +147,59 @@ void ParticleManager::update(float deltaTime)
 
         // dispatch before setting UAV to null
         m_RenderSystem->m_Context->CSSetShader(EmittionComputeShader->m_ComputerShader, nullptr, 0);
-        m_RenderSystem->UpdateConstantBuffer(
-            m_SegmentBufferGPU.m_StructuredBuffer, &m_SegmentBufferCPU, sizeof(m_SegmentBufferCPU));
-
         m_RenderSystem->m_Context->CSSetConstantBuffers(
             0, 1, &m_RenderSystem->m_BasePassConstantBuffers[E_CONSTANT_BUFFER_BASE_PASS::MVP]);
 
-        m_RenderSystem->m_Context->Dispatch(256, 1, 1);
+        // At reduced simulation rate the skipped frames' time step and world offset are applied on the next simulated
+        // frame
+        const CSceneInfoBuffer& scene = m_RenderSystem->m_ConstantBuffer_SCENE;
+        m_SimulationStepTime += scene.deltaTime;
+        m_SimulationStepOffset.x += scene.worldOffsetDelta.x;
+        m_SimulationStepOffset.y += scene.worldOffsetDelta.y;
+        m_SimulationStepOffset.z += scene.worldOffsetDelta.z;
+        bool simulate = m_FrameIndex % m_LOD.GetSimulationInterval() == 0;
+        COUNTER_SET("Particles/Budget", m_LOD.GetStats().lodParticles);
+
+        FParticleSimulationParams params;
+        params.time             = scene.time;
+        params.deltaTime        = m_SimulationStepTime;
+        params.worldOffsetDelta = m_SimulationStepOffset;
+        if (simulate)
+        {
+                m_SimulationStepTime   = 0.0f;
+                m_SimulationStepOffset = XMFLOAT3(0.0f, 0.0f, 0.0f);
+        }
+
+        if (simulate && m_UseCPUSimulation)
+        {
+                m_SimulationCPU.Update(m_EmittersCPU, m_SegmentBufferCPU, params);
+                // The GPU simulation keeps its alive count on the GPU, only the budget is known there
+                COUNTER_SET("Particles/Alive", m_SimulationCPU.GetStats().aliveCount);
+                m_SimulationCPU.WriteGPULayout(m_SimulationCPUStaging, 0, gMaxParticleCount);
+                m_RenderSystem->m_Context->UpdateSubresource(
+                    m_ParticleBuffer.m_StructuredBuffer, 0, nullptr, m_SimulationCPUStaging, 0, 0);
+        }
+        else if (simulate)
+        {
+                if (params.deltaTime != scene.deltaTime)
+                {
+                        // The scene buffer is uploaded again with the frame's values before drawing
+                        CSceneInfoBuffer stepScene = scene;
+                        stepScene.deltaTime        = params.deltaTime;
+                        stepScene.worldOffsetDelta = params.worldOffsetDelta;
+                        m_RenderSystem->UpdateConstantBuffer(
+                            m_RenderSystem->m_BasePassConstantBuffers[E_CONSTANT_BUFFER_BASE_PASS::SCENE],
+                            &stepScene,
+                            sizeof(stepScene));
+                }
+
+                // Emission only needs to cover the budget, simulation also covers particles left alive by a
+                // larger budget
+                m_RenderSystem->m_Context->Dispatch((m_ParticleBudget + 511) / 512, 1, 1);
 
-        m_RenderSystem->m_Context->CSSetShader(simComputeShader->m_ComputerShader, nullptr, 0);
-        m_RenderSystem->m_Context->Dispatch(256, 1, 1);
+                m_RenderSystem->m_Context->CSSetShader(simComputeShader->m_ComputerShader, nullptr, 0);
+                m_RenderSystem->m_Context->Dispatch((m_SimulatedParticleCount + 511) / 512, 1, 1);
+        }
 
 
         m_RenderSystem->m_Context->CSSetShaderResources(1, 1, &nullSRV);
@@ -177,7 +246,30 @@ void ParticleManager::update(float deltaTime)
         m_RenderSystem->m_Context->PSSetShaderResources(0, 1, &texture->m_SRV);
         // draw call;
         // TODO: uncomment after showing Audio Students
-        m_RenderSystem->m_Context->Draw(gMaxParticleCount, 0);
+        if (m_UseDepthSorting && m_UseCPUSimulation)
+        {
+                // The camera moves on frames the simulation is skipped so the particles are sorted every frame
+                m_Sort.Sort(m_SimulationCPU, eyePosition, m_RenderSystem->m_CachedMainInvViewMatrix.r[2]);
+                unsigned int sortedCount = m_Sort.GetStats().sortedCount;
+
+                D3D11_MAPPED_SUBRESOURCE mappedResource{};
+                HRESULT                  hr = m_RenderSystem->m_Context->Map(
+                    m_SortedIndexBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource);
+                assert(SUCCEEDED(hr));
+                memcpy(mappedResource.pData, m_Sort.GetSortedIndices(), sizeof(uint32_t) * sortedCount);
+                m_RenderSystem->m_Context->Unmap(m_SortedIndexBuffer, 0);
+
+                // The vertex shader passes SV_VertexID through as the particle index
+                m_RenderSystem->m_Context->IASetIndexBuffer(m_SortedIndexBuffer, DXGI_FORMAT_R32_UINT, 0);
+                m_RenderSystem->m_Context->DrawIndexed(sortedCount, 0, 0);
+                COUNTER_ADD("Render/Draw calls", 1);
+                m_RenderSystem->m_Context->IASetIndexBuffer(nullptr, DXGI_FORMAT_UNKNOWN, 0);
+        }
+        else
+        {
+                m_RenderSystem->m_Context->Draw(gMaxParticleCount, 0);
+                COUNTER_ADD("Render/Draw calls", 1);
+        }
 
         // reset srv null for geometry shader
 
@@ -186,8 +278,6 @@ void ParticleManager::update(float deltaTime)
         m_RenderSystem->m_Context->GSSetConstantBuffers(0, 1, &nullBuffer);
         ID3D11GeometryShader* nullGeometryShader = NULL;
         m_RenderSystem->m_Context->GSSetShader(nullGeometryShader, 0, 0);
-
-        GEngine::Get()->m_MainThreadProfilingContext.End();
 }
 
 void ParticleManager::init()
@@ -213,7 +303,26 @@ void ParticleManager::init()
         // init
         m_RenderSystem = SYSTEM_MANAGER->GetSystem<RenderSystem>();
 
-        ParticleBufferInit(m_RenderSystem->GetDevice(), nullptr, nullptr, nullptr, gMaxParticleCount);
+        ParticleBufferInit(m_RenderSystem->GetDevice(), nullptr, m_EmittersCPU, &m_SegmentBufferCPU, gMaxParticleCount);
+
+        // Emitter and segment ranges are written into a staging buffer and copied into the structured buffers, the ring
+        // keeps the CPU from mapping a buffer the GPU may still be copying from
+        CD3D11_BUFFER_DESC stagingDesc((sizeof(FEmitterGPU) + sizeof(FEmitterSegment)) * gMaxEmitterSlotCount,
+                                       0,
+                                       D3D11_USAGE_STAGING,
+                                       D3D11_CPU_ACCESS_WRITE);
+        for (unsigned int i = 0; i < kStagingRingSize; ++i)
+        {
+                HRESULT hr = m_RenderSystem->GetDevice()->CreateBuffer(&stagingDesc, nullptr, &m_StagingRing[i]);
+                assert(SUCCEEDED(hr));
+        }
+
+        for (unsigned int i = 0; i < gMaxEmitterSlotCount; ++i)
+        {
+                m_SlotOwners[i] = UINT32_MAX;
+                m_FreeSlots[i]  = (int16_t)(gMaxEmitterSlotCount - 1 - i);
+        }
+        m_FreeSlotCount = gMaxEmitterSlotCount;
         // Load Computer Shader
         m_SimulationComputeShaderHandle = RESOURCE_MANAGER->LoadComputeShader("SimulationComputeShader");
         m_EmittionComputeShaderHandle   = RESOURCE_MANAGER->LoadComputeShader("EmittionComputeShader");
@@ -230,14 +339,17 @@ void ParticleManager::init()
             {"COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0}};
         UINT numElements = ARRAYSIZE(layout1);
 
-        FileIO::FShaderData shaderData;
-        EResult             er = FileIO::LoadShaderDataFromFile("PureVertexShader", "_VS", &shaderData);
+        FShaderBytecode shaderData = ShaderCache::GetBytecode("PureVertexShader", E_SHADER_STAGE::VS);
 
-        assert(er.m_Flags == ERESULT_FLAG::SUCCESS);
+        assert(shaderData.data);
 }
 
 void ParticleManager::shutdown()
 {
+        for (unsigned int i = 0; i < kStagingRingSize; ++i)
+                SAFE_RELEASE(m_StagingRing[i]);
+        SetDepthSorting(false);
+        SetCPUSimulation(false);
         ParticleBufferShutdown(&m_ParticleBuffer);
         ParticleBufferShutdown(&m_EmitterBuffer);
         ParticleBufferShutdown(&m_SegmentBufferGPU);
@@ -266,7 +378,7 @@ void ParticleManager::ParticleBufferInit(ID3D11Device1*                device1,
         rwData.SysMemPitch      = 0;
         rwData.SysMemSlicePitch = 0;
         HREFTYPE hr             = device1->CreateBuffer(&sbDesc, &rwData, &m_ParticleBuffer.m_StructuredBuffer);
-        delete particleData;
+        delete[] particleData;
 
         D3D11_UNORDERED_ACCESS_VIEW_DESC sbUAVDesc;
 
@@ -304,16 +416,16 @@ void ParticleManager::ParticleBufferInit(ID3D11Device1*                device1,
 
         // CD3D11_BUFFER_DESC
         sbDesc.BindFlags           = D3D11_BIND_SHADER_RESOURCE;
-        sbDesc.CPUAccessFlags      = D3D11_CPU_ACCESS_WRITE;
+        sbDesc.CPUAccessFlags      = 0;
         sbDesc.MiscFlags           = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
         sbDesc.StructureByteStride = sizeof(FEmitterGPU);
         sbDesc.ByteWidth           = sizeof(FEmitterGPU) * ParticleData::gMaxEmitterCount * 1;
-        sbDesc.Usage               = D3D11_USAGE_DYNAMIC;
+        sbDesc.Usage               = D3D11_USAGE_DEFAULT;
         // D3D11_SUBRESOURCE_DATA
         rwData.pSysMem          = emitterData;
         rwData.SysMemPitch      = 0;
         rwData.SysMemSlicePitch = 0;
-        hr                      = device1->CreateBuffer(&sbDesc, nullptr, &m_EmitterBuffer.m_StructuredBuffer);
+        hr                      = device1->CreateBuffer(&sbDesc, &rwData, &m_EmitterBuffer.m_StructuredBuffer);
 
         // D3D11_SHADER_RESOURCE_VIEW_DESC
         sbSRVDesc.Buffer.ElementOffset = 0;
@@ -333,17 +445,17 @@ void ParticleManager::ParticleBufferInit(ID3D11Device1*                device1,
 
         // CD3D11_BUFFER_DESC sbDesc;
         sbDesc.BindFlags           = D3D11_BIND_SHADER_RESOURCE;
-        sbDesc.CPUAccessFlags      = D3D11_CPU_ACCESS_WRITE;
+        sbDesc.CPUAccessFlags      = 0;
         sbDesc.MiscFlags           = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
-        sbDesc.StructureByteStride = sizeof(int);
+        sbDesc.StructureByteStride = sizeof(FEmitterSegment);
         sbDesc.ByteWidth           = sizeof(FSegmentBuffer); // * numParticles * 1;
-        sbDesc.Usage               = D3D11_USAGE_DYNAMIC;
+        sbDesc.Usage               = D3D11_USAGE_DEFAULT;
 
         // D3D11_SUBRESOURCE_DATA rwData;
         rwData.pSysMem          = segmentData; // not sure should pass in what type of data
         rwData.SysMemPitch      = 0;
         rwData.SysMemSlicePitch = 0;
-        hr                      = device1->CreateBuffer(&sbDesc, nullptr, &m_SegmentBufferGPU.m_StructuredBuffer);
+        hr                      = device1->CreateBuffer(&sbDesc, &rwData, &m_SegmentBufferGPU.m_StructuredBuffer);
 
         // D3D11_UNORDERED_ACCESS_VIEW_DESC sbUAVDesc;
         // sbUAVDesc.Buffer.FirstElement = 0;
@@ -377,6 +489,105 @@ void ParticleManager::ParticleBufferShutdown(ParticleBuffer* buffer)
         SAFE_RELEASE(buffer->m_StructuredView);
 }
 
+int ParticleManager::AcquireEmitterSlot(EmitterComponent& emitter)
+{
+        // Components move in memory when their pool compacts, the redirection index identifies the owner
+        uint32_t owner = (uint32_t)emitter.GetHandle().redirection_index;
+        if (emitter.slot < 0 || m_SlotOwners[emitter.slot] != owner)
+        {
+                if (m_FreeSlotCount == 0)
+                {
+                        emitter.slot = -1;
+                        return -1;
+                }
+                emitter.slot               = m_FreeSlots[--m_FreeSlotCount];
+                m_SlotOwners[emitter.slot] = owner;
+                m_LOD.ResetEmitter(emitter.slot);
+        }
+
+        m_SlotLastSeenFrame[emitter.slot] = m_FrameIndex;
+        m_UploadStats.activeSlots++;
+        return emitter.slot;
+}
+
+void ParticleManager::ReleaseStaleEmitterSlots()
+{
+        // Slots of freed or deactivated emitters stop spawning, their live particles run out as before
+        for (unsigned int slot = 0; slot < gMaxEmitterSlotCount; ++slot)
+        {
+                if (m_SlotOwners[slot] == UINT32_MAX || m_SlotLastSeenFrame[slot] == m_FrameIndex)
+                        continue;
+
+                m_SlotOwners[slot] = UINT32_MAX;
+                m_SegmentAllocator.SetRequest(slot, 0, 0.0f);
+                m_FreeSlots[m_FreeSlotCount++] = (int16_t)slot;
+        }
+}
+
+void ParticleManager::UploadDirtyRanges()
+{
+        struct FDirtyStream
+        {
+                uint64_t*     dirtyBits;
+                const char*   source;
+                unsigned int  stride;
+                ID3D11Buffer* destination;
+                unsigned int* dirtyCount;
+        };
+        FDirtyStream streams[] = {
+            {m_EmitterDirtyBits,
+             reinterpret_cast<const char*>(m_EmittersCPU),
+             sizeof(FEmitterGPU),
+             m_EmitterBuffer.m_StructuredBuffer,
+             &m_UploadStats.dirtyEmitters},
+            {m_SegmentDirtyBits,
+             reinterpret_cast<const char*>(m_SegmentBufferCPU.segments),
+             sizeof(FEmitterSegment),
+             m_SegmentBufferGPU.m_StructuredBuffer,
+             &m_UploadStats.dirtySegments}};
+
+        bool anyDirty = false;
+        for (unsigned int i = 0; i < kEmitterDirtyWords; ++i)
+                anyDirty |= (m_EmitterDirtyBits[i] | m_SegmentDirtyBits[i]) != 0;
+        if (anyDirty == false)
+                return;
+
+        ID3D11Buffer* staging = m_StagingRing[m_StagingRingIndex];
+        m_StagingRingIndex    = (m_StagingRingIndex + 1) % kStagingRingSize;
+
+        D3D11_MAPPED_SUBRESOURCE mappedResource{};
+        HRESULT                  hr = m_RenderSystem->m_Context->Map(staging, 0, D3D11_MAP_WRITE, 0, &mappedResource);
+        assert(SUCCEEDED(hr));
+
+        char*        stagingData   = static_cast<char*>(mappedResource.pData);
+        unsigned int stagingOffset = 0;
+        for (auto& stream : streams)
+        {
+                ForEachSetBitRange(stream.dirtyBits, gMaxEmitterSlotCount, [&](unsigned int begin, unsigned int end) {
+                        unsigned int size = (end - begin) * stream.stride;
+                        memcpy(stagingData + stagingOffset, stream.source + begin * stream.stride, size);
+                        stagingOffset += size;
+                        *stream.dirtyCount += end - begin;
+                });
+        }
+        m_RenderSystem->m_Context->Unmap(staging, 0);
+
+        stagingOffset = 0;
+        for (auto& stream : streams)
+        {
+                ForEachSetBitRange(stream.dirtyBits, gMaxEmitterSlotCount, [&](unsigned int begin, unsigned int end) {
+                        unsigned int size = (end - begin) * stream.stride;
+                        D3D11_BOX    box  = {stagingOffset, 0, 0, stagingOffset + size, 1, 1};
+                        m_RenderSystem->m_Context->CopySubresourceRegion(
+                            stream.destination, 0, begin * stream.stride, 0, 0, staging, 0, &box);
+                        stagingOffset += size;
+                        m_UploadStats.uploadedRanges++;
+                });
+                memset(stream.dirtyBits, 0, sizeof(uint64_t) * kEmitterDirtyWords);
+        }
+        m_UploadStats.uploadedBytes = stagingOffset;
+}
+
 void ParticleManager::AddEmitter(EmitterComponent* emitter)
 {
         m_Emitters.push_back(emitter);
@@ -388,9 +599,58 @@ void ParticleManager::SetParticleInfo(ParticleData::FParticleGPU* particleInfo)
 }
 
 
+void ParticleManager::SetCPUSimulation(bool enabled)
+{
+        if (m_UseCPUSimulation == enabled)
+                return;
+
+        m_UseCPUSimulation = enabled;
+        if (enabled)
+        {
+                NMemory::ScopedMemoryTag memoryTag(NMemory::E_MEMORY_TAG::PARTICLES);
+                m_SimulationCPU.Initialize();
+                m_SimulationCPUStaging = new FParticleGPU[gMaxParticleCount];
+        }
+        else
+        {
+                m_SimulationCPU.Shutdown();
+                delete[] m_SimulationCPUStaging;
+                m_SimulationCPUStaging = nullptr;
+        }
+}
+
+void ParticleManager::SetDepthSorting(bool enabled)
+{
+        if (m_UseDepthSorting == enabled)
+                return;
+
+        m_UseDepthSorting = enabled;
+        if (enabled)
+        {
+                m_Sort.Initialize();
+                CD3D11_BUFFER_DESC indexDesc(sizeof(uint32_t) * gMaxParticleCount,
+                                             D3D11_BIND_INDEX_BUFFER,
+                                             D3D11_USAGE_DYNAMIC,
+                                             D3D11_CPU_ACCESS_WRITE);
+                HRESULT            hr = m_RenderSystem->GetDevice()->CreateBuffer(&indexDesc, nullptr, &m_SortedIndexBuffer);
+                assert(SUCCEEDED(hr));
+        }
+        else
+        {
+                m_Sort.Shutdown();
+                SAFE_RELEASE(m_SortedIndexBuffer);
+        }
+}
+
+void ParticleManager::SetParticleBudget(unsigned int budget)
+{
+        m_ParticleBudget = std::min<unsigned int>(budget, gMaxParticleCount);
+}
+
 void ParticleManager::Initialize()
 {
-        instance = new ParticleManager;
+        NMemory::ScopedMemoryTag memoryTag(NMemory::E_MEMORY_TAG::PARTICLES);
+        instance = new ParticleManager();
         instance->init();
 }
 
@@ -0,0 +1,75 @@
+#include <ParticleSegmentAllocator.h>
+#include <assert.h>
+#include <math.h>
+#include <algorithm>
+#include <JobScheduler.h>
+
+using namespace ParticleData;
+
+void ParticleSegmentAllocator::SetRequest(unsigned int slot, unsigned int desiredCount, float distanceSq)
+{
+        assert(slot < gMaxEmitterSlotCount);
+        m_DesiredCounts[slot] = desiredCount;
+        m_DistancesSq[slot]   = distanceSq;
+}
+
+void ParticleSegmentAllocator::Allocate(unsigned int budget)
+{
+        m_Stats        = FSegmentAllocatorStats();
+        m_Stats.budget = budget;
+
+        for (unsigned int slot = 0; slot < gMaxEmitterSlotCount; ++slot)
+        {
+                m_Segments[slot].count = m_DesiredCounts[slot];
+                m_Stats.requested += m_DesiredCounts[slot];
+        }
+
+        if (m_Stats.requested > budget)
+                TrimToBudget(budget);
+
+        // Offsets are the exclusive prefix sum of the granted counts
+        m_Stats.granted = ParallelExclusiveScan(
+            gMaxEmitterSlotCount,
+            0U,
+            [this](unsigned int slot) { return m_Segments[slot].count; },
+            [](unsigned int& lhs, const unsigned int& rhs) { lhs += rhs; },
+            [this](unsigned int slot, const unsigned int& offset) { m_Segments[slot].offset = offset; });
+        assert(m_Stats.granted <= budget);
+}
+
+void ParticleSegmentAllocator::TrimToBudget(unsigned int budget)
+{
+        // Slots with a request first, in slot order, then only those are sorted
+        m_PriorityOrder.resize(gMaxEmitterSlotCount);
+        unsigned int requestCount = ParallelPartition(gMaxEmitterSlotCount,
+                                                      m_PriorityOrder.data(),
+                                                      [](unsigned int slot) { return (uint16_t)slot; },
+                                                      [this](unsigned int slot) { return m_DesiredCounts[slot] > 0; });
+        m_PriorityOrder.resize(requestCount);
+
+        std::sort(m_PriorityOrder.begin(), m_PriorityOrder.end(), [this](uint16_t lhs, uint16_t rhs) {
+                return m_DistancesSq[lhs] < m_DistancesSq[rhs];
+        });
+
+        unsigned int remaining = budget;
+        for (uint16_t slot : m_PriorityOrder)
+        {
+                unsigned int granted   = std::min<unsigned int>(m_DesiredCounts[slot], remaining);
+                m_Segments[slot].count = granted;
+                remaining -= granted;
+                if (granted < m_DesiredCounts[slot])
+                        m_Stats.trimmedEmitters++;
+        }
+}
+
+FEmitterSegmentStats ParticleSegmentAllocator::GetEmitterStats(unsigned int slot) const
+{
+        assert(slot < gMaxEmitterSlotCount);
+
+        FEmitterSegmentStats output;
+        output.desired  = m_DesiredCounts[slot];
+        output.granted  = m_Segments[slot].count;
+        output.offset   = m_Segments[slot].offset;
+        output.distance = sqrtf(m_DistancesSq[slot]);
+        return output;
+}
\ No newline at end of file
@@ -0,0 +1,335 @@
+#include <ParticleSimulationCPU.h>
+#include <assert.h>
+#include <malloc.h>
+#include <string.h>
+#include <algorithm>
+#include <JobScheduler.h>
+#include <MemoryTracking.h>
+#include <Profiling.h>
+
+using namespace ParticleData;
+using namespace DirectX;
+
+namespace
+{
+        // rand() from Math.hlsl, four lanes at a time
+        inline XMVECTOR XM_CALLCONV RandomVector(FXMVECTOR seed)
+        {
+                const XMVECTOR frequency = XMVectorReplicate((12.9898f + 78.233f) * 2.0f);
+                const XMVECTOR amplitude = XMVectorReplicate(43758.5453f);
+
+                XMVECTOR noise = XMVectorMultiply(XMVectorSin(XMVectorMultiply(seed, frequency)), amplitude);
+                return XMVectorSubtract(noise, XMVectorFloor(noise));
+        }
+
+        inline unsigned int XM_CALLCONV CountSetLanes(FXMVECTOR mask)
+        {
+                return (unsigned int)XMVectorGetX(XMVector4Dot(XMVectorAndInt(mask, g_XMOne), g_XMOne));
+        }
+
+        inline XMVECTOR LoadStream(const float* stream)
+        {
+                return XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(stream));
+        }
+
+        inline void XM_CALLCONV StoreStream(float* stream, FXMVECTOR value)
+        {
+                XMStoreFloat4A(reinterpret_cast<XMFLOAT4A*>(stream), value);
+        }
+
+        inline void XM_CALLCONV SelectStream(float* stream, FXMVECTOR value, FXMVECTOR mask)
+        {
+                StoreStream(stream, XMVectorSelect(LoadStream(stream), value, mask));
+        }
+
+        // EmittionComputeShader_CS for the lanes of a quad selected by spawn
+        void XM_CALLCONV EmitQuad(float* const*      s,
+                                  unsigned int       i,
+                                  FXMVECTOR          id,
+                                  FXMVECTOR          spawn,
+                                  FXMVECTOR          seedBase,
+                                  const FEmitterGPU& emitter,
+                                  XMVECTOR&          time)
+        {
+                using E = E_PARTICLE_STREAM;
+
+                XMVECTOR seed    = XMVectorMultiplyAdd(id, XMVectorReplicate(0.547338f), seedBase);
+                XMVECTOR timeMin = XMVectorReplicate(emitter.lifeSpan.x - emitter.lifeSpan.y);
+                XMVECTOR timeMax = XMVectorReplicate(emitter.lifeSpan.x + emitter.lifeSpan.y);
+
+                XMVECTOR alpha    = RandomVector(seed);
+                XMVECTOR lifeTime = XMVectorLerpV(timeMin, timeMax, alpha);
+                seed              = alpha;
+                time              = XMVectorSelect(time, lifeTime, spawn);
+                SelectStream(s[E::LIFESPAN_X] + i, lifeTime, spawn);
+                SelectStream(s[E::LIFESPAN_Y] + i, XMVectorReplicate(emitter.lifeSpan.z), spawn);
+                SelectStream(s[E::LIFESPAN_Z] + i, XMVectorReplicate(emitter.lifeSpan.w), spawn);
+
+                XMVECTOR alphaA = RandomVector(seed);
+                XMVECTOR alphaB = RandomVector(XMVectorAdd(alphaA, seed));
+                XMVECTOR alphaC = RandomVector(XMVectorAdd(alphaB, alphaA));
+                seed            = alphaC;
+                SelectStream(s[E::VELOCITY_X] + i,
+                             XMVectorLerpV(XMVectorReplicate(emitter.minInitialVelocity.x),
+                                           XMVectorReplicate(emitter.maxInitialVelocity.x),
+                                           alphaA),
+                             spawn);
+                SelectStream(s[E::VELOCITY_Y] + i,
+                             XMVectorLerpV(XMVectorReplicate(emitter.minInitialVelocity.y),
+                                           XMVectorReplicate(emitter.maxInitialVelocity.y),
+                                           alphaB),
+                             spawn);
+                SelectStream(s[E::VELOCITY_Z] + i,
+                             XMVectorLerpV(XMVectorReplicate(emitter.minInitialVelocity.z),
+                                           XMVectorReplicate(emitter.maxInitialVelocity.z),
+                                           alphaC),
+                             spawn);
+                SelectStream(s[E::ACCELERATION_X] + i, XMVectorReplicate(emitter.acceleration.x), spawn);
+                SelectStream(s[E::ACCELERATION_Y] + i, XMVectorReplicate(emitter.acceleration.y), spawn);
+                SelectStream(s[E::ACCELERATION_Z] + i, XMVectorReplicate(emitter.acceleration.z), spawn);
+
+                alphaA = RandomVector(seed);
+                alphaB = RandomVector(XMVectorAdd(alphaA, seed));
+                alphaC = RandomVector(XMVectorAdd(alphaB, alphaA));
+                XMVECTOR x =
+                    XMVectorLerpV(XMVectorReplicate(emitter.emitterPosition.x + emitter.minOffset.x),
+                                  XMVectorReplicate(emitter.emitterPosition.x + emitter.maxOffset.x),
+                                  alphaA);
+                XMVECTOR y =
+                    XMVectorLerpV(XMVectorReplicate(emitter.emitterPosition.y + emitter.minOffset.y),
+                                  XMVectorReplicate(emitter.emitterPosition.y + emitter.maxOffset.y),
+                                  alphaB);
+                XMVECTOR z =
+                    XMVectorLerpV(XMVectorReplicate(emitter.emitterPosition.z + emitter.minOffset.z),
+                                  XMVectorReplicate(emitter.emitterPosition.z + emitter.maxOffset.z),
+                                  alphaC);
+                SelectStream(s[E::POSITION_X] + i, x, spawn);
+                SelectStream(s[E::POSITION_Y] + i, y, spawn);
+                SelectStream(s[E::POSITION_Z] + i, z, spawn);
+
+                SelectStream(s[E::FLAGS] + i, XMVectorReplicateInt(emitter.flags), spawn);
+                SelectStream(s[E::SCALE_X] + i, XMVectorReplicate(emitter.particleScale.x), spawn);
+                SelectStream(s[E::SCALE_Y] + i, XMVectorReplicate(emitter.particleScale.y), spawn);
+                SelectStream(s[E::INITIAL_COLOR_R] + i, XMVectorReplicate(emitter.initialColor.x), spawn);
+                SelectStream(s[E::INITIAL_COLOR_G] + i, XMVectorReplicate(emitter.initialColor.y), spawn);
+                SelectStream(s[E::INITIAL_COLOR_B] + i, XMVectorReplicate(emitter.initialColor.z), spawn);
+                SelectStream(s[E::INITIAL_COLOR_A] + i, XMVectorReplicate(emitter.initialColor.w), spawn);
+                SelectStream(s[E::FINAL_COLOR_R] + i, XMVectorReplicate(emitter.finalColor.x), spawn);
+                SelectStream(s[E::FINAL_COLOR_G] + i, XMVectorReplicate(emitter.finalColor.y), spawn);
+                SelectStream(s[E::FINAL_COLOR_B] + i, XMVectorReplicate(emitter.finalColor.z), spawn);
+                SelectStream(s[E::FINAL_COLOR_A] + i, XMVectorReplicate(emitter.finalColor.w), spawn);
+                SelectStream(s[E::TEXTURE_INDEX] + i, XMVectorReplicateInt(emitter.textureIndex), spawn);
+        }
+} // namespace
+
+void ParticleSimulationCPU::Initialize()
+{
+        size_t bytes = sizeof(float) * E_PARTICLE_STREAM::COUNT * gMaxParticleCount;
+        m_Streams    = static_cast<float*>(_aligned_malloc(bytes, 64));
+        assert(m_Streams);
+        memset(m_Streams, 0, bytes);
+        NMemory::MemoryTracking::TrackAllocation(NMemory::E_MEMORY_TAG::PARTICLES, bytes);
+}
+
+void ParticleSimulationCPU::Shutdown()
+{
+        if (m_Streams)
+                NMemory::MemoryTracking::TrackFree(NMemory::E_MEMORY_TAG::PARTICLES,
+                                                   sizeof(float) * E_PARTICLE_STREAM::COUNT * gMaxParticleCount);
+        _aligned_free(m_Streams);
+        m_Streams = nullptr;
+}
+
+void ParticleSimulationCPU::Update(const FEmitterGPU*               emitters,
+                                   const FSegmentBuffer&            segments,
+                                   const FParticleSimulationParams& params)
+{
+        assert(m_Streams);
+        int64_t start = TimeStamp().QuadPart;
+
+        m_Emitters = emitters;
+        m_Segments = &segments;
+        m_Params   = params;
+
+        auto simulationJob = ParallelFor([this](unsigned int block) { UpdateBlock(block); });
+        simulationJob.SetName("Particle simulation");
+        simulationJob.SetRange(0, kBlockCount, 8);
+        simulationJob();
+        simulationJob.Wait();
+
+        m_Stats = FParticleSimulationStats();
+        for (unsigned int i = 0; i < kBlockCount; ++i)
+        {
+                m_Stats.aliveCount += m_BlockAliveCounts[i];
+                m_Stats.spawnedCount += m_BlockSpawnedCounts[i];
+        }
+        m_Stats.updateMicroseconds = TimeStamp().QuadPart - start;
+}
+
+void ParticleSimulationCPU::UpdateBlock(unsigned int block)
+{
+        using E = E_PARTICLE_STREAM;
+
+        const FEmitterSegment* segments = m_Segments->segments;
+        const unsigned int     first    = block * kBlockSize;
+
+        float* s[E::COUNT];
+        for (int i = 0; i < E::COUNT; ++i)
+                s[i] = GetStream(i) + first;
+
+        const XMVECTOR zero        = XMVectorZero();
+        const XMVECTOR laneOffsets = XMVectorSet(0.0f, 1.0f, 2.0f, 3.0f);
+        const XMVECTOR deltaTime   = XMVectorReplicate(m_Params.deltaTime);
+        const XMVECTOR seedBase    = XMVectorReplicate(m_Params.time * 0.54843f);
+
+        const XMVECTOR offsetX = XMVectorReplicate(m_Params.worldOffsetDelta.x);
+        const XMVECTOR offsetY = XMVectorReplicate(m_Params.worldOffsetDelta.y);
+        const XMVECTOR offsetZ = XMVectorReplicate(m_Params.worldOffsetDelta.z);
+
+        // Same search as FindEmitterIndex in ParticleData.hlsl, then walk forward with the particle index
+        auto         byOffset = [](unsigned int id, const FEmitterSegment& segment) { return id < segment.offset; };
+        auto         found    = std::upper_bound(segments, segments + gMaxEmitterSlotCount, first, byOffset);
+        unsigned int segment  = (unsigned int)(found - segments) - 1;
+
+        unsigned int aliveCount   = 0;
+        unsigned int spawnedCount = 0;
+
+        for (unsigned int i = 0; i < kBlockSize; i += 4)
+        {
+                // EmittionComputeShader_CS
+                XMVECTOR time = LoadStream(s[E::TIME] + i);
+                XMVECTOR id   = XMVectorAdd(XMVectorReplicate((float)(first + i)), laneOffsets);
+                XMVECTOR dead = XMVectorLessOrEqual(time, zero);
+
+                // Live particles age in the emission pass as well as the simulation pass, as on the GPU
+                time = XMVectorSelect(XMVectorSubtract(time, deltaTime), time, dead);
+
+                // A quad can straddle segments, each overlapping segment emits into its own lanes
+                unsigned int quadBegin = first + i;
+                while (segment + 1 < gMaxEmitterSlotCount && segments[segment + 1].offset <= quadBegin)
+                        ++segment;
+                for (unsigned int k = segment; k < gMaxEmitterSlotCount && segments[k].offset < quadBegin + 4; ++k)
+                {
+                        unsigned int segmentEnd = segments[k].offset + segments[k].count;
+                        if (segments[k].count == 0 || segmentEnd <= quadBegin)
+                                continue;
+
+                        XMVECTOR inSegment = XMVectorAndInt(
+                            XMVectorGreaterOrEqual(id, XMVectorReplicate((float)segments[k].offset)),
+                            XMVectorLess(id, XMVectorReplicate((float)segmentEnd)));
+                        XMVECTOR spawn = XMVectorAndInt(dead, inSegment);
+                        if (XMComparisonAnyTrue(XMVector4EqualIntR(spawn, XMVectorTrueInt())))
+                        {
+                                spawnedCount += CountSetLanes(spawn);
+                                EmitQuad(s, i, id, spawn, seedBase, m_Emitters[k], time);
+                        }
+                }
+
+                // SimulationComputeShader_CS
+                XMVECTOR posX = LoadStream(s[E::POSITION_X] + i);
+                XMVECTOR posY = LoadStream(s[E::POSITION_Y] + i);
+                XMVECTOR posZ = LoadStream(s[E::POSITION_Z] + i);
+                StoreStream(s[E::PREV_POSITION_X] + i, posX);
+                StoreStream(s[E::PREV_POSITION_Y] + i, posY);
+                StoreStream(s[E::PREV_POSITION_Z] + i, posZ);
+
+                XMVECTOR velX = XMVectorMultiplyAdd(
+                    LoadStream(s[E::ACCELERATION_X] + i), deltaTime, LoadStream(s[E::VELOCITY_X] + i));
+                XMVECTOR velY = XMVectorMultiplyAdd(
+                    LoadStream(s[E::ACCELERATION_Y] + i), deltaTime, LoadStream(s[E::VELOCITY_Y] + i));
+                XMVECTOR velZ = XMVectorMultiplyAdd(
+                    LoadStream(s[E::ACCELERATION_Z] + i), deltaTime, LoadStream(s[E::VELOCITY_Z] + i));
+                StoreStream(s[E::VELOCITY_X] + i, velX);
+                StoreStream(s[E::VELOCITY_Y] + i, velY);
+                StoreStream(s[E::VELOCITY_Z] + i, velZ);
+
+                XMVECTOR alive = XMVectorGreater(time, zero);
+                aliveCount += CountSetLanes(alive);
+
+                time = XMVectorSelect(time, XMVectorSubtract(time, deltaTime), alive);
+                posX = XMVectorSelect(posX, XMVectorAdd(XMVectorMultiplyAdd(velX, deltaTime, posX), offsetX), alive);
+                posY = XMVectorSelect(posY, XMVectorAdd(XMVectorMultiplyAdd(velY, deltaTime, posY), offsetY), alive);
+                posZ = XMVectorSelect(posZ, XMVectorAdd(XMVectorMultiplyAdd(velZ, deltaTime, posZ), offsetZ), alive);
+                StoreStream(s[E::TIME] + i, time);
+                StoreStream(s[E::POSITION_X] + i, posX);
+                StoreStream(s[E::POSITION_Y] + i, posY);
+                StoreStream(s[E::POSITION_Z] + i, posZ);
+        }
+
+        m_BlockAliveCounts[block]   = aliveCount;
+        m_BlockSpawnedCounts[block] = spawnedCount;
+}
+
+void ParticleSimulationCPU::WriteGPULayout(FParticleGPU* output, unsigned int begin, unsigned int end) const
+{
+        using E = E_PARTICLE_STREAM;
+        assert(end <= gMaxParticleCount);
+
+        const float* s[E::COUNT];
+        for (int i = 0; i < E::COUNT; ++i)
+                s[i] = GetStream(i);
+
+        for (unsigned int i = begin; i < end; ++i)
+        {
+                FParticleGPU& p = output[i - begin];
+                p.position      = XMFLOAT4(s[E::POSITION_X][i], s[E::POSITION_Y][i], s[E::POSITION_Z][i], 1.0f);
+                p.prevPos =
+                    XMFLOAT4(s[E::PREV_POSITION_X][i], s[E::PREV_POSITION_Y][i], s[E::PREV_POSITION_Z][i], 1.0f);
+                p.initialColor = XMFLOAT4(s[E::INITIAL_COLOR_R][i],
+                                          s[E::INITIAL_COLOR_G][i],
+                                          s[E::INITIAL_COLOR_B][i],
+                                          s[E::INITIAL_COLOR_A][i]);
+                p.finalColor   = XMFLOAT4(
+                    s[E::FINAL_COLOR_R][i], s[E::FINAL_COLOR_G][i], s[E::FINAL_COLOR_B][i], s[E::FINAL_COLOR_A][i]);
+                p.velocity     = XMFLOAT3(s[E::VELOCITY_X][i], s[E::VELOCITY_Y][i], s[E::VELOCITY_Z][i]);
+                p.time         = s[E::TIME][i];
+                p.lifeSpan     = XMFLOAT3(s[E::LIFESPAN_X][i], s[E::LIFESPAN_Y][i], s[E::LIFESPAN_Z][i]);
+                p.scale        = XMFLOAT2(s[E::SCALE_X][i], s[E::SCALE_Y][i]);
+                p.acceleration = XMFLOAT3(s[E::ACCELERATION_X][i], s[E::ACCELERATION_Y][i], s[E::ACCELERATION_Z][i]);
+                memcpy(&p.flags, s[E::FLAGS] + i, sizeof(unsigned int));
+                memcpy(&p.textureIndex, s[E::TEXTURE_INDEX] + i, sizeof(unsigned int));
+        }
+}
+
+void ParticleSimulationCPU::ReadGPULayout(const FParticleGPU* input, unsigned int begin, unsigned int end)
+{
+        using E = E_PARTICLE_STREAM;
+        assert(end <= gMaxParticleCount);
+
+        float* s[E::COUNT];
+        for (int i = 0; i < E::COUNT; ++i)
+                s[i] = GetStream(i);
+
+        for (unsigned int i = begin; i < end; ++i)
+        {
+                const FParticleGPU& p    = input[i - begin];
+                s[E::POSITION_X][i]      = p.position.x;
+                s[E::POSITION_Y][i]      = p.position.y;
+                s[E::POSITION_Z][i]      = p.position.z;
+                s[E::PREV_POSITION_X][i] = p.prevPos.x;
+                s[E::PREV_POSITION_Y][i] = p.prevPos.y;
+                s[E::PREV_POSITION_Z][i] = p.prevPos.z;
+                s[E::VELOCITY_X][i]      = p.velocity.x;
+                s[E::VELOCITY_Y][i]      = p.velocity.y;
+                s[E::VELOCITY_Z][i]      = p.velocity.z;
+                s[E::ACCELERATION_X][i]  = p.acceleration.x;
+                s[E::ACCELERATION_Y][i]  = p.acceleration.y;
+                s[E::ACCELERATION_Z][i]  = p.acceleration.z;
+                s[E::TIME][i]            = p.time;
+                s[E::LIFESPAN_X][i]      = p.lifeSpan.x;
+                s[E::LIFESPAN_Y][i]      = p.lifeSpan.y;
+                s[E::LIFESPAN_Z][i]      = p.lifeSpan.z;
+                s[E::SCALE_X][i]         = p.scale.x;
+                s[E::SCALE_Y][i]         = p.scale.y;
+                s[E::INITIAL_COLOR_R][i] = p.initialColor.x;
+                s[E::INITIAL_COLOR_G][i] = p.initialColor.y;
+                s[E::INITIAL_COLOR_B][i] = p.initialColor.z;
+                s[E::INITIAL_COLOR_A][i] = p.initialColor.w;
+                s[E::FINAL_COLOR_R][i]   = p.finalColor.x;
+                s[E::FINAL_COLOR_G][i]   = p.finalColor.y;
+                s[E::FINAL_COLOR_B][i]   = p.finalColor.z;
+                s[E::FINAL_COLOR_A][i]   = p.finalColor.w;
+                memcpy(s[E::FLAGS] + i, &p.flags, sizeof(unsigned int));
+                memcpy(s[E::TEXTURE_INDEX] + i, &p.textureIndex, sizeof(unsigned int));
+        }
+}
\ No newline at end of file
@@ -0,0 +1,215 @@
+#include <ParticleSort.h>
+#include <assert.h>
+#include <float.h>
+#include <malloc.h>
+#include <string.h>
+#include <algorithm>
+#include <JobScheduler.h>
+#include <MemoryTracking.h>
+#include <ParticleSimulationCPU.h>
+#include <Profiling.h>
+
+using namespace ParticleData;
+using namespace DirectX;
+
+namespace
+{
+        constexpr size_t kSortMemoryBytes =
+            (sizeof(float) + sizeof(uint16_t) * 2 + sizeof(uint32_t) * 2) * ParticleData::gMaxParticleCount;
+}
+
+void ParticleSort::Initialize()
+{
+        m_Depths        = static_cast<float*>(_aligned_malloc(sizeof(float) * gMaxParticleCount, 64));
+        m_Keys          = static_cast<uint16_t*>(_aligned_malloc(sizeof(uint16_t) * gMaxParticleCount, 64));
+        m_BinnedKeys    = static_cast<uint16_t*>(_aligned_malloc(sizeof(uint16_t) * gMaxParticleCount, 64));
+        m_BinnedIndices = static_cast<uint32_t*>(_aligned_malloc(sizeof(uint32_t) * gMaxParticleCount, 64));
+        m_SortedIndices = static_cast<uint32_t*>(_aligned_malloc(sizeof(uint32_t) * gMaxParticleCount, 64));
+        assert(m_Depths && m_Keys && m_BinnedKeys && m_BinnedIndices && m_SortedIndices);
+        NMemory::MemoryTracking::TrackAllocation(NMemory::E_MEMORY_TAG::PARTICLES, kSortMemoryBytes);
+}
+
+void ParticleSort::Shutdown()
+{
+        if (m_Depths)
+                NMemory::MemoryTracking::TrackFree(NMemory::E_MEMORY_TAG::PARTICLES, kSortMemoryBytes);
+        _aligned_free(m_Depths);
+        _aligned_free(m_Keys);
+        _aligned_free(m_BinnedKeys);
+        _aligned_free(m_BinnedIndices);
+        _aligned_free(m_SortedIndices);
+        m_Depths        = nullptr;
+        m_Keys          = nullptr;
+        m_BinnedKeys    = nullptr;
+        m_BinnedIndices = nullptr;
+        m_SortedIndices = nullptr;
+}
+
+void ParticleSort::Sort(const ParticleSimulationCPU& simulation, FXMVECTOR eyePosition, FXMVECTOR viewForward)
+{
+        assert(m_Depths);
+        int64_t start = TimeStamp().QuadPart;
+
+        m_Simulation = &simulation;
+        m_Stats      = FParticleSortStats();
+        XMStoreFloat3(&m_EyePosition, eyePosition);
+        XMStoreFloat3(&m_ViewForward, XMVector3Normalize(viewForward));
+
+        auto depthJob = ParallelFor([this](unsigned int block) { ComputeDepths(block); });
+        depthJob.SetRange(0, kBlockCount, 1);
+        depthJob();
+        depthJob.Wait();
+
+        float nearDepth = FLT_MAX;
+        float farDepth  = -FLT_MAX;
+        for (unsigned int block = 0; block < kBlockCount; ++block)
+        {
+                if (m_BlockAliveCounts[block] == 0)
+                        continue;
+                nearDepth = std::min<float>(nearDepth, m_BlockNearDepths[block]);
+                farDepth  = std::max<float>(farDepth, m_BlockFarDepths[block]);
+                m_Stats.sortedCount += m_BlockAliveCounts[block];
+        }
+
+        if (m_Stats.sortedCount == 0)
+        {
+                m_Stats.sortMicroseconds = TimeStamp().QuadPart - start;
+                return;
+        }
+
+        // The farthest particle gets key 0 so that ascending keys draw back to front
+        m_Stats.nearDepth = nearDepth;
+        m_Stats.farDepth  = farDepth;
+        m_DepthScale      = farDepth > nearDepth ? 65535.0f / (farDepth - nearDepth) : 0.0f;
+
+        auto histogramJob = ParallelFor([this](unsigned int block) { BuildHistogram(block); });
+        histogramJob.SetRange(0, kBlockCount, 1);
+        histogramJob();
+        histogramJob.Wait();
+
+        // Exclusive scan over the bins in order and the blocks in order within a bin keeps the scatter stable
+        unsigned int offset = 0;
+        for (unsigned int bin = 0; bin < kBinCount; ++bin)
+        {
+                m_BinOffsets[bin] = offset;
+                for (unsigned int block = 0; block < kBlockCount; ++block)
+                {
+                        unsigned int count            = m_BlockBinOffsets[block][bin];
+                        m_BlockBinOffsets[block][bin] = offset;
+                        offset += count;
+                }
+                if (offset > m_BinOffsets[bin])
+                        m_Stats.occupiedBins++;
+        }
+        m_BinOffsets[kBinCount] = offset;
+        assert(offset == m_Stats.sortedCount);
+
+        auto scatterJob = ParallelFor([this](unsigned int block) { ScatterBins(block); });
+        scatterJob.SetRange(0, kBlockCount, 1);
+        scatterJob();
+        scatterJob.Wait();
+
+        auto binJob = ParallelFor([this](unsigned int bin) { SortBin(bin); });
+        binJob.SetRange(0, kBinCount, 8);
+        binJob();
+        binJob.Wait();
+
+        m_Stats.sortMicroseconds = TimeStamp().QuadPart - start;
+}
+
+void ParticleSort::ComputeDepths(unsigned int block)
+{
+        using E = E_PARTICLE_STREAM;
+
+        const float* time      = m_Simulation->GetStream(E::TIME);
+        const float* positionX = m_Simulation->GetStream(E::POSITION_X);
+        const float* positionY = m_Simulation->GetStream(E::POSITION_Y);
+        const float* positionZ = m_Simulation->GetStream(E::POSITION_Z);
+
+        float        nearDepth = FLT_MAX;
+        float        farDepth  = -FLT_MAX;
+        unsigned int alive     = 0;
+        for (unsigned int i = block * kBlockSize; i < (block + 1) * kBlockSize; ++i)
+        {
+                // Matches the geometry shader, which only emits a quad for particles with time left
+                if (time[i] <= 0.0f)
+                        continue;
+
+                float depth = (positionX[i] - m_EyePosition.x) * m_ViewForward.x +
+                              (positionY[i] - m_EyePosition.y) * m_ViewForward.y +
+                              (positionZ[i] - m_EyePosition.z) * m_ViewForward.z;
+                m_Depths[i] = depth;
+                nearDepth   = std::min<float>(nearDepth, depth);
+                farDepth    = std::max<float>(farDepth, depth);
+                alive++;
+        }
+
+        m_BlockNearDepths[block]  = nearDepth;
+        m_BlockFarDepths[block]   = farDepth;
+        m_BlockAliveCounts[block] = alive;
+}
+
+void ParticleSort::BuildHistogram(unsigned int block)
+{
+        unsigned int* histogram = m_BlockBinOffsets[block];
+        memset(histogram, 0, sizeof(unsigned int) * kBinCount);
+        if (m_BlockAliveCounts[block] == 0)
+                return;
+
+        const float* time = m_Simulation->GetStream(E_PARTICLE_STREAM::TIME);
+        for (unsigned int i = block * kBlockSize; i < (block + 1) * kBlockSize; ++i)
+        {
+                if (time[i] <= 0.0f)
+                        continue;
+
+                float key    = std::min<float>((m_Stats.farDepth - m_Depths[i]) * m_DepthScale, 65535.0f);
+                m_Keys[i]    = (uint16_t)key;
+                histogram[m_Keys[i] >> 8]++;
+        }
+}
+
+void ParticleSort::ScatterBins(unsigned int block)
+{
+        if (m_BlockAliveCounts[block] == 0)
+                return;
+
+        unsigned int* offsets = m_BlockBinOffsets[block];
+        const float*  time    = m_Simulation->GetStream(E_PARTICLE_STREAM::TIME);
+        for (unsigned int i = block * kBlockSize; i < (block + 1) * kBlockSize; ++i)
+        {
+                if (time[i] <= 0.0f)
+                        continue;
+
+                unsigned int destination     = offsets[m_Keys[i] >> 8]++;
+                m_BinnedKeys[destination]    = m_Keys[i];
+                m_BinnedIndices[destination] = i;
+        }
+}
+
+void ParticleSort::SortBin(unsigned int bin)
+{
+        unsigned int begin = m_BinOffsets[bin];
+        unsigned int end   = m_BinOffsets[bin + 1];
+        if (end - begin < 2)
+        {
+                if (end > begin)
+                        m_SortedIndices[begin] = m_BinnedIndices[begin];
+                return;
+        }
+
+        // Counting sort on the low byte of the key
+        unsigned int offsets[256] = {};
+        for (unsigned int i = begin; i < end; ++i)
+                offsets[m_BinnedKeys[i] & 0xFF]++;
+
+        unsigned int offset = begin;
+        for (unsigned int digit = 0; digit < 256; ++digit)
+        {
+                unsigned int count = offsets[digit];
+                offsets[digit]     = offset;
+                offset += count;
+        }
+
+        for (unsigned int i = begin; i < end; ++i)
+                m_SortedIndices[offsets[m_BinnedKeys[i] & 0xFF]++] = m_BinnedIndices[i];
+}
\ No newline at end of file
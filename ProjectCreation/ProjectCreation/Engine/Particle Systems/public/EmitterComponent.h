@@ -15,6 +15,7 @@ class EmitterComponent : public Component<EmitterComponent>
         float                     rotationRate = DirectX::XM_PIDIV2;
         bool                      rotate       = false;
         bool                      active       = true;
+        int                       slot         = -1; // persistent emitter/segment slot, owned by ParticleManager
         // defult values for emitters
         void Zero(); // Set all values to ZERO
         void FloatParticle(DirectX::XMFLOAT3 minOffset,
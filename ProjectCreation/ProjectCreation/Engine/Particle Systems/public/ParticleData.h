@@ -12,6 +12,9 @@ namespace ParticleData
         static constexpr unsigned int gMaxParticleCount = 2 << 18;
         static constexpr unsigned int gMaxEmitterCount  = 2 << 11;
 
+        // Number of emitter segments searched by the compute shaders, matches gMaxEmitterCount in ParticleData.hlsl
+        static constexpr unsigned int gMaxEmitterSlotCount = 2 << 10;
+
         struct FEmitterGPU
         {
                 DirectX::XMFLOAT4 lifeSpan;  // x is life time, y is variance, z,w is fade in ad out
@@ -53,8 +56,24 @@ namespace ParticleData
                 int row;
         };
 
+        // Range of the particle buffer owned by an emitter slot
+        struct FEmitterSegment
+        {
+                unsigned int offset;
+                unsigned int count;
+        };
+
         struct FSegmentBuffer
         {
-                int desiredCount[gMaxEmitterCount];
+                FEmitterSegment segments[gMaxEmitterCount];
+        };
+
+        struct FEmitterUploadStats
+        {
+                unsigned int activeSlots    = 0;
+                unsigned int dirtyEmitters  = 0;
+                unsigned int dirtySegments  = 0;
+                unsigned int uploadedRanges = 0;
+                unsigned int uploadedBytes  = 0;
         };
 }; // namespace ParticleData
\ No newline at end of file
@@ -0,0 +1,55 @@
+#pragma once
+#include "ParticleData.h"
+
+struct FParticleLODSettings
+{
+        float fullDetailSize     = 0.05f;  // projected size (fraction of screen height) that runs at full rate
+        float minDetailSize      = 0.005f; // projected size that runs at minScale
+        float minScale           = 0.1f;
+        float targetFrameTime    = 1.0f / 60.0f;
+        float hysteresis         = 0.1f; // scale difference an emitter tolerates before its LOD moves
+        float response           = 2.0f; // scale change per second while an emitter converges
+        float halfRateEnterScale = 0.5f; // global scale below which particles simulate every second frame
+        float halfRateExitScale  = 0.7f;
+};
+
+struct FParticleLODStats
+{
+        float        globalScale        = 1.0f;
+        unsigned int simulationInterval = 1;
+        unsigned int reducedEmitters    = 0;
+        unsigned int requestedParticles = 0; // before LOD
+        unsigned int lodParticles       = 0; // after LOD
+        unsigned int savedParticles     = 0;
+};
+
+// Scales emitter spawn rate and particle count by projected emitter size and by a global scale driven by the frame
+// time, and halves the simulation rate when the global scale is low. Per emitter scales only move once they are more
+// than the hysteresis away from their target and then converge at a limited rate, so emitters do not pop.
+class ParticleLOD
+{
+    public:
+        FParticleLODSettings m_Settings;
+
+        void  BeginFrame(float frameTime);
+        void  ResetEmitter(unsigned int slot);
+        float UpdateEmitter(unsigned int slot, float radius, float distance, float projectionScale, float deltaTime);
+        void  RecordEmitter(unsigned int requested, unsigned int lodRequested);
+
+        inline unsigned int GetSimulationInterval() const
+        {
+                return m_Stats.simulationInterval;
+        }
+        inline const FParticleLODStats& GetStats() const
+        {
+                return m_Stats;
+        }
+
+    private:
+        float             m_Scales[ParticleData::gMaxEmitterSlotCount];
+        bool              m_Converging[ParticleData::gMaxEmitterSlotCount];
+        float             m_SmoothedFrameTime  = 1.0f / 60.0f;
+        float             m_GlobalScale        = 1.0f;
+        unsigned int      m_SimulationInterval = 1;
+        FParticleLODStats m_Stats;
+};
\ No newline at end of file
@@ -4,8 +4,12 @@
 #include <IResource.h>
 #include "ParticleBufferSetup.h"
 #include "ParticleData.h"
+#include "ParticleLOD.h"
 #include <Pools.h>
 #include "EmitterComponent.h"
+#include "ParticleSegmentAllocator.h"
+#include "ParticleSimulationCPU.h"
+#include "ParticleSort.h"
 class RenderSystem;
 class ComponentManager;
 class ParticleManager
@@ -31,12 +35,40 @@ class ParticleManager
         ParticleData::FParticleGPU*             m_ParticleInfo;
         ParticleData::FEmitterGPU               m_EmittersCPU[ParticleData::gMaxEmitterCount];
         std::vector<EmitterComponent*>          m_Emitters;
-        int                                     m_PreviousEmitterCount = 0;
+        ParticleSimulationCPU                   m_SimulationCPU;
+        ParticleData::FParticleGPU*             m_SimulationCPUStaging = nullptr;
+        bool                                    m_UseCPUSimulation     = false;
+        ParticleSort                            m_Sort;
+        ID3D11Buffer*                           m_SortedIndexBuffer = nullptr;
+        bool                                    m_UseDepthSorting   = false;
         void                                    UpdateResources(ID3D11Resource* resource);
         void                                    update(float deltaTime);
         void                                    init();
         void                                    shutdown();
 
+        // Persistent emitter slots, slot i owns segment i of the particle buffer
+        static constexpr unsigned int           kEmitterDirtyWords = ParticleData::gMaxEmitterSlotCount / 64;
+        static constexpr unsigned int           kStagingRingSize   = 3;
+        uint32_t                                m_SlotOwners[ParticleData::gMaxEmitterSlotCount];
+        uint32_t                                m_SlotLastSeenFrame[ParticleData::gMaxEmitterSlotCount];
+        int16_t                                 m_FreeSlots[ParticleData::gMaxEmitterSlotCount];
+        int                                     m_FreeSlotCount = 0;
+        uint32_t                                m_FrameIndex    = 0;
+        uint64_t                                m_EmitterDirtyBits[kEmitterDirtyWords];
+        uint64_t                                m_SegmentDirtyBits[kEmitterDirtyWords];
+        ID3D11Buffer*                           m_StagingRing[kStagingRingSize];
+        unsigned int                            m_StagingRingIndex = 0;
+        ParticleData::FEmitterUploadStats       m_UploadStats;
+        ParticleSegmentAllocator                m_SegmentAllocator;
+        unsigned int                            m_ParticleBudget         = kDefaultParticleBudget;
+        unsigned int                            m_SimulatedParticleCount = 0;
+        ParticleLOD                             m_LOD;
+        float                                   m_SimulationStepTime = 0.0f;
+        DirectX::XMFLOAT3                       m_SimulationStepOffset;
+        int                                     AcquireEmitterSlot(EmitterComponent& emitter);
+        void                                    ReleaseStaleEmitterSlots();
+        void                                    UploadDirtyRanges();
+
         void ParticleBufferInit(ID3D11Device1*                device1,
                                 ParticleData::FParticleGPU*   particleData,
                                 ParticleData::FEmitterGPU*    emitterData,
@@ -45,8 +77,51 @@ class ParticleManager
         void ParticleBufferShutdown(ParticleBuffer* buffer);
 
     public:
+        // Matches the 256 x 512 threads the compute shaders were dispatched with before segments were budgeted
+        static constexpr unsigned int kDefaultParticleBudget = 256 * 512;
+
         void                           AddEmitter(EmitterComponent* emitter);
         void                           SetParticleInfo(ParticleData::FParticleGPU* particleInfo);
+        // Runs emission and simulation on the job system and uploads the result instead of dispatching the compute
+        // shaders. Particle state is not carried across a switch.
+        void                           SetCPUSimulation(bool enabled);
+        inline bool                    IsCPUSimulation() const
+        {
+                return m_UseCPUSimulation;
+        }
+        // Draws the CPU simulated particles back to front through an index buffer. Has no effect while the particles
+        // are simulated on the GPU.
+        void                           SetDepthSorting(bool enabled);
+        inline bool                    IsDepthSorting() const
+        {
+                return m_UseDepthSorting;
+        }
+        inline const ParticleSort&     GetSort() const
+        {
+                return m_Sort;
+        }
+        inline const ParticleData::FEmitterUploadStats& GetUploadStats() const
+        {
+                return m_UploadStats;
+        }
+        // Total particles shared between emitters, the farthest emitters are trimmed first
+        void                           SetParticleBudget(unsigned int budget);
+        inline unsigned int            GetParticleBudget() const
+        {
+                return m_ParticleBudget;
+        }
+        inline ParticleLOD&            GetLOD()
+        {
+                return m_LOD;
+        }
+        inline const ParticleSegmentAllocator& GetSegmentAllocator() const
+        {
+                return m_SegmentAllocator;
+        }
+        inline const ParticleSimulationCPU& GetSimulationCPU() const
+        {
+                return m_SimulationCPU;
+        }
         static void                    Initialize();
         static void                    Update(float deltaTime);
         static void                    Shutdown();
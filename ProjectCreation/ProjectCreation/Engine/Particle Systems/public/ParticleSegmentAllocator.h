@@ -0,0 +1,49 @@
+#pragma once
+#include <stdint.h>
+#include <vector>
+#include "ParticleData.h"
+
+struct FEmitterSegmentStats
+{
+        unsigned int desired  = 0;
+        unsigned int granted  = 0;
+        unsigned int offset   = 0;
+        float        distance = 0.0f;
+};
+
+struct FSegmentAllocatorStats
+{
+        unsigned int budget          = 0;
+        unsigned int requested       = 0;
+        unsigned int granted         = 0;
+        unsigned int trimmedEmitters = 0;
+};
+
+// Packs the particle count requested by each emitter slot into a contiguous range of the particle buffer.
+// Offsets are the exclusive prefix sum of the granted counts. When the requests exceed the budget the emitters
+// closest to the camera are served first and the farthest ones are trimmed.
+class ParticleSegmentAllocator
+{
+    public:
+        void SetRequest(unsigned int slot, unsigned int desiredCount, float distanceSq);
+        void Allocate(unsigned int budget);
+
+        inline const ParticleData::FEmitterSegment* GetSegments() const
+        {
+                return m_Segments;
+        }
+        inline const FSegmentAllocatorStats& GetStats() const
+        {
+                return m_Stats;
+        }
+        FEmitterSegmentStats GetEmitterStats(unsigned int slot) const;
+
+    private:
+        void TrimToBudget(unsigned int budget);
+
+        unsigned int                  m_DesiredCounts[ParticleData::gMaxEmitterSlotCount] = {};
+        float                         m_DistancesSq[ParticleData::gMaxEmitterSlotCount]   = {};
+        ParticleData::FEmitterSegment m_Segments[ParticleData::gMaxEmitterSlotCount]      = {};
+        std::vector<uint16_t>         m_PriorityOrder;
+        FSegmentAllocatorStats        m_Stats;
+};
\ No newline at end of file
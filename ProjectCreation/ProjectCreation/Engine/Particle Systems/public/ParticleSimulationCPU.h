@@ -0,0 +1,101 @@
+#pragma once
+#include <DirectXMath.h>
+#include <stdint.h>
+#include "ParticleData.h"
+
+// Stream layout of the CPU particle buffer, one float (or uint) array per field
+struct E_PARTICLE_STREAM
+{
+        enum
+        {
+                POSITION_X = 0,
+                POSITION_Y,
+                POSITION_Z,
+                PREV_POSITION_X,
+                PREV_POSITION_Y,
+                PREV_POSITION_Z,
+                VELOCITY_X,
+                VELOCITY_Y,
+                VELOCITY_Z,
+                ACCELERATION_X,
+                ACCELERATION_Y,
+                ACCELERATION_Z,
+                TIME,
+                LIFESPAN_X,
+                LIFESPAN_Y,
+                LIFESPAN_Z,
+                SCALE_X,
+                SCALE_Y,
+                INITIAL_COLOR_R,
+                INITIAL_COLOR_G,
+                INITIAL_COLOR_B,
+                INITIAL_COLOR_A,
+                FINAL_COLOR_R,
+                FINAL_COLOR_G,
+                FINAL_COLOR_B,
+                FINAL_COLOR_A,
+                FLAGS,
+                TEXTURE_INDEX,
+                COUNT
+        };
+};
+
+struct FParticleSimulationParams
+{
+        float             time      = 0.0f; // SceneInfoBuffer::_Time
+        float             deltaTime = 0.0f; // SceneInfoBuffer::_DeltaTime
+        DirectX::XMFLOAT3 worldOffsetDelta{0.0f, 0.0f, 0.0f};
+};
+
+struct FParticleSimulationStats
+{
+        unsigned int aliveCount         = 0;
+        unsigned int spawnedCount       = 0;
+        int64_t      updateMicroseconds = 0;
+};
+
+// CPU implementation of EmittionComputeShader_CS followed by SimulationComputeShader_CS.
+// Particles are stored as SoA streams and processed four at a time in blocks of kBlockSize.
+// Scene depth collision is not reproduced as the depth buffer only exists on the GPU.
+class ParticleSimulationCPU
+{
+    public:
+        static constexpr unsigned int kBlockSize  = 256;
+        static constexpr unsigned int kBlockCount = ParticleData::gMaxParticleCount / kBlockSize;
+
+        void Initialize();
+        void Shutdown();
+
+        // Runs emission and simulation for every particle, blocks until all jobs have finished
+        void Update(const ParticleData::FEmitterGPU*    emitters,
+                    const ParticleData::FSegmentBuffer& segments,
+                    const FParticleSimulationParams&    params);
+
+        // Converts particles [begin, end) to the structured buffer layout used by the shaders
+        void WriteGPULayout(ParticleData::FParticleGPU* output, unsigned int begin, unsigned int end) const;
+        void ReadGPULayout(const ParticleData::FParticleGPU* input, unsigned int begin, unsigned int end);
+
+        inline float* GetStream(int stream)
+        {
+                return m_Streams + (size_t)stream * ParticleData::gMaxParticleCount;
+        }
+        inline const float* GetStream(int stream) const
+        {
+                return m_Streams + (size_t)stream * ParticleData::gMaxParticleCount;
+        }
+        inline const FParticleSimulationStats& GetStats() const
+        {
+                return m_Stats;
+        }
+
+    private:
+        void UpdateBlock(unsigned int block);
+
+        float*                              m_Streams  = nullptr;
+        const ParticleData::FEmitterGPU*    m_Emitters = nullptr;
+        const ParticleData::FSegmentBuffer* m_Segments = nullptr;
+        FParticleSimulationParams           m_Params;
+        FParticleSimulationStats            m_Stats;
+        unsigned int                        m_BlockAliveCounts[kBlockCount]   = {};
+        unsigned int                        m_BlockSpawnedCounts[kBlockCount] = {};
+};
\ No newline at end of file
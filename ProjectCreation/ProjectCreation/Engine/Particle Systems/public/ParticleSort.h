@@ -0,0 +1,65 @@
+#pragma once
+#include <DirectXMath.h>
+#include <stdint.h>
+#include "ParticleData.h"
+
+class ParticleSimulationCPU;
+
+struct FParticleSortStats
+{
+        unsigned int sortedCount      = 0;
+        unsigned int occupiedBins     = 0;
+        float        nearDepth        = 0.0f;
+        float        farDepth         = 0.0f;
+        int64_t      sortMicroseconds = 0;
+};
+
+// Orders the live particles of the CPU simulation back to front for alpha blending.
+// View depth is quantized to a 16 bit key over the depth range of the live particles. Particles are binned by the
+// high byte of the key with a parallel histogram and scatter, then every bin is ordered by the low byte on its own.
+class ParticleSort
+{
+    public:
+        static constexpr unsigned int kBlockSize  = 4096;
+        static constexpr unsigned int kBlockCount = ParticleData::gMaxParticleCount / kBlockSize;
+        static constexpr unsigned int kBinCount   = 256;
+
+        void Initialize();
+        void Shutdown();
+
+        // Sorts by distance along viewForward from eyePosition, farthest first. Blocks until all jobs have finished.
+        void Sort(const ParticleSimulationCPU& simulation, DirectX::FXMVECTOR eyePosition, DirectX::FXMVECTOR viewForward);
+
+        // Particle indices in draw order, valid until the next Sort
+        inline const uint32_t* GetSortedIndices() const
+        {
+                return m_SortedIndices;
+        }
+        inline const FParticleSortStats& GetStats() const
+        {
+                return m_Stats;
+        }
+
+    private:
+        void ComputeDepths(unsigned int block);
+        void BuildHistogram(unsigned int block);
+        void ScatterBins(unsigned int block);
+        void SortBin(unsigned int bin);
+
+        const ParticleSimulationCPU* m_Simulation    = nullptr;
+        float*                       m_Depths        = nullptr;
+        uint16_t*                    m_Keys          = nullptr;
+        uint16_t*                    m_BinnedKeys    = nullptr;
+        uint32_t*                    m_BinnedIndices = nullptr;
+        uint32_t*                    m_SortedIndices = nullptr;
+        DirectX::XMFLOAT3            m_EyePosition;
+        DirectX::XMFLOAT3            m_ViewForward;
+        float                        m_DepthScale = 0.0f;
+        FParticleSortStats           m_Stats;
+        float                        m_BlockNearDepths[kBlockCount]            = {};
+        float                        m_BlockFarDepths[kBlockCount]             = {};
+        unsigned int                 m_BlockAliveCounts[kBlockCount]           = {};
+        // Histogram of each block, turned into the block's write offset for every bin
+        unsigned int                 m_BlockBinOffsets[kBlockCount][kBinCount] = {};
+        unsigned int                 m_BinOffsets[kBinCount + 1]               = {};
+};
\ No newline at end of file
@@ -162,6 +162,7 @@ void Bloom::Render(ID3D11ShaderResourceView** inSRV, ID3D11RenderTargetView** ou
         m_Context->PSSetShaderResources(0, 1, inSRV);
         m_Context->PSSetShader(maskPS->m_PixelShader, nullptr, 0);
         m_Context->Draw(4, 0);
+        COUNTER_ADD("Render/Draw calls", 1);
 
         m_Context->PSSetShader(downscaleKarisPS->m_PixelShader, nullptr, 0);
         m_Context->OMSetRenderTargets(0, nullptr, nullptr);
@@ -176,6 +177,7 @@ void Bloom::Render(ID3D11ShaderResourceView** inSRV, ID3D11RenderTargetView** ou
                 // m_Context->ClearRenderTargetView(m_BlurRTVs[i], black);
                 m_Context->OMSetRenderTargets(1, &m_BlurRTVs[0], nullptr);
                 m_Context->Draw(4, 0);
+                COUNTER_ADD("Render/Draw calls", 1);
                 m_Context->OMSetRenderTargets(0, nullptr, nullptr);
                 m_Context->PSSetShaderResources(E_BLOOM_PS_SRV::BLOOM, 1, &m_BlurSRVs[0]);
         }
@@ -194,6 +196,7 @@ void Bloom::Render(ID3D11ShaderResourceView** inSRV, ID3D11RenderTargetView** ou
                 // m_Context->ClearRenderTargetView(m_BlurRTVs[i], black);
                 m_Context->OMSetRenderTargets(1, &m_BlurRTVs[i], nullptr);
                 m_Context->Draw(4, 0);
+                COUNTER_ADD("Render/Draw calls", 1);
                 m_Context->OMSetRenderTargets(0, nullptr, nullptr);
                 m_Context->PSSetShaderResources(E_BLOOM_PS_SRV::BLOOM, 1, &m_BlurSRVs[i]);
         }
@@ -222,6 +225,7 @@ void Bloom::Render(ID3D11ShaderResourceView** inSRV, ID3D11RenderTargetView** ou
                 m_Context->RSSetViewports(1, &viewport);
                 m_Context->OMSetRenderTargets(1, &m_BlurRTVs[i], nullptr);
                 m_Context->Draw(4, 0);
+                COUNTER_ADD("Render/Draw calls", 1);
                 m_Context->OMSetRenderTargets(0, nullptr, nullptr);
                 m_Context->PSSetShaderResources(E_BLOOM_PS_SRV::BLOOM, 1, &m_BlurSRVs[i]);
         }
@@ -244,6 +248,7 @@ void Bloom::Render(ID3D11ShaderResourceView** inSRV, ID3D11RenderTargetView** ou
         m_Context->PSSetShaderResources(4, 1, &nullSRV);
         m_Context->OMSetRenderTargets(1, &m_BlurRTVs[E_PASSES::AO], nullptr);
         m_Context->Draw(4, 0);
+        COUNTER_ADD("Render/Draw calls", 1);
 
         // Blur AO
         UINT AOTargetIndex = E_PASSES::MASK;
@@ -262,6 +267,7 @@ void Bloom::Render(ID3D11ShaderResourceView** inSRV, ID3D11RenderTargetView** ou
                 m_Context->OMSetRenderTargets(1, &m_BlurRTVs[AOTargetIndex], nullptr);
                 m_Context->PSSetShaderResources(E_BLOOM_PS_SRV::BLOOM, 1, &m_BlurSRVs[E_PASSES::AO]);
                 m_Context->Draw(4, 0);
+                COUNTER_ADD("Render/Draw calls", 1);
         }
 
         UINT div        = (UINT)pow(2, 0);
@@ -276,6 +282,7 @@ void Bloom::Render(ID3D11ShaderResourceView** inSRV, ID3D11RenderTargetView** ou
         m_Context->PSSetShaderResources(E_BLOOM_PS_SRV::BLOOM, 1, &m_BlurSRVs[0]);
         m_Context->PSSetShaderResources(E_BLOOM_PS_SRV::SCREEN, 1, inSRV);
         m_Context->Draw(4, 0);
+        COUNTER_ADD("Render/Draw calls", 1);
 }
 
 void Bloom::Shutdown()
@@ -4,6 +4,7 @@
 #include <EntityFactory.h>
 #include <FileIO.h>
 #include <GEngine.h>
+#include <JobScheduler.h>
 #include <MathLibrary.h>
 #include <PlayerMovement.h>
 #include <RenderingSystem.h>
@@ -22,9 +23,11 @@
 #include <wrl/client.h>
 
 #include <AnimationClip.h>
+#include <AnimationSystem.h>
 #include <GeometryShader.h>
 #include <Material.h>
 #include <PixelShader.h>
+#include <ShaderCache.h>
 #include <SkeletalMesh.h>
 #include <StaticMesh.h>
 #include <Texture2D.h>
@@ -317,15 +320,14 @@ void RenderSystem::CreateInputLayouts()
             {"TANGENT", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
             {"BINORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0}};
 
-        FileIO::FShaderData shaderData;
-        EResult             er = FileIO::LoadShaderDataFromFile("Default", "_VS", &shaderData);
+        FShaderBytecode shaderData = ShaderCache::GetBytecode("Default", E_SHADER_STAGE::VS);
 
-        assert(er.m_Flags == ERESULT_FLAG::SUCCESS);
+        assert(shaderData.data);
 
         HRESULT hr = m_Device->CreateInputLayout(vLayout,
                                                  ARRAYSIZE(vLayout),
-                                                 shaderData.bytes.data(),
-                                                 shaderData.bytes.size(),
+                                                 shaderData.data,
+                                                 shaderData.size,
                                                  &m_DefaultInputLayouts[E_INPUT_LAYOUT::DEFAULT]);
         assert(SUCCEEDED(hr));
 
@@ -340,14 +342,14 @@ void RenderSystem::CreateInputLayouts()
             {"JOINTINDICES", 0, DXGI_FORMAT_R32G32B32A32_UINT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
             {"WEIGHTS", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0}};
 
-        er = FileIO::LoadShaderDataFromFile("Default_Skinned", "_VS", &shaderData);
+        shaderData = ShaderCache::GetBytecode("Default_Skinned", E_SHADER_STAGE::VS);
 
-        assert(er.m_Flags == ERESULT_FLAG::SUCCESS);
+        assert(shaderData.data);
 
         hr = m_Device->CreateInputLayout(vLayoutSkinned,
                                          ARRAYSIZE(vLayoutSkinned),
-                                         shaderData.bytes.data(),
-                                         shaderData.bytes.size(),
+                                         shaderData.data,
+                                         shaderData.size,
                                          &m_DefaultInputLayouts[E_INPUT_LAYOUT::SKINNED]);
         assert(SUCCEEDED(hr));
 
@@ -355,14 +357,14 @@ void RenderSystem::CreateInputLayouts()
             {"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
             {"COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0}};
 
-        er = FileIO::LoadShaderDataFromFile("Debug", "_VS", &shaderData);
+        shaderData = ShaderCache::GetBytecode("Debug", E_SHADER_STAGE::VS);
 
-        assert(er.m_Flags == ERESULT_FLAG::SUCCESS);
+        assert(shaderData.data);
 
         hr = m_Device->CreateInputLayout(vLayoutDebug,
                                          ARRAYSIZE(vLayoutDebug),
-                                         shaderData.bytes.data(),
-                                         shaderData.bytes.size(),
+                                         shaderData.data,
+                                         shaderData.size,
                                          &m_DefaultInputLayouts[E_INPUT_LAYOUT::DEBUG]);
 
         assert(SUCCEEDED(hr));
@@ -371,14 +373,14 @@ void RenderSystem::CreateInputLayouts()
             {"POSITION", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
             {"COLOR", 0, DXGI_FORMAT_R32_UINT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0}};
 
-        er = FileIO::LoadShaderDataFromFile("Line", "_VS", &shaderData);
+        shaderData = ShaderCache::GetBytecode("Line", E_SHADER_STAGE::VS);
 
-        assert(er.m_Flags == ERESULT_FLAG::SUCCESS);
+        assert(shaderData.data);
 
         hr = m_Device->CreateInputLayout(vLayoutLine,
                                          ARRAYSIZE(vLayoutLine),
-                                         shaderData.bytes.data(),
-                                         shaderData.bytes.size(),
+                                         shaderData.data,
+                                         shaderData.size,
                                          &m_DefaultInputLayouts[E_INPUT_LAYOUT::LINE]);
 }
 
@@ -394,6 +396,15 @@ void RenderSystem::CreateCommonShaders()
         m_LineGeometryShader                                   = m_ResourceManager->LoadGeometryShader("Line");
 }
 
+void RenderSystem::CreateCommonTextures()
+{
+        m_CommonTextureHandles[0] = m_ResourceManager->LoadTexture2D("IBLTestDiffuseHDR");
+        m_CommonTextureHandles[1] = m_ResourceManager->LoadTexture2D("IBLTestSpecularHDR");
+        m_CommonTextureHandles[2] = m_ResourceManager->LoadTexture2D("IBLTestBrdf");
+        m_CommonTextureHandles[3] = m_ResourceManager->LoadTexture2D("Clouds_Fibers_BlurredNoise");
+        m_CommonTextureHandles[4] = m_ResourceManager->LoadTexture2D("Veins_Caustics_Tiles");
+}
+
 void RenderSystem::CreateCommonConstantBuffers()
 {
         HRESULT           hr{};
@@ -595,6 +606,7 @@ void RenderSystem::DrawDebug()
             E_CONSTANT_BUFFER_BASE_PASS::MVP, 1, &m_BasePassConstantBuffers[E_CONSTANT_BUFFER_BASE_PASS::MVP]);
         m_Context->PSSetShader(ps, 0, 0);
         m_Context->Draw((UINT)debug_renderer::get_line_vert_count(), 0);
+        COUNTER_ADD("Render/Draw calls", 1);
 }
 
 void RenderSystem::DrawLines()
@@ -661,6 +673,7 @@ void RenderSystem::DrawLines()
                         m_Context->Unmap(m_LineVertexBuffer, 0);
 
                         m_Context->Draw(lengthA, 0);
+                        COUNTER_ADD("Render/Draw calls", 1);
                 }
 
                 if (lengthB > 1)
@@ -671,6 +684,7 @@ void RenderSystem::DrawLines()
                         m_Context->Unmap(m_LineVertexBuffer, 0);
 
                         m_Context->Draw(lengthB, 0);
+                        COUNTER_ADD("Render/Draw calls", 1);
                 }
         }
         ID3D11GeometryShader* nullGS = nullptr;
@@ -704,7 +718,7 @@ void RenderSystem::DrawLines()
         m_Context->IASetInputLayout(m_DefaultInputLayouts[E_INPUT_LAYOUT::DEFAULT]);
 }
 
-void RenderSystem::UpdateConstantBuffer(ID3D11Buffer* gpuBuffer, void* cpuBuffer, size_t size)
+void RenderSystem::UpdateConstantBuffer(ID3D11Buffer* gpuBuffer, const void* cpuBuffer, size_t size)
 {
         D3D11_MAPPED_SUBRESOURCE mappedResource{};
         m_Context->Map(gpuBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource);
@@ -751,6 +765,7 @@ void RenderSystem::DrawMesh(ID3D11Buffer*      vertexBuffer,
                              sizeof(FSurfaceProperties));
 
         m_Context->DrawIndexed(indexCount, 0, 0);
+        COUNTER_ADD("Render/Draw calls", 1);
 }
 
 void RenderSystem::Present()
@@ -805,6 +820,7 @@ void RenderSystem::DrawMeshInstanced(ID3D11Buffer* vertexBuffer,
                              sizeof(FSurfaceProperties));
 
         m_Context->DrawIndexedInstanced(indexCount, instanceCount, 0, 0, instanceOffset);
+        COUNTER_ADD("Render/Draw calls", 1);
 }
 
 void RenderSystem::DrawStaticMesh(StaticMesh* mesh, Material* material, DirectX::XMMATRIX* mtx)
@@ -814,41 +830,26 @@ void RenderSystem::DrawStaticMesh(StaticMesh* mesh, Material* material, DirectX:
         DrawMesh(mesh->m_VertexBuffer, mesh->m_IndexBuffer, mesh->m_IndexCount, sizeof(FVertex), material, mtx);
 }
 
-void RenderSystem::DrawSkeletalMesh(SkeletalMesh*               mesh,
-                                    Material*                   material,
-                                    DirectX::XMMATRIX*          mtx,
-                                    const Animation::FSkeleton* skel)
+void RenderSystem::DrawSkeletalMesh(SkeletalMesh*                mesh,
+                                    Material*                    material,
+                                    DirectX::XMMATRIX*           mtx,
+                                    const SkeletalMeshComponent* meshComp)
 {
         using namespace DirectX;
 
-        const UINT strides[] = {sizeof(FSkinnedVertex)};
-        const UINT offsets[] = {0};
+        const std::vector<XMMATRIX>& palette = meshComp->GetSkinningPalette();
+        assert(palette.size() <= ARRAYSIZE(m_ConstantBuffer_ANIM.jointTransforms));
 
-        int jointCount = (int)skel->jointTransforms.size();
-
-
-        for (int i = 0; i < jointCount; ++i)
+        if (m_DrawBoneHierarchy)
         {
-                m_ConstantBuffer_ANIM.jointTransforms[i] = skel->jointTransforms[i].transform.CreateMatrix();
-        }
-
-        for (int i = 1; i < jointCount; ++i)
-        {
-                XMMATRIX parent = m_ConstantBuffer_ANIM.jointTransforms[skel->jointTransforms[i].parent_index];
-                m_ConstantBuffer_ANIM.jointTransforms[i] = m_ConstantBuffer_ANIM.jointTransforms[i] * parent;
-        }
-        /** If Debug? Debug renderer**/
-        debug_renderer::AddBoneHierarchy(*skel, m_ConstantBuffer_ANIM.jointTransforms, *mtx, ColorConstants::White, 0.2f);
-
-        for (int i = 0; i < jointCount; ++i)
-        {
-                m_ConstantBuffer_ANIM.jointTransforms[i] = XMMatrixTranspose(skel->inverseBindPose[i].transform.CreateMatrix() *
-                                                                             m_ConstantBuffer_ANIM.jointTransforms[i]);
+                debug_renderer::AddBoneHierarchy(
+                    meshComp->m_Skeleton, meshComp->m_GlobalJointTransforms.data(), *mtx, ColorConstants::White, 0.2f);
         }
 
+        // Palettes are built and transposed by the AnimationSystem, only upload them here
         UpdateConstantBuffer(m_BasePassConstantBuffers[E_CONSTANT_BUFFER_BASE_PASS::ANIM],
-                             &m_ConstantBuffer_ANIM,
-                             sizeof(m_ConstantBuffer_ANIM));
+                             palette.data(),
+                             sizeof(XMMATRIX) * palette.size());
         m_Context->IASetInputLayout(m_DefaultInputLayouts[E_INPUT_LAYOUT::SKINNED]);
 
         DrawMesh(mesh->m_VertexBuffer, mesh->m_IndexBuffer, mesh->m_IndexCount, sizeof(FSkinnedVertex), material, mtx);
@@ -874,13 +875,10 @@ void RenderSystem::OnPreUpdate(float deltaTime)
         using namespace std;
         using namespace DirectX;
 
+        GET_SYSTEM(AnimationSystem)->WaitForSkinningPalettes();
+
         ID3D11ShaderResourceView* srvs[5] = {0};
-        srvs[0] = m_ResourceManager->GetResource<Texture2D>(m_ResourceManager->LoadTexture2D("IBLTestDiffuseHDR"))->m_SRV;
-        srvs[1] = m_ResourceManager->GetResource<Texture2D>(m_ResourceManager->LoadTexture2D("IBLTestSpecularHDR"))->m_SRV;
-        srvs[2] = m_ResourceManager->GetResource<Texture2D>(m_ResourceManager->LoadTexture2D("IBLTestBrdf"))->m_SRV;
-        srvs[3] =
-            m_ResourceManager->GetResource<Texture2D>(m_ResourceManager->LoadTexture2D("Clouds_Fibers_BlurredNoise"))->m_SRV;
-        srvs[4] = m_ResourceManager->GetResource<Texture2D>(m_ResourceManager->LoadTexture2D("Veins_Caustics_Tiles"))->m_SRV;
+        m_ResourceManager->GetSRVs(5, m_CommonTextureHandles, srvs);
 
         m_Context->PSSetShaderResources(E_BASE_PASS_PIXEL_SRV::PER_MAT_COUNT, 5, srvs);
         m_Context->VSSetShaderResources(E_BASE_PASS_PIXEL_SRV::PER_MAT_COUNT + 3, 2, &srvs[3]);
@@ -941,8 +939,8 @@ void RenderSystem::OnPreUpdate(float deltaTime)
         XMStoreFloat3(&m_ConstantBuffer_SCENE._PlayedVelocity, currVel);
 
         /** Prepare draw calls **/
-        m_TransluscentDraws.clear();
-        m_OpaqueDraws.clear();
+        m_TransluscentDraws = NMemory::FrameVector<FDraw>();
+        m_OpaqueDraws       = NMemory::FrameVector<FDraw>();
         // Add all static meshes
 
 
@@ -958,6 +956,10 @@ void RenderSystem::OnPreUpdate(float deltaTime)
                 TransformComponent* tcomp        = entityHandle.GetComponent<TransformComponent>();
                 Material*           mat          = m_ResourceManager->GetResource<Material>(staticMeshComp.m_MaterialHandle);
 
+                // Meshes and materials loaded asynchronously are skipped until their GPU objects exist
+                if (!staticMesh->IsReady() || !mat->IsReady())
+                        continue;
+
                 drawcall.meshResource   = staticMeshComp.m_StaticMeshHandle;
                 drawcall.materialHandle = staticMeshComp.m_MaterialHandle;
                 drawcall.mtx            = tcomp->transform.CreateMatrix();
@@ -987,6 +989,9 @@ void RenderSystem::OnPreUpdate(float deltaTime)
                 TransformComponent* tcomp        = entityHandle.GetComponent<TransformComponent>();
                 Material*           mat          = m_ResourceManager->GetResource<Material>(skelMeshComp.m_MaterialHandle);
 
+                if (!skelMesh->IsReady() || !mat->IsReady())
+                        continue;
+
                 drawcall.meshResource   = skelMeshComp.m_SkeletalMeshHandle;
                 drawcall.materialHandle = skelMeshComp.m_MaterialHandle;
                 drawcall.mtx            = tcomp->transform.CreateMatrix();
@@ -1112,7 +1117,7 @@ void RenderSystem::OnUpdate(float deltaTime)
                         SkeletalMesh* mesh = m_ResourceManager->GetResource<SkeletalMesh>(m_OpaqueDraws[i].meshResource);
                         Material*     mat  = m_ResourceManager->GetResource<Material>(m_OpaqueDraws[i].materialHandle);
                         SkeletalMeshComponent* meshComp = m_OpaqueDraws[i].componentHandle.Get<SkeletalMeshComponent>();
-                        DrawSkeletalMesh(mesh, mat, &m_OpaqueDraws[i].mtx, &meshComp->m_Skeleton);
+                        DrawSkeletalMesh(mesh, mat, &m_OpaqueDraws[i].mtx, meshComp);
                 }*/
         }
 
@@ -1133,7 +1138,7 @@ void RenderSystem::OnUpdate(float deltaTime)
                         SkeletalMesh* mesh = m_ResourceManager->GetResource<SkeletalMesh>(m_TransluscentDraws[i].meshResource);
                         Material*     mat  = m_ResourceManager->GetResource<Material>(m_TransluscentDraws[i].materialHandle);
                         SkeletalMeshComponent* meshComp = m_TransluscentDraws[i].componentHandle.Get<SkeletalMeshComponent>();
-                        DrawSkeletalMesh(mesh, mat, &m_TransluscentDraws[i].mtx, &meshComp->m_Skeleton);
+                        DrawSkeletalMesh(mesh, mat, &m_TransluscentDraws[i].mtx, meshComp);
                 }*/
         }
         DrawLines();
@@ -1175,6 +1180,7 @@ void RenderSystem::OnUpdate(float deltaTime)
         }
 
         m_Context->OMSetBlendState(m_BlendStates[E_BLEND_STATE::Opaque], blendFactor, sampleMask);
+        debug_renderer::merge_lines();
         if (GEngine::Get()->IsDebugMode())
                 DrawDebug();
         debug_renderer::clear_lines();
@@ -1200,20 +1206,41 @@ void RenderSystem::OnInitialize()
         m_ResourceManager = GEngine::Get()->GetResourceManager();
         m_HandleManager   = GEngine::Get()->GetHandleManager();
 
-        CreateDeviceAndSwapChain();
-        D3D11_TEXTURE2D_DESC desc;
-        UIManager::Initialize(m_WindowHandle);
-        auto res = UIManager::instance->GetHighestSupportedResolution();
-        CreateDefaultRenderTargets(&desc, res.first, res.second, false);
-        CreateRasterizerStates();
-        CreateCommonShaders();
-        CreateInputLayouts();
-        CreateCommonConstantBuffers();
-        CreateSamplerStates();
-        CreateDebugBuffers();
-        CreatePostProcessEffects(&desc);
-        CreateBlendStates();
-        CreateDepthStencilStates();
+        {
+                PROFILE_SCOPE("Startup", "CreateDevice");
+                CreateDeviceAndSwapChain();
+                ShaderCache::Initialize(m_Device);
+        }
+
+        // Fixed function states only need the device, a worker creates them while this thread helps creating the
+        // shaders the last run recorded
+        {
+                PROFILE_SCOPE("Startup", "PipelineStates");
+                auto stateJob = Job<>([this]() {
+                        PROFILE_SCOPE("Startup", "FixedFunctionStates");
+                        CreateRasterizerStates();
+                        CreateSamplerStates();
+                        CreateBlendStates();
+                        CreateDepthStencilStates();
+                });
+                stateJob();
+                ShaderCache::Prewarm();
+                stateJob.Wait();
+        }
+
+        {
+                PROFILE_SCOPE("Startup", "RenderResources");
+                D3D11_TEXTURE2D_DESC desc;
+                UIManager::Initialize(m_WindowHandle);
+                auto res = UIManager::instance->GetHighestSupportedResolution();
+                CreateDefaultRenderTargets(&desc, res.first, res.second, false);
+                CreateCommonShaders();
+                CreateCommonTextures();
+                CreateInputLayouts();
+                CreateCommonConstantBuffers();
+                CreateDebugBuffers();
+                CreatePostProcessEffects(&desc);
+        }
 
         // UI Manager Initialize
         /** Create viewport. This should be replaced**/
@@ -18,7 +18,9 @@
 #include <DirectXMacros.h>
 #include <StaticMeshComponent.h>
 #include <debug_renderer.h>
+#include <MemoryTracking.h>
 #include <RenderingSystem.h>
+#include <ShaderCache.h>
 
 TerrainManager* TerrainManager::instance;
 
@@ -28,29 +30,11 @@ void TerrainManager::_initialize(RenderSystem* rs)
 
         // Terrain shaders
         {
-                FileIO::FShaderData vertexShaderData;
-                FileIO::LoadShaderDataFromFile("Terrain", "_VS", &vertexShaderData);
-                rs->GetDevice()->CreateVertexShader(
-                    vertexShaderData.bytes.data(), vertexShaderData.bytes.size(), nullptr, &vertexShader);
-
-                FileIO::FShaderData domainShaderData;
-                FileIO::LoadShaderDataFromFile("Terrain", "_DS", &domainShaderData);
-                rs->GetDevice()->CreateDomainShader(
-                    domainShaderData.bytes.data(), domainShaderData.bytes.size(), nullptr, &domainShader);
-
-                FileIO::FShaderData hullShaderData;
-                FileIO::LoadShaderDataFromFile("Terrain", "_HS", &hullShaderData);
-                rs->GetDevice()->CreateHullShader(
-                    hullShaderData.bytes.data(), hullShaderData.bytes.size(), nullptr, &hullShader);
-
-                FileIO::LoadShaderDataFromFile("Ocean", "_HS", &hullShaderData);
-                rs->GetDevice()->CreateHullShader(
-                    hullShaderData.bytes.data(), hullShaderData.bytes.size(), nullptr, &oceanHullShader);
-
-                FileIO::FShaderData pixelShaderData;
-                FileIO::LoadShaderDataFromFile("Terrain", "_PS", &pixelShaderData);
-                rs->GetDevice()->CreatePixelShader(
-                    pixelShaderData.bytes.data(), pixelShaderData.bytes.size(), nullptr, &pixelShader);
+                vertexShader    = (ID3D11VertexShader*)ShaderCache::AcquireShader("Terrain", E_SHADER_STAGE::VS);
+                domainShader    = (ID3D11DomainShader*)ShaderCache::AcquireShader("Terrain", E_SHADER_STAGE::DS);
+                hullShader      = (ID3D11HullShader*)ShaderCache::AcquireShader("Terrain", E_SHADER_STAGE::HS);
+                oceanHullShader = (ID3D11HullShader*)ShaderCache::AcquireShader("Ocean", E_SHADER_STAGE::HS);
+                pixelShader     = (ID3D11PixelShader*)ShaderCache::AcquireShader("Terrain", E_SHADER_STAGE::PS);
 
                 D3D11_INPUT_ELEMENT_DESC vLayout[] = {
                     {"POSITION",
@@ -63,21 +47,14 @@ void TerrainManager::_initialize(RenderSystem* rs)
                     {"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
                 };
 
-                rs->GetDevice()->CreateInputLayout(
-                    vLayout, 2, vertexShaderData.bytes.data(), vertexShaderData.bytes.size(), &inputLayout);
+                FShaderBytecode vertexShaderData = ShaderCache::GetBytecode("Terrain", E_SHADER_STAGE::VS);
+                rs->GetDevice()->CreateInputLayout(vLayout, 2, vertexShaderData.data, vertexShaderData.size, &inputLayout);
         }
 
         // Ocean shaders
         {
-                FileIO::FShaderData pixelShaderData;
-                FileIO::LoadShaderDataFromFile("Ocean", "_PS", &pixelShaderData);
-                rs->GetDevice()->CreatePixelShader(
-                    pixelShaderData.bytes.data(), pixelShaderData.bytes.size(), nullptr, &oceanPixelShader);
-
-                FileIO::FShaderData domainShaderData;
-                FileIO::LoadShaderDataFromFile("Ocean", "_DS", &domainShaderData);
-                rs->GetDevice()->CreateDomainShader(
-                    domainShaderData.bytes.data(), domainShaderData.bytes.size(), nullptr, &oceanDomainShader);
+                oceanPixelShader  = (ID3D11PixelShader*)ShaderCache::AcquireShader("Ocean", E_SHADER_STAGE::PS);
+                oceanDomainShader = (ID3D11DomainShader*)ShaderCache::AcquireShader("Ocean", E_SHADER_STAGE::DS);
         }
 
 
@@ -514,6 +491,7 @@ void TerrainManager::_update(float deltaTime)
                                                    &renderSystem->m_ConstantBuffer_MVP,
                                                    sizeof(renderSystem->m_ConstantBuffer_MVP));
                 renderSystem->m_Context->DrawIndexed(patchQuadCount * 4, 0, 0);
+                COUNTER_ADD("Render/Draw calls", 1);
         }
 
         renderSystem->m_Context->HSSetShader(hullShader, nullptr, 0);
@@ -527,6 +505,7 @@ void TerrainManager::_update(float deltaTime)
                 renderSystem->m_Context->PSSetShader(pixelShader, nullptr, 0);
                 renderSystem->m_Context->DSSetShader(domainShader, nullptr, 0);
                 renderSystem->m_Context->DrawIndexed(patchQuadCount * 4, 0, 0);
+                COUNTER_ADD("Render/Draw calls", 1);
         }
 
         // Volcano Stuff
@@ -862,15 +841,15 @@ DirectX::XMVECTOR TerrainManager::AlignPositionToTerrain(const DirectX::XMVECTOR
 
 void TerrainManager::Initialize(RenderSystem* rs)
 {
+        NMemory::ScopedMemoryTag memoryTag(NMemory::E_MEMORY_TAG::TERRAIN);
         instance = new TerrainManager;
         instance->_initialize(rs);
 }
 
 void TerrainManager::Update(float deltaTime)
 {
-        GEngine::Get()->m_MainThreadProfilingContext.Begin("TerrainManager", "TerrainManager");
+        PROFILE_SCOPE("TerrainManager", "TerrainManager");
         instance->_update(deltaTime);
-        GEngine::Get()->m_MainThreadProfilingContext.End();
 }
 
 void TerrainManager::Shutdown()
@@ -1,7 +1,12 @@
 #include "debug_renderer.h"
+#include <assert.h>
 #include <array>
 #include <ColorConstants.h>
 #include <MemoryDefines.h>
+#include <MemoryTracking.h>
+#include <algorithm>
+#include <atomic>
+#include <string.h>
 
 using namespace DirectX;
 
@@ -14,10 +19,63 @@ namespace
         // Maximum number of debug lines at one time (i.e: Capacity)
         constexpr size_t MAX_LINE_VERTS = MB(4) / sizeof(FDebugVertex);
 
+        // Verts each thread collects locally before reserving a range of the shared block
+        constexpr size_t THREAD_LINE_VERTS = 1024;
+        constexpr size_t MAX_LINE_THREADS  = 64;
+
         // CPU-side buffer of debug-line verts
         // Copied to the GPU and reset every frame.
-        size_t       line_vert_count = 0;
-        FDebugVertex line_verts[MAX_LINE_VERTS];
+        std::atomic<size_t> line_vert_count{0};
+        FDebugVertex        line_verts[MAX_LINE_VERTS];
+
+        struct alignas(64) FThreadLineBuffer
+        {
+                size_t       count = 0;
+                FDebugVertex verts[THREAD_LINE_VERTS];
+        };
+
+        std::atomic<unsigned int> line_thread_count{0};
+        FThreadLineBuffer         thread_line_buffers[MAX_LINE_THREADS];
+        thread_local int          t_line_buffer_index = -1;
+
+        std::atomic<size_t>             line_flush_count{0};
+        std::atomic<size_t>             line_dropped_vert_count{0};
+        debug_renderer::FDebugLineStats line_stats;
+
+        const NMemory::FStaticMemoryRegistration line_verts_registration(NMemory::E_MEMORY_TAG::DEBUG_RENDERER,
+                                                                         sizeof(line_verts));
+        const NMemory::FStaticMemoryRegistration thread_line_buffers_registration(NMemory::E_MEMORY_TAG::DEBUG_RENDERER,
+                                                                                  sizeof(thread_line_buffers));
+
+        FThreadLineBuffer& GetThreadLineBuffer()
+        {
+                if (t_line_buffer_index < 0)
+                {
+                        unsigned int index = line_thread_count.fetch_add(1);
+                        assert(index < MAX_LINE_THREADS);
+                        t_line_buffer_index = (int)index;
+                }
+                return thread_line_buffers[t_line_buffer_index];
+        }
+
+        // Reserves a range of the shared block with a single atomic bump and copies the thread's verts into it.
+        // Whatever doesn't fit is dropped and counted.
+        void FlushThreadLineBuffer(FThreadLineBuffer& buffer)
+        {
+                if (buffer.count == 0)
+                        return;
+
+                size_t first  = line_vert_count.fetch_add(buffer.count, std::memory_order_relaxed);
+                size_t copied = first < MAX_LINE_VERTS ? std::min<size_t>(buffer.count, MAX_LINE_VERTS - first) : 0;
+
+                if (copied > 0)
+                        memcpy(line_verts + first, buffer.verts, copied * sizeof(FDebugVertex));
+                if (copied < buffer.count)
+                        line_dropped_vert_count.fetch_add(buffer.count - copied, std::memory_order_relaxed);
+
+                line_flush_count.fetch_add(1, std::memory_order_relaxed);
+                buffer.count = 0;
+        }
 } // namespace
 
 namespace debug_renderer
@@ -34,10 +92,15 @@ namespace debug_renderer
                 XMStoreFloat3(&pA, point_a);
                 XMStoreFloat3(&pB, point_b);
 
-                line_verts[line_vert_count]     = FDebugVertex(pA, color_a);
-                line_verts[line_vert_count + 1] = FDebugVertex(pB, color_b);
+                // Lines go to the calling thread's buffer so jobs can submit without locking
+                FThreadLineBuffer& buffer = GetThreadLineBuffer();
+                if (buffer.count + 2 > THREAD_LINE_VERTS)
+                        FlushThreadLineBuffer(buffer);
+
+                buffer.verts[buffer.count]     = FDebugVertex(pA, color_a);
+                buffer.verts[buffer.count + 1] = FDebugVertex(pB, color_b);
 
-                line_vert_count += 2;
+                buffer.count += 2;
         }
 
         void AddGrid(DirectX::XMVECTOR center, float width, int segments, DirectX::XMFLOAT4 color)
@@ -222,12 +285,34 @@ namespace debug_renderer
                 }
         }
 
+        void merge_lines()
+        {
+                // Flushes what is left in every thread's buffer into the shared block
+                unsigned int threadCount = std::min<unsigned int>(line_thread_count.load(), MAX_LINE_THREADS);
+                for (unsigned int i = 0; i < threadCount; ++i)
+                        FlushThreadLineBuffer(thread_line_buffers[i]);
+        }
+
         void clear_lines()
         {
-                // Resets debug_vert_count
+                // Records the frame's stats, then resets debug_vert_count and the thread buffers
+                line_stats.submittedVerts = line_vert_count.load();
+                line_stats.mergedVerts    = get_line_vert_count();
+                line_stats.droppedVerts   = line_dropped_vert_count.exchange(0);
+                line_stats.flushCount     = line_flush_count.exchange(0);
+                line_stats.threadCount    = std::min<unsigned int>(line_thread_count.load(), MAX_LINE_THREADS);
+
+                for (unsigned int i = 0; i < line_stats.threadCount; ++i)
+                        thread_line_buffers[i].count = 0;
+
                 line_vert_count = 0;
         }
 
+        FDebugLineStats get_line_stats()
+        {
+                return line_stats;
+        }
+
         const FDebugVertex* get_line_verts()
         {
                 // Does just what it says in the name
@@ -236,8 +321,8 @@ namespace debug_renderer
 
         size_t get_line_vert_count()
         {
-                // Does just what it says in the name
-                return line_vert_count;
+                // Reservations past the end are dropped, so the counter can run over the capacity
+                return std::min<size_t>(line_vert_count.load(), MAX_LINE_VERTS);
         }
 
         size_t get_line_vert_capacity()
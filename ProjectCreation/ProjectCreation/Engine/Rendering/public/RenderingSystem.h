@@ -20,6 +20,7 @@
 /** Forward Declarations **/
 struct StaticMesh;
 struct SkeletalMesh;
+struct SkeletalMeshComponent;
 struct Material;
 struct FTransform;
 struct FCameraSettings;
@@ -251,8 +252,9 @@ class RenderSystem : public ISystem
         ComponentHandle m_SkyHandle;
         ComponentHandle m_CloudHandle;
 
-        std::vector<FDraw> m_OpaqueDraws;
-        std::vector<FDraw> m_TransluscentDraws;
+        // Rebuilt every frame in frame memory
+        NMemory::FrameVector<FDraw> m_OpaqueDraws;
+        NMemory::FrameVector<FDraw> m_TransluscentDraws;
 
         IDXGISwapChain1*      m_Swapchain;
         ID3D11Device1*        m_Device;
@@ -268,6 +270,7 @@ class RenderSystem : public ISystem
         void CreateRasterizerStates();
         void CreateInputLayouts();
         void CreateCommonShaders();
+        void CreateCommonTextures();
         void CreateCommonConstantBuffers();
         void CreateSamplerStates();
         void CreateBlendStates();
@@ -293,6 +296,8 @@ class RenderSystem : public ISystem
         ResourceHandle m_CommonVertexShaderHandles[E_VERTEX_SHADERS::COUNT];
         ResourceHandle m_CommonPixelShaderHandles[E_PIXEL_SHADERS::COUNT];
         ResourceHandle m_LineGeometryShader;
+        // IBL maps and shared noise textures bound every frame
+        ResourceHandle m_CommonTextureHandles[5];
 
 
         /** Base pass constant buffers **/
@@ -310,7 +315,7 @@ class RenderSystem : public ISystem
         float m_BackBufferWidth;
         float m_BackBufferHeight;
 
-        void UpdateConstantBuffer(ID3D11Buffer* gpuBuffer, void* cpuBuffer, size_t size);
+        void UpdateConstantBuffer(ID3D11Buffer* gpuBuffer, const void* cpuBuffer, size_t size);
 
         void DrawMesh(ID3D11Buffer*      vertexBuffer,
                       ID3D11Buffer*      indexBuffer,
@@ -321,7 +326,10 @@ class RenderSystem : public ISystem
 
 
         void DrawStaticMesh(StaticMesh* mesh, Material* material, DirectX::XMMATRIX* mtx);
-        void DrawSkeletalMesh(SkeletalMesh* mesh, Material* material, DirectX::XMMATRIX* mtx, const Animation::FSkeleton* skel);
+        void DrawSkeletalMesh(SkeletalMesh*                mesh,
+                              Material*                    material,
+                              DirectX::XMMATRIX*           mtx,
+                              const SkeletalMeshComponent* meshComp);
 
 
         ComponentHandle  m_MainCameraHandle;
@@ -359,6 +367,9 @@ class RenderSystem : public ISystem
         using native_handle_type = void*;
         native_handle_type m_WindowHandle;
 
+        // Draws the joints of every skeletal mesh through the debug renderer
+        bool m_DrawBoneHierarchy = false;
+
         void         SetWindowHandle(native_handle_type handle);
         void         SetMainCameraComponent(ComponentHandle cameraHandle);
         void         RefreshMainCameraSettings();
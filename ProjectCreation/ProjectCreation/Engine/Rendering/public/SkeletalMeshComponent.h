@@ -13,4 +13,16 @@ struct SkeletalMeshComponent : public Component<SkeletalMeshComponent>
         ResourceHandle m_SkeletalMeshHandle;
 
 		Animation::FSkeleton m_Skeleton;
+
+        // Filled by the AnimationSystem palette job after pose evaluation.
+        // The job writes the back palette and then flips m_FrontPalette, the renderer only uploads the front one.
+        std::vector<DirectX::XMMATRIX> m_InverseBindMatrices;
+        std::vector<DirectX::XMMATRIX> m_GlobalJointTransforms;
+        std::vector<DirectX::XMMATRIX> m_SkinningPalettes[2];
+        int                            m_FrontPalette = 0;
+
+        inline const std::vector<DirectX::XMMATRIX>& GetSkinningPalette() const
+        {
+                return m_SkinningPalettes[m_FrontPalette];
+        }
 };
\ No newline at end of file
@@ -6,8 +6,19 @@
 #include <Vertex.h>
 
 // Interface to the debug renderer
+// add_line may be called from any thread. Each thread fills its own buffer, which is merged into the shared
+// vertex block when it fills up and by merge_lines at the end of the frame.
 namespace debug_renderer
 {
+        struct FDebugLineStats
+        {
+                size_t       submittedVerts = 0;
+                size_t       mergedVerts    = 0;
+                size_t       droppedVerts   = 0;
+                size_t       flushCount     = 0;
+                unsigned int threadCount    = 0;
+        };
+
         void add_line(const DirectX::XMVECTOR& point_a,
                       const DirectX::XMVECTOR& point_b,
                       const DirectX::XMFLOAT4& color_a,
@@ -38,8 +49,14 @@ namespace debug_renderer
                               DirectX::XMMATRIX                  parent,
                               const DirectX::XMFLOAT4&           color = ColorConstants::White);
 
+        // Call once no jobs are adding lines, before reading the verts
+        void merge_lines();
+
         void clear_lines();
 
+        // Stats of the last cleared frame
+        FDebugLineStats get_line_stats();
+
         const FDebugVertex* get_line_verts();
 
         size_t get_line_vert_count();
@@ -1,5 +1,6 @@
 #include <ResourceManager.h>
 #include <assert.h>
+#include <MemoryTracking.h>
 
 #include <RenderingSystem.h>
 #include <GEngine.h>
@@ -10,21 +11,104 @@
 
 #include <d3d11_1.h>
 
+#include <AssetArchive.h>
+
 #include <AnimationClip.h>
 #include <ComputeShader.h>
 #include <GeometryShader.h>
 #include <Material.h>
 #include <PixelShader.h>
+#include <ShaderCache.h>
 #include <SkeletalMesh.h>
 #include <StaticMesh.h>
 #include <Texture2D.h>
 #include <VertexShader.h>
 
+namespace
+{
+        ID3D11Device* GetDevice()
+        {
+                return GEngine::Get()->GetSystemManager()->GetSystem<RenderSystem>()->m_Device;
+        }
+
+        void CreateMeshBuffers(const void*     vertices,
+                               uint32_t        vertexCount,
+                               uint32_t        vertexSize,
+                               const uint32_t* indices,
+                               uint32_t        indexCount,
+                               ID3D11Buffer**  outVertexBuffer,
+                               ID3D11Buffer**  outIndexBuffer)
+        {
+                HRESULT hr;
+
+                D3D11_BUFFER_DESC bd{};
+                bd.Usage          = D3D11_USAGE_DEFAULT;
+                bd.ByteWidth      = UINT(vertexSize * vertexCount);
+                bd.BindFlags      = D3D11_BIND_VERTEX_BUFFER;
+                bd.CPUAccessFlags = 0;
+
+                D3D11_SUBRESOURCE_DATA InitData{};
+                InitData.pSysMem = vertices;
+
+                hr = GetDevice()->CreateBuffer(&bd, &InitData, outVertexBuffer);
+                assert(SUCCEEDED(hr));
+
+                bd.ByteWidth     = UINT(sizeof(uint32_t) * indexCount);
+                bd.BindFlags     = D3D11_BIND_INDEX_BUFFER;
+                InitData.pSysMem = indices;
+
+                hr = GetDevice()->CreateBuffer(&bd, &InitData, outIndexBuffer);
+                assert(SUCCEEDED(hr));
+        }
+
+        // Uploads straight from the mapped file, the mapping is closed once the view goes away
+        void SetStaticMeshData(StaticMesh* resource, FileIO::FStaticMeshView& meshView)
+        {
+                resource->m_VertexCount = meshView.vertexCount;
+                resource->m_IndexCount  = meshView.indexCount;
+
+                CreateMeshBuffers(meshView.vertices,
+                                  resource->m_VertexCount,
+                                  sizeof(FVertex),
+                                  meshView.indices,
+                                  resource->m_IndexCount,
+                                  &resource->m_VertexBuffer,
+                                  &resource->m_IndexBuffer);
+        }
+
+        // Skinned vertices are only needed by the GPU, the mapping is closed once the view goes away
+        void SetSkeletalMeshData(SkeletalMesh* resource, FileIO::FSkeletalMeshView& meshView)
+        {
+                resource->m_BindPoseSkeleton.inverseBindPose = std::move(meshView.inverseJoints);
+                resource->m_BindPoseSkeleton.jointTransforms = std::move(meshView.joints);
+                resource->m_VertexCount                      = meshView.vertexCount;
+                resource->m_IndexCount                       = meshView.indexCount;
+
+                CreateMeshBuffers(meshView.vertices,
+                                  resource->m_VertexCount,
+                                  sizeof(FSkinnedVertex),
+                                  meshView.indices,
+                                  resource->m_IndexCount,
+                                  &resource->m_VertexBuffer,
+                                  &resource->m_IndexBuffer);
+        }
+
+        void CreateTextureFromAsset(Texture2D* resource, const FileIO::FAssetFile& file)
+        {
+                ID3D11Resource* texture;
+                HRESULT         hr = DirectX::CreateDDSTextureFromMemory(
+                    GetDevice(), (const uint8_t*)file.GetData(), file.GetSize(), &texture, &resource->m_SRV);
+                assert(SUCCEEDED(hr));
+                texture->Release();
+        }
+} // namespace
+
 
 ResourceHandle ResourceManager::LoadMaterial(const char* name)
 {
+        NMemory::ScopedMemoryTag memoryTag(NMemory::E_MEMORY_TAG::RESOURCES);
         auto container = GetResourceContainer<Material>();
-        auto it        = container->m_NameTable.find(name);
+        auto it        = container->m_NameTable.find(FAssetId(name));
 
         ResourceHandle outputHandle;
 
@@ -52,6 +136,7 @@ ResourceHandle ResourceManager::LoadMaterial(const char* name)
         else
         {
                 outputHandle = it->second;
+                WaitIfPending(container, outputHandle);
         }
 
 
@@ -60,29 +145,26 @@ ResourceHandle ResourceManager::LoadMaterial(const char* name)
 
 ResourceHandle ResourceManager::LoadTexture2D(const char* name)
 {
+        NMemory::ScopedMemoryTag memoryTag(NMemory::E_MEMORY_TAG::RESOURCES);
         auto container = GetResourceContainer<Texture2D>();
-        auto it        = container->m_NameTable.find(name);
+        auto it        = container->m_NameTable.find(FAssetId(name));
 
         ResourceHandle outputHandle;
 
         if (it == container->m_NameTable.end())
         {
-                RenderSystem* renderSystem = GEngine::Get()->GetSystemManager()->GetSystem<RenderSystem>();
-
                 outputHandle = container->CreateResource(name);
 
-                FileIO::FMaterialData materialData;
-                Texture2D*            resource = container->GetResource(outputHandle);
+                FileIO::FAssetFile file;
+                EResult            result = file.Open("Textures", name, ".dds");
 
-                ID3D11Resource* texture;
-                std::wstring    str = L"../Assets/Textures/" + StringUtility::utf8_decode(name) + L".dds";
-                HRESULT hr = DirectX::CreateDDSTextureFromFile(renderSystem->m_Device, str.c_str(), &texture, &resource->m_SRV);
-                assert(SUCCEEDED(hr));
-                texture->Release();
+                assert(result.m_Flags == ERESULT_FLAG::SUCCESS);
+                CreateTextureFromAsset(container->GetResource(outputHandle), file);
         }
         else
         {
                 outputHandle = it->second;
+                WaitIfPending(container, outputHandle);
         }
 
 
@@ -91,28 +173,20 @@ ResourceHandle ResourceManager::LoadTexture2D(const char* name)
 
 ResourceHandle ResourceManager::LoadVertexShader(const char* name)
 {
-
-
+        NMemory::ScopedMemoryTag memoryTag(NMemory::E_MEMORY_TAG::RESOURCES);
         auto container = GetResourceContainer<VertexShader>();
-        auto it        = container->m_NameTable.find(name);
+        auto it        = container->m_NameTable.find(FAssetId(name));
 
         ResourceHandle outputHandle;
 
         if (it == container->m_NameTable.end())
         {
-                outputHandle               = container->CreateResource(name);
-                RenderSystem* renderSystem = GEngine::Get()->GetSystemManager()->GetSystem<RenderSystem>();
-
-                FileIO::FMaterialData materialData;
-                VertexShader*         resource = container->GetResource(outputHandle);
-
-                FileIO::FShaderData shaderData;
-                FileIO::LoadShaderDataFromFile(name, "_VS", &shaderData);
+                outputHandle = container->CreateResource(name);
 
-                HRESULT hr = renderSystem->m_Device->CreateVertexShader(
-                    shaderData.bytes.data(), shaderData.bytes.size(), nullptr, &resource->m_VertexShader);
+                VertexShader* resource   = container->GetResource(outputHandle);
+                resource->m_VertexShader = (ID3D11VertexShader*)ShaderCache::AcquireShader(name, E_SHADER_STAGE::VS);
 
-                assert(SUCCEEDED(hr));
+                assert(resource->m_VertexShader);
         }
         else
         {
@@ -125,24 +199,20 @@ ResourceHandle ResourceManager::LoadVertexShader(const char* name)
 
 ResourceHandle ResourceManager::LoadPixelShader(const char* name)
 {
+        NMemory::ScopedMemoryTag memoryTag(NMemory::E_MEMORY_TAG::RESOURCES);
         auto container = GetResourceContainer<PixelShader>();
-        auto it        = container->m_NameTable.find(name);
+        auto it        = container->m_NameTable.find(FAssetId(name));
 
         ResourceHandle outputHandle;
 
         if (it == container->m_NameTable.end())
         {
-                outputHandle               = container->CreateResource(name);
-                RenderSystem* renderSystem = GEngine::Get()->GetSystemManager()->GetSystem<RenderSystem>();
-
-                FileIO::FMaterialData materialData;
-                PixelShader*          resource = container->GetResource(outputHandle);
+                outputHandle = container->CreateResource(name);
 
-                FileIO::FShaderData shaderData;
-                FileIO::LoadShaderDataFromFile(name, "_PS", &shaderData);
+                PixelShader* resource   = container->GetResource(outputHandle);
+                resource->m_PixelShader = (ID3D11PixelShader*)ShaderCache::AcquireShader(name, E_SHADER_STAGE::PS);
 
-                renderSystem->m_Device->CreatePixelShader(
-                    shaderData.bytes.data(), shaderData.bytes.size(), nullptr, &resource->m_PixelShader);
+                assert(resource->m_PixelShader);
         }
         else
         {
@@ -155,115 +225,80 @@ ResourceHandle ResourceManager::LoadPixelShader(const char* name)
 
 ResourceHandle ResourceManager::LoadComputeShader(const char* name)
 {
+        NMemory::ScopedMemoryTag memoryTag(NMemory::E_MEMORY_TAG::RESOURCES);
         auto container = GetResourceContainer<ComputeShader>();
-        auto it        = container->m_NameTable.find(name);
+        auto it        = container->m_NameTable.find(FAssetId(name));
 
         ResourceHandle outputHandle;
 
         if (it == container->m_NameTable.end())
         {
+                outputHandle = container->CreateResource(name);
 
-                if (it == container->m_NameTable.end())
-                {
-                        outputHandle               = container->CreateResource(name);
-                        RenderSystem* renderSystem = GEngine::Get()->GetSystemManager()->GetSystem<RenderSystem>();
+                ComputeShader* resource    = container->GetResource(outputHandle);
+                resource->m_ComputerShader = (ID3D11ComputeShader*)ShaderCache::AcquireShader(name, E_SHADER_STAGE::CS);
 
-                        FileIO::FMaterialData materialData;
-                        ComputeShader*        resource = container->GetResource(outputHandle);
+                assert(resource->m_ComputerShader);
+        }
+        else
+        {
+                outputHandle = it->second;
+        }
 
-                        FileIO::FShaderData shaderData;
-                        FileIO::LoadShaderDataFromFile(name, "_CS", &shaderData);
 
-                        renderSystem->m_Device->CreateComputeShader(
-                            shaderData.bytes.data(), shaderData.bytes.size(), nullptr, &resource->m_ComputerShader);
-                }
-                else
-                {
-                        outputHandle = it->second;
-                }
-        }
         return outputHandle;
 }
 
 ResourceHandle ResourceManager::LoadGeometryShader(const char* name)
 {
+        NMemory::ScopedMemoryTag memoryTag(NMemory::E_MEMORY_TAG::RESOURCES);
         auto container = GetResourceContainer<GeometryShader>();
-        auto it        = container->m_NameTable.find(name);
+        auto it        = container->m_NameTable.find(FAssetId(name));
 
         ResourceHandle outputHandle;
 
         if (it == container->m_NameTable.end())
         {
+                outputHandle = container->CreateResource(name);
 
-                if (it == container->m_NameTable.end())
-                {
-                        outputHandle               = container->CreateResource(name);
-                        RenderSystem* renderSystem = GEngine::Get()->GetSystemManager()->GetSystem<RenderSystem>();
+                GeometryShader* resource   = container->GetResource(outputHandle);
+                resource->m_GeometryShader = (ID3D11GeometryShader*)ShaderCache::AcquireShader(name, E_SHADER_STAGE::GS);
 
-                        FileIO::FMaterialData materialData;
-                        GeometryShader*       resource = container->GetResource(outputHandle);
+                assert(resource->m_GeometryShader);
+        }
+        else
+        {
+                outputHandle = it->second;
+        }
 
-                        FileIO::FShaderData shaderData;
-                        FileIO::LoadShaderDataFromFile(name, "_GS", &shaderData);
 
-                        renderSystem->m_Device->CreateGeometryShader(
-                            shaderData.bytes.data(), shaderData.bytes.size(), nullptr, &resource->m_GeometryShader);
-                }
-                else
-                {
-                        outputHandle = it->second;
-                }
-        }
         return outputHandle;
 }
 
 ResourceHandle ResourceManager::LoadStaticMesh(const char* name)
 {
+        NMemory::ScopedMemoryTag memoryTag(NMemory::E_MEMORY_TAG::RESOURCES);
 
 
         auto container = GetResourceContainer<StaticMesh>();
-        auto it        = container->m_NameTable.find(name);
+        auto it        = container->m_NameTable.find(FAssetId(name));
 
         ResourceHandle outputHandle;
 
         if (it == container->m_NameTable.end())
         {
-                HRESULT hr;
-
-                outputHandle               = container->CreateResource(name);
-                RenderSystem* renderSystem = GEngine::Get()->GetSystemManager()->GetSystem<RenderSystem>();
-
-                FileIO::FStaticMeshData meshData;
-                EResult                 result = FileIO::LoadStaticMeshDataFromFile(name, &meshData);
+                outputHandle = container->CreateResource(name);
 
+                FileIO::FStaticMeshView meshView;
+                EResult                 result = FileIO::MapStaticMeshFile(name, &meshView);
                 assert(result.m_Flags == ERESULT_FLAG::SUCCESS);
-                StaticMesh* resource = container->GetResource(outputHandle);
-
-                resource->m_VertexCount = (uint32_t)meshData.vertices.size();
-                resource->m_IndexCount  = (uint32_t)meshData.indices.size();
-
-                D3D11_BUFFER_DESC bd{};
-                bd.Usage          = D3D11_USAGE_DEFAULT;
-                bd.ByteWidth      = UINT(sizeof(FVertex) * resource->m_VertexCount);
-                bd.BindFlags      = D3D11_BIND_VERTEX_BUFFER;
-                bd.CPUAccessFlags = 0;
-
-                D3D11_SUBRESOURCE_DATA InitData{};
-                InitData.pSysMem = meshData.vertices.data();
-
-                hr = renderSystem->m_Device->CreateBuffer(&bd, &InitData, &resource->m_VertexBuffer);
-                assert(SUCCEEDED(hr));
 
-                bd.ByteWidth     = UINT(sizeof(uint32_t) * resource->m_IndexCount);
-                bd.BindFlags     = D3D11_BIND_INDEX_BUFFER;
-                InitData.pSysMem = meshData.indices.data();
-
-                hr = renderSystem->m_Device->CreateBuffer(&bd, &InitData, &resource->m_IndexBuffer);
-                assert(SUCCEEDED(hr));
+                SetStaticMeshData(container->GetResource(outputHandle), meshView);
         }
         else
         {
                 outputHandle = it->second;
+                WaitIfPending(container, outputHandle);
         }
 
 
@@ -272,51 +307,26 @@ ResourceHandle ResourceManager::LoadStaticMesh(const char* name)
 
 ResourceHandle ResourceManager::LoadSkeletalMesh(const char* name)
 {
+        NMemory::ScopedMemoryTag memoryTag(NMemory::E_MEMORY_TAG::RESOURCES);
         auto container = GetResourceContainer<SkeletalMesh>();
-        auto it        = container->m_NameTable.find(name);
+        auto it        = container->m_NameTable.find(FAssetId(name));
 
         ResourceHandle outputHandle;
 
         if (it == container->m_NameTable.end())
         {
-                HRESULT hr;
-
-                outputHandle               = container->CreateResource(name);
-                RenderSystem* renderSystem = GEngine::Get()->GetSystemManager()->GetSystem<RenderSystem>();
+                outputHandle = container->CreateResource(name);
 
-                FileIO::FSkeletalMeshData meshData;
-                EResult                   result = FileIO::LoadSkeletalMeshDataFromFile(name, &meshData);
+                FileIO::FSkeletalMeshView meshView;
+                EResult                   result = FileIO::MapSkeletalMeshFile(name, &meshView);
                 assert(result.m_Flags == ERESULT_FLAG::SUCCESS);
 
-                SkeletalMesh* resource                       = container->GetResource(outputHandle);
-                resource->m_BindPoseSkeleton.inverseBindPose = meshData.inverseJoints;
-                resource->m_BindPoseSkeleton.jointTransforms = meshData.joints;
-                resource->m_VertexCount                      = (uint32_t)meshData.vertices.size();
-                resource->m_IndexCount                       = (uint32_t)meshData.indices.size();
-
-                D3D11_BUFFER_DESC bd{};
-                bd.Usage          = D3D11_USAGE_DEFAULT;
-                bd.ByteWidth      = UINT(sizeof(FSkinnedVertex) * resource->m_VertexCount);
-                bd.BindFlags      = D3D11_BIND_VERTEX_BUFFER;
-                bd.CPUAccessFlags = 0;
-
-                D3D11_SUBRESOURCE_DATA InitData{};
-                InitData.pSysMem = meshData.vertices.data();
-
-                hr = renderSystem->m_Device->CreateBuffer(&bd, &InitData, &resource->m_VertexBuffer);
-
-                assert(SUCCEEDED(hr));
-
-                bd.ByteWidth     = UINT(sizeof(uint32_t) * resource->m_IndexCount);
-                bd.BindFlags     = D3D11_BIND_INDEX_BUFFER;
-                InitData.pSysMem = meshData.indices.data();
-
-                hr = renderSystem->m_Device->CreateBuffer(&bd, &InitData, &resource->m_IndexBuffer);
-                assert(SUCCEEDED(hr));
+                SetSkeletalMeshData(container->GetResource(outputHandle), meshView);
         }
         else
         {
                 outputHandle = it->second;
+                WaitIfPending(container, outputHandle);
         }
 
 
@@ -325,8 +335,9 @@ ResourceHandle ResourceManager::LoadSkeletalMesh(const char* name)
 
 ResourceHandle ResourceManager::LoadAnimationClip(const char* name, const Animation::FSkeleton* skeleton)
 {
+        NMemory::ScopedMemoryTag memoryTag(NMemory::E_MEMORY_TAG::RESOURCES);
         auto container = GetResourceContainer<AnimationClip>();
-        auto it        = container->m_NameTable.find(name);
+        auto it        = container->m_NameTable.find(FAssetId(name));
 
         ResourceHandle outputHandle;
 
@@ -334,10 +345,10 @@ ResourceHandle ResourceManager::LoadAnimationClip(const char* name, const Animat
         {
                 outputHandle = container->CreateResource(name);
 
-                Animation::FAnimClip animClip;
-                FileIO::ImportAnimClipData(name, animClip, *skeleton);
+                Animation::FCompressedAnimClip animClip;
+                FileIO::ImportCompressedAnimClipData(name, animClip, *skeleton);
                 AnimationClip* resource = container->GetResource(outputHandle);
-                resource->m_AnimClip    = animClip;
+                resource->m_AnimClip    = std::move(animClip);
         }
         else
         {
@@ -375,13 +386,272 @@ void ResourceManager::GetSRVs(unsigned int count, ResourceHandle* textureHandles
         }
 }
 
+struct FAsyncLoadRequest
+{
+        ResourceHandle handle;
+        std::string    name;
+        EResult        result;
+
+        virtual ~FAsyncLoadRequest() = default;
+
+        // Loader thread. Reads and decodes the file, must not touch the containers or the device
+        virtual void Load() = 0;
+
+        // Main thread. Creates the GPU objects and fills in the pending resource
+        virtual void Finalize(ResourceManager* resourceManager) = 0;
+};
+
+namespace
+{
+        template <typename T>
+        T* BeginFinalize(ResourceManager* resourceManager, FAsyncLoadRequest* request)
+        {
+                T* resource = resourceManager->GetResource<T>(request->handle);
+                assert(resource->GetState() == E_RESOURCE_STATE::PENDING);
+
+                bool succeeded = request->result.m_Flags == ERESULT_FLAG::SUCCESS;
+                resource->SetState(succeeded ? E_RESOURCE_STATE::READY : E_RESOURCE_STATE::FAILED);
+                return succeeded ? resource : nullptr;
+        }
+
+        struct FStaticMeshLoadRequest : public FAsyncLoadRequest
+        {
+                FileIO::FStaticMeshView meshView;
+
+                virtual void Load() override
+                {
+                        result = FileIO::MapStaticMeshFile(name.c_str(), &meshView);
+                        if (result.m_Flags == ERESULT_FLAG::SUCCESS)
+                                meshView.file.Prefetch();
+                }
+
+                virtual void Finalize(ResourceManager* resourceManager) override
+                {
+                        if (StaticMesh* resource = BeginFinalize<StaticMesh>(resourceManager, this))
+                                SetStaticMeshData(resource, meshView);
+                }
+        };
+
+        struct FSkeletalMeshLoadRequest : public FAsyncLoadRequest
+        {
+                FileIO::FSkeletalMeshView meshView;
+
+                virtual void Load() override
+                {
+                        result = FileIO::MapSkeletalMeshFile(name.c_str(), &meshView);
+                        if (result.m_Flags == ERESULT_FLAG::SUCCESS)
+                                meshView.file.Prefetch();
+                }
+
+                virtual void Finalize(ResourceManager* resourceManager) override
+                {
+                        if (SkeletalMesh* resource = BeginFinalize<SkeletalMesh>(resourceManager, this))
+                                SetSkeletalMeshData(resource, meshView);
+                }
+        };
+
+        struct FTexture2DLoadRequest : public FAsyncLoadRequest
+        {
+                FileIO::FAssetFile file;
+
+                virtual void Load() override
+                {
+                        result = file.Open("Textures", name.c_str(), ".dds");
+                        if (result.m_Flags == ERESULT_FLAG::SUCCESS)
+                                file.Prefetch();
+                }
+
+                virtual void Finalize(ResourceManager* resourceManager) override
+                {
+                        if (Texture2D* resource = BeginFinalize<Texture2D>(resourceManager, this))
+                                CreateTextureFromAsset(resource, file);
+                }
+        };
+
+        struct FMaterialLoadRequest : public FAsyncLoadRequest
+        {
+                FileIO::FMaterialData materialData;
+
+                virtual void Load() override
+                {
+                        result = FileIO::LoadMaterialDataFromFile(name.c_str(), &materialData);
+                }
+
+                virtual void Finalize(ResourceManager* resourceManager) override
+                {
+                        if (Material* resource = BeginFinalize<Material>(resourceManager, this))
+                        {
+                                // Shaders are shared by most materials and already loaded by the time levels stream in
+                                resource->m_VertexShaderHandle = resourceManager->LoadVertexShader(materialData.vertexShader.data());
+                                resource->m_PixelShaderHandle  = resourceManager->LoadPixelShader(materialData.pixelShader.data());
+                                resource->m_SurfaceProperties  = materialData.surfaceProperties;
+
+                                // Textures keep a null SRV until their own load is finalized
+                                resource->m_TextureUsed = 0;
+                                for (auto desc : materialData.textureDescs)
+                                {
+                                        resource->m_TextureHandles[int(desc.textureType)] =
+                                            resourceManager->LoadTexture2DAsync(desc.filePath.data());
+                                        resource->m_TextureUsed |= 1 << int(desc.textureType);
+                                }
+                        }
+                }
+        };
+} // namespace
+
+template <typename T, typename Request>
+ResourceHandle ResourceManager::LoadAsync(const char* name)
+{
+        NMemory::ScopedMemoryTag memoryTag(NMemory::E_MEMORY_TAG::RESOURCES);
+        auto container = GetResourceContainer<T>();
+        auto it        = container->m_NameTable.find(FAssetId(name));
+
+        // Coalesces with a load of the same name that is already queued or finished
+        if (it != container->m_NameTable.end())
+                return it->second;
+
+        ResourceHandle outputHandle = container->CreateResource(name);
+        container->GetResource(outputHandle)->SetState(E_RESOURCE_STATE::PENDING);
+
+        Request* request = new Request();
+        request->handle  = outputHandle;
+        request->name    = name;
+        SubmitLoad(request);
+
+        return outputHandle;
+}
+
+ResourceHandle ResourceManager::LoadMaterialAsync(const char* name)
+{
+        return LoadAsync<Material, FMaterialLoadRequest>(name);
+}
+
+ResourceHandle ResourceManager::LoadTexture2DAsync(const char* name)
+{
+        return LoadAsync<Texture2D, FTexture2DLoadRequest>(name);
+}
+
+ResourceHandle ResourceManager::LoadStaticMeshAsync(const char* name)
+{
+        return LoadAsync<StaticMesh, FStaticMeshLoadRequest>(name);
+}
+
+ResourceHandle ResourceManager::LoadSkeletalMeshAsync(const char* name)
+{
+        return LoadAsync<SkeletalMesh, FSkeletalMeshLoadRequest>(name);
+}
+
+void ResourceManager::SubmitLoad(FAsyncLoadRequest* request)
+{
+        ++m_InFlightLoads;
+        {
+                std::lock_guard<std::mutex> lock(m_LoaderMutex);
+                m_QueuedLoads.push_back(request);
+        }
+        m_LoaderWake.notify_one();
+}
+
+void ResourceManager::LoaderThreadMain()
+{
+        NMemory::ScopedMemoryTag memoryTag(NMemory::E_MEMORY_TAG::RESOURCES);
+
+        while (true)
+        {
+                FAsyncLoadRequest* request;
+                {
+                        std::unique_lock<std::mutex> lock(m_LoaderMutex);
+                        m_LoaderWake.wait(lock, [this]() { return !m_LoadersActive || !m_QueuedLoads.empty(); });
+                        if (!m_LoadersActive)
+                                return;
+
+                        request = m_QueuedLoads.front();
+                        m_QueuedLoads.pop_front();
+                }
+
+                request->Load();
+
+                std::lock_guard<std::mutex> lock(m_CompletedMutex);
+                m_CompletedLoads.push_back(request);
+        }
+}
+
+unsigned int ResourceManager::FinalizeLoads(unsigned int maxCount)
+{
+        NMemory::ScopedMemoryTag memoryTag(NMemory::E_MEMORY_TAG::RESOURCES);
+
+        unsigned int finalizedCount = 0;
+        while (finalizedCount < maxCount)
+        {
+                FAsyncLoadRequest* request;
+                {
+                        std::lock_guard<std::mutex> lock(m_CompletedMutex);
+                        if (m_CompletedLoads.empty())
+                                break;
+
+                        request = m_CompletedLoads.front();
+                        m_CompletedLoads.pop_front();
+                }
+
+                request->Finalize(this);
+                delete request;
+
+                --m_InFlightLoads;
+                ++finalizedCount;
+        }
+
+        return finalizedCount;
+}
+
+void ResourceManager::WaitForLoads()
+{
+        while (m_InFlightLoads > 0)
+        {
+                if (FinalizeLoads() == 0)
+                        std::this_thread::yield();
+        }
+}
+
+void ResourceManager::Update()
+{
+        FinalizeLoads(kMaxFinalizesPerUpdate);
+}
+
 void ResourceManager::Initialize()
-{}
+{
+        // Without the archive every asset is read from its loose file
+        FileIO::AssetArchive::Mount(FileIO::AssetArchive::kDefaultArchivePath);
+
+        m_LoadersActive = true;
+        for (unsigned int i = 0; i < kLoaderThreadCount; ++i)
+                m_LoaderThreads.push_back(std::thread(&ResourceManager::LoaderThreadMain, this));
+}
 
 void ResourceManager::Shutdown()
 {
+        {
+                std::lock_guard<std::mutex> lock(m_LoaderMutex);
+                m_LoadersActive = false;
+        }
+        m_LoaderWake.notify_all();
+        for (auto& thread : m_LoaderThreads)
+                thread.join();
+        m_LoaderThreads.clear();
+
+        // Loads that never ran or were never finalized leave their resources pending
+        for (auto request : m_QueuedLoads)
+                delete request;
+        for (auto request : m_CompletedLoads)
+                delete request;
+        m_QueuedLoads.clear();
+        m_CompletedLoads.clear();
+        m_InFlightLoads = 0;
+
         for (auto& it : m_Containers)
         {
                 delete it.second;
         }
-}
+
+        // Cached shader bytecode and static meshes keep pointers into the archive
+        ShaderCache::Shutdown();
+        FileIO::AssetArchive::Unmount();
+}
\ No newline at end of file
@@ -0,0 +1,309 @@
+#include "ShaderCache.h"
+
+#include <assert.h>
+#include <string.h>
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <d3d11_1.h>
+
+#include <AssetArchive.h>
+#include <AssetId.h>
+#include <JobScheduler.h>
+#include <Profiling.h>
+
+namespace
+{
+        const char* const kStageSuffixes[E_SHADER_STAGE::COUNT] = {"_VS", "_PS", "_GS", "_CS", "_HS", "_DS"};
+
+        struct FShaderEntry
+        {
+                std::string        name;
+                int                stage = 0;
+                bool               read  = false;
+                FileIO::FAssetFile file;
+                uint64_t           contentHash = 0;
+                // One reference owned by the entry, entries with the same bytecode share the object
+                ID3D11DeviceChild* shader = nullptr;
+        };
+
+        ID3D11Device*                                               g_Device = nullptr;
+        std::mutex                                                  g_Mutex;
+        std::unordered_map<uint64_t, std::unique_ptr<FShaderEntry>> g_Entries;
+        // Created objects by content hash, not owning
+        std::unordered_map<uint64_t, ID3D11DeviceChild*> g_Objects;
+        FShaderCacheStats                                g_Stats;
+
+        uint64_t MakeKey(const char* fileName, int stage)
+        {
+                return FAssetId::Hash(fileName) ^ ((uint64_t)stage << 58);
+        }
+
+        int FindStage(const char* suffix)
+        {
+                for (int i = 0; i < E_SHADER_STAGE::COUNT; ++i)
+                        if (strncmp(suffix, kStageSuffixes[i], 3) == 0)
+                                return i;
+                return -1;
+        }
+
+        // DXBC containers start with a 16 byte checksum of their contents, anything else is hashed here
+        uint64_t HashBytecode(const char* data, size_t size)
+        {
+                if (size >= 20 && memcmp(data, "DXBC", 4) == 0)
+                {
+                        uint64_t checksum[2];
+                        memcpy(checksum, data + 4, sizeof(checksum));
+                        return checksum[0] ^ (checksum[1] * 1099511628211ULL);
+                }
+
+                uint64_t hash = 14695981039346656037ULL;
+                for (size_t i = 0; i < size; ++i)
+                        hash = (hash ^ (uint8_t)data[i]) * 1099511628211ULL;
+                return hash;
+        }
+
+        // Safe to call for different entries from several threads
+        void ReadEntry(FShaderEntry* entry)
+        {
+                std::string fileName = entry->name + kStageSuffixes[entry->stage];
+                if (entry->file.Open("Shaders", fileName.c_str(), ".cso").m_Flags == ERESULT_FLAG::SUCCESS)
+                        entry->contentHash = HashBytecode(entry->file.GetData(), entry->file.GetSize());
+                entry->read = true;
+        }
+
+        // The device is free threaded, so this also runs on the job workers
+        ID3D11DeviceChild* CreateShaderObject(int stage, const char* data, size_t size)
+        {
+                ID3D11DeviceChild* output = nullptr;
+                HRESULT            hr     = E_FAIL;
+
+                switch (stage)
+                {
+                        case E_SHADER_STAGE::VS:
+                        {
+                                ID3D11VertexShader* shader = nullptr;
+                                hr                         = g_Device->CreateVertexShader(data, size, nullptr, &shader);
+                                output                     = shader;
+                                break;
+                        }
+                        case E_SHADER_STAGE::PS:
+                        {
+                                ID3D11PixelShader* shader = nullptr;
+                                hr                        = g_Device->CreatePixelShader(data, size, nullptr, &shader);
+                                output                    = shader;
+                                break;
+                        }
+                        case E_SHADER_STAGE::GS:
+                        {
+                                ID3D11GeometryShader* shader = nullptr;
+                                hr                           = g_Device->CreateGeometryShader(data, size, nullptr, &shader);
+                                output                       = shader;
+                                break;
+                        }
+                        case E_SHADER_STAGE::CS:
+                        {
+                                ID3D11ComputeShader* shader = nullptr;
+                                hr                          = g_Device->CreateComputeShader(data, size, nullptr, &shader);
+                                output                      = shader;
+                                break;
+                        }
+                        case E_SHADER_STAGE::HS:
+                        {
+                                ID3D11HullShader* shader = nullptr;
+                                hr                       = g_Device->CreateHullShader(data, size, nullptr, &shader);
+                                output                   = shader;
+                                break;
+                        }
+                        case E_SHADER_STAGE::DS:
+                        {
+                                ID3D11DomainShader* shader = nullptr;
+                                hr                         = g_Device->CreateDomainShader(data, size, nullptr, &shader);
+                                output                     = shader;
+                                break;
+                        }
+                }
+
+                assert(SUCCEEDED(hr));
+                return output;
+        }
+
+        // Gives the entry its reference, sharing the object of identical bytecode if there is one
+        void ResolveShader(FShaderEntry* entry)
+        {
+                if (entry->shader || !entry->file.GetData())
+                        return;
+
+                auto it = g_Objects.find(entry->contentHash);
+                if (it != g_Objects.end() && it->second)
+                {
+                        entry->shader = it->second;
+                        entry->shader->AddRef();
+                        g_Stats.sharedCount++;
+                        return;
+                }
+
+                entry->shader = CreateShaderObject(entry->stage, entry->file.GetData(), entry->file.GetSize());
+                g_Objects[entry->contentHash] = entry->shader;
+        }
+
+        FShaderEntry* GetEntry(const char* fileName, int stage)
+        {
+                assert(stage >= 0 && stage < E_SHADER_STAGE::COUNT);
+
+                auto& entry = g_Entries[MakeKey(fileName, stage)];
+                if (!entry)
+                {
+                        entry        = std::make_unique<FShaderEntry>();
+                        entry->name  = fileName;
+                        entry->stage = stage;
+                }
+
+                if (entry->read)
+                {
+                        g_Stats.hitCount++;
+                }
+                else
+                {
+                        g_Stats.missCount++;
+                        ReadEntry(entry.get());
+                }
+
+                return entry.get();
+        }
+} // namespace
+
+void ShaderCache::Initialize(ID3D11Device* device)
+{
+        assert(device && !g_Device);
+        g_Device = device;
+        g_Stats  = FShaderCacheStats();
+}
+
+void ShaderCache::Prewarm()
+{
+        assert(g_Device);
+        std::lock_guard<std::mutex> lock(g_Mutex);
+        int64_t                     start = TimeStamp().QuadPart;
+
+        std::vector<FShaderEntry*> pending;
+        {
+                std::ifstream manifest(kManifestPath);
+                std::string   line;
+                while (std::getline(manifest, line))
+                {
+                        // "<suffix> <file name>"
+                        int stage = line.size() > 4 && line[3] == ' ' ? FindStage(line.c_str()) : -1;
+                        if (stage < 0)
+                                continue;
+
+                        std::string name  = line.substr(4);
+                        auto&       entry = g_Entries[MakeKey(name.c_str(), stage)];
+                        if (entry)
+                                continue;
+
+                        entry        = std::make_unique<FShaderEntry>();
+                        entry->name  = name;
+                        entry->stage = stage;
+                        pending.push_back(entry.get());
+                }
+        }
+
+        if (pending.empty())
+                return;
+
+        // All reads first, then one object per distinct bytecode
+        FShaderEntry** pendingEntries = pending.data();
+        auto           readJob = ParallelFor([pendingEntries](unsigned int i) { ReadEntry(pendingEntries[i]); });
+        readJob.SetName("Shader cache reads");
+        readJob.SetRange(0, (unsigned int)pending.size(), 1);
+        readJob();
+        readJob.Wait();
+
+        std::vector<FShaderEntry*> unique;
+        for (auto entry : pending)
+        {
+                if (entry->file.GetData() && g_Objects.emplace(entry->contentHash, nullptr).second)
+                        unique.push_back(entry);
+        }
+
+        if (!unique.empty())
+        {
+                FShaderEntry** uniqueEntries = unique.data();
+                auto           createJob     = ParallelFor([uniqueEntries](unsigned int i) {
+                        FShaderEntry* entry = uniqueEntries[i];
+                        entry->shader       = CreateShaderObject(entry->stage, entry->file.GetData(), entry->file.GetSize());
+                });
+                createJob.SetRange(0, (unsigned int)unique.size(), 1);
+                createJob();
+                createJob.Wait();
+        }
+
+        for (auto entry : unique)
+                g_Objects[entry->contentHash] = entry->shader;
+        for (auto entry : pending)
+                ResolveShader(entry);
+
+        g_Stats.prewarmedCount      = (unsigned int)pending.size();
+        g_Stats.prewarmMicroseconds = TimeStamp().QuadPart - start;
+}
+
+void ShaderCache::Shutdown()
+{
+        std::lock_guard<std::mutex> lock(g_Mutex);
+
+        std::vector<FShaderEntry*> entries;
+        for (auto& it : g_Entries)
+                if (it.second->file.GetData())
+                        entries.push_back(it.second.get());
+
+        std::sort(entries.begin(), entries.end(), [](const FShaderEntry* lhs, const FShaderEntry* rhs) {
+                return lhs->stage != rhs->stage ? lhs->stage < rhs->stage : lhs->name < rhs->name;
+        });
+
+        std::ofstream manifest(kManifestPath, std::ios::out | std::ios::trunc);
+        for (auto entry : entries)
+                manifest << kStageSuffixes[entry->stage] << ' ' << entry->name << '\n';
+
+        for (auto& it : g_Entries)
+                if (it.second->shader)
+                        it.second->shader->Release();
+
+        g_Entries.clear();
+        g_Objects.clear();
+        g_Device = nullptr;
+}
+
+FShaderBytecode ShaderCache::GetBytecode(const char* fileName, int stage)
+{
+        std::lock_guard<std::mutex> lock(g_Mutex);
+        FShaderEntry*               entry = GetEntry(fileName, stage);
+
+        FShaderBytecode output;
+        output.data = entry->file.GetData();
+        output.size = entry->file.GetSize();
+        return output;
+}
+
+ID3D11DeviceChild* ShaderCache::AcquireShader(const char* fileName, int stage)
+{
+        assert(g_Device);
+        std::lock_guard<std::mutex> lock(g_Mutex);
+        FShaderEntry*               entry = GetEntry(fileName, stage);
+
+        ResolveShader(entry);
+        if (entry->shader)
+                entry->shader->AddRef();
+
+        return entry->shader;
+}
+
+const FShaderCacheStats& ShaderCache::GetStats()
+{
+        return g_Stats;
+}
\ No newline at end of file
@@ -4,11 +4,11 @@
 
 #include <D3DNativeTypes.h>
 
-#include <AnimationContainers.h>
+#include <AnimationCompression.h>
 
 struct AnimationClip : public Resource<AnimationClip>
 {
         virtual void Release() override;
 
-        Animation::FAnimClip m_AnimClip;
+        Animation::FCompressedAnimClip m_AnimClip;
 };
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <stdint.h>
+#include <functional>
+
+// Resource name key. The name is hashed once, at compile time when declared constexpr, so name table lookups don't build or hash
+// strings. Same 64 bit FNV-1a over the case folded, forward slashed name as AssetArchive::HashPath
+struct FAssetId
+{
+        uint64_t m_Hash = 0;
+
+        constexpr FAssetId() = default;
+
+        constexpr FAssetId(const char* name) : m_Hash(Hash(name))
+        {}
+
+        constexpr bool IsValid() const
+        {
+                return m_Hash != 0;
+        }
+
+        constexpr bool operator==(const FAssetId& other) const
+        {
+                return m_Hash == other.m_Hash;
+        }
+
+        constexpr bool operator!=(const FAssetId& other) const
+        {
+                return m_Hash != other.m_Hash;
+        }
+
+        static constexpr uint64_t Hash(const char* name)
+        {
+                uint64_t hash = 14695981039346656037ULL;
+                for (const char* c = name; *c; ++c)
+                {
+                        char normalized = *c == '\\' ? '/' : (*c >= 'A' && *c <= 'Z') ? char(*c - 'A' + 'a') : *c;
+                        hash            = (hash ^ (uint8_t)normalized) * 1099511628211ULL;
+                }
+
+                // Zero is the invalid id
+                return hash ? hash : 1;
+        }
+};
+
+namespace std
+{
+        template <>
+        struct hash<FAssetId>
+        {
+                size_t operator()(const FAssetId& id) const
+                {
+                        return (size_t)id.m_Hash;
+                }
+        };
+} // namespace std
\ No newline at end of file
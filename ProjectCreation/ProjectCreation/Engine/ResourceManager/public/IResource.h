@@ -7,12 +7,25 @@ class IResource;
 
 typedef GHandle<IResource> ResourceHandle;
 
+struct E_RESOURCE_STATE
+{
+        enum
+        {
+                READY,
+                // Loading on a loader thread, GPU objects not yet created
+                PENDING,
+                FAILED,
+                COUNT
+        };
+};
+
 class IResource
 {
     protected:
         ResourceHandle m_Handle;
         int16_t        m_ReferenceCount = 0;
         std::string    m_Name;
+        int            m_State = E_RESOURCE_STATE::READY;
 
 
         ResourceHandle AcquireHandle();
@@ -33,4 +46,19 @@ class IResource
         {
                 return m_Name;
         }
+
+        inline int GetState() const
+        {
+                return m_State;
+        }
+
+        inline void SetState(int state)
+        {
+                m_State = state;
+        }
+
+        inline bool IsReady() const
+        {
+                return m_State == E_RESOURCE_STATE::READY;
+        }
 };
\ No newline at end of file
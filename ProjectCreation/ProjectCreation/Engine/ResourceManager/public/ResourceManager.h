@@ -1,13 +1,19 @@
 #pragma once
 
+#include "AssetId.h"
 #include "Resource.h"
 
 #include <assert.h>
+#include <condition_variable>
+#include <deque>
+#include <limits.h>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
 #include <MemoryLeakDetection.h>
+#include <MemoryTracking.h>
 
 namespace Animation
 {
@@ -24,47 +30,71 @@ class ResourceContainerBase
 
 struct Material;
 
+// Slot map of resources. A handle holds the slot index in m_Id and the slot's generation in m_DeletionAccumulator,
+// lookups are an array access plus a generation compare. Destroying a resource bumps its slot's generation, so stale
+// handles fail the check while every other handle keeps pointing at the same slot.
 template <class T>
 class ResourceContainer : public ResourceContainerBase
 {
         static_assert(std::is_base_of<Resource<T>, T>::value, "Resource container can only store derived Resource types");
 
+        // Generations wrap within the handle's 24 bits and skip 0, so a default constructed handle never matches
+        static constexpr uint32_t kGenerationMask = (1U << 24) - 1;
 
-        std::vector<T>                                  m_Container;
-        std::unordered_set<ResourceHandle>              m_HandleSet;
-        std::unordered_map<std::string, ResourceHandle> m_NameTable;
+        struct FSlot
+        {
+                T        resource;
+                uint32_t generation = 1;
+                bool     alive      = false;
+        };
+
+        std::vector<FSlot>                              m_Slots;
+        std::vector<uint32_t>                           m_FreeSlots;
+        std::unordered_map<FAssetId, ResourceHandle>    m_NameTable;
 
     public:
         virtual ~ResourceContainer() override
         {
-                for (auto& resource : m_Container)
-                        resource.Release();
+                for (auto& slot : m_Slots)
+                        if (slot.alive)
+                                slot.resource.Release();
         };
 
+        bool IsValid(const ResourceHandle& handle) const
+        {
+                return handle.m_Id < m_Slots.size() && m_Slots[handle.m_Id].alive &&
+                       m_Slots[handle.m_Id].generation == handle.m_DeletionAccumulator;
+        }
+
+        // Invalid handle if no resource of that name exists
+        ResourceHandle FindResource(FAssetId id) const
+        {
+                auto it = m_NameTable.find(id);
+                return it == m_NameTable.end() ? ResourceHandle() : it->second;
+        }
+
         T* GetResource(const ResourceHandle& handle)
         {
-                auto it = m_HandleSet.find(handle);
-                assert(it != m_HandleSet.end() && "Resource doesn't exist");
-                return &m_Container[handle.m_Data];
+                assert(IsValid(handle) && "Resource doesn't exist");
+                return &m_Slots[handle.m_Id].resource;
         }
 
         void DestroyResource(const ResourceHandle& handle)
         {
-                auto it = m_HandleSet.find(handle);
-                assert(it != m_HandleSet.end() && "Resource doesn't exist");
-                Resource* resource  = GetResource(handle);
-                size_t    lastIndex = m_Container.size() - 1;
-                if (it->second != lastIndex)
-                {
-                        m_Container[it->second] = m_Container[lastIndex];
-                }
+                NMemory::ScopedMemoryTag memoryTag(NMemory::E_MEMORY_TAG::RESOURCES);
+                assert(IsValid(handle) && "Resource doesn't exist");
 
+                FSlot& slot = m_Slots[handle.m_Id];
+                m_NameTable.erase(FAssetId(slot.resource.GetName().c_str()));
+                slot.resource.Release();
+                slot.resource = T();
+                slot.alive    = false;
 
-                m_Container.erase(m_Container.end() - 1);
-                m_HandleSet.erase(handle);
-                m_NameTable.erase(resource->GetName());
+                slot.generation = (slot.generation + 1) & kGenerationMask;
+                if (slot.generation == 0)
+                        slot.generation = 1;
 
-                return resource;
+                m_FreeSlots.push_back(handle.m_Id);
         }
 
         T* AcquireResource(const ResourceHandle& handle)
@@ -87,18 +117,29 @@ class ResourceContainer : public ResourceContainerBase
 
         ResourceHandle CreateResource(std::string name)
         {
-                assert(m_NameTable.find(name) == m_NameTable.end());
-
-                ResourceHandle outHandle;
-                auto           dataOld = m_Container.data();
-                outHandle.m_Data       = (uint32_t)m_Container.size();
-                m_Container.emplace_back(T());
-                size_t index    = m_Container.size() - 1;
-                T&     resource = m_Container.back();
-                resource.Init(name, outHandle);
-                auto dataNew      = m_Container.data();
-                m_NameTable[name] = outHandle;
-                m_HandleSet.insert(outHandle);
+                FAssetId id(name.c_str());
+                // Also catches two names hashing to the same id
+                assert(m_NameTable.find(id) == m_NameTable.end());
+                NMemory::ScopedMemoryTag memoryTag(NMemory::E_MEMORY_TAG::RESOURCES);
+
+                uint32_t index;
+                if (m_FreeSlots.empty())
+                {
+                        index = (uint32_t)m_Slots.size();
+                        m_Slots.emplace_back();
+                }
+                else
+                {
+                        index = m_FreeSlots.back();
+                        m_FreeSlots.pop_back();
+                }
+
+                FSlot& slot = m_Slots[index];
+                slot.alive  = true;
+
+                ResourceHandle outHandle(index, slot.generation);
+                slot.resource.Init(name, outHandle);
+                m_NameTable[id] = outHandle;
                 return outHandle;
         }
 
@@ -107,16 +148,42 @@ class ResourceContainer : public ResourceContainerBase
 
 class RenderSystem;
 
+// File read and decoded on a loader thread, finalized on the main thread. Defined in ResourceManager.cpp
+struct FAsyncLoadRequest;
+
 class ResourceManager
 {
+        static constexpr unsigned int kLoaderThreadCount     = 2;
+        static constexpr unsigned int kMaxFinalizesPerUpdate = 16;
+
         std::unordered_map<ResourceTypeID, ResourceContainerBase*> m_Containers;
 
+        std::vector<std::thread>       m_LoaderThreads;
+        std::mutex                     m_LoaderMutex;
+        std::condition_variable        m_LoaderWake;
+        std::deque<FAsyncLoadRequest*> m_QueuedLoads;
+        std::mutex                     m_CompletedMutex;
+        std::deque<FAsyncLoadRequest*> m_CompletedLoads;
+        bool                           m_LoadersActive = false;
+        // Submitted but not yet finalized, main thread only
+        unsigned int                   m_InFlightLoads = 0;
+
         template <typename T>
         ResourceHandle CreateResource();
 
         template <typename T>
         ResourceContainer<T>* GetResourceContainer();
 
+        template <typename T, typename Request>
+        ResourceHandle LoadAsync(const char* name);
+
+        // A synchronous load of a name that is still pending has to wait for the async load to land
+        template <typename T>
+        void WaitIfPending(ResourceContainer<T>* container, const ResourceHandle& handle);
+
+        void SubmitLoad(FAsyncLoadRequest* request);
+        void LoaderThreadMain();
+
     public:
         ResourceHandle LoadMaterial(const char* name);
         ResourceHandle LoadTexture2D(const char* name);
@@ -128,6 +195,27 @@ class ResourceManager
         ResourceHandle LoadSkeletalMesh(const char* name);
         ResourceHandle LoadAnimationClip(const char* name, const Animation::FSkeleton* skeleton);
 
+        // Return a handle immediately. The resource stays E_RESOURCE_STATE::PENDING until the file has been read on a
+        // loader thread and its GPU objects were created by FinalizeLoads. Requests for a name that is already loaded
+        // or queued return the existing handle.
+        ResourceHandle LoadMaterialAsync(const char* name);
+        ResourceHandle LoadTexture2DAsync(const char* name);
+        ResourceHandle LoadStaticMeshAsync(const char* name);
+        ResourceHandle LoadSkeletalMeshAsync(const char* name);
+
+        // Creates the GPU objects of loads whose files have been read. Main thread only
+        unsigned int FinalizeLoads(unsigned int maxCount = UINT_MAX);
+        // Blocks until every submitted load has been finalized
+        void WaitForLoads();
+
+        inline unsigned int GetInFlightLoadCount() const
+        {
+                return m_InFlightLoads;
+        }
+
+        // Finalizes a bounded number of loads per frame
+        void Update();
+
         template <typename T>
         ResourceHandle CopyResource(ResourceHandle, const char* name);
 
@@ -143,6 +231,15 @@ class ResourceManager
         template <typename T>
         T* GetResource(const ResourceHandle& handle);
 
+        // Handle of an already created resource without loading it, invalid if there is none. Resolve ids once and keep
+        // the handle rather than calling Load* with a name every frame
+        template <typename T>
+        ResourceHandle FindResource(FAssetId id);
+
+        // False for handles whose resource has been destroyed
+        template <typename T>
+        bool IsValid(const ResourceHandle& handle);
+
 
         void Initialize();
         void Shutdown();
@@ -174,13 +271,22 @@ ResourceContainer<T>* ResourceManager::GetResourceContainer()
         return rc;
 }
 
+template <typename T>
+void ResourceManager::WaitIfPending(ResourceContainer<T>* container, const ResourceHandle& handle)
+{
+        if (container->GetResource(handle)->GetState() == E_RESOURCE_STATE::PENDING)
+                WaitForLoads();
+}
+
 template <typename T>
 inline ResourceHandle ResourceManager::CopyResource(ResourceHandle source, const char* name)
 {
-        ResourceContainer<T>* container      = GetResourceContainer<T>();
-        ResourceHandle        targetHandle   = container->CreateResource(name);
-        T*                    sourceResource = container->GetResource(source);
-        T*                    targetResource = container->GetResource(targetHandle);
+        ResourceContainer<T>* container = GetResourceContainer<T>();
+        WaitIfPending(container, source);
+
+        ResourceHandle targetHandle   = container->CreateResource(name);
+        T*             sourceResource = container->GetResource(source);
+        T*             targetResource = container->GetResource(targetHandle);
         targetResource->Copy(sourceResource);
 
 
@@ -207,3 +313,17 @@ T* ResourceManager::GetResource(const ResourceHandle& handle)
         ResourceContainer<T>* container = GetResourceContainer<T>();
         return container->GetResource(handle);
 }
+
+template <typename T>
+ResourceHandle ResourceManager::FindResource(FAssetId id)
+{
+        ResourceContainer<T>* container = GetResourceContainer<T>();
+        return container->FindResource(id);
+}
+
+template <typename T>
+bool ResourceManager::IsValid(const ResourceHandle& handle)
+{
+        ResourceContainer<T>* container = GetResourceContainer<T>();
+        return container->IsValid(handle);
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct ID3D11Device;
+struct ID3D11DeviceChild;
+
+// Matches the "_VS", "_PS", ... suffix of the compiled shader files
+struct E_SHADER_STAGE
+{
+        enum
+        {
+                VS = 0,
+                PS,
+                GS,
+                CS,
+                HS,
+                DS,
+                COUNT
+        };
+};
+
+struct FShaderBytecode
+{
+        const char* data = nullptr;
+        size_t      size = 0;
+};
+
+struct FShaderCacheStats
+{
+        unsigned int prewarmedCount      = 0;
+        unsigned int hitCount            = 0;
+        unsigned int missCount           = 0;
+        // Shaders whose bytecode was identical to an already created one
+        unsigned int sharedCount         = 0;
+        int64_t      prewarmMicroseconds = 0;
+};
+
+// Compiled shaders shared by every loader. Bytecode is read once per file and kept mapped, shader objects are keyed by
+// the content hash of their bytecode so identical files create a single object. Every shader used during a run is
+// written to a manifest on shutdown, the next launch reads and creates all of them at once on the job workers.
+namespace ShaderCache
+{
+        constexpr const char* kManifestPath = "../Assets/ShaderCache.manifest";
+
+        void Initialize(ID3D11Device* device);
+        // Creates every shader listed in the manifest, in parallel
+        void Prewarm();
+        // Writes the manifest and releases the cache's references
+        void Shutdown();
+
+        // Empty if the file doesn't exist. Stays valid until Shutdown
+        FShaderBytecode GetBytecode(const char* fileName, int stage);
+
+        // Shader object for the file, with a reference added for the caller. Cast to the stage's interface, e.g.
+        // (ID3D11VertexShader*)AcquireShader("Default", E_SHADER_STAGE::VS)
+        ID3D11DeviceChild* AcquireShader(const char* fileName, int stage);
+
+        const FShaderCacheStats& GetStats();
+} // namespace ShaderCache
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include "UIAssetPreload.h"
+
+#include <iterator>
+
+namespace
+{
+        // Every file UIManager::Initialize loads, keep in sync when menus gain sprites or fonts
+        constexpr const char* kSpritePaths[] = {"../Assets/2d/Sprite/Black_Solid.dds",
+                                                "../Assets/2d/Sprite/Full_Sail_Logo.dds",
+                                                "../Assets/2d/Sprite/GPGlogo_solid.dds",
+                                                "../Assets/2d/Sprite/Deep!deep_Logo.dds",
+                                                "../Assets/2d/Sprite/Mouse_Key.dds",
+                                                "../Assets/2d/Sprite/RightTrigger.dds",
+                                                "../Assets/2d/Sprite/A_Key.dds",
+                                                "../Assets/2d/Sprite/B_Button.dds",
+                                                "../Assets/2d/Sprite/S_Key.dds",
+                                                "../Assets/2d/Sprite/D_Key.dds",
+                                                "../Assets/2d/Sprite/X_Button.dds",
+                                                "../Assets/2d/Sprite/Grey Box Test.dds"};
+        constexpr const char* kFontPaths[]   = {"../Assets/2d/Text/angel.spritefont",
+                                              "../Assets/2d/Text/calibri.spritefont",
+                                              "../Assets/2d/Text/couriernew.spritefont"};
+
+        FileIO::FMappedFile g_SpriteFiles[std::size(kSpritePaths)];
+        FileIO::FMappedFile g_FontFiles[std::size(kFontPaths)];
+
+        void PreloadFiles(const char* const* paths, FileIO::FMappedFile* files, size_t count)
+        {
+                for (size_t i = 0; i < count; ++i)
+                {
+                        // A missing file is left for Initialize to report, it falls back to reading by name
+                        if (files[i].Open(paths[i]).m_Flags == ERESULT_FLAG::SUCCESS)
+                                files[i].Prefetch();
+                }
+        }
+
+        // The paths are plain ASCII, so the wide name compares character by character
+        bool PathEquals(const char* path, const wchar_t* widePath)
+        {
+                for (; *path && *widePath; ++path, ++widePath)
+                        if ((wchar_t)(unsigned char)*path != *widePath)
+                                return false;
+                return *path == 0 && *widePath == 0;
+        }
+
+        const FileIO::FMappedFile* FindFile(const char* const*         paths,
+                                            const FileIO::FMappedFile* files,
+                                            size_t                     count,
+                                            const wchar_t*             path)
+        {
+                for (size_t i = 0; i < count; ++i)
+                        if (files[i].IsOpen() && PathEquals(paths[i], path))
+                                return &files[i];
+                return nullptr;
+        }
+} // namespace
+
+void UIAssetPreload::PreloadSprites()
+{
+        PreloadFiles(kSpritePaths, g_SpriteFiles, std::size(kSpritePaths));
+}
+
+void UIAssetPreload::PreloadFonts()
+{
+        PreloadFiles(kFontPaths, g_FontFiles, std::size(kFontPaths));
+}
+
+const FileIO::FMappedFile* UIAssetPreload::FindSprite(const wchar_t* path)
+{
+        return FindFile(kSpritePaths, g_SpriteFiles, std::size(kSpritePaths), path);
+}
+
+const FileIO::FMappedFile* UIAssetPreload::FindFont(const wchar_t* path)
+{
+        return FindFile(kFontPaths, g_FontFiles, std::size(kFontPaths), path);
+}
+
+void UIAssetPreload::Release()
+{
+        for (FileIO::FMappedFile& file : g_SpriteFiles)
+                file.Close();
+        for (FileIO::FMappedFile& file : g_FontFiles)
+                file.Close();
+}
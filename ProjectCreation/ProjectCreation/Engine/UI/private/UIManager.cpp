@@ -10,6 +10,7 @@
 #include <MemoryLeakDetection.h>
 #include <PairHash.h>
 #include <RenderingSystem.h>
+#include <UIAssetPreload.h>
 
 #include <TutorialLevel.h>
 class TutorialLevel;
@@ -18,6 +19,29 @@ class TutorialLevel;
 #define NOMINMAX
 UIManager* UIManager::instance;
 using namespace DirectX;
+
+namespace
+{
+        // Startup maps the UI files on job threads, fall back to reading by name for anything it didn't map
+        HRESULT CreateSpriteTexture(ID3D11Device*              device,
+                                    const wchar_t*             fileName,
+                                    ID3D11Resource**           resource,
+                                    ID3D11ShaderResourceView** view)
+        {
+                if (const FileIO::FMappedFile* file = UIAssetPreload::FindSprite(fileName))
+                        return DirectX::CreateDDSTextureFromMemory(
+                            device, (const uint8_t*)file->GetData(), file->GetSize(), resource, view);
+                return DirectX::CreateDDSTextureFromFile(device, fileName, resource, view);
+        }
+
+        DirectX::SpriteFont* CreateSpriteFont(ID3D11Device* device, const wchar_t* fileName)
+        {
+                if (const FileIO::FMappedFile* file = UIAssetPreload::FindFont(fileName))
+                        return new DirectX::SpriteFont(device, (const uint8_t*)file->GetData(), file->GetSize());
+                return new DirectX::SpriteFont(device, fileName);
+        }
+} // namespace
+
 // Adds Sprites to the vector of Sprites
 int UIManager::AddSprite(ID3D11Device*        device,
                          ID3D11DeviceContext* deviceContext,
@@ -36,9 +60,9 @@ int UIManager::AddSprite(ID3D11Device*        device,
         Microsoft::WRL::ComPtr<ID3D11Resource> resource;
         Microsoft::WRL::ComPtr<ID3D11Resource> altresource;
         if (gamePadFileName)
-                HRESULT hr = DirectX::CreateDDSTextureFromFile(
-                    device, gamePadFileName, altresource.GetAddressOf(), &cSprite.mAltTexture);
-        HRESULT hr = DirectX::CreateDDSTextureFromFile(device, FileName, resource.GetAddressOf(), &cSprite.mTexture);
+                HRESULT hr =
+                    CreateSpriteTexture(device, gamePadFileName, altresource.GetAddressOf(), &cSprite.mAltTexture);
+        HRESULT hr = CreateSpriteTexture(device, FileName, resource.GetAddressOf(), &cSprite.mTexture);
 
         if (FAILED(hr))
         {
@@ -922,11 +946,11 @@ void UIManager::Initialize(native_handle_type hwnd)
         constexpr float pauseButtonHeight = 0.05f;
 
         instance->m_FontTypes[E_FONT_TYPE::Angel] =
-            new DirectX::SpriteFont(instance->m_RenderSystem->m_Device, L"../Assets/2d/Text/angel.spritefont");
+            CreateSpriteFont(instance->m_RenderSystem->m_Device, L"../Assets/2d/Text/angel.spritefont");
         instance->m_FontTypes[E_FONT_TYPE::Calibri] =
-            new DirectX::SpriteFont(instance->m_RenderSystem->m_Device, L"../Assets/2d/Text/calibri.spritefont");
+            CreateSpriteFont(instance->m_RenderSystem->m_Device, L"../Assets/2d/Text/calibri.spritefont");
         instance->m_FontTypes[E_FONT_TYPE::CourierNew] =
-            new DirectX::SpriteFont(instance->m_RenderSystem->m_Device, L"../Assets/2d/Text/couriernew.spritefont");
+            CreateSpriteFont(instance->m_RenderSystem->m_Device, L"../Assets/2d/Text/couriernew.spritefont");
 
         // Level Fade
         instance->AddSprite(instance->m_RenderSystem->m_Device,
@@ -2693,12 +2717,15 @@ void UIManager::Initialize(native_handle_type hwnd)
         // Exit
         instance->m_AllSprites[E_MENU_CATEGORIES::Demo][1].OnMouseDown.AddEventListener(
             [](UIMouseEvent* e) { GEngine::Get()->RequestGameExit(); });
+
+        // Every texture and font has been created, the mapped files aren't needed anymore
+        UIAssetPreload::Release();
 }
 
 void UIManager::Update(float deltaTime)
 {
         JGamePad::Get()->Refresh();
-        GEngine::Get()->m_MainThreadProfilingContext.Begin("UIManager", "UIManager");
+        PROFILE_SCOPE("UIManager", "UIManager");
         using namespace DirectX;
 
         instance->m_ScreenSize =
@@ -2758,7 +2785,23 @@ void UIManager::Update(float deltaTime)
                                 instance->m_SpriteBatch->End();
                         }
                 }
-        GEngine::Get()->m_MainThreadProfilingContext.End();
+
+#ifdef COUNTERS
+        if (instance->m_ShowCounters)
+        {
+                std::string overlay = Counters::FormatOverlay();
+                instance->m_SpriteBatch->Begin(DirectX::SpriteSortMode::SpriteSortMode_Deferred,
+                                               instance->m_States->NonPremultiplied());
+                instance->m_FontTypes[E_FONT_TYPE::CourierNew]->DrawString(instance->m_SpriteBatch.get(),
+                                                                           overlay.c_str(),
+                                                                           XMFLOAT2(16.0f, 16.0f),
+                                                                           DirectX::Colors::White,
+                                                                           0.0f,
+                                                                           XMFLOAT2(0.0f, 0.0f),
+                                                                           0.35f);
+                instance->m_SpriteBatch->End();
+        }
+#endif
 
         for (int i = 0; i < instance->timed_functions.size(); i++)
         {
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <MappedFile.h>
+
+// The sprite sheets and fonts UIManager::Initialize creates its textures from. Startup maps and pages them in on job
+// workers while the renderer's device is being created, Initialize then parses them from memory instead of reading
+// every file on the main thread.
+namespace UIAssetPreload
+{
+        // Called once each from startup graph steps, the two sets can be read concurrently
+        void PreloadSprites();
+        void PreloadFonts();
+
+        // nullptr when the file isn't one of the preloaded ones or failed to open
+        const FileIO::FMappedFile* FindSprite(const wchar_t* path);
+        const FileIO::FMappedFile* FindFont(const wchar_t* path);
+
+        // Unmaps everything once Initialize has created its textures
+        void Release();
+} // namespace UIAssetPreload
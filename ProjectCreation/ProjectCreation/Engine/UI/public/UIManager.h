@@ -141,6 +141,9 @@ class UIManager
 
         void CatchWinProcSetFullscreen();
 
+        // Table of every counter drawn over the game
+        bool m_ShowCounters = false;
+
     private:
         void SetFullscreen(bool val);
         void UpdateResolutionText();
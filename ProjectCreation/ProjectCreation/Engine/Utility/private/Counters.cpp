@@ -0,0 +1,187 @@
+#include "Counters.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <algorithm>
+#include <fstream>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+        struct FCounter
+        {
+                std::string name;
+                int         mode    = E_COUNTER_MODE::ACCUMULATE;
+                double      current = 0.0;
+                double      window[Counters::kWindowSize];
+                unsigned    head   = 0;
+                unsigned    frames = 0;
+        };
+
+        std::vector<FCounter>                     g_Counters;
+        std::unordered_map<std::string, unsigned> g_CounterIds;
+        const std::string                         g_InvalidName;
+} // namespace
+
+unsigned Counters::Register(const std::string& name, int mode)
+{
+        assert(mode >= 0 && mode < E_COUNTER_MODE::COUNT);
+
+        auto it = g_CounterIds.find(name);
+        if (it != g_CounterIds.end())
+                return it->second;
+
+        unsigned id = (unsigned)g_Counters.size();
+        g_Counters.emplace_back();
+        g_Counters.back().name = name;
+        g_Counters.back().mode = mode;
+        g_CounterIds.emplace(name, id);
+        return id;
+}
+
+unsigned Counters::Find(const std::string& name)
+{
+        auto it = g_CounterIds.find(name);
+        return it == g_CounterIds.end() ? kInvalidId : it->second;
+}
+
+void Counters::Add(unsigned id, double value)
+{
+        assert(id < g_Counters.size());
+        g_Counters[id].current += value;
+}
+
+void Counters::Set(unsigned id, double value)
+{
+        assert(id < g_Counters.size());
+        g_Counters[id].current = value;
+}
+
+void Counters::EndFrame()
+{
+        for (FCounter& counter : g_Counters)
+        {
+                counter.window[counter.head] = counter.current;
+                counter.head                 = (counter.head + 1) % kWindowSize;
+                counter.frames               = std::min(counter.frames + 1, kWindowSize);
+
+                if (counter.mode == E_COUNTER_MODE::ACCUMULATE)
+                        counter.current = 0.0;
+        }
+}
+
+unsigned Counters::GetCount()
+{
+        return (unsigned)g_Counters.size();
+}
+
+const std::string& Counters::GetName(unsigned id)
+{
+        return id < g_Counters.size() ? g_Counters[id].name : g_InvalidName;
+}
+
+FCounterStats Counters::GetStats(unsigned id)
+{
+        FCounterStats stats;
+        if (id >= g_Counters.size() || g_Counters[id].frames == 0)
+                return stats;
+
+        const FCounter& counter = g_Counters[id];
+
+        // The window is small, sorting a copy on query keeps EndFrame a plain store
+        double sorted[kWindowSize];
+        std::copy(counter.window, counter.window + counter.frames, sorted);
+        std::sort(sorted, sorted + counter.frames);
+
+        double sum = 0.0;
+        for (unsigned i = 0; i < counter.frames; ++i)
+                sum += sorted[i];
+
+        auto percentile = [&](double p) {
+                unsigned rank = (unsigned)(p * counter.frames + 0.999999);
+                return sorted[std::min(std::max(rank, 1u), counter.frames) - 1];
+        };
+
+        stats.last       = counter.window[(counter.head + kWindowSize - 1) % kWindowSize];
+        stats.min        = sorted[0];
+        stats.max        = sorted[counter.frames - 1];
+        stats.avg        = sum / counter.frames;
+        stats.p95        = percentile(0.95);
+        stats.p99        = percentile(0.99);
+        stats.frameCount = counter.frames;
+        return stats;
+}
+
+FCounterStats Counters::GetStats(const std::string& name)
+{
+        return GetStats(Find(name));
+}
+
+void Counters::WriteCSV(const char* fileName)
+{
+        std::ofstream file(fileName, std::ios::out | std::ios::trunc);
+        if (!file.is_open())
+                return;
+
+        file << "name,last,min,max,avg,p95,p99,frames\n";
+        for (unsigned id = 0; id < g_Counters.size(); ++id)
+        {
+                FCounterStats stats = GetStats(id);
+                file << '"' << g_Counters[id].name << "\"," << stats.last << ',' << stats.min << ',' << stats.max << ','
+                     << stats.avg << ',' << stats.p95 << ',' << stats.p99 << ',' << stats.frameCount << '\n';
+        }
+}
+
+void Counters::WriteJSON(const char* fileName)
+{
+        std::ofstream file(fileName, std::ios::out | std::ios::trunc);
+        if (!file.is_open())
+                return;
+
+        file << "{\n";
+        for (unsigned id = 0; id < g_Counters.size(); ++id)
+        {
+                FCounterStats stats = GetStats(id);
+                file << "  \"" << g_Counters[id].name << "\": { \"last\": " << stats.last << ", \"min\": " << stats.min
+                     << ", \"max\": " << stats.max << ", \"avg\": " << stats.avg << ", \"p95\": " << stats.p95
+                     << ", \"p99\": " << stats.p99 << ", \"frames\": " << stats.frameCount << " }"
+                     << (id + 1 < g_Counters.size() ? ",\n" : "\n");
+        }
+        file << "}";
+}
+
+std::string Counters::FormatOverlay()
+{
+        std::string output;
+        char        line[160];
+
+        snprintf(line, sizeof(line), "%-32s %10s %10s %10s %10s\n", "counter", "last", "avg", "p95", "p99");
+        output += line;
+        for (unsigned id = 0; id < g_Counters.size(); ++id)
+        {
+                FCounterStats stats = GetStats(id);
+                snprintf(line,
+                         sizeof(line),
+                         "%-32.32s %10.1f %10.1f %10.1f %10.1f\n",
+                         g_Counters[id].name.c_str(),
+                         stats.last,
+                         stats.avg,
+                         stats.p95,
+                         stats.p99);
+                output += line;
+        }
+        return output;
+}
+
+void Counters::Shutdown()
+{
+        // Call sites cache their ids in function statics, so registrations stay valid until exit and only the values
+        // are dropped
+        for (FCounter& counter : g_Counters)
+        {
+                counter.current = 0.0;
+                counter.head    = 0;
+                counter.frames  = 0;
+        }
+}
\ No newline at end of file
@@ -6,90 +6,124 @@
 #include <ControllerSystem.h>
 #include <CoreInput.h>
 #include <PhysicsSystem.h>
+#include <StartupGraph.h>
+#include <UIAssetPreload.h>
 
 void EngineUtil::InitEngineSystemManagers(RenderSystem::native_handle_type handle)
 {
+        // The job scheduler starts with the engine, every other step runs in the startup graph
         GEngine::Initialize();
-        AudioManager::Initialize();
 
         SystemManager* systemManager = GEngine::Get()->GetSystemManager();
         HandleManager* HandleManager = GEngine::Get()->GetHandleManager();
 
-
-        // Create Render System
-        {
-                FSystemProperties sysInitProps;
-                sysInitProps.m_Priority   = E_SYSTEM_PRIORITY::VERY_LOW;
-                sysInitProps.m_UpdateRate = 0.0f;
-                sysInitProps.m_Flags      = SYSTEM_FLAG_UPDATE_WHEN_PAUSED;
-                RenderSystem* renderSystem;
-                systemManager->CreateSystem<RenderSystem>(&renderSystem);
-                renderSystem->SetWindowHandle(handle);
-                systemManager->RegisterSystem(&sysInitProps, renderSystem);
-                renderSystem->m_SystemName = "RenderSystem";
-        }
-
-        // Create Physics System
-        {
-                FSystemProperties sysInitProps;
-                sysInitProps.m_Priority   = E_SYSTEM_PRIORITY::VERY_HIGH;
-                sysInitProps.m_UpdateRate = 0.0125f;
-
-                PhysicsSystem* physicsSystem;
-                systemManager->CreateSystem<PhysicsSystem>(&physicsSystem);
-                systemManager->RegisterSystem(&sysInitProps, physicsSystem);
-                physicsSystem->m_SystemName = "PhysicsSystem";
-        }
-
-        // Create Animation System
-        {
-                FSystemProperties sysInitProps;
-                sysInitProps.m_Priority   = E_SYSTEM_PRIORITY::NORMAL;
-                sysInitProps.m_UpdateRate = 0.0f;
-
-                AnimationSystem* animSystem;
-                systemManager->CreateSystem<AnimationSystem>(&animSystem);
-                systemManager->RegisterSystem(&sysInitProps, animSystem);
-                animSystem->m_SystemName = "AnimSystem";
-        }
-
-        // Create Controller System
-        {
-                FSystemProperties sysInitProps;
-                sysInitProps.m_Priority   = E_SYSTEM_PRIORITY::VERY_HIGH;
-                sysInitProps.m_UpdateRate = 0.0f;
-
-                ControllerSystem* controllerSystem;
-                systemManager->CreateSystem<ControllerSystem>(&controllerSystem);
-                systemManager->RegisterSystem(&sysInitProps, controllerSystem);
-                controllerSystem->m_SystemName = "ControllerSystem";
-        }
-
-        // Create Transform System
-        {
-                FSystemProperties sysInitProps;
-                sysInitProps.m_Priority   = E_SYSTEM_PRIORITY::VERY_HIGH;
-                sysInitProps.m_UpdateRate = 0.0f;
-
-                TransformSystem* transformSystem;
-                systemManager->CreateSystem<TransformSystem>(&transformSystem);
-                systemManager->RegisterSystem(&sysInitProps, transformSystem);
-                transformSystem->m_SystemName = "TransformSystem";
-        }
-
-        // Create Transform System
-        {
-                FSystemProperties sysInitProps;
-                sysInitProps.m_Priority   = E_SYSTEM_PRIORITY::NORMAL;
-                sysInitProps.m_UpdateRate = 0.0f;
-
-                SpatialSoundSystem* continousAudioSystem;
-                systemManager->CreateSystem<SpatialSoundSystem>(&continousAudioSystem);
-                systemManager->RegisterSystem(&sysInitProps, continousAudioSystem);
-                continousAudioSystem->m_SystemName = "ContinousAudioSystem";
-        }
-
-        GCoreInput::InitializeInput((HWND)handle);
+        StartupGraph startup;
+
+        // Audio has no device or ECS dependencies, so the music streams are opened while the renderer starts
+        unsigned audio = startup.Add("AudioManager", E_STARTUP_THREAD::ANY, []() { AudioManager::Initialize(); });
+        unsigned music =
+            startup.Add("Music", E_STARTUP_THREAD::ANY, []() { AudioManager::Get()->PreloadMusic(); }, {audio});
+
+        // UIManager::Initialize runs inside RenderSystem's OnInitialize, its sprite and font files are mapped and paged
+        // in here so it only parses them and creates the device objects
+        unsigned uiSprites =
+            startup.Add("UI sprites", E_STARTUP_THREAD::ANY, []() { UIAssetPreload::PreloadSprites(); });
+        unsigned uiFonts = startup.Add("UI fonts", E_STARTUP_THREAD::ANY, []() { UIAssetPreload::PreloadFonts(); });
+
+        // Systems register on the main thread, their OnInitialize creates entities and uses the immediate context.
+        // Update order comes from their priorities, so only real OnInitialize dependencies are edges here.
+        unsigned render = startup.Add(
+            "RenderSystem",
+            E_STARTUP_THREAD::MAIN,
+            [systemManager, handle]() {
+                    FSystemProperties sysInitProps;
+                    sysInitProps.m_Priority   = E_SYSTEM_PRIORITY::VERY_LOW;
+                    sysInitProps.m_UpdateRate = 0.0f;
+                    sysInitProps.m_Flags      = SYSTEM_FLAG_UPDATE_WHEN_PAUSED;
+                    RenderSystem* renderSystem;
+                    systemManager->CreateSystem<RenderSystem>(&renderSystem);
+                    renderSystem->SetWindowHandle(handle);
+                    systemManager->RegisterSystem(&sysInitProps, renderSystem);
+                    renderSystem->m_SystemName = "RenderSystem";
+            },
+            {uiSprites, uiFonts});
+
+        startup.Add(
+            "PhysicsSystem",
+            E_STARTUP_THREAD::MAIN,
+            [systemManager]() {
+                    FSystemProperties sysInitProps;
+                    sysInitProps.m_Priority   = E_SYSTEM_PRIORITY::VERY_HIGH;
+                    sysInitProps.m_UpdateRate = 0.0125f;
+
+                    PhysicsSystem* physicsSystem;
+                    systemManager->CreateSystem<PhysicsSystem>(&physicsSystem);
+                    systemManager->RegisterSystem(&sysInitProps, physicsSystem);
+                    physicsSystem->m_SystemName = "PhysicsSystem";
+            });
+
+        startup.Add(
+            "AnimationSystem",
+            E_STARTUP_THREAD::MAIN,
+            [systemManager]() {
+                    FSystemProperties sysInitProps;
+                    sysInitProps.m_Priority   = E_SYSTEM_PRIORITY::NORMAL;
+                    sysInitProps.m_UpdateRate = 0.0f;
+
+                    AnimationSystem* animSystem;
+                    systemManager->CreateSystem<AnimationSystem>(&animSystem);
+                    systemManager->RegisterSystem(&sysInitProps, animSystem);
+                    animSystem->m_SystemName = "AnimSystem";
+            });
+
+        // CreatePlayer hands the player's camera to the RenderSystem
+        unsigned controller = startup.Add(
+            "ControllerSystem",
+            E_STARTUP_THREAD::MAIN,
+            [systemManager]() {
+                    FSystemProperties sysInitProps;
+                    sysInitProps.m_Priority   = E_SYSTEM_PRIORITY::VERY_HIGH;
+                    sysInitProps.m_UpdateRate = 0.0f;
+
+                    ControllerSystem* controllerSystem;
+                    systemManager->CreateSystem<ControllerSystem>(&controllerSystem);
+                    systemManager->RegisterSystem(&sysInitProps, controllerSystem);
+                    controllerSystem->m_SystemName = "ControllerSystem";
+            }, {render});
+
+        // Both look the player up through the ControllerSystem, the spatial sounds also need the SFX banks
+        startup.Add(
+            "TransformSystem",
+            E_STARTUP_THREAD::MAIN,
+            [systemManager]() {
+                    FSystemProperties sysInitProps;
+                    sysInitProps.m_Priority   = E_SYSTEM_PRIORITY::VERY_HIGH;
+                    sysInitProps.m_UpdateRate = 0.0f;
+
+                    TransformSystem* transformSystem;
+                    systemManager->CreateSystem<TransformSystem>(&transformSystem);
+                    systemManager->RegisterSystem(&sysInitProps, transformSystem);
+                    transformSystem->m_SystemName = "TransformSystem";
+            }, {controller});
+
+        startup.Add(
+            "SpatialSoundSystem",
+            E_STARTUP_THREAD::MAIN,
+            [systemManager]() {
+                    FSystemProperties sysInitProps;
+                    sysInitProps.m_Priority   = E_SYSTEM_PRIORITY::NORMAL;
+                    sysInitProps.m_UpdateRate = 0.0f;
+
+                    SpatialSoundSystem* continousAudioSystem;
+                    systemManager->CreateSystem<SpatialSoundSystem>(&continousAudioSystem);
+                    systemManager->RegisterSystem(&sysInitProps, continousAudioSystem);
+                    continousAudioSystem->m_SystemName = "ContinousAudioSystem";
+            }, {controller, music});
+
+        startup.Add("Input", E_STARTUP_THREAD::MAIN, [handle]() { GCoreInput::InitializeInput((HWND)handle); });
+
+        startup.Run();
+        startup.PrintReport();
 }
 
 void EngineUtil::ShutdownEngineSystemManagers()
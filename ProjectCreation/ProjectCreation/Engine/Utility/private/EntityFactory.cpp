@@ -28,9 +28,23 @@ EntityHandle EntityFactory::CreateStaticMeshEntity(const char*      staticMeshNa
                                                    ComponentHandle* outStaticMeshHandle,
                                                    bool             wrapping)
 {
-        auto HandleManager   = GEngine::Get()->GetHandleManager();
         auto resourceManager = GEngine::Get()->GetResourceManager();
 
+        return CreateStaticMeshEntity(resourceManager->LoadStaticMeshAsync(staticMeshName),
+                                      resourceManager->LoadMaterialAsync(materialName),
+                                      outTransformHandle,
+                                      outStaticMeshHandle,
+                                      wrapping);
+}
+
+EntityHandle EntityFactory::CreateStaticMeshEntity(const ResourceHandle& staticMeshHandle,
+                                                   const ResourceHandle& materialHandle,
+                                                   ComponentHandle*      outTransformHandle,
+                                                   ComponentHandle*      outStaticMeshHandle,
+                                                   bool                  wrapping)
+{
+        auto HandleManager = GEngine::Get()->GetHandleManager();
+
         auto outEntityHandle = HandleManager->CreateEntity();
 
         auto tCompHandle = outEntityHandle.AddComponent<TransformComponent>();
@@ -40,8 +54,8 @@ EntityHandle EntityFactory::CreateStaticMeshEntity(const char*      staticMeshNa
         auto                sMeshCompHandle = HandleManager->AddComponent<StaticMeshComponent>(outEntityHandle);
         NMemory::type_index index           = StaticMeshComponent::SGetTypeIndex();
         auto                meshComp        = sMeshCompHandle.Get<StaticMeshComponent>();
-        meshComp->m_MaterialHandle          = resourceManager->LoadMaterial(materialName);
-        meshComp->m_StaticMeshHandle        = resourceManager->LoadStaticMesh(staticMeshName);
+        meshComp->m_MaterialHandle          = materialHandle;
+        meshComp->m_StaticMeshHandle        = staticMeshHandle;
 
         if (outTransformHandle)
                 *outTransformHandle = tCompHandle;
@@ -1 +1,264 @@
-#include "Profiling.h"
\ No newline at end of file
+#include "Profiling.h"
+
+#include <assert.h>
+#include <process.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+        std::mutex                 g_RegisterMutex;
+        Profiler::FThreadBuffer*   g_Buffers[Profiler::kMaxThreads];
+        std::atomic<uint32_t>      g_BufferCount{0};
+        uint64_t                   g_OriginTicks   = 0;
+        int64_t                    g_OriginCounter = 0;
+
+        struct FThreadEvents
+        {
+                const Profiler::FThreadBuffer* buffer;
+                std::vector<FProfilerEvent>    events;
+        };
+
+        // Copies the events still in each ring, events the owning thread overwrote while copying are dropped
+        std::vector<FThreadEvents> Snapshot()
+        {
+                std::vector<FThreadEvents> output;
+
+                uint32_t bufferCount = g_BufferCount.load(std::memory_order_acquire);
+                for (uint32_t i = 0; i < bufferCount; ++i)
+                {
+                        const Profiler::FThreadBuffer* buffer = g_Buffers[i];
+
+                        uint64_t end   = buffer->writeCount.load(std::memory_order_acquire);
+                        uint64_t begin = end > Profiler::kEventsPerThread ? end - Profiler::kEventsPerThread : 0;
+
+                        FThreadEvents thread;
+                        thread.buffer = buffer;
+                        thread.events.reserve(end - begin);
+                        for (uint64_t j = begin; j < end; ++j)
+                                thread.events.push_back(buffer->events[j & (Profiler::kEventsPerThread - 1)]);
+
+                        uint64_t overwritten = buffer->writeCount.load(std::memory_order_acquire);
+                        overwritten          = overwritten > Profiler::kEventsPerThread ? overwritten - Profiler::kEventsPerThread : 0;
+                        if (overwritten > begin)
+                                thread.events.erase(thread.events.begin(),
+                                                    thread.events.begin() + std::min<uint64_t>(overwritten - begin, end - begin));
+
+                        output.push_back(std::move(thread));
+                }
+
+                return output;
+        }
+
+        void WriteChromeTrace(const std::vector<FThreadEvents>& threads, double ticksPerMicrosecond)
+        {
+                std::ofstream file(Profiler::kChromeTracePath, std::ios::out | std::ios::trunc);
+                if (!file.is_open())
+                        return;
+
+                const int pid = ::_getpid();
+                char      line[512];
+                bool      first = true;
+
+                file << "[";
+                for (const FThreadEvents& thread : threads)
+                {
+                        snprintf(line,
+                                 sizeof(line),
+                                 "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                                 first ? "" : ",",
+                                 pid,
+                                 thread.buffer->index,
+                                 thread.buffer->name);
+                        file << line;
+                        first = false;
+
+                        for (const FProfilerEvent& event : thread.events)
+                        {
+                                double start = double(event.start - g_OriginTicks) / ticksPerMicrosecond;
+                                if (event.type == E_PROFILER_EVENT::COUNTER)
+                                {
+                                        snprintf(line,
+                                                 sizeof(line),
+                                                 ",\n{\"name\":\"%s\",\"ph\":\"C\",\"pid\":%d,\"tid\":%u,\"ts\":%.3f,\"args\":{\"%s\":%g}}",
+                                                 event.category,
+                                                 pid,
+                                                 thread.buffer->index,
+                                                 start,
+                                                 event.name,
+                                                 event.value);
+                                        file << line;
+                                        continue;
+                                }
+
+                                double duration = double(event.end - event.start) / ticksPerMicrosecond;
+                                snprintf(line,
+                                         sizeof(line),
+                                         ",\n{\"cat\":\"%s\",\"name\":\"%s\",\"ph\":\"X\",\"pid\":%d,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                                         event.category,
+                                         event.name,
+                                         pid,
+                                         thread.buffer->index,
+                                         start,
+                                         duration);
+                                file << line;
+                        }
+                }
+                file << "\n]";
+        }
+
+        // Little endian layout:
+        //   "PRF1", uint32 version, double ticks per microsecond, uint32 string count, uint32 thread count
+        //   strings:  uint16 length, characters
+        //   threads:  uint32 name string, uint32 event count, events of uint32 type, uint32 category string,
+        //             uint32 name string, uint64 start tick relative to Profiler::Initialize and either the uint64 end
+        //             tick of a scope or the double value of a counter
+        void WriteBinaryTrace(const std::vector<FThreadEvents>& threads, double ticksPerMicrosecond)
+        {
+                std::ofstream file(Profiler::kBinaryTracePath, std::ios::out | std::ios::trunc | std::ios::binary);
+                if (!file.is_open())
+                        return;
+
+                // Events only hold pointers, equal strings at different addresses still share one entry
+                std::vector<std::string>                  strings;
+                std::unordered_map<std::string, uint32_t> stringIndices;
+                auto                                      addString = [&](const char* string) {
+                        auto it = stringIndices.emplace(string, (uint32_t)strings.size());
+                        if (it.second)
+                                strings.push_back(string);
+                        return it.first->second;
+                };
+
+                struct FBinaryEvent
+                {
+                        uint32_t type;
+                        uint32_t category;
+                        uint32_t name;
+                        uint64_t start;
+                        uint64_t end;
+                };
+
+                std::vector<uint32_t>                  threadNames;
+                std::vector<std::vector<FBinaryEvent>> threadEvents;
+                for (const FThreadEvents& thread : threads)
+                {
+                        threadNames.push_back(addString(thread.buffer->name));
+                        threadEvents.emplace_back();
+                        threadEvents.back().reserve(thread.events.size());
+                        for (const FProfilerEvent& event : thread.events)
+                                threadEvents.back().push_back(
+                                    {event.type,
+                                     addString(event.category),
+                                     addString(event.name),
+                                     event.start - g_OriginTicks,
+                                     event.type == E_PROFILER_EVENT::COUNTER ? event.end : event.end - g_OriginTicks});
+                }
+
+                const uint32_t version     = 2;
+                const uint32_t stringCount = (uint32_t)strings.size();
+                const uint32_t threadCount = (uint32_t)threads.size();
+                file.write("PRF1", 4);
+                file.write((const char*)&version, sizeof(version));
+                file.write((const char*)&ticksPerMicrosecond, sizeof(ticksPerMicrosecond));
+                file.write((const char*)&stringCount, sizeof(stringCount));
+                file.write((const char*)&threadCount, sizeof(threadCount));
+
+                for (const std::string& string : strings)
+                {
+                        uint16_t length = (uint16_t)std::min<size_t>(string.size(), UINT16_MAX);
+                        file.write((const char*)&length, sizeof(length));
+                        file.write(string.data(), length);
+                }
+
+                for (uint32_t i = 0; i < threadCount; ++i)
+                {
+                        uint32_t eventCount = (uint32_t)threadEvents[i].size();
+                        file.write((const char*)&threadNames[i], sizeof(uint32_t));
+                        file.write((const char*)&eventCount, sizeof(eventCount));
+                        for (const FBinaryEvent& event : threadEvents[i])
+                        {
+                                file.write((const char*)&event.type, sizeof(event.type));
+                                file.write((const char*)&event.category, sizeof(event.category));
+                                file.write((const char*)&event.name, sizeof(event.name));
+                                file.write((const char*)&event.start, sizeof(event.start));
+                                file.write((const char*)&event.end, sizeof(event.end));
+                        }
+                }
+        }
+} // namespace
+
+void Profiler::Initialize()
+{
+        assert(!g_Active.load());
+
+        LARGE_INTEGER counter;
+        QueryPerformanceCounter(&counter);
+        g_OriginCounter = counter.QuadPart;
+        g_OriginTicks   = Ticks();
+
+        g_Active.store(true);
+        SetThreadName("Main");
+}
+
+void Profiler::Shutdown()
+{
+        assert(g_Active.load());
+        g_Active.store(false);
+
+        // Everything below is off the recording path, threads only ever touch their own ring
+        double                     ticksPerMicrosecond = GetTicksPerMicrosecond();
+        std::vector<FThreadEvents> threads             = Snapshot();
+        WriteChromeTrace(threads, ticksPerMicrosecond);
+        WriteBinaryTrace(threads, ticksPerMicrosecond);
+
+        // Other threads still point at their buffers through t_Buffer, so the buffers live until the process exits and
+        // a later Initialize starts them over from an empty ring
+        std::lock_guard<std::mutex> lock(g_RegisterMutex);
+        uint32_t                    bufferCount = g_BufferCount.load(std::memory_order_relaxed);
+        for (uint32_t i = 0; i < bufferCount; ++i)
+                g_Buffers[i]->writeCount.store(0, std::memory_order_relaxed);
+}
+
+double Profiler::GetTicksPerMicrosecond()
+{
+        // Measured over the whole run instead of trusting a nominal TSC frequency
+        LARGE_INTEGER counter;
+        LARGE_INTEGER frequency;
+        QueryPerformanceCounter(&counter);
+        QueryPerformanceFrequency(&frequency);
+        uint64_t ticks = Ticks();
+
+        double microseconds = double(counter.QuadPart - g_OriginCounter) * 1000000.0 / double(frequency.QuadPart);
+        return microseconds > 0.0 ? double(ticks - g_OriginTicks) / microseconds : 1.0;
+}
+
+void Profiler::SetThreadName(const char* name)
+{
+        if (!g_Active.load(std::memory_order_relaxed))
+                return;
+
+        FThreadBuffer* buffer = t_Buffer ? t_Buffer : (t_Buffer = RegisterThread());
+        strncpy_s(buffer->name, name, _TRUNCATE);
+}
+
+Profiler::FThreadBuffer* Profiler::RegisterThread()
+{
+        std::lock_guard<std::mutex> lock(g_RegisterMutex);
+
+        uint32_t index = g_BufferCount.load(std::memory_order_relaxed);
+        assert(index < kMaxThreads);
+
+        FThreadBuffer* buffer = new FThreadBuffer;
+        buffer->index         = index;
+        snprintf(buffer->name, sizeof(buffer->name), "Thread %u", index);
+
+        g_Buffers[index] = buffer;
+        g_BufferCount.store(index + 1, std::memory_order_release);
+        return buffer;
+}
\ No newline at end of file
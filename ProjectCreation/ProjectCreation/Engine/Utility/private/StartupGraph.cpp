@@ -0,0 +1,216 @@
+#include "StartupGraph.h"
+
+#include <assert.h>
+#include <sstream>
+
+#include <ConsoleUtility.h>
+#include <JobScheduler.h>
+#include <Profiling.h>
+
+unsigned int StartupGraph::Add(const char*                         name,
+                               int                                 thread,
+                               std::function<void()>               function,
+                               std::initializer_list<unsigned int> dependencies)
+{
+        assert(thread >= 0 && thread < E_STARTUP_THREAD::COUNT);
+
+        unsigned int index = (unsigned int)m_Steps.size();
+
+        FStartupStep step;
+        step.name         = name;
+        step.thread       = thread;
+        step.function     = std::move(function);
+        step.dependencies = dependencies;
+
+        // Only depending on earlier steps keeps the graph acyclic
+        for (unsigned int dependency : step.dependencies)
+                assert(dependency < index);
+
+        m_Steps.push_back(std::move(step));
+        return index;
+}
+
+bool StartupGraph::IsReady(unsigned int index) const
+{
+        for (unsigned int dependency : m_Steps[index].dependencies)
+                if (!m_Finished[dependency].load(std::memory_order_acquire))
+                        return false;
+        return true;
+}
+
+bool StartupGraph::TryStart(unsigned int index)
+{
+        return !m_Started[index].load(std::memory_order_relaxed) &&
+               !m_Started[index].exchange(true, std::memory_order_acq_rel);
+}
+
+void StartupGraph::RunStep(unsigned int index)
+{
+        FStartupStep& step = m_Steps[index];
+        step.threadIndex   = (unsigned int)reinterpret_cast<uintptr_t>(TlsGetValue(g_tls_access_value));
+        step.start         = TimeStamp().QuadPart - m_Origin;
+        {
+                PROFILE_SCOPE("Startup", step.name);
+                step.function();
+        }
+        step.end = TimeStamp().QuadPart - m_Origin;
+
+        m_Finished[index].store(true, std::memory_order_release);
+
+        {
+                std::lock_guard<std::mutex> lock(m_FinishedMutex);
+                ++m_FinishedCount;
+        }
+        m_FinishedCondition.notify_one();
+}
+
+void StartupGraph::RunWorkerSteps(unsigned int index)
+{
+        RunStep(index);
+
+        const unsigned int count = (unsigned int)m_Steps.size();
+        for (unsigned int i = index + 1; i < count; ++i)
+        {
+                if (m_Steps[i].thread == E_STARTUP_THREAD::ANY && IsReady(i) && TryStart(i))
+                        RunStep(i);
+        }
+
+        // Notified under the lock, Run may destroy the graph as soon as it sees the count drop
+        std::lock_guard<std::mutex> lock(m_FinishedMutex);
+        --m_ActiveWorkerCount;
+        m_FinishedCondition.notify_one();
+}
+
+void StartupGraph::Run()
+{
+        const unsigned int count = (unsigned int)m_Steps.size();
+
+        m_Started.reset(new std::atomic<bool>[count]);
+        m_Finished.reset(new std::atomic<bool>[count]);
+        for (unsigned int i = 0; i < count; ++i)
+        {
+                m_Started[i].store(false, std::memory_order_relaxed);
+                m_Finished[i].store(false, std::memory_order_relaxed);
+        }
+
+        m_FinishedCount     = 0;
+        m_ActiveWorkerCount = 0;
+        m_Origin            = TimeStamp().QuadPart;
+
+        // Jobs are only created here, worker threads have no job allocator of their own
+        unsigned int finishedCount = 0;
+        while (finishedCount < count)
+        {
+                // Taken before looking for ready steps, any step finishing after this can make another one ready
+                unsigned int finishedBeforeScan;
+                {
+                        std::lock_guard<std::mutex> lock(m_FinishedMutex);
+                        finishedBeforeScan = m_FinishedCount;
+                }
+
+                // Queue every ready worker step before blocking this thread on a main step
+                for (unsigned int i = 0; i < count; ++i)
+                {
+                        if (m_Steps[i].thread == E_STARTUP_THREAD::ANY && IsReady(i) && TryStart(i))
+                        {
+                                {
+                                        std::lock_guard<std::mutex> lock(m_FinishedMutex);
+                                        ++m_ActiveWorkerCount;
+                                }
+                                Job<> job([this, i]() { RunWorkerSteps(i); });
+                                job();
+                        }
+                }
+
+                bool ranMainStep = false;
+                for (unsigned int i = 0; i < count && !ranMainStep; ++i)
+                {
+                        if (m_Steps[i].thread == E_STARTUP_THREAD::MAIN && IsReady(i) && TryStart(i))
+                        {
+                                RunStep(i);
+                                ranMainStep = true;
+                        }
+                }
+
+                finishedCount = 0;
+                for (unsigned int i = 0; i < count; ++i)
+                        finishedCount += m_Finished[i].load(std::memory_order_acquire);
+
+                // Nothing this thread could start, help with the queued steps
+                if (!ranMainStep && finishedCount < count)
+                {
+                        JobInternal* job = JobSchedulerInternal::GetJob();
+                        if (job)
+                        {
+                                JobSchedulerInternal::Execute(job);
+                        }
+                        else
+                        {
+                                // Workers hold every runnable step, nothing new can become ready until one finishes
+                                std::unique_lock<std::mutex> lock(m_FinishedMutex);
+                                m_FinishedCondition.wait(lock, [&]() { return m_FinishedCount != finishedBeforeScan; });
+                        }
+                }
+        }
+
+        // Every job has started its step by now, only the ones still scanning for more steps are left
+        {
+                std::unique_lock<std::mutex> lock(m_FinishedMutex);
+                m_FinishedCondition.wait(lock, [&]() { return m_ActiveWorkerCount == 0; });
+        }
+
+        m_Started.reset();
+        m_Finished.reset();
+
+        m_TotalMicroseconds = TimeStamp().QuadPart - m_Origin;
+        FindCriticalPath();
+}
+
+void StartupGraph::FindCriticalPath()
+{
+        const unsigned int count = (unsigned int)m_Steps.size();
+
+        // Steps only depend on earlier ones, so one pass in order sees every dependency's chain first
+        std::vector<int64_t>      chain(count, 0);
+        std::vector<unsigned int> previous(count, UINT_MAX);
+        unsigned int              last = UINT_MAX;
+
+        for (unsigned int i = 0; i < count; ++i)
+        {
+                FStartupStep& step = m_Steps[i];
+                step.critical      = false;
+
+                int64_t longest = 0;
+                for (unsigned int dependency : step.dependencies)
+                {
+                        if (chain[dependency] > longest)
+                        {
+                                longest     = chain[dependency];
+                                previous[i] = dependency;
+                        }
+                }
+                chain[i] = longest + (step.end - step.start);
+
+                if (last == UINT_MAX || chain[i] > chain[last])
+                        last = i;
+        }
+
+        m_CriticalPathMicroseconds = last == UINT_MAX ? 0 : chain[last];
+        for (unsigned int i = last; i != UINT_MAX; i = previous[i])
+                m_Steps[i].critical = true;
+}
+
+void StartupGraph::PrintReport() const
+{
+        for (const FStartupStep& step : m_Steps)
+        {
+                std::stringstream line;
+                line << (step.critical ? "* " : "  ") << step.name << ": " << step.start << " - " << step.end
+                     << " us, thread " << step.threadIndex;
+                ConsoleUtil::PrintMessage(line.str(), "Startup");
+        }
+
+        ConsoleUtil::PrintMessage("total: " + std::to_string(m_TotalMicroseconds) +
+                                      " us, critical path: " + std::to_string(m_CriticalPathMicroseconds) + " us",
+                                  "Startup");
+}
\ No newline at end of file
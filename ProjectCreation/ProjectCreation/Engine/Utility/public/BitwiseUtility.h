@@ -1,4 +1,6 @@
 #pragma once
+#include <stdint.h>
+
 inline namespace BitwiseUtility
 {
         // nextPowerOf2 is from the link below
@@ -24,4 +26,29 @@ inline namespace BitwiseUtility
         {
                 return nextPowerOf2(input + (otherPowerOf2 & input - 1));
         }
+
+        // Calls lambda(begin, end) for every run of set bits among the first count bits, words with no bits left are
+        // skipped whole
+        template <typename Lambda>
+        inline void ForEachSetBitRange(const uint64_t* bits, unsigned int count, Lambda&& lambda)
+        {
+                unsigned int i = 0;
+                while (i < count)
+                {
+                        if (bits[i / 64] >> (i % 64) == 0)
+                        {
+                                i = (i / 64 + 1) * 64;
+                                continue;
+                        }
+                        if ((bits[i / 64] >> (i % 64) & 1) == 0)
+                        {
+                                ++i;
+                                continue;
+                        }
+                        unsigned int begin = i;
+                        while (i < count && (bits[i / 64] >> (i % 64) & 1))
+                                ++i;
+                        lambda(begin, i);
+                }
+        }
 } // namespace BitwiseUtility
\ No newline at end of file
@@ -1,31 +1,9 @@
 #pragma once
+#include <assert.h>
+#include <stdint.h>
 #include <atomic>
-inline namespace BitwiseUtility
-{
-        // nextPowerOf2 is from the link below
-        // https://www.geeksforgeeks.org/smallest-power-of-2-greater-than-or-equal-to-n/
-        // Added an if check to return if n is already a power of 2
-        inline constexpr unsigned int nextPowerOf2(unsigned int n)
-        {
-                if (!(n & (n - 1)))
-                        return n;
-                n--;
-                n |= n >> 1;
-                n |= n >> 2;
-                n |= n >> 4;
-                n |= n >> 8;
-                n |= n >> 16;
-                n++;
-                return n;
-                // This code is contributed by SHUBHAMSINGH10
-        }
-
-        //  gets the next power of 2 that is a factor of N, where N is also a power of 2.
-        inline constexpr unsigned int nextPwrOf2FactorOfOtherPowerOf2(unsigned input, unsigned N)
-        {
-                return nextPowerOf2(input + (N & input - 1));
-        }
-} // namespace BitwiseUtility
+#include <utility>
+#include <BitwiseUtility.h>
 inline namespace ContainerUtility
 {
         constexpr size_t divideRoundUp(size_t dividend, size_t divisor)
@@ -173,30 +151,29 @@ inline namespace ContainerUtility
                 }
         };
 
-        template <typename T, size_t N = 32, size_t Alignment = 1>
-        struct StackVector : VectorImpl<T>
-        {
-                static constexpr unsigned Alignment = GetAlignment(sizeof(T), Alignment);
-
-                char Buffer[N * Alignment];
-                StackVector() : VectorImpl<T>((T*)Buffer, (T*)Buffer, N, Alignment)
-                {}
-        };
-
         inline constexpr unsigned GetAlignment(unsigned ElementSize, unsigned RequestedAlignment)
         {
                 if (ElementSize > RequestedAlignment && !(ElementSize % RequestedAlignment))
                         return ElementSize;
                 if (ElementSize > RequestedAlignment && (ElementSize % RequestedAlignment))
                         return GetAlignment(ElementSize, nextPowerOf2(RequestedAlignment + 1));
-                if (ElementSize < RequestedAlignment)
-                        return RequestedAlignment;
+                return RequestedAlignment;
         }
 
-        template <typename T, unsigned Alignment = 1>
+        template <typename T, size_t N = 32, size_t RequestedAlignment = 1>
+        struct StackVector : VectorImpl<T>
+        {
+                static constexpr unsigned Alignment = GetAlignment(sizeof(T), RequestedAlignment);
+
+                char Buffer[N * Alignment];
+                StackVector() : VectorImpl<T>((T*)Buffer, (T*)Buffer, N, Alignment)
+                {}
+        };
+
+        template <typename T, unsigned RequestedAlignment = 1>
         struct AllocVector : public VectorImpl<T>
         {
-                static constexpr unsigned Alignment = GetAlignment(sizeof(T), Alignment);
+                static constexpr unsigned Alignment = GetAlignment(sizeof(T), RequestedAlignment);
                 static constexpr unsigned Padding   = Alignment - sizeof(T);
                 AllocVector() : VectorImpl<T>(0, 0, 0, Alignment)
                 {}
@@ -250,7 +227,7 @@ inline namespace ContainerUtility
                 {
                         if (sz > VectorImpl<T>::Capacity)
                         {
-                                AllocVector<T, Alignment> other = AllocVector<T, Alignment>(sz);
+                                AllocVector other = AllocVector(sz);
                                 size_t difference               = (size_t)VectorImpl<T>::End - (size_t)VectorImpl<T>::Begin;
                                 for (unsigned i = 0; i < sz && i < difference / Alignment; i++)
                                         other[i] = VectorImpl<T>::operator[](i);
@@ -277,10 +254,10 @@ inline namespace ContainerUtility
 				}
         };
 
-        template <typename T, unsigned MaxElements>
+        template <typename T, unsigned RequestedElements>
         struct RingBuffer
         {
-                static constexpr unsigned MaxElements = nextPowerOf2(MaxElements);
+                static constexpr unsigned MaxElements = nextPowerOf2(RequestedElements);
                 static constexpr unsigned Mask        = MaxElements - 1;
 
                 char*    Buffer;
@@ -302,12 +279,12 @@ inline namespace ContainerUtility
                 }
         };
 
-        template <typename T, unsigned Alignment, unsigned MaxElements>
+        template <typename T, unsigned RequestedAlignment, unsigned RequestedElements>
         struct RingBufferAtomic
         {
-                static constexpr unsigned MaxElements = nextPowerOf2(MaxElements);
+                static constexpr unsigned MaxElements = nextPowerOf2(RequestedElements);
                 static constexpr unsigned Mask        = MaxElements - 1;
-                static constexpr unsigned Alignment   = GetAlignment(sizeof(T), Alignment);
+                static constexpr unsigned Alignment   = GetAlignment(sizeof(T), RequestedAlignment);
 
                 char* const           Buffer;
                 std::atomic<unsigned> previousAllocationOffset = 0 - 1;
@@ -324,4 +301,227 @@ inline namespace ContainerUtility
                 }
         };
 
+        inline constexpr size_t QUEUE_CACHE_LINE_SIZE = 64;
+
+        // Bounded single producer single consumer queue. Each side keeps a cached copy of the other side's index so it
+        // only touches the shared cache line when the queue looks full or empty.
+        template <typename T, unsigned MaxElements>
+        struct SPSCQueue
+        {
+                static constexpr unsigned Capacity = nextPowerOf2(MaxElements);
+                static constexpr unsigned Mask     = Capacity - 1;
+
+                SPSCQueue() : Buffer(new T[Capacity])
+                {}
+                ~SPSCQueue()
+                {
+                        delete[] Buffer;
+                }
+                SPSCQueue(const SPSCQueue&) = delete;
+                SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+                // Producer thread only
+                template <typename U>
+                bool TryPush(U&& element)
+                {
+                        return TryPushBatchImpl(1, [&](size_t index) { Buffer[index & Mask] = std::forward<U>(element); });
+                }
+                unsigned TryPushBatch(const T* elements, unsigned count)
+                {
+                        return TryPushBatchImpl(count, [&](size_t index) { Buffer[index & Mask] = *elements++; });
+                }
+
+                // Consumer thread only
+                bool TryPop(T& element)
+                {
+                        return TryPopBatch(&element, 1) == 1;
+                }
+                unsigned TryPopBatch(T* elements, unsigned maxCount)
+                {
+                        size_t head      = Head.value.load(std::memory_order_relaxed);
+                        size_t available = ProducerTail - head;
+                        if (available < maxCount)
+                        {
+                                ProducerTail = Tail.value.load(std::memory_order_acquire);
+                                available    = ProducerTail - head;
+                        }
+
+                        unsigned count = available < maxCount ? (unsigned)available : maxCount;
+                        for (unsigned i = 0; i < count; ++i)
+                                elements[i] = std::move(Buffer[(head + i) & Mask]);
+                        Head.value.store(head + count, std::memory_order_release);
+                        return count;
+                }
+
+                size_t SizeApprox() const
+                {
+                        return Tail.value.load(std::memory_order_relaxed) - Head.value.load(std::memory_order_relaxed);
+                }
+
+            private:
+                template <typename Writer>
+                unsigned TryPushBatchImpl(unsigned count, Writer&& writer)
+                {
+                        size_t tail = Tail.value.load(std::memory_order_relaxed);
+                        size_t space = Capacity - (tail - ConsumerHead);
+                        if (space < count)
+                        {
+                                ConsumerHead = Head.value.load(std::memory_order_acquire);
+                                space        = Capacity - (tail - ConsumerHead);
+                        }
+
+                        count = space < count ? (unsigned)space : count;
+                        for (unsigned i = 0; i < count; ++i)
+                                writer(tail + i);
+                        Tail.value.store(tail + count, std::memory_order_release);
+                        return count;
+                }
+
+                struct alignas(QUEUE_CACHE_LINE_SIZE) PaddedIndex
+                {
+                        std::atomic<size_t> value{0};
+                };
+
+                T* const    Buffer;
+                PaddedIndex Head;
+                PaddedIndex Tail;
+                // Producer's view of Head and consumer's view of Tail, each on the owning side's cache line
+                alignas(QUEUE_CACHE_LINE_SIZE) size_t ConsumerHead = 0;
+                alignas(QUEUE_CACHE_LINE_SIZE) size_t ProducerTail = 0;
+        };
+
+        // Bounded queue after Dmitry Vyukov's MPMC queue: every cell carries a sequence number that tells producers and
+        // consumers whether the cell is free or filled for the current lap of the ring. Batches claim a run of ready
+        // cells with a single compare exchange. With SingleConsumer the pop side claims cells without the compare
+        // exchange.
+        template <typename T, unsigned MaxElements, bool SingleConsumer>
+        struct BoundedQueue
+        {
+                static constexpr unsigned Capacity = nextPowerOf2(MaxElements);
+                static constexpr unsigned Mask     = Capacity - 1;
+                static_assert(Capacity >= 2, "Error. Bounded queue needs at least two cells");
+
+                BoundedQueue() : Cells(new Cell[Capacity])
+                {
+                        for (unsigned i = 0; i < Capacity; ++i)
+                                Cells[i].sequence.store(i, std::memory_order_relaxed);
+                }
+                ~BoundedQueue()
+                {
+                        delete[] Cells;
+                }
+                BoundedQueue(const BoundedQueue&) = delete;
+                BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+                template <typename U>
+                bool TryPush(U&& element)
+                {
+                        size_t position;
+                        if (ClaimCells(EnqueuePosition, 0, 1, false, position) == 0)
+                                return false;
+                        Cell& cell = Cells[position & Mask];
+                        cell.data  = std::forward<U>(element);
+                        cell.sequence.store(position + 1, std::memory_order_release);
+                        return true;
+                }
+                unsigned TryPushBatch(const T* elements, unsigned count)
+                {
+                        size_t   position;
+                        unsigned claimed = ClaimCells(EnqueuePosition, 0, count, false, position);
+                        for (unsigned i = 0; i < claimed; ++i)
+                        {
+                                Cell& cell = Cells[(position + i) & Mask];
+                                cell.data  = elements[i];
+                                cell.sequence.store(position + i + 1, std::memory_order_release);
+                        }
+                        return claimed;
+                }
+
+                // Any thread, or only the consumer thread when SingleConsumer is set
+                bool TryPop(T& element)
+                {
+                        return TryPopBatch(&element, 1) == 1;
+                }
+                unsigned TryPopBatch(T* elements, unsigned maxCount)
+                {
+                        size_t   position;
+                        unsigned claimed = ClaimCells(DequeuePosition, 1, maxCount, SingleConsumer, position);
+                        for (unsigned i = 0; i < claimed; ++i)
+                        {
+                                Cell& cell  = Cells[(position + i) & Mask];
+                                elements[i] = std::move(cell.data);
+                                cell.sequence.store(position + i + Capacity, std::memory_order_release);
+                        }
+                        return claimed;
+                }
+
+                size_t SizeApprox() const
+                {
+                        size_t enqueued = EnqueuePosition.value.load(std::memory_order_relaxed);
+                        size_t dequeued = DequeuePosition.value.load(std::memory_order_relaxed);
+                        return enqueued > dequeued ? enqueued - dequeued : 0;
+                }
+
+            private:
+                struct Cell
+                {
+                        std::atomic<size_t> sequence;
+                        T                   data;
+                };
+
+                struct alignas(QUEUE_CACHE_LINE_SIZE) PaddedIndex
+                {
+                        std::atomic<size_t> value{0};
+                };
+
+                // Claims up to maxCount consecutive cells whose sequence equals their position plus lap, where lap is 0
+                // for cells free to write and 1 for cells ready to read
+                unsigned ClaimCells(PaddedIndex& index, size_t lap, unsigned maxCount, bool exclusive, size_t& position)
+                {
+                        position = index.value.load(std::memory_order_relaxed);
+                        while (true)
+                        {
+                                unsigned ready = 0;
+                                while (ready < maxCount)
+                                {
+                                        const Cell& cell = Cells[(position + ready) & Mask];
+                                        if (cell.sequence.load(std::memory_order_acquire) != position + ready + lap)
+                                                break;
+                                        ++ready;
+                                }
+
+                                if (ready == 0)
+                                {
+                                        // Either the queue is full/empty or another thread already claimed this cell
+                                        size_t sequence = Cells[position & Mask].sequence.load(std::memory_order_acquire);
+                                        if ((intptr_t)(sequence - (position + lap)) < 0)
+                                                return 0;
+                                        position = index.value.load(std::memory_order_relaxed);
+                                        continue;
+                                }
+
+                                if (exclusive)
+                                {
+                                        index.value.store(position + ready, std::memory_order_relaxed);
+                                        return ready;
+                                }
+                                size_t expected = position;
+                                if (index.value.compare_exchange_weak(expected, position + ready, std::memory_order_relaxed))
+                                        return ready;
+                                position = expected;
+                        }
+                }
+
+                Cell* const Cells;
+                PaddedIndex EnqueuePosition;
+                PaddedIndex DequeuePosition;
+        };
+
+        template <typename T, unsigned MaxElements>
+        using MPMCQueue = BoundedQueue<T, MaxElements, false>;
+
+        // Pop side may only be used from one thread
+        template <typename T, unsigned MaxElements>
+        using MPSCQueue = BoundedQueue<T, MaxElements, true>;
+
 }; // namespace ContainerUtility
\ No newline at end of file
@@ -0,0 +1,109 @@
+#pragma once
+#include <limits.h>
+#include <stdint.h>
+#include <string>
+
+#include <Profiling.h>
+
+// Counters are on in every configuration, define NO_COUNTERS to compile the macros out
+#define COUNTERS
+
+#ifdef NO_COUNTERS
+#undef COUNTERS
+#endif
+
+struct E_COUNTER_MODE
+{
+        enum
+        {
+                // Summed over the frame, starts at 0 every frame
+                ACCUMULATE = 0,
+                // Last value set, kept until it is set again
+                SAMPLE,
+                COUNT
+        };
+};
+
+struct FCounterStats
+{
+        double   last       = 0.0;
+        double   min        = 0.0;
+        double   max        = 0.0;
+        double   avg        = 0.0;
+        double   p95        = 0.0;
+        double   p99        = 0.0;
+        unsigned frameCount = 0;
+};
+
+// Named per frame values with rolling statistics over the last kWindowSize frames.
+// Counters are written and read on the main thread only, values gathered on other threads are summed by their owner
+// and set once per frame.
+namespace Counters
+{
+        constexpr unsigned    kWindowSize = 240;
+        constexpr unsigned    kInvalidId  = UINT_MAX;
+        constexpr const char* kCSVPath    = "counters.csv";
+        constexpr const char* kJSONPath   = "counters.json";
+
+        // Returns the existing id if the name is already registered
+        unsigned Register(const std::string& name, int mode = E_COUNTER_MODE::ACCUMULATE);
+        // kInvalidId if the name was never registered
+        unsigned Find(const std::string& name);
+
+        void Add(unsigned id, double value);
+        void Set(unsigned id, double value);
+
+        // Moves this frame's values into the windows, after every system updated
+        void EndFrame();
+
+        unsigned           GetCount();
+        const std::string& GetName(unsigned id);
+        FCounterStats      GetStats(unsigned id);
+        // Stats with a frameCount of 0 if the name was never registered
+        FCounterStats GetStats(const std::string& name);
+
+        void WriteCSV(const char* fileName = kCSVPath);
+        void WriteJSON(const char* fileName = kJSONPath);
+        // One line per counter with last, average, p95 and p99, for the in game overlay
+        std::string FormatOverlay();
+
+        // Clears every counter's values, ids handed out by Register stay valid
+        void Shutdown();
+
+        // Adds the scope's duration in microseconds
+        struct FScopeTimer
+        {
+                unsigned id;
+                int64_t  start;
+
+                inline FScopeTimer(unsigned id) : id(id), start(TimeStamp().QuadPart)
+                {}
+                inline ~FScopeTimer()
+                {
+                        Add(id, double(TimeStamp().QuadPart - start));
+                }
+        };
+} // namespace Counters
+
+// The name is only looked up the first time a call site runs, so it has to be the same on every call
+#ifdef COUNTERS
+#define COUNTER_ADD(name, value)                                                                                       \
+        do                                                                                                             \
+        {                                                                                                              \
+                static const unsigned counterId = Counters::Register(name, E_COUNTER_MODE::ACCUMULATE);                \
+                Counters::Add(counterId, double(value));                                                               \
+        } while (0)
+#define COUNTER_SET(name, value)                                                                                       \
+        do                                                                                                             \
+        {                                                                                                              \
+                static const unsigned counterId = Counters::Register(name, E_COUNTER_MODE::SAMPLE);                    \
+                Counters::Set(counterId, double(value));                                                               \
+        } while (0)
+#define COUNTER_TIME_SCOPE(name)                                                                                       \
+        static const unsigned PROFILE_CONCAT(counterId, __LINE__) = Counters::Register(name);                          \
+        Counters::FScopeTimer PROFILE_CONCAT(counterTimer, __LINE__)(PROFILE_CONCAT(counterId, __LINE__))
+#else
+#define COUNTER_ADD(name, value)
+#define COUNTER_SET(name, value)
+#define COUNTER_TIME_SCOPE(name)
+#endif
\ No newline at end of file
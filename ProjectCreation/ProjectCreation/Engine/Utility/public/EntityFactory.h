@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>
 #include <HandleManager.h>
+#include <IResource.h>
 
 namespace EntityFactory
 {
@@ -14,6 +15,13 @@ namespace EntityFactory
                                             ComponentHandle* outStaticMeshHandle = nullptr,
                                             bool             wrapping            = true);
 
+        // Same as above from already resolved resources, no name lookups
+        EntityHandle CreateStaticMeshEntity(const ResourceHandle& staticMeshHandle,
+                                            const ResourceHandle& materialHandle,
+                                            ComponentHandle*      outTransformHandle  = nullptr,
+                                            ComponentHandle*      outStaticMeshHandle = nullptr,
+                                            bool                  wrapping            = true);
+
         EntityHandle CreateSkeletalMeshEntity(const char*              skeletalMeshName,
                                               const char*              materialName,
                                               std::vector<std::string> animNames,
@@ -1,88 +1,159 @@
 #pragma once
 #define WIN_32_LEAN_AND_MEAN
 #include <Windows.h>
-#include <fstream>
-#include <sstream>
-#include <stack>
-#include <string>
-#include <thread>
-
+#include <intrin.h>
+#include <stdint.h>
+#include <atomic>
 
+// Profiling is on in every configuration, define NO_PROFILING to compile the scopes out
 #define PROFILING
 
-#ifndef _DEBUG
+#ifdef NO_PROFILING
 #undef PROFILING
 #endif
 
+// Microseconds since boot
 inline LARGE_INTEGER TimeStamp()
 {
+        static const int64_t frequency = []() {
+                LARGE_INTEGER Frequency;
+                QueryPerformanceFrequency(&Frequency);
+                return Frequency.QuadPart;
+        }();
+
+        // Whole seconds and remainder separately, the counter times a million overflows after a few days
         LARGE_INTEGER TimeStamp;
-        LARGE_INTEGER Frequency;
-        QueryPerformanceFrequency(&Frequency);
         QueryPerformanceCounter(&TimeStamp);
-        TimeStamp.QuadPart *= 1000000;
-        TimeStamp.QuadPart /= Frequency.QuadPart;
+        TimeStamp.QuadPart = (TimeStamp.QuadPart / frequency) * 1000000 +
+                             (TimeStamp.QuadPart % frequency) * 1000000 / frequency;
         return TimeStamp;
 }
 
-struct ProfilerContext
+struct E_PROFILER_EVENT
 {
-#ifdef PROFILING
-        std::stringstream       ss;
-        std::stack<std::string> name_Stack;
-        std::stack<std::string> category_stack;
-        std::thread::id         tid;
-        unsigned                pid;
-#endif
+        enum
+        {
+                SCOPE = 0,
+                // Sample of a named series, counters with the same category are drawn as one track
+                COUNTER,
+                COUNT
+        };
+};
+
+// Category and name have to stay valid until Profiler::Shutdown, string literals or names owned by systems
+struct FProfilerEvent
+{
+        const char* category;
+        const char* name;
+        uint64_t    start;
+        union
+        {
+                uint64_t end;
+                double   value;
+        };
+        uint32_t type;
+};
 
+namespace Profiler
+{
+        // Per thread ring of events, a thread recording more keeps only the latest ones
+        constexpr uint32_t kEventsPerThread = 1 << 16;
+        constexpr uint32_t kMaxThreads      = 64;
 
-        inline void Initialize()
+        constexpr const char* kChromeTracePath = "profiling.json";
+        constexpr const char* kBinaryTracePath = "profiling.bin";
+
+        // Written by its own thread only, readers snapshot it through writeCount
+        struct FThreadBuffer
         {
-#ifdef PROFILING
+                FProfilerEvent        events[kEventsPerThread];
+                std::atomic<uint64_t> writeCount{0};
+                uint32_t              index      = 0;
+                char                  name[32]   = {};
+        };
 
-                tid = std::this_thread::get_id();
-                pid = ::_getpid();
-                ss << "[";
+        inline std::atomic<bool>           g_Active{false};
+        inline thread_local FThreadBuffer* t_Buffer = nullptr;
 
-#endif
+        // Has to be called before any other thread records
+        void Initialize();
+        // Writes the Chrome trace and the binary trace, then empties the buffers. Every other recording thread has to
+        // be stopped, the buffers themselves are kept for the threads that registered them
+        void Shutdown();
+
+        // Shown as the thread's name in the traces
+        void SetThreadName(const char* name);
+
+        // Measured against the performance counter since Initialize
+        double GetTicksPerMicrosecond();
+
+        FThreadBuffer* RegisterThread();
+
+        inline uint64_t Ticks()
+        {
+                return __rdtsc();
         }
 
-        inline void Begin(std::string cat = "", std::string name = "")
+        inline void Record(const FProfilerEvent& event)
         {
-#ifdef PROFILING
+                if (!g_Active.load(std::memory_order_relaxed))
+                        return;
 
-                ss << "{ \"cat\":\"" << cat << "\",\"ph\":\"B\", \"name\":\"" << name << "\",\"pid\":\"" << pid
-                   << "\",\"tid\":\"" << tid << "\",\"ts\":\"" << TimeStamp().QuadPart << "\"},";
-                category_stack.emplace(cat);
-                name_Stack.emplace(name);
-#endif
-        }
+                FThreadBuffer* buffer = t_Buffer ? t_Buffer : (t_Buffer = RegisterThread());
+                uint64_t       index  = buffer->writeCount.load(std::memory_order_relaxed);
 
+                buffer->events[index & (kEventsPerThread - 1)] = event;
+                buffer->writeCount.store(index + 1, std::memory_order_release);
+        }
 
-        inline void End()
+        inline void Record(const char* category, const char* name, uint64_t start, uint64_t end)
         {
-#ifdef PROFILING
-
-                std::string name = name_Stack.top();
-                std::string cat  = category_stack.top();
-                name_Stack.pop();
-                category_stack.pop();
-                ss << "{ \"cat\":\"" << cat << "\",\"ph\":\"E\", \"name\":\"" << name << "\",\"pid\":\"" << pid
-                   << "\",\"tid\":\"" << tid << "\",\"ts\":\"" << TimeStamp().QuadPart << "\"},";
-#endif
+                FProfilerEvent event;
+                event.category = category;
+                event.name     = name;
+                event.start    = start;
+                event.end      = end;
+                event.type     = E_PROFILER_EVENT::SCOPE;
+                Record(event);
         }
 
-        inline void Dump()
+        inline void RecordCounter(const char* category, const char* name, double value)
         {
-#ifdef PROFILING
+                FProfilerEvent event;
+                event.category = category;
+                event.name     = name;
+                event.start    = Ticks();
+                event.value    = value;
+                event.type     = E_PROFILER_EVENT::COUNTER;
+                Record(event);
+        }
 
-                ss.seekp(-1, std::ios_base::end);
-                ss << "]";
-                std::string  s = ss.str();
-                std::fstream fs("profiling.json", std::ios::out);
-                fs.write(s.c_str(), s.size());
-                fs.close();
+        struct FScope
+        {
+                const char* category;
+                const char* name;
+                uint64_t    start;
+
+                inline FScope(const char* category, const char* name) :
+                    category(category),
+                    name(name),
+                    start(Ticks())
+                {}
+
+                inline ~FScope()
+                {
+                        Record(category, name, start, Ticks());
+                }
+        };
+} // namespace Profiler
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
 
+#ifdef PROFILING
+#define PROFILE_SCOPE(category, name) Profiler::FScope PROFILE_CONCAT(profileScope, __COUNTER__)(category, name)
+#else
+#define PROFILE_SCOPE(category, name)
 #endif
-        }
-};
\ No newline at end of file
+
+#define PROFILE_FUNCTION(category) PROFILE_SCOPE(category, __FUNCTION__)
\ No newline at end of file
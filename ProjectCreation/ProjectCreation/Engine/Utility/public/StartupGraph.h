@@ -0,0 +1,96 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+struct E_STARTUP_THREAD
+{
+        enum
+        {
+                // Window, immediate context and ECS work
+                MAIN = 0,
+                // Any job scheduler thread
+                ANY,
+                COUNT
+        };
+};
+
+struct FStartupStep
+{
+        const char*               name = nullptr;
+        std::function<void()>     function;
+        std::vector<unsigned int> dependencies;
+        int                       thread = E_STARTUP_THREAD::MAIN;
+
+        // Microseconds since Run started
+        int64_t      start       = 0;
+        int64_t      end         = 0;
+        unsigned int threadIndex = 0;
+        bool         critical    = false;
+};
+
+// Engine init steps with declared dependencies. A step starts once its dependencies have finished, ANY steps as jobs
+// and MAIN steps on the thread calling Run, which helps executing jobs while nothing is ready for it. Every step is
+// timed so the report shows which chain of dependencies bounded the startup.
+class StartupGraph
+{
+        std::vector<FStartupStep> m_Steps;
+        int64_t                   m_Origin                   = 0;
+        int64_t                   m_TotalMicroseconds        = 0;
+        int64_t                   m_CriticalPathMicroseconds = 0;
+
+        // Only valid during Run
+        std::unique_ptr<std::atomic<bool>[]> m_Started;
+        std::unique_ptr<std::atomic<bool>[]> m_Finished;
+
+        // Signalled whenever a step finishes, Run sleeps on it while workers own every runnable step
+        std::mutex              m_FinishedMutex;
+        std::condition_variable m_FinishedCondition;
+        unsigned int            m_FinishedCount     = 0;
+        // Worker jobs still inside RunWorkerSteps, they touch the graph after their last step has finished
+        unsigned int            m_ActiveWorkerCount = 0;
+
+        bool IsReady(unsigned int index) const;
+        bool TryStart(unsigned int index);
+        void RunStep(unsigned int index);
+        // Runs the step and then every ANY step it made ready, workers can't create jobs of their own
+        void RunWorkerSteps(unsigned int index);
+        void FindCriticalPath();
+
+    public:
+        // Dependencies have to be added before the steps depending on them. The name is kept by the profiler, so it
+        // has to be a string literal
+        unsigned int Add(const char*                         name,
+                         int                                 thread,
+                         std::function<void()>               function,
+                         std::initializer_list<unsigned int> dependencies = {});
+
+        // Blocks until every step has finished. The job scheduler has to be initialized
+        void Run();
+
+        inline const std::vector<FStartupStep>& GetSteps() const
+        {
+                return m_Steps;
+        }
+
+        // Wall time of Run
+        inline int64_t GetTotalMicroseconds() const
+        {
+                return m_TotalMicroseconds;
+        }
+
+        // Longest chain of dependent steps, the lower bound for Run with unlimited threads
+        inline int64_t GetCriticalPathMicroseconds() const
+        {
+                return m_CriticalPathMicroseconds;
+        }
+
+        // One console line per step, critical path steps are marked with '*'
+        void PrintReport() const;
+};
\ No newline at end of file
@@ -16,9 +16,9 @@ cbuffer CScreenSpaceBuffer : register(b2)
 [numthreads(512, 1, 1)] void main(uint3 DTid
                                   : SV_DispatchThreadID) {
         int id            = DTid.x;
-        int emitterIndex  = id / gMaxParticlePerEmitter;
-        int emitterOffset = id % gMaxParticlePerEmitter;
-        int desired       = SegmentBuffer[emitterIndex].desiredCount;
+        int emitterIndex  = FindEmitterIndex(id);
+        int emitterOffset = id - SegmentBuffer[emitterIndex].offset;
+        int desired       = SegmentBuffer[emitterIndex].count;
 
         if (ParticleBuffer[id].time <= 0.0f)
         {
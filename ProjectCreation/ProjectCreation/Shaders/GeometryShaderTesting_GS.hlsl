@@ -54,22 +54,23 @@ void TextureAddress(inout float2 UVcord[4], uint index, uint rowcol) // row and
 [maxvertexcount(4)] void main(point VS_OUTPUT input[1], inout TriangleStream<GSOutput> output, uint InstanceID
                               : SV_PrimitiveID) {
         GSOutput verts[4] = {(GSOutput)0, (GSOutput)0, (GSOutput)0, (GSOutput)0};
-        uint     id       = InstanceID;
+        // SV_VertexID of the point, the particle index when drawn through the sorted index buffer
+        uint id = input[0].id;
 
         float2 uv[4] = {float2(0.0f, 0.0f), float2(1.0f, 0.0f), float2(0.0f, 1.0f), float2(1.0f, 1.0f)}; //defult value\
 
-        TextureAddress(uv, (uint)buffer[InstanceID].textureIndex, 2); // buffer[InstanceID].textueRowCol
+        TextureAddress(uv, (uint)buffer[id].textureIndex, 2); // buffer[id].textueRowCol
 
-        float3 screenVel = mul(float4(buffer[InstanceID].velocity.xyz, 0.0f), ViewProjection).xyz;
+        float3 screenVel = mul(float4(buffer[id].velocity.xyz, 0.0f), ViewProjection).xyz;
 
         float3 zValue = {0.0f, 0.0f, 1.0f};
 
-        float dirAlpha = float(buffer[InstanceID].flags & ALIGN_TO_VEL);
+        float dirAlpha = float(buffer[id].flags & ALIGN_TO_VEL);
 
         float3 upDir    = lerp(float3(0.0f, 1.0f, 0.0f), normalize(screenVel.xyz), dirAlpha); // vel direction
         float3 rightDir = cross(upDir, zValue);
 
-        if (buffer[InstanceID].time > 0.0f)
+        if (buffer[id].time > 0.0f)
         {
                 // Compute current data from initial and target
                 float  timeAlpha    = 1.0f - buffer[id].time / buffer[id].lifeSpan.x;
@@ -86,7 +87,7 @@ void TextureAddress(inout float2 UVcord[4], uint index, uint rowcol) // row and
 
                 for (int i = 0; i < 4; ++i)
                 {
-                        verts[i].posWS = buffer[InstanceID].position.xyz;
+                        verts[i].posWS = buffer[id].position.xyz;
                         // verts[i].pos   = float4(0.0f, 0.0f, 0.0f, 1.0f);
                         verts[i].color = currentColor;
                 }
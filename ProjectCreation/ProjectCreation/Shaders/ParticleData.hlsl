@@ -1,6 +1,5 @@
 static const unsigned int gMaxEmitterCount       = 2 << 10;
 static const unsigned int gMaxParticleCount      = 2 << 18;
-static const unsigned int gMaxParticlePerEmitter = gMaxParticleCount / gMaxEmitterCount;
 
 #define ALIGN_TO_VEL (1 << 0)
 #define NO_COLLISION (1 << 1)
@@ -41,12 +40,31 @@ struct FEmitterGPU
         uint   textureIndex;
 };
 
+// Range of ParticleBuffer owned by an emitter, offsets are an exclusive prefix sum of the counts
 struct FSegmentBuffer
 {
-        int desiredCount;
+        uint offset;
+        uint count;
 };
 
 RWStructuredBuffer<FParticleGPU> ParticleBuffer : register(u0);
 StructuredBuffer<FEmitterGPU>    EmitterBuffer : register(t0);
 Texture2D                        SceneDepth : register(t1);
-StructuredBuffer<FSegmentBuffer> SegmentBuffer : register(t2);
\ No newline at end of file
+StructuredBuffer<FSegmentBuffer> SegmentBuffer : register(t2);
+
+// Last segment starting at or before id. Empty segments share their offset with the following segment so the
+// search lands on the segment that owns id.
+int FindEmitterIndex(uint id)
+{
+        int low  = 0;
+        int high = gMaxEmitterCount - 1;
+        while (low < high)
+        {
+                int mid = (low + high + 1) / 2;
+                if (SegmentBuffer[mid].offset <= id)
+                        low = mid;
+                else
+                        high = mid - 1;
+        }
+        return low;
+}
\ No newline at end of file
@@ -33,7 +33,6 @@ float3 VSPositionFromDepth(float2 vTexCoord)
                                   : SV_DispatchThreadID) {
         float3 direction;
         int    id           = DTid.x;
-        int    emitterIndex = id / gMaxParticlePerEmitter;
 
         ParticleBuffer[id].prevPos = ParticleBuffer[id].position;
 
@@ -36,6 +36,8 @@
 #include <OrbitSystem.h>
 #include <SpeedBoostSystem.h>
 #include <DirectionalLightComponent.h>
+#include <AssetArchive.h>
+#include <ShaderCache.h>
 
 
 using namespace DirectX;
@@ -97,6 +99,10 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
         std::srand(unsigned(std::time(0)));
         JGamePad::Get()->Init();
 
+        // Packs the loose asset files into the archive mounted at startup
+        if (strstr(lpCmdLine, "-packassets"))
+                FileIO::AssetArchive::Build("../Assets", FileIO::AssetArchive::kDefaultArchivePath);
+
         // console window creation
 		HWND mainWindowHandle = WindowsUtil::CreateDefaultEngineWindow();
 
@@ -179,28 +185,51 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
         GEngine::Get()->GetLevelStateManager()->Init();
         UIManager::instance->StartupResAdjust(mainWindowHandle);
 
+        // Cold start asset cost, every loose open is a CreateFile, a mapping and their closes
+        {
+                FileIO::FAssetIOStats assetStats = FileIO::AssetArchive::GetStats();
+                ConsoleUtil::PrintMessage(std::string(FileIO::AssetArchive::IsMounted() ? "archive" : "loose files") +
+                                              ", archive reads: " + std::to_string(assetStats.archiveReads) +
+                                              ", loose opens: " + std::to_string(assetStats.looseFileOpens) +
+                                              ", bytes: " + std::to_string(assetStats.bytesServed) +
+                                              ", open time (us): " + std::to_string(assetStats.openMicroseconds),
+                                          "AssetArchive");
+        }
+        {
+                const FShaderCacheStats& shaderStats = ShaderCache::GetStats();
+                ConsoleUtil::PrintMessage("prewarmed: " + std::to_string(shaderStats.prewarmedCount) +
+                                              " in " + std::to_string(shaderStats.prewarmMicroseconds) + " us" +
+                                              ", hits: " + std::to_string(shaderStats.hitCount) +
+                                              ", misses: " + std::to_string(shaderStats.missCount) +
+                                              ", shared: " + std::to_string(shaderStats.sharedCount),
+                                          "ShaderCache");
+        }
+
 
         GEngine::Get()->Signal();
         while (msg.message != WM_QUIT && !GEngine::Get()->WantsGameExit())
         {
                 GCoreInput::UpdateInput();
 
-                GEngine::Get()->m_MainThreadProfilingContext.Begin("Main Loop", "PeekMessage");
-                while (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE))
                 {
-                        TranslateMessage(&msg);
-                        DispatchMessage(&msg);
-                        if (msg.message == WM_QUIT)
-                                break;
+                        PROFILE_SCOPE("Main Loop", "PeekMessage");
+                        while (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE))
+                        {
+                                TranslateMessage(&msg);
+                                DispatchMessage(&msg);
+                                if (msg.message == WM_QUIT)
+                                        break;
+                        }
                 }
-                GEngine::Get()->m_MainThreadProfilingContext.End();
 
-                GEngine::Get()->m_MainThreadProfilingContext.Begin("Main Loop", "GEngine::Signal");
                 // Main application loop goes here.
-                float deltaTime = GEngine::Get()->Update();
-                GEngine::Get()->m_MainThreadProfilingContext.End();
+                float deltaTime;
+                {
+                        PROFILE_SCOPE("Main Loop", "GEngine::Signal");
+                        deltaTime = GEngine::Get()->Update();
+                }
 
-                GEngine::Get()->m_MainThreadProfilingContext.Begin("Main Loop", "Other");
+                PROFILE_SCOPE("Main Loop", "Other");
                 if (GetActiveWindow() != mainWindowHandle && GEngine::Get()->GetGamePaused() == false)
                 {
                         UIManager::instance->Pause();
@@ -222,9 +251,20 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
                 }
 
 
+#ifdef COUNTERS
+                if (GCoreInput::GetKeyState(KeyCode::F9) == KeyState::DownFirst)
+                        UIManager::instance->m_ShowCounters = !UIManager::instance->m_ShowCounters;
+                if (GCoreInput::GetKeyState(KeyCode::F10) == KeyState::DownFirst)
+                {
+                        Counters::WriteCSV();
+                        Counters::WriteJSON();
+                }
+#endif
+
                 debug_renderer::AddGrid(XMVectorZero(), 10.0f, 10, ColorConstants::White);
                 GEngine::Get()->GetSystemManager()->Update(deltaTime);
-                GEngine::Get()->m_MainThreadProfilingContext.End();
+                GEngine::Get()->EndFrame();
+                NMemory::FrameAllocator::EndFrame();
         }
         JGamePad::Shutdown();
         EngineUtil::ShutdownEngineSystemManagers();